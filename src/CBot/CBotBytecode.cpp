@@ -0,0 +1,1158 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotBytecode.h"
+
+#include "CBot/CBotExecutionContext.h"
+#include "CBot/CBotStack.h"
+
+#include "CBot/CBotInstr/CBotInstr.h"
+
+#include "CBot/CBotVar/CBotVarInt.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <mutex>
+
+namespace CBot
+{
+
+namespace
+{
+
+using Opcode = CBotBytecode::Opcode;
+using Value = CBotBytecode::Value;
+
+//! Temporary registers are numbered from here until the function is compiled
+const int TEMPORARY_BASE = 1 << 24;
+//! The position in the code is kept in the state of the stack, which is saved as a 16-bit word
+const int MAX_CODE_SIZE = 32000;
+
+std::set<std::string> g_defNums;
+std::mutex g_defNumsMutex;
+
+bool IsNumber(CBotType type)
+{
+    return type == CBotTypInt || type == CBotTypFloat || type == CBotTypBoolean;
+}
+
+Value UndefinedValue(CBotType type)
+{
+    Value value;
+    value.type = type;
+    value.init = CBotVar::InitType::UNDEF;
+    value.valInt = 0;
+    value.defNum = nullptr;
+    return value;
+}
+
+float GetFloat(const Value& value)
+{
+    if (value.type == CBotTypFloat) return value.valFloat;
+    return static_cast<float>(value.valInt);
+}
+
+int GetInt(const Value& value)
+{
+    if (value.type == CBotTypFloat) return static_cast<int>(value.valFloat);
+    return value.valInt;
+}
+
+// The following work like CBotVar::SetValFloat() and CBotVar::SetValInt() of the type of the value
+
+void SetFloat(Value& value, float val)
+{
+    if (value.type == CBotTypFloat)        value.valFloat = val;
+    else if (value.type == CBotTypBoolean) value.valInt = static_cast<bool>(val);
+    else                                   value.valInt = static_cast<int>(val);
+    value.init = CBotVar::InitType::DEF;
+}
+
+void SetInt(Value& value, int val, const std::string* defNum = nullptr)
+{
+    if (value.type == CBotTypFloat)        value.valFloat = static_cast<float>(val);
+    else if (value.type == CBotTypBoolean) value.valInt = static_cast<bool>(val);
+    else                                   value.valInt = val;
+    value.defNum = defNum;
+    value.init = CBotVar::InitType::DEF;
+}
+
+//! Works like CBotVar::SetVal()
+void Assign(Value& var, const Value& value)
+{
+    switch (value.type)
+    {
+        case CBotTypInt:
+            SetInt(var, value.valInt, value.defNum);
+            break;
+        case CBotTypFloat:
+            SetFloat(var, value.valFloat);
+            break;
+        default:
+            SetInt(var, value.valInt);
+    }
+    var.init = value.init;
+}
+
+bool IsNan(const Value& value)
+{
+    return value.init > CBotVar::InitType::DEF;
+}
+
+//! Type of the result of a binary operator, like in CBotTwoOpExpr::Execute()
+CBotType GetResultType(Opcode op, CBotType left, CBotType right)
+{
+    switch (op)
+    {
+        case Opcode::Less:
+        case Opcode::Greater:
+        case Opcode::LessEqual:
+        case Opcode::GreaterEqual:
+        case Opcode::Equal:
+        case Opcode::NotEqual:
+            return CBotTypBoolean;
+        case Opcode::Div:
+            return std::max(std::max(left, right), CBotTypFloat);
+        default:
+            return std::max(left, right);
+    }
+}
+
+//! Computes a binary operator into result, which already has the type of the result
+CBotError Compute(Opcode op, const Value& left, const Value& right, Value& result)
+{
+    switch (op)
+    {
+        case Opcode::Add:
+        case Opcode::AddAssign:
+            SetFloat(result, GetFloat(left) + GetFloat(right));
+            break;
+        case Opcode::Sub:
+        case Opcode::SubAssign:
+            SetFloat(result, GetFloat(left) - GetFloat(right));
+            break;
+        case Opcode::Mul:
+        case Opcode::MulAssign:
+            SetFloat(result, GetFloat(left) * GetFloat(right));
+            break;
+        case Opcode::Power:
+            SetFloat(result, pow(GetFloat(left), GetFloat(right)));
+            break;
+        case Opcode::Div:
+        case Opcode::DivAssign:
+        {
+            float r = GetFloat(right);
+            if (r == 0) return CBotErrZeroDiv;
+            SetFloat(result, GetFloat(left) / r);
+            break;
+        }
+        case Opcode::Mod:
+        case Opcode::ModAssign:
+        {
+            float r = GetFloat(right);
+            if (r == 0) return CBotErrZeroDiv;
+            SetFloat(result, fmod(GetFloat(left), r));
+            break;
+        }
+        case Opcode::And:
+        case Opcode::AndAssign:
+            if (result.type == CBotTypBoolean) SetInt(result, GetInt(left) && GetInt(right));
+            else                               SetInt(result, GetInt(left) & GetInt(right));
+            break;
+        case Opcode::Or:
+        case Opcode::OrAssign:
+            if (result.type == CBotTypBoolean) SetInt(result, GetInt(left) || GetInt(right));
+            else                               SetInt(result, GetInt(left) | GetInt(right));
+            break;
+        case Opcode::Xor:
+        case Opcode::XorAssign:
+            SetInt(result, GetInt(left) ^ GetInt(right));
+            break;
+        case Opcode::ShiftLeft:
+        case Opcode::ShiftLeftAssign:
+            SetInt(result, GetInt(left) << GetInt(right));
+            break;
+        case Opcode::ShiftRightArith:
+        case Opcode::ShiftRightArithAssign:
+            SetInt(result, GetInt(left) >> GetInt(right));
+            break;
+        case Opcode::ShiftRight:
+        case Opcode::ShiftRightAssign:
+        {
+            int source = GetInt(left);
+            int shift  = GetInt(right);
+            if (shift >= 1) source &= 0x7fffffff;
+            SetInt(result, source >> shift);
+            break;
+        }
+        case Opcode::Less:
+            SetInt(result, GetFloat(left) < GetFloat(right));
+            break;
+        case Opcode::Greater:
+            SetInt(result, GetFloat(left) > GetFloat(right));
+            break;
+        case Opcode::LessEqual:
+            SetInt(result, GetFloat(left) <= GetFloat(right));
+            break;
+        case Opcode::GreaterEqual:
+            SetInt(result, GetFloat(left) >= GetFloat(right));
+            break;
+        case Opcode::Equal:
+            SetInt(result, GetFloat(left) == GetFloat(right));
+            break;
+        case Opcode::NotEqual:
+            SetInt(result, GetFloat(left) != GetFloat(right));
+            break;
+        default:
+            assert(false);
+    }
+    return CBotNoErr;
+}
+
+//! Writes a value to a variable of the same type
+void StoreValue(CBotVar* var, const Value& value)
+{
+    switch (var->GetType())
+    {
+        case CBotTypInt:
+            var->SetValInt(GetInt(value), value.defNum != nullptr ? *value.defNum : std::string());
+            break;
+        case CBotTypFloat:
+            var->SetValFloat(GetFloat(value));
+            break;
+        default:
+            var->SetValInt(GetInt(value));
+    }
+    var->SetInit(value.init);
+}
+
+CBotVar* CreateVar(const std::string& name, const Value& value)
+{
+    CBotVar* var = CBotVar::Create(name, CBotTypResult(value.type));
+    StoreValue(var, value);
+    return var;
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+CBotBytecode::CBotBytecode()
+{
+}
+
+CBotBytecode::~CBotBytecode()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+const std::string* CBotBytecode::InternDefNum(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(g_defNumsMutex);
+    return &*g_defNums.insert(name).first;
+}
+
+CBotBytecode::Value CBotBytecode::LoadValue(CBotVar* var)
+{
+    Value value = UndefinedValue(var->GetType());
+    if (value.type == CBotTypFloat)
+    {
+        value.valFloat = var->GetValFloat();
+    }
+    else
+    {
+        value.valInt = var->GetValInt();
+        if (value.type == CBotTypInt)
+        {
+            const std::string& defNum = static_cast<CBotVarInt*>(var)->m_defnum;
+            if (!defNum.empty()) value.defNum = InternDefNum(defNum);
+        }
+    }
+    value.init = var->GetInit();
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CBotBytecode::LoadRegisters(CBotStack* pj, CBotStack* frame, Value* regs, bool resume)
+{
+    CBotVar* var = frame->m_listVar;
+    for (std::size_t i = 0; i < m_registers.size(); i++)
+    {
+        const Register& reg = m_registers[i];
+        switch (reg.kind)
+        {
+            case RegisterKind::Parameter:
+            {
+                CBotVar* param = pj->FindVar(reg.ident, false);
+                regs[i] = param != nullptr ? LoadValue(param) : UndefinedValue(reg.type);
+                break;
+            }
+            case RegisterKind::Variable:
+                if (resume && var != nullptr)
+                {
+                    regs[i] = LoadValue(var);
+                    var = var->GetNext();
+                }
+                else
+                {
+                    regs[i] = UndefinedValue(reg.type);
+                }
+                break;
+            case RegisterKind::Constant:
+                regs[i] = reg.constant;
+                break;
+        }
+    }
+
+    Value* temps = regs + m_registers.size();
+    var = resume ? frame->m_var : nullptr;
+    for (int i = 0; i < m_tempCount; i++)
+    {
+        if (var != nullptr)
+        {
+            temps[i] = LoadValue(var);
+            var = var->GetNext();
+        }
+        else
+        {
+            temps[i] = UndefinedValue(CBotTypInt);
+        }
+    }
+}
+
+void CBotBytecode::Suspend(CBotStack* pj, CBotStack* frame, const Value* regs, int pc)
+{
+    // Local variables are kept in the frame, like the variables of a block,
+    // so they can be shown by the debugger and saved with the stack
+    bool create = frame->m_listVar == nullptr;
+    CBotVar* var = frame->m_listVar;
+    for (std::size_t i = 0; i < m_registers.size(); i++)
+    {
+        const Register& reg = m_registers[i];
+        if (reg.kind == RegisterKind::Parameter)
+        {
+            CBotVar* param = pj->FindVar(reg.ident, false);
+            if (param != nullptr) StoreValue(param, regs[i]);
+        }
+        else if (reg.kind == RegisterKind::Variable)
+        {
+            if (create)
+            {
+                CBotVar* newVar = CreateVar(reg.name, regs[i]);
+                newVar->SetUniqNum(reg.ident);
+                frame->AddVar(newVar);
+            }
+            else if (var != nullptr)
+            {
+                StoreValue(var, regs[i]);
+                var = var->GetNext();
+            }
+        }
+    }
+
+    // Temporary values are the result of the frame
+    CBotVar* temps = nullptr;
+    CBotVar* last = nullptr;
+    for (int i = 0; i < m_tempCount; i++)
+    {
+        CBotVar* temp = CreateVar("", regs[m_registers.size() + i]);
+        if (last == nullptr) temps = temp;
+        else                 last->AddNext(temp);
+        last = temp;
+    }
+    frame->SetVar(temps);
+
+    frame->m_state = pc + 1;
+    frame->m_instr = m_statements[pc];
+}
+
+std::vector<CBotVar*> CBotBytecode::CreateArguments(const Call& call, const Value* regs)
+{
+    std::vector<CBotVar*> args;
+    for (int arg : call.args)
+        args.push_back(CreateVar("", regs[arg]));
+    args.push_back(nullptr);
+    return args;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotBytecode::Execute(CBotStack* &pj)
+{
+    CBotStack* frame = pj->AddStack(nullptr, CBotStack::BlockVisibilityType::BLOCK);
+    if (frame->StackOver()) return pj->Return(frame);
+
+    CBotExecutionContext* context = frame->GetExecutionContext();
+    bool stepMode = context->GetTimerLimit() <= 0;
+
+    // The state of the frame is the position to resume at, plus 1
+    int resumed = frame->GetState() - 1;
+    int pc = std::max(resumed, 0);
+
+    std::size_t registerCount = m_registers.size() + m_tempCount;
+    Value localRegs[32];
+    std::vector<Value> heapRegs;
+    Value* regs = localRegs;
+    if (registerCount > 32)
+    {
+        heapRegs.resize(registerCount);
+        regs = heapRegs.data();
+    }
+    LoadRegisters(pj, frame, regs, resumed >= 0);
+
+    int timer = context->m_timer;
+    long long count = 0;
+    auto flushTimer = [&]()
+    {
+        context->m_timer = timer;
+        context->m_instructionCount += count;
+        count = 0;
+    };
+    auto suspend = [&](int position)
+    {
+        flushTimer();
+        Suspend(pj, frame, regs, position);
+        return false;
+    };
+    auto error = [&](CBotError code, CBotToken* token)
+    {
+        flushTimer();
+        frame->SetError(code, token);
+        return pj->Return(frame);
+    };
+
+    while (true)
+    {
+        const Instruction& ins = m_code[pc];
+        timer--;
+        count++;
+
+        switch (ins.op)
+        {
+            case Opcode::Statement:
+                if (pc != resumed && (stepMode || timer <= -10)) return suspend(pc);
+                break;
+
+            case Opcode::End:
+                flushTimer();
+                frame->SetVar(nullptr);
+                return pj->Return(frame);
+
+            case Opcode::Return:
+                flushTimer();
+                frame->SetVar(ins.a >= 0 ? CreateVar("", regs[ins.a]) : nullptr);
+                frame->SetBreak(3, std::string());
+                return pj->Return(frame);
+
+            case Opcode::Jump:
+            case Opcode::JumpIf:
+            case Opcode::JumpIfNot:
+                if (ins.op == Opcode::Jump || (regs[ins.b].valInt != 0) == (ins.op == Opcode::JumpIf))
+                {
+                    if (ins.a <= pc)
+                    {
+                        // backward jumps can interrupt execution, like loops of the tree interpreter
+                        resumed = -1;
+                        if (timer <= 0) return suspend(ins.a);
+                    }
+                    pc = ins.a;
+                    continue;
+                }
+                break;
+
+            case Opcode::Declare:
+                regs[ins.a] = UndefinedValue(m_registers[ins.a].type);
+                break;
+
+            case Opcode::Assign:
+                Assign(regs[ins.a], regs[ins.b]);
+                break;
+
+            case Opcode::Move:
+                regs[ins.a] = regs[ins.b];
+                break;
+
+            case Opcode::LoadVar:
+                if (regs[ins.b].init == CBotVar::InitType::UNDEF) return error(CBotErrNotInit, ins.token);
+                regs[ins.a] = regs[ins.b];
+                break;
+
+            case Opcode::CheckVar:
+                if (regs[ins.a].init == CBotVar::InitType::IS_NAN) return error(CBotErrNan, ins.token);
+                if (regs[ins.a].init != CBotVar::InitType::DEF) return error(CBotErrNotInit, ins.token);
+                break;
+
+            case Opcode::Equal:
+            case Opcode::NotEqual:
+            {
+                const Value& left = regs[ins.b];
+                const Value& right = regs[ins.c];
+                Value result = UndefinedValue(CBotTypBoolean);
+                if (IsNan(left) || IsNan(right))
+                    SetInt(result, (left.init == right.init) == (ins.op == Opcode::Equal));
+                else
+                    Compute(ins.op, left, right, result);
+                regs[ins.a] = result;
+                break;
+            }
+
+            case Opcode::Add:
+            case Opcode::Sub:
+            case Opcode::Mul:
+            case Opcode::Div:
+            case Opcode::Mod:
+            case Opcode::Power:
+            case Opcode::And:
+            case Opcode::Or:
+            case Opcode::Xor:
+            case Opcode::ShiftLeft:
+            case Opcode::ShiftRight:
+            case Opcode::ShiftRightArith:
+            case Opcode::Less:
+            case Opcode::Greater:
+            case Opcode::LessEqual:
+            case Opcode::GreaterEqual:
+            {
+                const Value& left = regs[ins.b];
+                const Value& right = regs[ins.c];
+                if (IsNan(left) || IsNan(right)) return error(CBotErrNan, ins.token);
+                Value result = UndefinedValue(GetResultType(ins.op, left.type, right.type));
+                CBotError err = Compute(ins.op, left, right, result);
+                if (err != CBotNoErr) return error(err, ins.token);
+                regs[ins.a] = result;
+                break;
+            }
+
+            case Opcode::AddAssign:
+            case Opcode::SubAssign:
+            case Opcode::MulAssign:
+            case Opcode::DivAssign:
+            case Opcode::ModAssign:
+            case Opcode::AndAssign:
+            case Opcode::OrAssign:
+            case Opcode::XorAssign:
+            case Opcode::ShiftLeftAssign:
+            case Opcode::ShiftRightAssign:
+            case Opcode::ShiftRightArithAssign:
+            {
+                // the value of the variable was checked by CheckVar
+                Value result = UndefinedValue(regs[ins.a].type);
+                CBotError err = Compute(ins.op, regs[ins.b], regs[ins.c], result);
+                if (err != CBotNoErr) return error(err, ins.token);
+                regs[ins.a] = result;
+                break;
+            }
+
+            case Opcode::Neg:
+            {
+                Value result = regs[ins.b];
+                if (result.type == CBotTypFloat) result.valFloat = -result.valFloat;
+                else                             result.valInt = -result.valInt;
+                regs[ins.a] = result;
+                break;
+            }
+
+            case Opcode::Not:
+            {
+                Value result = regs[ins.b];
+                if (result.type == CBotTypBoolean) SetInt(result, !result.valInt);
+                else                               result.valInt = ~result.valInt;
+                regs[ins.a] = result;
+                break;
+            }
+
+            case Opcode::Inc:
+            case Opcode::Dec:
+            {
+                Value& var = regs[ins.a];
+                if (var.init == CBotVar::InitType::IS_NAN) return error(CBotErrNan, ins.token);
+                if (var.init != CBotVar::InitType::DEF) return error(CBotErrNotInit, ins.token);
+                int delta = ins.op == Opcode::Inc ? 1 : -1;
+                if (var.type == CBotTypFloat) var.valFloat += delta;
+                else                          var.valInt += delta;
+                break;
+            }
+
+            case Opcode::Call:
+            {
+                const Call& call = m_calls[ins.a];
+                flushTimer();
+
+                CBotStack* callStack = frame->AddStack(call.instr);
+                if (callStack->StackOver()) return pj->Return(frame);
+
+                std::vector<CBotVar*> args = CreateArguments(call, regs);
+                long ident = call.ident;
+                bool finished = callStack->ExecuteCall(ident, call.instr->GetToken(), args.data(), call.type);
+                for (CBotVar* arg : args) delete arg;
+
+                if (!finished)
+                {
+                    if (!frame->IsOk()) return false;
+                    return suspend(pc);   // the call is resumed from its own stack
+                }
+                if (!frame->Return(callStack)) return false;
+
+                if (call.result >= 0)
+                {
+                    CBotVar* result = frame->GetVar();
+                    regs[call.result] = result != nullptr ? LoadValue(result) : UndefinedValue(static_cast<CBotType>(call.type.GetType()));
+                }
+                frame->SetVar(nullptr);
+                timer = context->m_timer;
+                break;
+            }
+        }
+        pc++;
+    }
+}
+
+void CBotBytecode::RestoreState(CBotStack* &pj)
+{
+    CBotStack* frame = pj->RestoreStack(nullptr);
+    if (frame == nullptr) return;
+
+    int pc = frame->GetState() - 1;
+    if (pc < 0 || pc >= GetSize()) return;
+    frame->m_instr = m_statements[pc];
+
+    // identifiers of variables are not saved with the stack
+    CBotVar* var = frame->m_listVar;
+    for (const Register& reg : m_registers)
+    {
+        if (reg.kind != RegisterKind::Variable) continue;
+        if (var == nullptr) break;
+        var->SetUniqNum(reg.ident);
+        var = var->GetNext();
+    }
+
+    if (m_code[pc].op != Opcode::Call) return;
+
+    const Call& call = m_calls[m_code[pc].a];
+    CBotStack* callStack = frame->RestoreStack(call.instr);
+    if (callStack == nullptr) return;
+
+    std::vector<Value> regs(m_registers.size() + m_tempCount);
+    LoadRegisters(pj, frame, regs.data(), true);
+    std::vector<CBotVar*> args = CreateArguments(call, regs.data());
+    long ident = call.ident;
+    callStack->RestoreCall(ident, call.instr->GetToken(), args.data());
+    for (CBotVar* arg : args) delete arg;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotBytecodeCompiler::CBotBytecodeCompiler()
+{
+}
+
+CBotBytecodeCompiler::~CBotBytecodeCompiler()
+{
+}
+
+bool CBotBytecodeCompiler::AddParameter(long ident, const std::string& name, const CBotTypResult& type)
+{
+    if (!IsNumber(static_cast<CBotType>(type.GetType()))) return false;
+    m_parameters.push_back({ ident, name, static_cast<CBotType>(type.GetType()) });
+    return true;
+}
+
+std::unique_ptr<CBotBytecode> CBotBytecodeCompiler::Compile(CBotInstr* block)
+{
+    // Compiled again each time a variable is found to possibly become undefined, see AssignVariable()
+    do
+    {
+        if (!CompileFunction(block)) return nullptr;
+    }
+    while (m_retry);
+
+    if (m_bytecode->GetSize() > MAX_CODE_SIZE) return nullptr;
+
+    // Temporary registers go after all other registers
+    int tempBase = static_cast<int>(m_bytecode->m_registers.size());
+    auto remap = [tempBase](int& reg)
+    {
+        if (reg >= TEMPORARY_BASE) reg = tempBase + reg - TEMPORARY_BASE;
+    };
+    for (CBotBytecode::Instruction& ins : m_bytecode->m_code)
+    {
+        switch (ins.op)
+        {
+            case Opcode::Statement:
+            case Opcode::End:
+            case Opcode::Jump:
+            case Opcode::Call:
+                break;
+            case Opcode::JumpIf:
+            case Opcode::JumpIfNot:
+                remap(ins.b);
+                break;
+            default:
+                remap(ins.a);
+                remap(ins.b);
+                remap(ins.c);
+        }
+    }
+    for (CBotBytecode::Call& call : m_bytecode->m_calls)
+    {
+        for (int& arg : call.args) remap(arg);
+        remap(call.result);
+    }
+
+    return std::move(m_bytecode);
+}
+
+bool CBotBytecodeCompiler::CompileFunction(CBotInstr* block)
+{
+    m_bytecode.reset(new CBotBytecode());
+    m_variables.clear();
+    m_loops.clear();
+    m_statement = block;
+    m_discarded = nullptr;
+    m_tempCount = 0;
+    m_undefinedResults.clear();
+    m_retry = false;
+
+    for (const Parameter& param : m_parameters)
+    {
+        CBotBytecode::Register reg;
+        reg.kind = CBotBytecode::RegisterKind::Parameter;
+        reg.name = param.name;
+        reg.type = param.type;
+        reg.ident = param.ident;
+        reg.defined = m_undefinedVariables.count(param.ident) == 0;
+        reg.constant = UndefinedValue(param.type);
+        m_variables.push_back({ param.ident, static_cast<int>(m_bytecode->m_registers.size()) });
+        m_bytecode->m_registers.push_back(reg);
+    }
+
+    int result = -1;
+    if (!block->CompileBytecode(*this, result)) return false;
+    Emit(Opcode::End);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotBytecodeCompiler::CompileStatement(CBotInstr* instr)
+{
+    // Statements inside of a statement are compiled with the second pass of the outer statement
+    if (m_dryRun) return true;
+
+    CBotInstr* outer = m_statement;
+    m_statement = instr;
+    Emit(Opcode::Statement);
+
+    int tempCount = m_tempCount;
+    int result = -1;
+    m_dryRun = true;
+    m_changes.clear();
+    m_pending.clear();
+    bool ok = CompileOperand(instr, result, true);
+    m_dryRun = false;
+    m_tempCount = tempCount;
+
+    if (ok) ok = CompileOperand(instr, result, true);
+    m_tempCount = tempCount;    // temporary values don't outlive the statement
+
+    m_statement = outer;
+    return ok;
+}
+
+bool CBotBytecodeCompiler::CompileOperand(CBotInstr* instr, int& result, bool discard)
+{
+    m_discarded = discard ? instr : nullptr;
+    result = -1;
+    return instr->CompileBytecode(*this, result);
+}
+
+bool CBotBytecodeCompiler::IsDiscarded(CBotInstr* instr) const
+{
+    return m_discarded == instr;
+}
+
+int CBotBytecodeCompiler::KeepOperand(CBotInstr* owner, int index, int operand)
+{
+    if (IsTemporary(operand)) return operand;
+
+    if (m_dryRun)
+    {
+        m_pending.push_back({ owner, index, operand, m_changes.size() });
+        return operand;
+    }
+
+    if (m_keptOperands.count({ owner, index }) == 0) return operand;
+    int temp = AllocTemp();
+    EmitMove(temp, operand);
+    return temp;
+}
+
+void CBotBytecodeCompiler::EndOperands(CBotInstr* owner)
+{
+    if (!m_dryRun) return;
+
+    for (auto it = m_pending.begin(); it != m_pending.end();)
+    {
+        if (it->owner != owner)
+        {
+            ++it;
+            continue;
+        }
+        if (std::find(m_changes.begin() + it->changes, m_changes.end(), it->operand) != m_changes.end())
+            m_keptOperands.insert({ it->owner, it->index });
+        it = m_pending.erase(it);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int CBotBytecodeCompiler::DeclareVariable(long ident, const std::string& name, const CBotTypResult& type, int value)
+{
+    CBotType varType = static_cast<CBotType>(type.GetType());
+    if (!IsNumber(varType)) return -1;
+
+    // the first pass already declared it
+    int variable = GetVariable(ident);
+    if (variable < 0)
+    {
+        CBotBytecode::Register reg;
+        reg.kind = CBotBytecode::RegisterKind::Variable;
+        reg.name = name;
+        reg.type = varType;
+        reg.ident = ident;
+        reg.defined = value >= 0 && m_undefinedVariables.count(ident) == 0;
+        reg.constant = UndefinedValue(varType);
+        variable = static_cast<int>(m_bytecode->m_registers.size());
+        m_variables.push_back({ ident, variable });
+        m_bytecode->m_registers.push_back(reg);
+    }
+
+    ChangeVariable(variable);
+    Emit(Opcode::Declare, variable);
+    if (value >= 0)
+    {
+        Emit(Opcode::Assign, variable, value);
+        AssignVariable(variable, value);
+    }
+    return variable;
+}
+
+int CBotBytecodeCompiler::GetVariable(long ident) const
+{
+    for (const auto& variable : m_variables)
+    {
+        if (variable.first == ident) return variable.second;
+    }
+    return -1;
+}
+
+int CBotBytecodeCompiler::ReadVariable(int variable, CBotToken* token)
+{
+    if (m_bytecode->m_registers[variable].defined) return variable;
+
+    int temp = AllocTemp();
+    Emit(Opcode::LoadVar, temp, variable, -1, token);
+    return temp;
+}
+
+int CBotBytecodeCompiler::AddConstant(int value, const std::string& defNum)
+{
+    Value constant = UndefinedValue(CBotTypInt);
+    SetInt(constant, value, defNum.empty() ? nullptr : CBotBytecode::InternDefNum(defNum));
+    return AddConstantValue(constant);
+}
+
+int CBotBytecodeCompiler::AddConstant(float value)
+{
+    Value constant = UndefinedValue(CBotTypFloat);
+    SetFloat(constant, value);
+    return AddConstantValue(constant);
+}
+
+int CBotBytecodeCompiler::AddConstant(bool value)
+{
+    Value constant = UndefinedValue(CBotTypBoolean);
+    SetInt(constant, value);
+    return AddConstantValue(constant);
+}
+
+int CBotBytecodeCompiler::AddNanConstant()
+{
+    Value constant = UndefinedValue(CBotTypInt);
+    constant.init = CBotVar::InitType::IS_NAN;
+    return AddConstantValue(constant);
+}
+
+int CBotBytecodeCompiler::AddConstantValue(const Value& value)
+{
+    std::vector<CBotBytecode::Register>& registers = m_bytecode->m_registers;
+    for (std::size_t i = 0; i < registers.size(); i++)
+    {
+        const Value& constant = registers[i].constant;
+        if (registers[i].kind != CBotBytecode::RegisterKind::Constant) continue;
+        if (constant.type != value.type || constant.init != value.init || constant.defNum != value.defNum) continue;
+        if (value.type == CBotTypFloat ? constant.valFloat == value.valFloat : constant.valInt == value.valInt)
+            return static_cast<int>(i);
+    }
+
+    CBotBytecode::Register reg;
+    reg.kind = CBotBytecode::RegisterKind::Constant;
+    reg.type = value.type;
+    reg.ident = 0;
+    reg.defined = true;
+    reg.constant = value;
+    registers.push_back(reg);
+    return static_cast<int>(registers.size() - 1);
+}
+
+int CBotBytecodeCompiler::AllocTemp()
+{
+    int temp = TEMPORARY_BASE + m_tempCount++;
+    m_bytecode->m_tempCount = std::max(m_bytecode->m_tempCount, m_tempCount);
+    m_undefinedResults.erase(temp);
+    return temp;
+}
+
+bool CBotBytecodeCompiler::IsTemporary(int reg) const
+{
+    return reg >= TEMPORARY_BASE;
+}
+
+void CBotBytecodeCompiler::ChangeVariable(int variable)
+{
+    if (m_dryRun) m_changes.push_back(variable);
+}
+
+void CBotBytecodeCompiler::AssignVariable(int variable, int value)
+{
+    if (m_dryRun || m_undefinedResults.count(value) == 0) return;
+
+    // The value can come from an external function which didn't set its result,
+    // reading the variable would then be an error
+    CBotBytecode::Register& reg = m_bytecode->m_registers[variable];
+    if (m_undefinedVariables.insert(reg.ident).second && reg.defined) m_retry = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int CBotBytecodeCompiler::Emit(Opcode op, int a, int b, int c, CBotToken* token)
+{
+    if (m_dryRun) return -1;
+
+    m_bytecode->m_code.push_back({ op, a, b, c, token });
+    m_bytecode->m_statements.push_back(m_statement);
+    return static_cast<int>(m_bytecode->m_code.size() - 1);
+}
+
+int CBotBytecodeCompiler::EmitBinary(int tokenType, int left, int right, CBotToken* token, int result)
+{
+    Opcode op;
+    switch (tokenType)
+    {
+        case ID_ADD:     op = Opcode::Add;             break;
+        case ID_SUB:     op = Opcode::Sub;             break;
+        case ID_MUL:     op = Opcode::Mul;             break;
+        case ID_DIV:     op = Opcode::Div;             break;
+        case ID_MODULO:  op = Opcode::Mod;             break;
+        case ID_POWER:   op = Opcode::Power;           break;
+        case ID_AND:
+        case ID_LOG_AND:
+        case ID_TXT_AND: op = Opcode::And;             break;
+        case ID_OR:
+        case ID_LOG_OR:
+        case ID_TXT_OR:  op = Opcode::Or;              break;
+        case ID_XOR:     op = Opcode::Xor;             break;
+        case ID_SL:      op = Opcode::ShiftLeft;       break;
+        case ID_SR:      op = Opcode::ShiftRight;      break;
+        case ID_ASR:     op = Opcode::ShiftRightArith; break;
+        case ID_LO:      op = Opcode::Less;            break;
+        case ID_HI:      op = Opcode::Greater;         break;
+        case ID_LS:      op = Opcode::LessEqual;       break;
+        case ID_HS:      op = Opcode::GreaterEqual;    break;
+        case ID_EQ:      op = Opcode::Equal;           break;
+        case ID_NE:      op = Opcode::NotEqual;        break;
+        default:
+            return -1;
+    }
+
+    if (result < 0) result = AllocTemp();
+    Emit(op, result, left, right, token);
+    return result;
+}
+
+int CBotBytecodeCompiler::EmitUnary(int tokenType, int operand, CBotToken* token)
+{
+    Opcode op;
+    switch (tokenType)
+    {
+        case ID_ADD:
+            return operand;
+        case ID_SUB:
+            op = Opcode::Neg;
+            break;
+        case ID_NOT:
+        case ID_LOG_NOT:
+        case ID_TXT_NOT:
+            op = Opcode::Not;
+            break;
+        default:
+            return -1;
+    }
+
+    int result = AllocTemp();
+    Emit(op, result, operand, -1, token);
+    return result;
+}
+
+int CBotBytecodeCompiler::EmitAssign(int tokenType, int variable, int left, int value, CBotToken* token, CBotToken* varToken, bool discard)
+{
+    Opcode op;
+    switch (tokenType)
+    {
+        case ID_ASS:       op = Opcode::Assign;                break;
+        case ID_ASSADD:    op = Opcode::AddAssign;             break;
+        case ID_ASSSUB:    op = Opcode::SubAssign;             break;
+        case ID_ASSMUL:    op = Opcode::MulAssign;             break;
+        case ID_ASSDIV:    op = Opcode::DivAssign;             break;
+        case ID_ASSMODULO: op = Opcode::ModAssign;             break;
+        case ID_ASSAND:    op = Opcode::AndAssign;             break;
+        case ID_ASSOR:     op = Opcode::OrAssign;              break;
+        case ID_ASSXOR:    op = Opcode::XorAssign;             break;
+        case ID_ASSSL:     op = Opcode::ShiftLeftAssign;       break;
+        case ID_ASSSR:     op = Opcode::ShiftRightAssign;      break;
+        case ID_ASSASR:    op = Opcode::ShiftRightArithAssign; break;
+        default:
+            return -1;
+    }
+
+    ChangeVariable(variable);
+    if (op == Opcode::Assign)
+    {
+        Emit(op, variable, value);
+        AssignVariable(variable, value);
+    }
+    else
+    {
+        // like CBotExpression::Execute(), the variable is checked after the value is computed
+        Emit(Opcode::CheckVar, left, -1, -1, varToken);
+        Emit(op, variable, left, value, token);
+    }
+
+    if (discard) return variable;
+    int result = AllocTemp();
+    Emit(Opcode::Move, result, variable);
+    return result;
+}
+
+int CBotBytecodeCompiler::EmitIncrement(int tokenType, int variable, bool post, CBotToken* token, bool discard)
+{
+    ChangeVariable(variable);
+
+    int result = variable;
+    if (post && !discard)
+    {
+        result = AllocTemp();
+        Emit(Opcode::Move, result, variable);
+    }
+    Emit(tokenType == ID_INC ? Opcode::Inc : Opcode::Dec, variable, -1, -1, token);
+    if (!post && !discard)
+    {
+        result = AllocTemp();
+        Emit(Opcode::Move, result, variable);
+    }
+    return result;
+}
+
+void CBotBytecodeCompiler::EmitMove(int result, int value)
+{
+    if (result == value) return;
+    Emit(Opcode::Move, result, value);
+    if (!m_dryRun && m_undefinedResults.count(value) != 0) m_undefinedResults.insert(result);
+}
+
+bool CBotBytecodeCompiler::EmitCall(CBotInstr* instr, long ident, const CBotTypResult& type, const std::vector<int>& args, int& result)
+{
+    CBotType resultType = static_cast<CBotType>(type.GetType());
+    if (resultType != CBotTypVoid && !IsNumber(resultType)) return false;
+
+    result = resultType != CBotTypVoid ? AllocTemp() : -1;
+    if (m_dryRun) return true;
+
+    m_bytecode->m_calls.push_back({ instr, ident, type, args, result });
+    Emit(Opcode::Call, static_cast<int>(m_bytecode->m_calls.size() - 1));
+    if (result >= 0) m_undefinedResults.insert(result);
+    return true;
+}
+
+void CBotBytecodeCompiler::EmitReturn(int value)
+{
+    Emit(Opcode::Return, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int CBotBytecodeCompiler::GetPosition() const
+{
+    return m_bytecode->GetSize();
+}
+
+int CBotBytecodeCompiler::EmitJump(int condition, bool jumpIf)
+{
+    if (condition < 0) return Emit(Opcode::Jump, -1);
+    return Emit(jumpIf ? Opcode::JumpIf : Opcode::JumpIfNot, -1, condition);
+}
+
+void CBotBytecodeCompiler::SetJumpTarget(int jump)
+{
+    if (jump >= 0) m_bytecode->m_code[jump].a = GetPosition();
+}
+
+void CBotBytecodeCompiler::EmitJumpTo(int target, int condition, bool jumpIf)
+{
+    if (condition < 0) Emit(Opcode::Jump, target);
+    else               Emit(jumpIf ? Opcode::JumpIf : Opcode::JumpIfNot, target, condition);
+}
+
+void CBotBytecodeCompiler::BeginLoop(const std::string& label)
+{
+    if (m_dryRun) return;
+    m_loops.push_back({ label, {}, {} });
+}
+
+bool CBotBytecodeCompiler::EmitBreak(const std::string& label, bool isContinue)
+{
+    if (m_dryRun) return true;
+
+    // like CBotStack::BreakReturn(), a break without label ends the innermost loop
+    for (auto it = m_loops.rbegin(); it != m_loops.rend(); ++it)
+    {
+        if (!label.empty() && it->label != label) continue;
+        int jump = EmitJump();
+        if (isContinue) it->continues.push_back(jump);
+        else            it->breaks.push_back(jump);
+        return true;
+    }
+    return false;
+}
+
+void CBotBytecodeCompiler::EndLoop(int continueTarget)
+{
+    if (m_dryRun) return;
+
+    Loop& loop = m_loops.back();
+    for (int jump : loop.continues) m_bytecode->m_code[jump].a = continueTarget;
+    for (int jump : loop.breaks) SetJumpTarget(jump);
+    m_loops.pop_back();
+}
+
+} // namespace CBot
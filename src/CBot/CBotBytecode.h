@@ -0,0 +1,363 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include "CBot/CBotTypResult.h"
+
+#include "CBot/CBotVar/CBotVar.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace CBot
+{
+
+class CBotInstr;
+class CBotStack;
+class CBotToken;
+
+/**
+ * \brief Body of a CBot function lowered into bytecode for a register VM
+ *
+ * The tree interpreter (CBotInstr::Execute()) adds a CBotStack level and creates a CBotVar
+ * for every sub-expression it evaluates. Functions which only work on int, float and bool values
+ * are also lowered by CBotBytecodeCompiler into a flat list of instructions working on an array
+ * of registers, which is much cheaper to run.
+ *
+ * The VM runs on a single stack level (the frame) added on the stack of the function, and behaves
+ * like the tree interpreter towards the rest of CBot:
+ * - every instruction takes one timer tick; execution is suspended on backward jumps and when
+ *   entering the function if the timer ran out, and on every statement in step by step mode
+ * - calls go through CBotStack::ExecuteCall(), so external functions can suspend the program as before
+ * - when suspended, the registers are written to the frame: local variables to its variable list
+ *   (where the debugger finds them), temporary values to its result, and the position in the code
+ *   to its state, so CBotStack::SaveState() and CBotStack::RestoreState() work unchanged
+ *
+ * Which one is used is decided when the function is entered (see CBotProgram::EnableBytecode())
+ * and kept in the state of its stack, so a function started by one is always finished by it.
+ */
+class CBotBytecode
+{
+public:
+    ~CBotBytecode();
+
+    /**
+     * \brief Executes the function body, like CBotInstr::Execute() of the block would do
+     * \param pj Stack of the function, with the parameters already defined
+     * \return false if interrupted (see CBotInstr::Execute())
+     */
+    bool Execute(CBotStack* &pj);
+
+    /**
+     * \brief Restores the execution state of the function body after CBotStack::RestoreState()
+     * \param pj Stack of the function
+     */
+    void RestoreState(CBotStack* &pj);
+
+    //! Returns the number of instructions
+    int GetSize() const { return static_cast<int>(m_code.size()); }
+
+    //! Opcodes of the VM, see CBotBytecode.cpp for their operands
+    enum class Opcode : unsigned char
+    {
+        Statement,
+        End,
+        Return,
+        Jump,
+        JumpIf,
+        JumpIfNot,
+        Declare,
+        Assign,
+        Move,
+        LoadVar,
+        CheckVar,
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Mod,
+        Power,
+        And,
+        Or,
+        Xor,
+        ShiftLeft,
+        ShiftRight,
+        ShiftRightArith,
+        Less,
+        Greater,
+        LessEqual,
+        GreaterEqual,
+        Equal,
+        NotEqual,
+        AddAssign,
+        SubAssign,
+        MulAssign,
+        DivAssign,
+        ModAssign,
+        AndAssign,
+        OrAssign,
+        XorAssign,
+        ShiftLeftAssign,
+        ShiftRightAssign,
+        ShiftRightArithAssign,
+        Neg,
+        Not,
+        Inc,
+        Dec,
+        Call,
+    };
+
+    //! Content of a register, mirrors CBotVarInt, CBotVarFloat and CBotVarBoolean
+    struct Value
+    {
+        CBotType type;
+        CBotVar::InitType init;
+        union
+        {
+            int valInt;     //!< int and bool values
+            float valFloat;
+        };
+        //! Name of the value given by DefineNum(), nullptr if none (see InternDefNum())
+        const std::string* defNum;
+    };
+
+    struct Instruction
+    {
+        Opcode op;
+        int a;
+        int b;
+        int c;
+        //! Token to report errors at
+        CBotToken* token;
+    };
+
+    enum class RegisterKind
+    {
+        Parameter,
+        Variable,
+        Constant,
+    };
+
+    //! A register which is not a temporary value
+    struct Register
+    {
+        RegisterKind kind;
+        std::string name;
+        CBotType type;
+        long ident;
+        //! Parameters and variables declared with a value are always defined when read
+        bool defined;
+        Value constant;
+    };
+
+    struct Call
+    {
+        //! CBotInstrCall this call was lowered from
+        CBotInstr* instr;
+        long ident;
+        CBotTypResult type;
+        std::vector<int> args;
+        //! Register for the result, -1 if not used
+        int result;
+    };
+
+    //! Returns a pointer to a string equal to name which stays valid forever
+    static const std::string* InternDefNum(const std::string& name);
+
+private:
+    friend class CBotBytecodeCompiler;
+    CBotBytecode();
+
+    //! Reads a value from a variable, see CBotVarInt::m_defnum
+    static Value LoadValue(CBotVar* var);
+    //! Reads the registers, from the frame if execution is resumed
+    void LoadRegisters(CBotStack* pj, CBotStack* frame, Value* regs, bool resume);
+    //! Writes the registers to the stack before execution is interrupted at the given position
+    void Suspend(CBotStack* pj, CBotStack* frame, const Value* regs, int pc);
+    //! Returns the list of arguments of a call, terminated by nullptr
+    std::vector<CBotVar*> CreateArguments(const Call& call, const Value* regs);
+
+private:
+    std::vector<Instruction> m_code;
+    //! Statement each instruction is part of, for CBotStack::GetRunPos()
+    std::vector<CBotInstr*> m_statements;
+    //! Registers are parameters, local variables and constants, followed by the temporary values
+    std::vector<Register> m_registers;
+    int m_tempCount = 0;
+    std::vector<Call> m_calls;
+};
+
+/**
+ * \brief Lowers the instructions of a function into CBotBytecode
+ *
+ * Each instruction class that can be lowered overrides CBotInstr::CompileBytecode(), using the
+ * interface below. If any instruction can't be lowered, the function is only run by the tree interpreter.
+ *
+ * Expressions give the register holding their value. Reading a variable gives the register of the
+ * variable itself, unless its value has to be checked first, so an operation whose later operands can
+ * change the variable has to copy it first (see KeepOperand()). To know that, each statement is compiled
+ * twice, the first time without generating any code.
+ */
+class CBotBytecodeCompiler
+{
+public:
+    CBotBytecodeCompiler();
+    ~CBotBytecodeCompiler();
+
+    //! Adds a parameter of the function, false if its type is not supported
+    bool AddParameter(long ident, const std::string& name, const CBotTypResult& type);
+    //! Lowers the body of the function, nullptr if it can't be lowered
+    std::unique_ptr<CBotBytecode> Compile(CBotInstr* block);
+
+    /**
+     * \name Interface for CBotInstr::CompileBytecode()
+     */
+    //@{
+    //! Compiles an instruction used as a statement (element of a block, body of a loop, ...)
+    bool CompileStatement(CBotInstr* instr);
+    //! Compiles an expression which is part of the current statement
+    /** \param discard true if the value of the expression is not used */
+    bool CompileOperand(CBotInstr* instr, int& result, bool discard = false);
+    //! Returns true if the value of the instruction being compiled is not used
+    bool IsDiscarded(CBotInstr* instr) const;
+    //! Returns the register to use for an operand which has to keep its value while the following operands are evaluated
+    /**
+     * \param owner Instruction the operand belongs to
+     * \param index Index of the operand in the owner
+     * \param operand Register with the value of the operand
+     * \see EndOperands()
+     */
+    int KeepOperand(CBotInstr* owner, int index, int operand);
+    //! Must be called by owner once all its operands are compiled, see KeepOperand()
+    void EndOperands(CBotInstr* owner);
+
+    //! Declares a local variable with an optional initial value, returns its register or -1 if its type is not supported
+    int DeclareVariable(long ident, const std::string& name, const CBotTypResult& type, int value);
+    //! Returns the register of a local variable or parameter, -1 if there is none
+    int GetVariable(long ident) const;
+    //! Returns a register with the value of a variable, checking that it is defined
+    int ReadVariable(int variable, CBotToken* token);
+
+    int AddConstant(int value, const std::string& defNum);
+    int AddConstant(float value);
+    int AddConstant(bool value);
+    int AddNanConstant();
+    int AllocTemp();
+
+    //! Binary operator of CBotTwoOpExpr, returns the register of the result or -1 if not supported
+    int EmitBinary(int tokenType, int left, int right, CBotToken* token, int result = -1);
+    //! Unary operator of CBotExprUnaire, returns the register of the result or -1 if not supported
+    int EmitUnary(int tokenType, int operand, CBotToken* token);
+    //! Assignment operator of CBotExpression, returns the register of the result or -1 if not supported
+    /**
+     * \param left Value of the variable before the right operand was evaluated, for compound assignments
+     * \param token Token of the operator
+     * \param varToken Token of the variable
+     */
+    int EmitAssign(int tokenType, int variable, int left, int value, CBotToken* token, CBotToken* varToken, bool discard);
+    //! Increment or decrement of CBotPreIncExpr and CBotPostIncExpr, returns the register of the result
+    int EmitIncrement(int tokenType, int variable, bool post, CBotToken* token, bool discard);
+    //! Copies a value to the given register
+    void EmitMove(int result, int value);
+    //! Function call, result is -1 for void functions
+    bool EmitCall(CBotInstr* instr, long ident, const CBotTypResult& type, const std::vector<int>& args, int& result);
+    //! Return from the function, value is -1 for void functions
+    void EmitReturn(int value);
+
+    //! Returns the position of the next instruction
+    int GetPosition() const;
+    //! Adds a forward jump, which is then given its target with SetJumpTarget()
+    /** \param condition register of the condition, -1 for an unconditional jump */
+    int EmitJump(int condition = -1, bool jumpIf = false);
+    //! Makes a jump added by EmitJump() go to the current position
+    void SetJumpTarget(int jump);
+    //! Adds a jump to an already known position
+    void EmitJumpTo(int target, int condition = -1, bool jumpIf = false);
+
+    void BeginLoop(const std::string& label);
+    //! break or continue, false if there is no such loop
+    bool EmitBreak(const std::string& label, bool isContinue);
+    //! Ends the innermost loop, break goes to the current position
+    void EndLoop(int continueTarget);
+    //@}
+
+private:
+    struct Parameter
+    {
+        long ident;
+        std::string name;
+        CBotType type;
+    };
+
+    struct Loop
+    {
+        std::string label;
+        std::vector<int> breaks;
+        std::vector<int> continues;
+    };
+
+    //! Operand given to KeepOperand() during the first pass
+    struct PendingOperand
+    {
+        CBotInstr* owner;
+        int index;
+        int operand;
+        //! Number of variable changes before the following operands
+        std::size_t changes;
+    };
+
+    bool CompileFunction(CBotInstr* block);
+    int Emit(CBotBytecode::Opcode op, int a = -1, int b = -1, int c = -1, CBotToken* token = nullptr);
+    int AddConstantValue(const CBotBytecode::Value& value);
+    bool IsTemporary(int reg) const;
+    void ChangeVariable(int variable);
+    void AssignVariable(int variable, int value);
+
+private:
+    std::unique_ptr<CBotBytecode> m_bytecode;
+    std::vector<Parameter> m_parameters;
+    //! Register of each variable by its identifier
+    std::vector<std::pair<long, int>> m_variables;
+    std::vector<Loop> m_loops;
+    //! Statement being compiled
+    CBotInstr* m_statement = nullptr;
+    //! Instruction whose value is not used, see IsDiscarded()
+    CBotInstr* m_discarded = nullptr;
+    int m_tempCount = 0;
+
+    //! First pass over a statement, see CBotBytecodeCompiler
+    bool m_dryRun = false;
+    //! Variables changed so far in the first pass
+    std::vector<int> m_changes;
+    std::vector<PendingOperand> m_pending;
+    //! Operands which have to be copied, found by the first pass
+    std::set<std::pair<CBotInstr*, int>> m_keptOperands;
+
+    //! Temporary registers with the result of a call, which can be undefined
+    std::set<int> m_undefinedResults;
+    //! Variables which can become undefined when assigned, they are always checked when read
+    std::set<long> m_undefinedVariables;
+    //! A variable was found to be in m_undefinedVariables, so the function has to be compiled again
+    bool m_retry = false;
+};
+
+} // namespace CBot
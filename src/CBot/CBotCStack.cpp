@@ -168,10 +168,18 @@ void CBotCStack::SetType(CBotTypResult& type)
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar* CBotCStack::FindVar(CBotToken* &pToken)
+{
+    int blockLevel;
+    return FindVar(pToken, blockLevel);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotVar* CBotCStack::FindVar(CBotToken* &pToken, int& blockLevel)
 {
     CBotCStack*    p = this;
-    std::string    name = pToken->GetString();
+    const std::string& name = pToken->GetString();
 
+    blockLevel = 0;
     while (p != nullptr)
     {
         CBotVar*    pp = p->m_listVar;
@@ -183,8 +191,10 @@ CBotVar* CBotCStack::FindVar(CBotToken* &pToken)
             }
             pp = pp->m_next;
         }
+        if ( p->m_bBlock ) blockLevel++;
         p = p->m_prev;
     }
+    blockLevel = -1;
     return nullptr;
 }
 
@@ -379,6 +389,7 @@ bool CBotCStack::CheckCall(CBotToken* &pToken, CBotDefParam* pParam)
         }
     }
 
+    std::lock_guard<std::mutex> lock(CBotFunction::m_publicFunctionsMutex);
     for (CBotFunction* pp : CBotFunction::m_publicFunctions)
     {
         if ( pToken->GetString() == pp->GetName() )
@@ -109,6 +109,15 @@ public:
      */
     CBotVar* FindVar(CBotToken* &p);
 
+    /*!
+     * \brief FindVar Finds a variable and the block it was declared in.
+     * \param p
+     * \param[out] blockLevel Number of blocks between this stack and the block
+     * declaring the variable, for CBotStack::FindVar(long, int, bool)
+     * \return
+     */
+    CBotVar* FindVar(CBotToken* &p, int& blockLevel);
+
     /*!
      * \brief FindVar
      * \param Token
@@ -22,7 +22,11 @@
 #include "CBot/CBotInstr/CBotInstrUtils.h"
 #include "CBot/CBotInstr/CBotNew.h"
 #include "CBot/CBotInstr/CBotLeftExprVar.h"
+#include "CBot/CBotInstr/CBotExprLitBool.h"
+#include "CBot/CBotInstr/CBotExprLitNan.h"
 #include "CBot/CBotInstr/CBotExprLitNull.h"
+#include "CBot/CBotInstr/CBotExprLitNum.h"
+#include "CBot/CBotInstr/CBotExprLitString.h"
 #include "CBot/CBotInstr/CBotTwoOpExpr.h"
 #include "CBot/CBotInstr/CBotFunction.h"
 #include "CBot/CBotInstr/CBotExpression.h"
@@ -45,6 +49,7 @@ namespace CBot
 
 ////////////////////////////////////////////////////////////////////////////////
 std::set<CBotClass*> CBotClass::m_publicClasses{};
+std::recursive_mutex CBotClass::m_publicClassesMutex{};
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotClass::CBotClass(const std::string& name,
@@ -60,12 +65,14 @@ CBotClass::CBotClass(const std::string& name,
     m_bIntrinsic= bIntrinsic;
     m_nbVar     = m_parent == nullptr ? 0 : m_parent->m_nbVar;
 
+    std::lock_guard<std::recursive_mutex> lock(m_publicClassesMutex);
     m_publicClasses.insert(this);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotClass::~CBotClass()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_publicClassesMutex);
     m_publicClasses.erase(this);
 
     delete  m_pVar;
@@ -83,6 +90,7 @@ CBotClass* CBotClass::Create(const std::string& name,
 ////////////////////////////////////////////////////////////////////////////////
 void CBotClass::ClearPublic()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_publicClassesMutex);
     while ( !m_publicClasses.empty() )
     {
         auto it = m_publicClasses.begin();
@@ -106,6 +114,8 @@ void CBotClass::Purge()
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotClass::Lock(CBotProgram* prog)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_publicClassesMutex);
+
     if (m_lockProg.size() == 0)
     {
         m_lockCurrentCount = 1;
@@ -131,6 +141,8 @@ bool CBotClass::Lock(CBotProgram* prog)
 ////////////////////////////////////////////////////////////////////////////////
 void CBotClass::Unlock()
 {
+    std::lock_guard<std::recursive_mutex> lock(m_publicClassesMutex);
+
     if (--m_lockCurrentCount > 0) return; // if called Lock() multiple times, wait for all to unlock
 
     m_lockProg.pop_front();
@@ -139,6 +151,8 @@ void CBotClass::Unlock()
 ////////////////////////////////////////////////////////////////////////////////
 void CBotClass::FreeLock(CBotProgram* prog)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_publicClassesMutex);
+
     for (CBotClass* pClass : m_publicClasses)
     {
         if (pClass->m_lockProg.size() > 0 && prog == pClass->m_lockProg[0])
@@ -268,6 +282,56 @@ bool CBotClass::IsIntrinsic()
     return  m_bIntrinsic;
 }
 
+namespace
+{
+bool IsConstant(CBotInstr* p)
+{
+    for (; p != nullptr; p = p->GetNext3())    // array sizes are chained by next3
+    {
+        if (dynamic_cast<CBotExprLitNum*>(p) == nullptr &&
+            dynamic_cast<CBotExprLitString*>(p) == nullptr &&
+            dynamic_cast<CBotExprLitBool*>(p) == nullptr &&
+            dynamic_cast<CBotExprLitNull*>(p) == nullptr &&
+            dynamic_cast<CBotExprLitNan*>(p) == nullptr &&
+            dynamic_cast<CBotEmpty*>(p) == nullptr) return false;
+    }
+    return true;
+}
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotClass::IsInstanceThreadSafe()
+{
+    if (m_parent != nullptr && !m_parent->IsInstanceThreadSafe()) return false;
+
+    // classes of the application run only their C++ code
+    if (m_pOpenblk == nullptr) return true;
+
+    std::string destructor = "~" + m_name;
+    for (CBotFunction* f : m_pMethod)
+    {
+        if (f->GetName() == destructor) return false;
+    }
+
+    for (CBotVar* pv = m_pVar; pv != nullptr; pv = pv->GetNext())
+    {
+        if (!IsConstant(pv->m_InitExpr) || !IsConstant(pv->m_LimExpr)) return false;
+
+        // fields holding an instance create it with the class
+        CBotTypResult type = pv->GetTypResult(CBotVar::GetTypeMode::CLASS_AS_INTRINSIC);
+        if ((type.Eq(CBotTypIntrinsic) || type.Eq(CBotTypClass)) &&
+            type.GetClass() != nullptr && !type.GetClass()->IsInstanceThreadSafe()) return false;
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotClass::AreInstancesThreadSafe()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_publicClassesMutex);
+    return std::all_of(m_publicClasses.begin(), m_publicClasses.end(), [](CBotClass* c) { return c->IsInstanceThreadSafe(); });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 CBotClass* CBotClass::Find(CBotToken* &pToken)
 {
@@ -277,6 +341,8 @@ CBotClass* CBotClass::Find(CBotToken* &pToken)
 ////////////////////////////////////////////////////////////////////////////////
 CBotClass* CBotClass::Find(const std::string& name)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_publicClassesMutex);
+
     for (CBotClass* p : m_publicClasses)
     {
         if ( p->GetName() == name ) return p;
@@ -369,6 +435,7 @@ bool CBotClass::SaveStaticState(FILE* pf)
     if (!WriteWord( pf, CBOTVERSION*2)) return false;
 
     // saves the state of static variables in classes
+    std::lock_guard<std::recursive_mutex> lock(m_publicClassesMutex);
     for (CBotClass* p : m_publicClasses)
     {
         if (!WriteWord( pf, 1 )) return false;
@@ -27,6 +27,7 @@
 #include <deque>
 #include <set>
 #include <list>
+#include <mutex>
 
 namespace CBot
 {
@@ -320,6 +321,21 @@ public:
      */
     bool IsIntrinsic();
 
+    /*!
+     * \brief Check if creating and destroying instances of this class runs nothing but constants
+     *
+     * Field initializers and destructors run on independent stacks, which can't be interrupted to defer
+     * external access (see CBotExecutionContext::SetDeferExternalAccess()).
+     *
+     * \return true if the class and its parents have no destructor and initialize their fields only with constants
+     */
+    bool IsInstanceThreadSafe();
+
+    /*!
+     * \brief Check IsInstanceThreadSafe() for all classes
+     */
+    static bool AreInstancesThreadSafe();
+
     /*!
      * \brief Purge
      */
@@ -377,6 +393,8 @@ public:
 private:
     //! List of all public classes
     static std::set<CBotClass*> m_publicClasses;
+    //! Guards m_publicClasses and the locks of all classes, which are shared by all running programs
+    static std::recursive_mutex m_publicClassesMutex;
 
 
     //! true if this class is fully compiled, false if only precompiled
@@ -397,7 +415,8 @@ private:
     std::list<CBotFunction*> m_pMethod{};
     void (*m_rUpdate)(CBotVar* thisVar, void* user);
 
-    CBotToken* m_pOpenblk;
+    //! Opening brace of the class definition, nullptr if the class is not defined by a program
+    CBotToken* m_pOpenblk = nullptr;
 
     //! How many times the program currently holding the lock called Lock()
     int m_lockCurrentCount = 0;
@@ -22,6 +22,7 @@
 #include "CBot/CBotInstr/CBotInstrUtils.h"
 #include "CBot/CBotInstr/CBotParExpr.h"
 
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotUtils.h"
 #include "CBot/CBotCStack.h"
 
@@ -248,6 +249,16 @@ void CBotDefParam::RestoreState(CBotStack* &pj, bool bMain)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotDefParam::CompileBytecode(CBotBytecodeCompiler& compiler)
+{
+    for (CBotDefParam* p = this; p != nullptr; p = p->m_next)
+    {
+        if (!compiler.AddParameter(p->m_nIdent, p->m_token.GetString(), p->m_type)) return false;
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int CBotDefParam::GetType()
 {
@@ -26,6 +26,7 @@
 namespace CBot
 {
 
+class CBotBytecodeCompiler;
 class CBotCStack;
 class CBotStack;
 class CBotVar;
@@ -76,6 +77,12 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain);
 
+    /*!
+     * \brief Adds the parameters to a bytecode compiler, see CBotFunction::CompileBytecode()
+     * \return false if any of them has a type the bytecode doesn't support
+     */
+    bool CompileBytecode(CBotBytecodeCompiler& compiler);
+
     /*!
      * \brief GetType
      * \return
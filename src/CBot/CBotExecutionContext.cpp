@@ -0,0 +1,107 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotExecutionContext.h"
+
+#include "CBot/CBotStack.h"
+
+#include "CBot/CBotVar/CBotVar.h"
+
+#include <mutex>
+
+namespace CBot
+{
+
+namespace
+{
+thread_local CBotExecutionContext* g_currentContext = nullptr;
+
+std::recursive_mutex g_externalAccessMutex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotExecutionContext::CBotExecutionContext()
+{
+}
+
+CBotExecutionContext::~CBotExecutionContext()
+{
+    delete m_retvar;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CBotExecutionContext::SetTimerLimit(int n)
+{
+    m_timerLimit = n;
+}
+
+int CBotExecutionContext::GetTimerLimit() const
+{
+    return m_timerLimit >= 0 ? m_timerLimit : CBotStack::GetTimer();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CBotExecutionContext::Reset()
+{
+    if (!m_externalAccessDeferred) m_timer = GetTimerLimit();
+    m_externalAccessDeferred = false;
+    m_error = CBotNoErr;
+    m_labelBreak.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void CBotExecutionContext::SetDeferExternalAccess(bool defer)
+{
+    m_deferExternalAccess = defer;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotExecutionContext* CBotExecutionContext::GetCurrent()
+{
+    if (g_currentContext != nullptr) return g_currentContext;
+
+    static thread_local CBotExecutionContext defaultContext;
+    return &defaultContext;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotExecutionContext::Scope::Scope(CBotExecutionContext* context)
+    : m_previous(g_currentContext)
+{
+    g_currentContext = context;
+}
+
+CBotExecutionContext::Scope::~Scope()
+{
+    g_currentContext = m_previous;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotExecutionContext::ExternalAccessLock::ExternalAccessLock(CBotExecutionContext* context)
+    : m_locked(context->m_deferExternalAccess)
+{
+    if (m_locked) g_externalAccessMutex.lock();
+}
+
+CBotExecutionContext::ExternalAccessLock::~ExternalAccessLock()
+{
+    if (m_locked) g_externalAccessMutex.unlock();
+}
+
+} // namespace CBot
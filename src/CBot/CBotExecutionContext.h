@@ -0,0 +1,169 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include "CBot/CBotEnums.h"
+
+#include <string>
+
+namespace CBot
+{
+
+class CBotVar;
+
+/**
+ * \brief State of a single program execution
+ *
+ * Holds everything that is shared by all levels of one execution stack: the error and its position,
+ * the instruction timer, the pending break label, the value of a "return" on its way up the stack
+ * and the user pointer for external calls. Every CBotProgram owns a context (or borrows one, see
+ * CBotProgram::SetExecutionContext()), so programs using different contexts can be run at the same
+ * time on different threads.
+ *
+ * Stacks created while a program is running (e.g. to call a destructor or to evaluate a class field
+ * initializer) use the context of the current thread, see GetCurrent() and CBotExecutionContext::Scope.
+ *
+ * Programs can only be run in parallel as long as they don't touch anything outside of CBot, see
+ * SetDeferExternalAccess().
+ *
+ * Compilation is not covered by this - CBotProgram::Compile() must still be called from one thread at a time.
+ */
+class CBotExecutionContext
+{
+public:
+    CBotExecutionContext();
+    ~CBotExecutionContext();
+
+    CBotExecutionContext(const CBotExecutionContext&) = delete;
+    CBotExecutionContext& operator=(const CBotExecutionContext&) = delete;
+
+    /**
+     * \brief Get the last error
+     * \param[out] start Starting position in code of the error
+     * \param[out] end Ending position in code of the error
+     * \return Error number
+     */
+    CBotError GetError(int& start, int& end) const { start = m_start; end = m_end; return m_error; }
+
+    /**
+     * \brief Set the number of "timer ticks" executed by each CBotProgram::Run() call
+     * \param n Number of ticks, -1 to follow the global setting from CBotStack::SetTimer()
+     */
+    void SetTimerLimit(int n);
+    /**
+     * \brief Get the number of "timer ticks" executed by each CBotProgram::Run() call
+     * \return SetTimerLimit() value, or CBotStack::GetTimer() if it was not set
+     */
+    int GetTimerLimit() const;
+
+    /**
+     * \brief Reset for execution resume - resets the error, the break label and the timer
+     *
+     * The timer is kept if the last execution was interrupted by deferred external access.
+     */
+    void Reset();
+
+    /**
+     * \brief Defer code outside of CBot instead of running it
+     *
+     * While set, a program about to run code outside of CBot (external calls which are not thread-safe,
+     * see CBotExternalCall::IsThreadSafe(), class update functions, class locks and static class members)
+     * is interrupted just before it and IsExternalAccessDeferred() becomes true. The next Run() without
+     * this flag continues from there, with the timer ticks which were left.
+     *
+     * This allows to run the CBot-only part of programs on worker threads and everything else in a
+     * deterministic order on the main thread. Destructors and field initializers can't be interrupted,
+     * so while a class runs more than constants in them (see CBotClass::AreInstancesThreadSafe()),
+     * programs are deferred before their first instruction.
+     *
+     * \param defer true to defer external access
+     */
+    void SetDeferExternalAccess(bool defer);
+    //! Returns the value set by SetDeferExternalAccess()
+    bool GetDeferExternalAccess() const { return m_deferExternalAccess; }
+    //! Returns true if the last execution was interrupted because of SetDeferExternalAccess()
+    bool IsExternalAccessDeferred() const { return m_externalAccessDeferred; }
+
+    //! Returns the number of steps (parts of instructions) executed with this context so far
+    long long GetInstructionCount() const { return m_instructionCount; }
+
+    /**
+     * \brief Get the context used by stacks created on this thread
+     *
+     * This is the context of the program currently being run on this thread, or a default
+     * context owned by the thread if no program is running.
+     */
+    static CBotExecutionContext* GetCurrent();
+
+    /**
+     * \brief Makes a context current on this thread for the lifetime of this object
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(CBotExecutionContext* context);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CBotExecutionContext* m_previous;
+    };
+
+    /**
+     * \brief Serializes external access which can't be deferred
+     *
+     * Locks a mutex shared by all contexts for the lifetime of this object, if the context defers external access.
+     */
+    class ExternalAccessLock
+    {
+    public:
+        explicit ExternalAccessLock(CBotExecutionContext* context);
+        ~ExternalAccessLock();
+
+        ExternalAccessLock(const ExternalAccessLock&) = delete;
+        ExternalAccessLock& operator=(const ExternalAccessLock&) = delete;
+
+    private:
+        bool m_locked;
+    };
+
+private:
+    friend class CBotStack;
+    friend class CBotBytecode;
+
+    CBotError m_error = CBotNoErr;
+    int m_start = 0;
+    int m_end = 0;
+    //! result of a return, moved from the stack that executed it to the stack of the function
+    CBotVar* m_retvar = nullptr;
+
+    int m_timerLimit = -1;
+    int m_timer = 0;
+    long long m_instructionCount = 0;
+    std::string m_labelBreak;
+    void* m_pUser = nullptr;
+
+    bool m_deferExternalAccess = false;
+    bool m_externalAccessDeferred = false;
+};
+
+} // namespace CBot
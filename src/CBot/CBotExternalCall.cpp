@@ -83,6 +83,7 @@ int CBotExternalCallList::DoCall(CBotToken* token, CBotVar* thisVar, CBotVar** p
     CBotExternalCall* pt = m_list[token->GetString()].get();
 
     if (pStack->IsCallFinished()) return true;
+    if (!pt->IsThreadSafe() && !pStack->CanAccessExternal()) return false;
     CBotStack* pile = pStack->AddStackExternalCall(pt);
 
     // lists the parameters depending on the contents of the stack (pStackVar)
@@ -124,6 +125,16 @@ CBotExternalCall::~CBotExternalCall()
 {
 }
 
+void CBotExternalCall::SetThreadSafe(bool threadSafe)
+{
+    m_threadSafe = threadSafe;
+}
+
+bool CBotExternalCall::IsThreadSafe()
+{
+    return m_threadSafe;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 CBotExternalCallDefault::CBotExternalCallDefault(RuntimeFunc rExec, CompileFunc rCompile)
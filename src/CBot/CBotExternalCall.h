@@ -73,6 +73,24 @@ public:
      * \return false to request program interruption, true otherwise
      */
     virtual bool Run(CBotVar* thisVar, CBotStack* pStack) = 0;
+
+    /**
+     * \brief Mark the function as thread-safe
+     *
+     * Thread-safe functions only work on their arguments, so they can be called by programs running
+     * in parallel (see CBotExecutionContext::SetDeferExternalAccess()). All other functions are deferred.
+     *
+     * \param threadSafe true if the function is thread-safe
+     */
+    void SetThreadSafe(bool threadSafe);
+    /**
+     * \brief Check if the function is thread-safe
+     * \see SetThreadSafe()
+     */
+    bool IsThreadSafe();
+
+private:
+    bool m_threadSafe = false;
 };
 
 /**
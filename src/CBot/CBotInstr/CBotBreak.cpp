@@ -19,6 +19,8 @@
 
 #include "CBot/CBotInstr/CBotBreak.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
 
@@ -92,6 +94,12 @@ void CBotBreak :: RestoreState(CBotStack* &pj, bool bMain)
     if ( bMain ) pj->RestoreStack(this);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotBreak::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    return compiler.EmitBreak(m_label, GetTokenType() == ID_CONTINUE);
+}
+
 std::string CBotBreak::GetDebugData()
 {
     return !m_label.empty() ? "m_label = "+m_label : "";
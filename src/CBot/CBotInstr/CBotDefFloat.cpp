@@ -19,6 +19,8 @@
 
 #include "CBot/CBotInstr/CBotDefFloat.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotInstr/CBotLeftExprVar.h"
 #include "CBot/CBotInstr/CBotTwoOpExpr.h"
 #include "CBot/CBotInstr/CBotDefArray.h"
@@ -173,6 +175,18 @@ void CBotDefFloat::RestoreState(CBotStack* &pj, bool bMain)
          m_next2b->RestoreState(pile, bMain);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotDefFloat::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    int value = -1;
+    if (m_expr != nullptr && !compiler.CompileOperand(m_expr, value)) return false;
+
+    CBotLeftExprVar* var = static_cast<CBotLeftExprVar*>(m_var);
+    if (compiler.DeclareVariable(var->m_nIdent, var->GetToken()->GetString(), var->m_typevar, value) < 0) return false;
+
+    return m_next2b == nullptr || m_next2b->CompileBytecode(compiler, result);      // other(s) definition(s)
+}
+
 std::map<std::string, CBotInstr*> CBotDefFloat::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
@@ -19,6 +19,8 @@
 
 #include "CBot/CBotInstr/CBotDefInt.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotInstr/CBotLeftExprVar.h"
 #include "CBot/CBotInstr/CBotDefArray.h"
 #include "CBot/CBotInstr/CBotTwoOpExpr.h"
@@ -178,6 +180,18 @@ void CBotDefInt::RestoreState(CBotStack* &pj, bool bMain)
     if (m_next2b) m_next2b->RestoreState(pile, bMain);            // other(s) definition(s)
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotDefInt::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    int value = -1;
+    if (m_expr != nullptr && !compiler.CompileOperand(m_expr, value)) return false;
+
+    CBotLeftExprVar* var = static_cast<CBotLeftExprVar*>(m_var);
+    if (compiler.DeclareVariable(var->m_nIdent, var->GetToken()->GetString(), var->m_typevar, value) < 0) return false;
+
+    return m_next2b == nullptr || m_next2b->CompileBytecode(compiler, result);      // other(s) definition(s)
+}
+
 std::map<std::string, CBotInstr*> CBotDefInt::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
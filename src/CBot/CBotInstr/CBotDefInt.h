@@ -57,6 +57,8 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result) override;
+
 protected:
     virtual const std::string GetDebugName() override { return "CBotDefInt"; }
     virtual std::map<std::string, CBotInstr*> GetDebugLinks() override;
@@ -18,6 +18,8 @@
  */
 
 #include "CBot/CBotInstr/CBotDo.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotBlock.h"
 #include "CBot/CBotInstr/CBotCondition.h"
 
@@ -154,6 +156,23 @@ void CBotDo :: RestoreState(CBotStack* &pj, bool bMain)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotDo::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    compiler.BeginLoop(m_label);
+    int start = compiler.GetPosition();
+
+    if (m_block != nullptr && !compiler.CompileStatement(m_block)) return false;
+
+    int test = compiler.GetPosition();
+    int condition;
+    if (!compiler.CompileOperand(m_condition, condition)) return false;
+    compiler.EmitJumpTo(start, condition, true);
+
+    compiler.EndLoop(test);
+    return true;
+}
+
 std::string CBotDo::GetDebugData()
 {
     return !m_label.empty() ? "m_label = "+m_label : "";
@@ -55,6 +55,8 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result) override;
+
 protected:
     virtual const std::string GetDebugName() override { return "CBotDo"; }
     virtual std::string GetDebugData() override;
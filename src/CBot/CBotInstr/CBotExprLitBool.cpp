@@ -19,6 +19,8 @@
 
 #include "CBot/CBotInstr/CBotExprLitBool.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
 
@@ -79,4 +81,11 @@ void CBotExprLitBool::RestoreState(CBotStack* &pj, bool bMain)
     if (bMain) pj->RestoreStack(this);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotExprLitBool::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    result = compiler.AddConstant(GetTokenType() == ID_TRUE);
+    return true;
+}
+
 } // namespace CBot
@@ -19,6 +19,8 @@
 
 #include "CBot/CBotInstr/CBotExprLitNan.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotStack.h"
 
 #include "CBot/CBotVar/CBotVar.h"
@@ -54,4 +56,11 @@ void CBotExprLitNan::RestoreState(CBotStack* &pj, bool bMain)
     if (bMain) pj->RestoreStack(this);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotExprLitNan::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    result = compiler.AddNanConstant();
+    return true;
+}
+
 } // namespace CBot
@@ -18,6 +18,8 @@
  */
 
 #include "CBot/CBotInstr/CBotExprLitNum.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotStack.h"
 
 #include "CBot/CBotCStack.h"
@@ -86,6 +88,14 @@ bool CBotExprLitNum::Execute(CBotStack* &pj)
 
     if (pile->IfStep()) return false;
 
+    pile->SetVar(CreateVar());                      // place on the stack
+
+    return pj->Return(pile);                        // it's ok
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotVar* CBotExprLitNum::CreateVar()
+{
     CBotVar*    var = CBotVar::Create("", m_numtype);
 
     std::string    nombre ;
@@ -106,9 +116,29 @@ bool CBotExprLitNum::Execute(CBotStack* &pj)
     default:
         assert(false);
     }
-    pile->SetVar(var);                            // place on the stack
+    return var;
+}
 
-    return pj->Return(pile);                        // it's ok
+////////////////////////////////////////////////////////////////////////////////
+CBotExprLitNum* CBotExprLitNum::Create(CBotVar* value, CBotToken* token)
+{
+    if (!value->IsDefined()) return nullptr;
+
+    CBotExprLitNum* inst = new CBotExprLitNum();
+    inst->SetToken(token);
+    inst->m_numtype = value->GetType();
+    switch (inst->m_numtype)
+    {
+    case CBotTypInt:
+        inst->m_valint = value->GetValInt();
+        return inst;
+    case CBotTypFloat:
+        inst->m_valfloat = value->GetValFloat();
+        return inst;
+    default:
+        delete inst;
+        return nullptr;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -117,6 +147,28 @@ void CBotExprLitNum::RestoreState(CBotStack* &pj, bool bMain)
     if (bMain) pj->RestoreStack(this);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotExprLitNum::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    std::string nombre;
+    if (m_token.GetType() == TokenTypDef)
+    {
+        nombre = m_token.GetString();
+    }
+
+    switch (m_numtype)
+    {
+    case CBotTypInt:
+        result = compiler.AddConstant(static_cast<int>(m_valint), nombre);
+        return true;
+    case CBotTypFloat:
+        result = compiler.AddConstant(m_valfloat);
+        return true;
+    default:
+        return false;
+    }
+}
+
 std::string CBotExprLitNum::GetDebugData()
 {
     std::stringstream ss;
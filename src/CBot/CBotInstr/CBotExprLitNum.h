@@ -58,6 +58,22 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result) override;
+
+    /*!
+     * \brief Creates the variable holding the value of this literal, as Execute() does
+     * \return New variable
+     */
+    CBotVar* CreateVar();
+
+    /*!
+     * \brief Creates a literal for a value computed at compile time
+     * \param value The value
+     * \param token Token covering the whole expression that was computed
+     * \return New literal, nullptr if the value is not an int or a float
+     */
+    static CBotExprLitNum* Create(CBotVar* value, CBotToken* token);
+
 protected:
     virtual const std::string GetDebugName() override { return "CBotExprLitNum"; }
     virtual std::string GetDebugData() override;
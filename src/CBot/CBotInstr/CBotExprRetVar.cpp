@@ -155,6 +155,7 @@ bool CBotExprRetVar::Execute(CBotStack* &pj)
     if (pile1->GetState() == 0)
     {
         pVar = pj->GetVar();
+        if (!pile1->CanUpdateVar(pVar)) return false;
         pVar->Update(pj->GetUserPtr());
         if (pVar->GetType(CBotVar::GetTypeMode::CLASS_AS_POINTER) == CBotTypNullPointer)
         {
@@ -18,6 +18,9 @@
  */
 
 #include "CBot/CBotInstr/CBotExprUnaire.h"
+
+#include "CBot/CBotBytecode.h"
+#include "CBot/CBotInstr/CBotExprLitNum.h"
 #include "CBot/CBotInstr/CBotParExpr.h"
 
 #include "CBot/CBotStack.h"
@@ -58,9 +61,9 @@ CBotInstr* CBotExprUnaire::Compile(CBotToken* &p, CBotCStack* pStack, bool bLite
     if (inst->m_expr != nullptr)
     {
         if (op == ID_ADD && pStk->GetType() < CBotTypBoolean)        // only with the number
-            return pStack->Return(inst, pStk);
+            return pStack->Return(FoldConstant(inst), pStk);
         if (op == ID_SUB && pStk->GetType() < CBotTypBoolean)        // only with the numer
-            return pStack->Return(inst, pStk);
+            return pStack->Return(FoldConstant(inst), pStk);
         if (op == ID_NOT && pStk->GetType() < CBotTypFloat)        // only with an integer
             return pStack->Return(inst, pStk);
         if (op == ID_LOG_NOT && pStk->GetTypResult().Eq(CBotTypBoolean))// only with boolean
@@ -74,6 +77,26 @@ CBotInstr* CBotExprUnaire::Compile(CBotToken* &p, CBotCStack* pStack, bool bLite
     return pStack->Return(nullptr, pStk);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+CBotInstr* CBotExprUnaire::FoldConstant(CBotExprUnaire* inst)
+{
+    // constants from DefineNum() keep their name when negated, see CBotVarInt
+    CBotExprLitNum* literal = dynamic_cast<CBotExprLitNum*>(inst->m_expr);
+    if (literal == nullptr || literal->GetToken()->GetType() == TokenTypDef) return inst;
+
+    CBotVar* value = literal->CreateVar();
+    if (inst->GetTokenType() == ID_SUB) value->Neg();
+
+    CBotToken token(inst->m_token);
+    token.SetPos(inst->m_token.GetStart(), literal->GetToken()->GetEnd());
+    CBotInstr* folded = CBotExprLitNum::Create(value, &token);
+    delete value;
+
+    if (folded == nullptr) return inst;
+    delete inst;
+    return folded;
+}
+
 // executes unary expression
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotExprUnaire::Execute(CBotStack* &pj)
@@ -122,6 +145,16 @@ void CBotExprUnaire::RestoreState(CBotStack* &pj, bool bMain)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotExprUnaire::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    int value;
+    if (!compiler.CompileOperand(m_expr, value)) return false;
+
+    result = compiler.EmitUnary(GetTokenType(), value, &m_token);
+    return result >= 0;
+}
+
 std::map<std::string, CBotInstr*> CBotExprUnaire::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
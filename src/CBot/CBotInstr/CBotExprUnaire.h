@@ -56,10 +56,20 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result) override;
+
 protected:
     virtual const std::string GetDebugName() override { return "CBotExprUnaire"; }
     virtual std::map<std::string, CBotInstr*> GetDebugLinks() override;
 
+private:
+    /*!
+     * \brief Replaces -a or +a by a literal if a is a number literal
+     * \param inst The expression, deleted if it was replaced
+     * \return The literal, or inst if it cannot be computed at compile time
+     */
+    static CBotInstr* FoldConstant(CBotExprUnaire* inst);
+
 private:
     //! Expression to be evaluated.
     CBotInstr* m_expr;
@@ -19,6 +19,8 @@
 
 #include <sstream>
 #include "CBot/CBotInstr/CBotExprVar.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotInstrMethode.h"
 #include "CBot/CBotInstr/CBotExpression.h"
 #include "CBot/CBotInstr/CBotIndexExpr.h"
@@ -36,6 +38,7 @@ namespace CBot
 CBotExprVar::CBotExprVar()
 {
     m_nIdent = 0;
+    m_blockLevel = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -59,11 +62,13 @@ CBotInstr* CBotExprVar::Compile(CBotToken*& p, CBotCStack* pStack, bool bCheckRe
         inst->SetToken(p);
 
         CBotVar*     var;
+        int          blockLevel;
 
-        if (nullptr != (var = pStk->FindVar(p)))   // seek if known variable
+        if (nullptr != (var = pStk->FindVar(p, blockLevel)))   // seek if known variable
         {
             int        ident = var->GetUniqNum();
             (static_cast<CBotExprVar*>(inst))->m_nIdent = ident;     // identifies variable by its number
+            (static_cast<CBotExprVar*>(inst))->m_blockLevel = blockLevel;
 
             if (ident > 0 && ident < 9000)
             {
@@ -78,6 +83,9 @@ CBotInstr* CBotExprVar::Compile(CBotToken*& p, CBotCStack* pStack, bool bCheckRe
                 CBotToken token("this");
                 inst->SetToken(&token);
                 (static_cast<CBotExprVar*>(inst))->m_nIdent = -2;    // identificator for this
+                CBotToken* pThisToken = &token;
+                pStk->FindVar(pThisToken, blockLevel);
+                (static_cast<CBotExprVar*>(inst))->m_blockLevel = blockLevel;
 
                 CBotFieldExpr* i = new CBotFieldExpr();     // new element
                 i->SetToken(p);     // keeps the name of the token
@@ -188,7 +196,9 @@ CBotInstr* CBotExprVar::CompileMethode(CBotToken* &p, CBotCStack* pStack)
     if (pp->GetType() == TokenTypVar)
     {
         CBotToken pthis("this");
-        CBotVar*     var = pStk->FindVar(pthis);
+        CBotToken*   pThisToken = &pthis;
+        int          blockLevel;
+        CBotVar*     var = pStk->FindVar(pThisToken, blockLevel);
         if (var == nullptr) return pStack->Return(nullptr, pStk);
 
         CBotInstr* inst = new CBotExprVar();
@@ -198,6 +208,7 @@ CBotInstr* CBotExprVar::CompileMethode(CBotToken* &p, CBotCStack* pStack)
 
         inst->SetToken(&pthis);
         (static_cast<CBotExprVar*>(inst))->m_nIdent = -2;    // ident for this
+        (static_cast<CBotExprVar*>(inst))->m_blockLevel = blockLevel;
 
         CBotToken* pp = p;
 
@@ -282,13 +293,17 @@ bool CBotExprVar::ExecuteVar(CBotVar* &pVar, CBotStack* &pj, CBotToken* prevToke
 
     if (bStep && m_nIdent>0 && pj->IfStep()) return false;
 
-    pVar = pj->FindVar(m_nIdent, true);     // tries with the variable update if necessary
+    int blockLevel = m_blockLevel;
+    pVar = pj->FindVar(m_nIdent, blockLevel, false);
+    if (blockLevel != m_blockLevel) m_blockLevel = blockLevel;
     if (pVar == nullptr)
     {
         assert(false);
         //pj->SetError(static_cast<CBotError>(1), &m_token); // TODO: yeah, don't care that this exception doesn't exist ~krzys_h
         return false;
     }
+    if (!pj->CanUpdateVar(pVar)) return false;
+    pVar->Update(pj->GetUserPtr());         // the variable update if necessary
     if ( m_next3 != nullptr &&
          !m_next3->ExecuteVar(pVar, pj, &m_token, bStep, false) )
             return false;   // field of an instance, table, methode
@@ -306,6 +321,25 @@ void CBotExprVar::RestoreStateVar(CBotStack* &pj, bool bMain)
          m_next3->RestoreStateVar(pj, bMain);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotExprVar::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    int variable;
+    if (!CompileBytecodeVar(compiler, variable)) return false;
+
+    result = compiler.ReadVariable(variable, &m_token);
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotExprVar::CompileBytecodeVar(CBotBytecodeCompiler& compiler, int& variable)
+{
+    if (m_next3 != nullptr) return false;       // field of an instance, table, methode
+
+    variable = compiler.GetVariable(m_nIdent);
+    return variable >= 0;
+}
+
 std::string CBotExprVar::GetDebugData()
 {
     std::stringstream ss;
@@ -24,6 +24,8 @@
 #include "CBot/CBotInstr/CBotInstr.h"
 #include "CBot/CBotVar/CBotVar.h"
 
+#include <atomic>
+
 namespace CBot
 {
 
@@ -70,6 +72,14 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result) override;
+
+    /**
+     * \brief Gives the register of the variable, for an assignment or an increment
+     * \return false if the variable is not a local variable of the function
+     */
+    bool CompileBytecodeVar(CBotBytecodeCompiler& compiler, int& variable);
+
     /*!
      * \brief ExecuteVar Fetch a variable at runtime.
      * \param pVar
@@ -95,6 +105,9 @@ protected:
 
 private:
     long m_nIdent;
+    //! Number of blocks up to the declaration of the variable, see CBotStack::FindVar(long, int&, bool)
+    //! Found during compilation and corrected during execution, possibly by several threads at once
+    std::atomic<int> m_blockLevel;
     friend class CBotPostIncExpr;
     friend class CBotPreIncExpr;
 
@@ -19,6 +19,8 @@
 
 #include "CBot/CBotInstr/CBotExpression.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotInstr/CBotInstrUtils.h"
 
 #include "CBot/CBotInstr/CBotTwoOpExpr.h"
@@ -193,6 +195,7 @@ bool CBotExpression::Execute(CBotStack* &pj)
             if (var->GetType() == CBotTypString && value->GetType() != CBotTypString)
             {
                 CBotVar* newVal = CBotVar::Create("", var->GetTypResult());
+                CBotExecutionContext::ExternalAccessLock lock(pj->GetExecutionContext());
                 value->Update(pj->GetUserPtr());
                 newVal->SetValString(value->GetValString());
                 pile2->SetVar(newVal);
@@ -314,6 +317,27 @@ void CBotExpression::RestoreState(CBotStack* &pj, bool bMain)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotExpression::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    if (m_rightop == nullptr) return false;
+    bool discard = compiler.IsDiscarded(this);
+
+    int variable;
+    if (!m_leftop->CompileBytecodeVar(compiler, variable)) return false;
+
+    // like in Execute(), a compound assignment uses the value of the variable before the right operand
+    int left = -1;
+    if (m_token.GetType() != ID_ASS) left = compiler.KeepOperand(this, 0, variable);
+
+    int value;
+    if (!compiler.CompileOperand(m_rightop, value)) return false;
+    compiler.EndOperands(this);
+
+    result = compiler.EmitAssign(m_token.GetType(), variable, left, value, &m_token, m_leftop->GetToken(), discard);
+    return result >= 0;
+}
+
 std::map<std::string, CBotInstr*> CBotExpression::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
@@ -100,12 +100,16 @@ bool CBotFieldExpr::ExecuteVar(CBotVar* &pVar, CBotStack* &pile, CBotToken* prev
 
     if (pVar->IsStatic())
     {
+        // static variables are shared by all programs
+        if (!pile->CanAccessExternal()) return false;
+
         // for a static variable, takes it in the class itself
         CBotClass* pClass = pItem->GetClass();
         pVar = pClass->GetItem(m_token.GetString());
     }
 
     // request the update of the element, if applicable
+    if (!pile->CanUpdateVar(pVar)) return false;
     pVar->Update(pile->GetUserPtr());
 
     if ( m_next3 != nullptr &&
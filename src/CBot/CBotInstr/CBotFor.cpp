@@ -18,6 +18,8 @@
  */
 
 #include "CBot/CBotInstr/CBotFor.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotListExpression.h"
 #include "CBot/CBotInstr/CBotBlock.h"
 #include "CBot/CBotInstr/CBotBoolExpr.h"
@@ -210,6 +212,34 @@ void CBotFor :: RestoreState(CBotStack* &pj, bool bMain)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotFor::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    int value;
+    if (m_init != nullptr && !compiler.CompileOperand(m_init, value, true)) return false;
+
+    compiler.BeginLoop(m_label);
+    int start = compiler.GetPosition();
+
+    int jumpEnd = -1;
+    if (m_test != nullptr)      // no test means an endless loop
+    {
+        int condition;
+        if (!compiler.CompileOperand(m_test, condition)) return false;
+        jumpEnd = compiler.EmitJump(condition);
+    }
+
+    if (m_block != nullptr && !compiler.CompileStatement(m_block)) return false;
+
+    int next = compiler.GetPosition();
+    if (m_incr != nullptr && !compiler.CompileOperand(m_incr, value, true)) return false;
+    compiler.EmitJumpTo(start);
+
+    compiler.SetJumpTarget(jumpEnd);
+    compiler.EndLoop(next);
+    return true;
+}
+
 std::string CBotFor::GetDebugData()
 {
     return !m_label.empty() ? "m_label = "+m_label : "";
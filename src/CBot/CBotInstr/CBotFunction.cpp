@@ -27,9 +27,11 @@
 #include "CBot/CBotInstr/CBotEmpty.h"
 #include "CBot/CBotInstr/CBotListArray.h"
 
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
 #include "CBot/CBotClass.h"
+#include "CBot/CBotProgram.h"
 #include "CBot/CBotDefParam.h"
 #include "CBot/CBotUtils.h"
 
@@ -56,6 +58,7 @@ CBotFunction::CBotFunction()
 
 ////////////////////////////////////////////////////////////////////////////////
 std::set<CBotFunction*> CBotFunction::m_publicFunctions{};
+std::mutex CBotFunction::m_publicFunctionsMutex{};
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotFunction::~CBotFunction()
@@ -66,6 +69,7 @@ CBotFunction::~CBotFunction()
     // remove public list if there is
     if (m_bPublic)
     {
+        std::lock_guard<std::mutex> lock(m_publicFunctionsMutex);
         m_publicFunctions.erase(this);
     }
 }
@@ -368,7 +372,7 @@ bool CBotFunction::Execute(CBotVar** ppVars, CBotStack* &pj, CBotVar* pInstance)
     CBotStack*  pile = pj->AddStack(this, CBotStack::BlockVisibilityType::FUNCTION);               // one end of stack local to this function
 //  if ( pile == EOX ) return true;
 
-    pile->SetProgram(m_pProg);                              // bases for routines
+    pile->SetProgram(GetProgram(pile->GetProgram()));       // bases for routines
 
     if ( pile->IfStep() ) return false;
 
@@ -384,6 +388,9 @@ bool CBotFunction::Execute(CBotVar** ppVars, CBotStack* &pj, CBotVar* pInstance)
             pile3b->Delete(); // done with param stack
         }
         pile->IncState();
+
+        // state 2 means the body runs on the bytecode VM, methods never do
+        if ( UseBytecode(pile) ) pile->IncState();
     }
 
     if ( pile->GetState() == 1 && !m_MasterClass.empty() )
@@ -415,7 +422,8 @@ bool CBotFunction::Execute(CBotVar** ppVars, CBotStack* &pj, CBotVar* pInstance)
         pile->IncState();
     }
 
-    if ( !m_block->Execute(pile) )
+    bool finished = m_bytecode != nullptr && pile->GetState() == 2 ? m_bytecode->Execute(pile) : m_block->Execute(pile);
+    if ( !finished )
     {
         if ( pile->GetError() < 0 )
             pile->SetError( CBotNoErr );
@@ -433,7 +441,7 @@ void CBotFunction::RestoreState(CBotVar** ppVars, CBotStack* &pj, CBotVar* pInst
     if ( pile == nullptr ) return;
     CBotStack*  pile2 = pile;
 
-    pile->SetProgram(m_pProg);                          // bases for routines
+    pile->SetProgram(GetProgram(pile->GetProgram()));   // bases for routines
 
     if ( pile->GetBlock() != CBotStack::BlockVisibilityType::FUNCTION)
     {
@@ -467,7 +475,10 @@ void CBotFunction::RestoreState(CBotVar** ppVars, CBotStack* &pj, CBotVar* pInst
         pThis->SetUniqNum(-2);
     }
 
-    m_block->RestoreState(pile2, true);
+    if ( m_bytecode != nullptr && pile->GetState() == 2 )
+        m_bytecode->RestoreState(pile2);
+    else
+        m_block->RestoreState(pile2, true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -488,6 +499,8 @@ CBotFunction* CBotFunction::FindLocalOrPublic(const std::list<CBotFunction*>& lo
 {
     TypeOrError.SetType(CBotErrUndefCall);      // no routine of the name
 
+    std::lock_guard<std::mutex> lock(m_publicFunctionsMutex);
+
     if ( nIdent )
     {
         for (CBotFunction* pt : localFunctionList)
@@ -680,7 +693,7 @@ int CBotFunction::DoCall(CBotProgram* program, const std::list<CBotFunction*>& l
         CBotStack*  pStk1 = pStack->AddStack(pt, CBotStack::BlockVisibilityType::FUNCTION);    // to put "this"
 //      if ( pStk1 == EOX ) return true;
 
-        pStk1->SetProgram(pt->m_pProg);                 // it may have changed module
+        pStk1->SetProgram(pt->GetProgram(program));     // it may have changed module
 
         if ( pStk1->IfStep() ) return false;
 
@@ -726,7 +739,7 @@ int CBotFunction::DoCall(CBotProgram* program, const std::list<CBotFunction*>& l
             {
                 if (!pt->m_param->Execute(ppVars, pStk3)) // interupt here
                 {
-                    if (!pStk3->IsOk() && pt->m_pProg != program)
+                    if (!pStk3->IsOk() && pt->GetProgram(program) != program)
                     {
                         pStk3->SetPosError(pToken);       // indicates the error on the procedure call
                     }
@@ -735,14 +748,16 @@ int CBotFunction::DoCall(CBotProgram* program, const std::list<CBotFunction*>& l
             }
             pStk3b->Delete(); // done with param stack
             pStk1->IncState();
+
+            if ( pt->UseBytecode(pStk1) ) pStk1->IncState();   // the body runs on the bytecode VM
         }
 
         // finally execution of the found function
 
-        if ( !pStk3->GetRetVar(                     // puts the result on the stack
-            pt->m_block->Execute(pStk3) ))          // GetRetVar said if it is interrupted
+        bool finished = pt->m_bytecode != nullptr && pStk1->GetState() == 2 ? pt->m_bytecode->Execute(pStk3) : pt->m_block->Execute(pStk3);
+        if ( !pStk3->GetRetVar(finished) )          // puts the result on the stack, GetRetVar said if it is interrupted
         {
-            if ( !pStk3->IsOk() && pt->m_pProg != program )
+            if ( !pStk3->IsOk() && pt->GetProgram(program) != program )
             {
                 pStk3->SetPosError(pToken);         // indicates the error on the procedure call
             }
@@ -772,7 +787,7 @@ void CBotFunction::RestoreCall(const std::list<CBotFunction*>& localFunctionList
         pStk1 = pStack->RestoreStack(pt);
         if ( pStk1 == nullptr ) return;
 
-        pStk1->SetProgram(pt->m_pProg);                 // it may have changed module
+        pStk1->SetProgram(pt->GetProgram(pStack->GetProgram())); // it may have changed module
 
         if ( pStk1->GetBlock() != CBotStack::BlockVisibilityType::FUNCTION)
         {
@@ -817,7 +832,11 @@ void CBotFunction::RestoreCall(const std::list<CBotFunction*>& localFunctionList
         // initializes the variables as parameters
         if (pt->m_param != nullptr)
             pt->m_param->RestoreState(pStk3, false); // restore parameter IDs
-        pt->m_block->RestoreState(pStk3, true);
+
+        if ( pt->m_bytecode != nullptr && pStk1->GetState() == 2 )
+            pt->m_bytecode->RestoreState(pStk3);
+        else
+            pt->m_block->RestoreState(pStk3, true);
     }
 }
 
@@ -837,7 +856,7 @@ int CBotFunction::DoCall(const std::list<CBotFunction*>& localFunctionList, long
         CBotStack*  pStk = pStack->AddStack(pt, CBotStack::BlockVisibilityType::FUNCTION);
 //      if ( pStk == EOX ) return true;
 
-        pStk->SetProgram(pt->m_pProg);                  // it may have changed module
+        pStk->SetProgram(pt->GetProgram(pProgCurrent)); // it may have changed module
         CBotStack*  pStk3 = pStk->AddStack(nullptr, CBotStack::BlockVisibilityType::BLOCK); // to set parameters passed
 
         // preparing parameters on the stack
@@ -872,7 +891,7 @@ int CBotFunction::DoCall(const std::list<CBotFunction*>& localFunctionList, long
             {
                 if (!pt->m_param->Execute(ppVars, pStk3)) // interupt here
                 {
-                    if (!pStk3->IsOk() && pt->m_pProg != pProgCurrent)
+                    if (!pStk3->IsOk() && pt->GetProgram(pProgCurrent) != pProgCurrent)
                     {
                         pStk3->SetPosError(pToken);       // indicates the error on the procedure call
                     }
@@ -887,6 +906,7 @@ int CBotFunction::DoCall(const std::list<CBotFunction*>& localFunctionList, long
         {
             if ( pt->m_bSynchro )
             {
+                if ( !pStk->CanAccessExternal() ) return false; // class locks are shared by all programs
                 CBotProgram* pProgBase = pStk->GetProgram(true);
                 if ( !pClass->Lock(pProgBase) ) return false; // try to lock, interrupt if failed
             }
@@ -904,7 +924,7 @@ int CBotFunction::DoCall(const std::list<CBotFunction*>& localFunctionList, long
                     pClass->Unlock();                   // release function
                 }
 
-                if ( pt->m_pProg != pProgCurrent )
+                if ( pt->GetProgram(pProgCurrent) != pProgCurrent )
                 {
                     pStk3->SetPosError(pToken);         // indicates the error on the procedure call
                 }
@@ -933,7 +953,7 @@ bool CBotFunction::RestoreCall(const std::list<CBotFunction*>& localFunctionList
     {
         CBotStack*  pStk = pStack->RestoreStack(pt);
         if ( pStk == nullptr ) return true;
-        pStk->SetProgram(pt->m_pProg);                  // it may have changed module
+        pStk->SetProgram(pt->GetProgram(pStack->GetProgram())); // it may have changed module
 
         CBotVar*    pthis = pStk->FindVar("this");
         pthis->SetUniqNum(-2);
@@ -1021,6 +1041,7 @@ std::string CBotFunction::GetParams()
 ////////////////////////////////////////////////////////////////////////////////
 void CBotFunction::AddPublic(CBotFunction* func)
 {
+    std::lock_guard<std::mutex> lock(m_publicFunctionsMutex);
     m_publicFunctions.insert(func);
 }
 
@@ -1030,6 +1051,23 @@ bool CBotFunction::HasReturn()
     return false;
 }
 
+void CBotFunction::CompileBytecode()
+{
+    m_bytecode.reset();
+    if (m_block == nullptr || !m_MasterClass.empty()) return;
+
+    CBotBytecodeCompiler compiler;
+    if (m_param != nullptr && !m_param->CompileBytecode(compiler)) return;
+    m_bytecode = compiler.Compile(m_block);
+}
+
+bool CBotFunction::UseBytecode(CBotStack* pile)
+{
+    if (m_bytecode == nullptr) return false;
+    CBotProgram* program = pile->GetProgram(true);
+    return program != nullptr && program->IsBytecodeEnabled();
+}
+
 std::string CBotFunction::GetDebugData()
 {
     std::stringstream ss;
@@ -21,11 +21,15 @@
 
 #include "CBot/CBotInstr/CBotInstr.h"
 
+#include <memory>
+#include <mutex>
 #include <set>
 
 namespace CBot
 {
 
+class CBotBytecode;
+
 /**
  * \brief A function declaration in the code
  *
@@ -245,6 +249,28 @@ public:
      */
     bool HasReturn() override;
 
+    /*!
+     * \brief Lowers the body of the function into bytecode, if it only uses what CBotBytecode supports
+     *
+     * Called once the whole program is compiled. Whether the bytecode is then used is decided
+     * by the program being run, see CBotProgram::EnableBytecode().
+     */
+    void CompileBytecode();
+
+private:
+    //! Returns true if the body of the function is run by the bytecode VM when entered on this stack
+    bool UseBytecode(CBotStack* pile);
+
+    /*!
+     * \brief Get the program the function runs in
+     * \param caller Program calling the function
+     * \return The program the function is part of, or the calling program if the function is shared
+     */
+    CBotProgram* GetProgram(CBotProgram* caller)
+    {
+        return m_pProg != nullptr ? m_pProg : caller;
+    }
+
 protected:
     virtual const std::string GetDebugName() override { return "CBotFunction"; }
     virtual std::string GetDebugData() override;
@@ -260,6 +286,8 @@ private:
     CBotDefParam* m_param;
     //! The instruction block.
     CBotInstr* m_block;
+    //! The instruction block lowered into bytecode, nullptr if it can't be
+    std::unique_ptr<CBotBytecode> m_bytecode;
     //! If returns CBotTypClass.
     CBotToken m_retToken;
     //! Complete type of the result.
@@ -272,6 +300,7 @@ private:
     std::string m_MasterClass;
     //! Token of the class we are part of
     CBotToken m_classToken;
+    //! Program the function is part of, nullptr if it is shared by several programs (see CBotProgram::CompileShared())
     CBotProgram* m_pProg;
     //! For the position of the word "extern".
     CBotToken m_extern;
@@ -282,6 +311,8 @@ private:
 
     //! List of public functions
     static std::set<CBotFunction*> m_publicFunctions;
+    //! Guards m_publicFunctions, which is shared by all programs
+    static std::mutex m_publicFunctionsMutex;
 
     friend class CBotProgram;
     friend class CBotClass;
@@ -18,6 +18,8 @@
  */
 
 #include "CBot/CBotInstr/CBotIf.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotBlock.h"
 #include "CBot/CBotInstr/CBotCondition.h"
 
@@ -172,6 +174,28 @@ bool CBotIf::HasReturn()
     return CBotInstr::HasReturn(); // check next block or instruction
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotIf::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    int condition;
+    if (!compiler.CompileOperand(m_condition, condition)) return false;
+
+    int jumpElse = compiler.EmitJump(condition);
+    if (m_block != nullptr && !compiler.CompileStatement(m_block)) return false;
+
+    if (m_blockElse == nullptr)
+    {
+        compiler.SetJumpTarget(jumpElse);
+        return true;
+    }
+
+    int jumpEnd = compiler.EmitJump();
+    compiler.SetJumpTarget(jumpElse);
+    if (!compiler.CompileStatement(m_blockElse)) return false;
+    compiler.SetJumpTarget(jumpEnd);
+    return true;
+}
+
 std::map<std::string, CBotInstr*> CBotIf::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
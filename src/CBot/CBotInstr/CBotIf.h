@@ -56,6 +56,8 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result) override;
+
     /**
      * \brief Check 'if' and 'else' for return statements.
      * Returns true when 'if' and 'else' have return statements,
@@ -91,6 +91,7 @@ bool CBotIndexExpr::ExecuteVar(CBotVar* &pVar, CBotStack* &pile, CBotToken* prev
         return pj->Return(pile);
     }
 
+    if (!pile->CanUpdateVar(pVar)) return false;
     pVar->Update(pile->GetUserPtr());
 
     if ( m_next3 != nullptr &&
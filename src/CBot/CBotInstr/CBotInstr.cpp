@@ -365,6 +365,11 @@ bool CBotInstr::HasReturn()
     return false; // end of the list
 }
 
+bool CBotInstr::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    return false;
+}
+
 std::map<std::string, CBotInstr*> CBotInstr::GetDebugLinks()
 {
     return {
@@ -26,6 +26,7 @@
 
 namespace CBot
 {
+class CBotBytecodeCompiler;
 class CBotDebug;
 
 /**
@@ -287,6 +288,14 @@ public:
      */
     virtual bool HasReturn();
 
+    /**
+     * \brief Lowers this instruction into bytecode, see CBotBytecodeCompiler
+     * \param compiler Compiler of the function this instruction is part of
+     * \param[out] result Register with the value of this instruction, if it is an expression
+     * \return false if this instruction can't be lowered, the function is then only run by the tree interpreter
+     */
+    virtual bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result);
+
 protected:
     friend class CBotDebug;
     /**
@@ -18,6 +18,8 @@
  */
 
 #include "CBot/CBotInstr/CBotInstrCall.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotExprRetVar.h"
 #include "CBot/CBotInstr/CBotInstrUtils.h"
 
@@ -212,6 +214,23 @@ void CBotInstrCall::RestoreState(CBotStack* &pj, bool bMain)
     pile2->RestoreCall(m_nFuncIdent, GetToken(), ppVars);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotInstrCall::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    if (m_exprRetVar != nullptr) return false;  // func().member
+
+    std::vector<int> args;
+    for (CBotInstr* p = m_parameters; p != nullptr; p = p->GetNext())
+    {
+        int value;
+        if (!compiler.CompileOperand(p, value)) return false;
+        args.push_back(compiler.KeepOperand(this, static_cast<int>(args.size()), value));
+    }
+    compiler.EndOperands(this);
+
+    return compiler.EmitCall(this, m_nFuncIdent, m_typRes, args, result);
+}
+
 std::string CBotInstrCall::GetDebugData()
 {
     std::stringstream ss;
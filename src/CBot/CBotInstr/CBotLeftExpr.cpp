@@ -19,6 +19,8 @@
 
 #include <sstream>
 #include "CBot/CBotInstr/CBotLeftExpr.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotFieldExpr.h"
 #include "CBot/CBotInstr/CBotIndexExpr.h"
 #include "CBot/CBotInstr/CBotExpression.h"
@@ -36,6 +38,7 @@ namespace CBot
 CBotLeftExpr::CBotLeftExpr()
 {
     m_nIdent = 0;
+    m_blockLevel = -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -58,9 +61,11 @@ CBotLeftExpr* CBotLeftExpr::Compile(CBotToken* &p, CBotCStack* pStack)
         inst->SetToken(p);
 
         CBotVar*     var;
+        int          blockLevel;
 
-        if (nullptr != (var = pStk->FindVar(p)))   // seek if known variable
+        if (nullptr != (var = pStk->FindVar(p, blockLevel)))   // seek if known variable
         {
+            inst->m_blockLevel = blockLevel;
             inst->m_nIdent = var->GetUniqNum();
             if (inst->m_nIdent > 0 && inst->m_nIdent < 9000)
             {
@@ -79,7 +84,9 @@ CBotLeftExpr* CBotLeftExpr::Compile(CBotToken* &p, CBotCStack* pStack)
                 i->SetToken(p);     // keeps the name of the token
                 inst->AddNext3(i);  // add after
 
-                var = pStk->FindVar(pthis);
+                CBotToken* pThisToken = &pthis;
+                var = pStk->FindVar(pThisToken, blockLevel);
+                inst->m_blockLevel = blockLevel;
                 var = var->GetItem(p->GetString());
                 i->SetUniqNum(var->GetUniqNum());
             }
@@ -218,7 +225,9 @@ bool CBotLeftExpr::ExecuteVar(CBotVar* &pVar, CBotStack* &pile, CBotToken* prevT
 {
     pile = pile->AddStack(this);
 
-    pVar = pile->FindVar(m_nIdent, false);
+    int blockLevel = m_blockLevel;
+    pVar = pile->FindVar(m_nIdent, blockLevel, false);
+    if (blockLevel != m_blockLevel) m_blockLevel = blockLevel;
     if (pVar == nullptr)
     {
         assert(false);
@@ -244,6 +253,15 @@ void CBotLeftExpr::RestoreStateVar(CBotStack* &pile, bool bMain)
          m_next3->RestoreStateVar(pile, bMain);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotLeftExpr::CompileBytecodeVar(CBotBytecodeCompiler& compiler, int& variable)
+{
+    if (m_next3 != nullptr) return false;       // field of an instance, table
+
+    variable = compiler.GetVariable(m_nIdent);
+    return variable >= 0;
+}
+
 std::string CBotLeftExpr::GetDebugData()
 {
     std::stringstream ss;
@@ -21,6 +21,8 @@
 
 #include "CBot/CBotInstr/CBotInstr.h"
 
+#include <atomic>
+
 namespace CBot
 {
 
@@ -90,12 +92,21 @@ public:
      */
     void RestoreStateVar(CBotStack* &pile, bool bMain) override;
 
+    /**
+     * \brief Gives the register of the variable, for an assignment or an increment
+     * \return false if the variable is not a local variable of the function
+     */
+    bool CompileBytecodeVar(CBotBytecodeCompiler& compiler, int& variable);
+
 protected:
     virtual const std::string GetDebugName() override { return "CBotLeftExpr"; }
     virtual std::string GetDebugData() override;
 
 private:
     long m_nIdent;
+    //! Number of blocks up to the declaration of the variable, see CBotStack::FindVar(long, int&, bool)
+    //! Found during compilation and corrected during execution, possibly by several threads at once
+    std::atomic<int> m_blockLevel;
 };
 
 } // namespace CBot
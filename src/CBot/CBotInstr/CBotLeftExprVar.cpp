@@ -66,6 +66,7 @@ bool CBotLeftExprVar::Execute(CBotStack* &pj)
     {
         if (m_typevar.Eq(CBotTypString) && var2->GetType() != CBotTypString)
         {
+            CBotExecutionContext::ExternalAccessLock lock(pj->GetExecutionContext());
             var2->Update(pj->GetUserPtr());
             var1->SetValString(var2->GetValString());
             return true;
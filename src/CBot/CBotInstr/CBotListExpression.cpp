@@ -24,6 +24,8 @@
 #include "CBot/CBotInstr/CBotExpression.h"
 #include "CBot/CBotInstr/CBotListExpression.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
 
@@ -127,6 +129,17 @@ void CBotListExpression::RestoreState(CBotStack* &pj, bool bMain)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotListExpression::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    for (CBotInstr* p = m_expr; p != nullptr; p = p->GetNext())
+    {
+        int value;
+        if (!compiler.CompileOperand(p, value, true)) return false;
+    }
+    return true;
+}
+
 std::map<std::string, CBotInstr*> CBotListExpression::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
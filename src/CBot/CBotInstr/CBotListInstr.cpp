@@ -18,6 +18,8 @@
  */
 
 #include "CBot/CBotInstr/CBotListInstr.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotBlock.h"
 
 #include "CBot/CBotStack.h"
@@ -123,6 +125,16 @@ bool CBotListInstr::HasReturn()
     return CBotInstr::HasReturn(); // check next block or instruction
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotListInstr::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    for (CBotInstr* p = m_instr; p != nullptr; p = p->GetNext())
+    {
+        if (!compiler.CompileStatement(p)) return false;
+    }
+    return true;
+}
+
 std::map<std::string, CBotInstr*> CBotListInstr::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
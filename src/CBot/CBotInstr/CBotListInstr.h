@@ -56,6 +56,8 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result) override;
+
     /**
      * \brief Check this block of instructions for a return statement.
      * If not found, the next block or instruction is checked.
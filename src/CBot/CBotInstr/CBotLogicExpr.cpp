@@ -19,6 +19,8 @@
 
 #include "CBot/CBotInstr/CBotLogicExpr.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotStack.h"
 
 namespace CBot
@@ -89,6 +91,27 @@ void CBotLogicExpr::RestoreState(CBotStack* &pStack, bool bMain)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotLogicExpr::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    int condition;
+    if (!compiler.CompileOperand(m_condition, condition)) return false;
+    result = compiler.AllocTemp();
+    int jumpElse = compiler.EmitJump(condition);
+
+    int value;
+    if (!compiler.CompileOperand(m_op1, value)) return false;
+    compiler.EmitMove(result, value);
+    int jumpEnd = compiler.EmitJump();
+
+    compiler.SetJumpTarget(jumpElse);
+    if (!compiler.CompileOperand(m_op2, value)) return false;
+    compiler.EmitMove(result, value);
+
+    compiler.SetJumpTarget(jumpEnd);
+    return true;
+}
+
 std::map<std::string, CBotInstr*> CBotLogicExpr::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
@@ -18,6 +18,8 @@
  */
 
 #include "CBot/CBotInstr/CBotPostIncExpr.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotExprVar.h"
 
 #include "CBot/CBotStack.h"
@@ -85,6 +87,18 @@ void CBotPostIncExpr::RestoreState(CBotStack* &pj, bool bMain)
     if (pile1 != nullptr) pile1->RestoreStack(this);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotPostIncExpr::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    bool discard = compiler.IsDiscarded(this);
+
+    int variable;
+    if (!static_cast<CBotExprVar*>(m_instr)->CompileBytecodeVar(compiler, variable)) return false;
+
+    result = compiler.EmitIncrement(GetTokenType(), variable, true, &m_token, discard);
+    return true;
+}
+
 std::map<std::string, CBotInstr*> CBotPostIncExpr::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
@@ -18,6 +18,8 @@
  */
 
 #include "CBot/CBotInstr/CBotPreIncExpr.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotExprVar.h"
 
 #include "CBot/CBotStack.h"
@@ -93,6 +95,18 @@ void CBotPreIncExpr::RestoreState(CBotStack* &pj, bool bMain)
     m_instr->RestoreState(pile, bMain);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotPreIncExpr::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    bool discard = compiler.IsDiscarded(this);
+
+    int variable;
+    if (!static_cast<CBotExprVar*>(m_instr)->CompileBytecodeVar(compiler, variable)) return false;
+
+    result = compiler.EmitIncrement(GetTokenType(), variable, false, &m_token, discard);
+    return true;
+}
+
 std::map<std::string, CBotInstr*> CBotPreIncExpr::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
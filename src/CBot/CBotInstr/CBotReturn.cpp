@@ -19,6 +19,8 @@
 
 #include "CBot/CBotInstr/CBotReturn.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotInstr/CBotInstrUtils.h"
 
 #include "CBot/CBotInstr/CBotExpression.h"
@@ -116,6 +118,16 @@ bool CBotReturn::HasReturn()
     return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotReturn::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    int value = -1;
+    if (m_instr != nullptr && !compiler.CompileOperand(m_instr, value)) return false;
+
+    compiler.EmitReturn(value);
+    return true;
+}
+
 std::map<std::string, CBotInstr*> CBotReturn::GetDebugLinks()
 {
     auto links = CBotInstr::GetDebugLinks();
@@ -55,6 +55,8 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result) override;
+
     /*!
      * \brief Always returns true.
      * \return true to signal a return statment has been found.
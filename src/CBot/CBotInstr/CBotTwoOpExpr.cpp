@@ -19,16 +19,21 @@
 
 #include "CBot/CBotInstr/CBotTwoOpExpr.h"
 
+#include "CBot/CBotBytecode.h"
+
 #include "CBot/CBotInstr/CBotInstrUtils.h"
 
 #include "CBot/CBotInstr/CBotParExpr.h"
 #include "CBot/CBotInstr/CBotLogicExpr.h"
 #include "CBot/CBotInstr/CBotExpression.h"
+#include "CBot/CBotInstr/CBotExprLitNum.h"
 
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
 
 #include "CBot/CBotVar/CBotVar.h"
+#include "CBot/CBotVar/CBotVarFloat.h"
+#include "CBot/CBotVar/CBotVarInt.h"
 
 #include <cassert>
 #include <algorithm>
@@ -253,6 +258,7 @@ CBotInstr* CBotTwoOpExpr::Compile(CBotToken* &p, CBotCStack* pStack, int* pOpera
             {
                 // ok so, saves the operand in the object
                 inst->m_leftop = left;
+                inst->m_operandType = GetNumericType(typeOp, type1, type2);
 
                 // special for evaluation of the operations of the same level from left to right
                 while ( IsInList(p->GetType(), pOperations, typeMask) ) // same operation(s) follows?
@@ -273,6 +279,7 @@ CBotInstr* CBotTwoOpExpr::Compile(CBotToken* &p, CBotCStack* pStack, int* pOpera
                         delete i;
                         return pStack->Return(nullptr, pStk);
                     }
+                    i->m_operandType = GetNumericType(typeOp, type1, type2);
 
                     if ( TypeRes != CBotTypString )                     // keep string conversion
                         TypeRes = std::max(type1.GetType(), type2.GetType());
@@ -284,8 +291,8 @@ CBotInstr* CBotTwoOpExpr::Compile(CBotToken* &p, CBotCStack* pStack, int* pOpera
                 // is a variable on the stack for the type of result
                 pStk->SetVar(CBotVar::Create("", t));
 
-                // and returns the requested object
-                return pStack->Return(inst, pStk);
+                // and returns the requested object, computed now if it only uses constants
+                return pStack->Return(FoldConstants(inst), pStk);
             }
             pStk->SetError(CBotErrBadType2, &inst->m_token);
         }
@@ -319,6 +326,68 @@ bool IsNan(CBotVar* left, CBotVar* right, CBotError* err = nullptr)
     return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+CBotType CBotTwoOpExpr::GetNumericType(int op, const CBotTypResult& type1, const CBotTypResult& type2)
+{
+    CBotType type;
+    if ( type1.Eq(CBotTypInt) && type2.Eq(CBotTypInt) ) type = CBotTypInt;
+    else if ( type1.Eq(CBotTypFloat) && type2.Eq(CBotTypFloat) ) type = CBotTypFloat;
+    else return CBotTypVoid;
+
+    switch (op)
+    {
+    case ID_ADD:
+    case ID_SUB:
+    case ID_MUL:
+    case ID_LO:
+    case ID_HI:
+    case ID_LS:
+    case ID_HS:
+    case ID_EQ:
+    case ID_NE:
+        return type;
+    case ID_DIV:
+        // the division of integers gives a float, see Compute()
+        return type == CBotTypFloat ? type : CBotTypVoid;
+    default:
+        return CBotTypVoid;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotInstr* CBotTwoOpExpr::FoldConstants(CBotTwoOpExpr* inst)
+{
+    // operations of the same level are chained on the left, see Compile()
+    CBotTwoOpExpr* chain = dynamic_cast<CBotTwoOpExpr*>(inst->m_leftop);
+    if ( chain != nullptr ) inst->m_leftop = FoldConstants(chain);
+
+    CBotExprLitNum* leftLit  = dynamic_cast<CBotExprLitNum*>(inst->m_leftop);
+    CBotExprLitNum* rightLit = dynamic_cast<CBotExprLitNum*>(inst->m_rightop);
+    if ( leftLit == nullptr || rightLit == nullptr ) return inst;
+
+    CBotVar*    left   = leftLit->CreateVar();
+    CBotVar*    right  = rightLit->CreateVar();
+    CBotError   err    = CBotNoErr;
+    CBotVar*    result = Compute(inst->GetTokenType(), left, right, err);
+
+    // errors (division by zero) are left for the execution, and only numbers can be literals
+    CBotInstr*  folded = nullptr;
+    if ( err == CBotNoErr )
+    {
+        CBotToken token(inst->m_token);
+        token.SetPos(leftLit->GetToken()->GetStart(), rightLit->GetToken()->GetEnd());
+        folded = CBotExprLitNum::Create(result, &token);
+    }
+
+    delete left;
+    delete right;
+    delete result;
+
+    if ( folded == nullptr ) return inst;
+    delete inst;
+    return folded;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotTwoOpExpr::Execute(CBotStack* &pStack)
 {
@@ -367,24 +436,42 @@ bool CBotTwoOpExpr::Execute(CBotStack* &pStack)
     }
 
     assert(pStk1->GetVar() != nullptr && pStk2->GetVar() != nullptr);
-    CBotTypResult       type1 = pStk1->GetVar()->GetTypResult();      // what kind of results?
-    CBotTypResult       type2 = pStk2->GetVar()->GetTypResult();
 
     CBotStack* pStk3 = pStk2->AddStack(this);               // adds an item to the stack
     if ( pStk3->IfStep() ) return false;                    // shows the operation if step by step
 
+    // operands of simple types are computed in place when possible
+    if ( m_operandType != CBotTypVoid && ExecuteNumeric(pStk1->GetVar(), pStk2) )
+        return pStack->Return(pStk2);
+
+    CBotError err = CBotNoErr;
+    CBotVar*    result = Compute(GetTokenType(), pStk1->GetVar(), pStk2->GetVar(), err);
+
+    pStk2->SetVar(result);                      // puts the result on the stack
+    if ( err ) pStk2->SetError(err, &m_token);  // and the possible error (division by zero)
+
+//  pStk1->Return(pStk2);                       // releases the stack
+    return pStack->Return(pStk2);               // transmits the result
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotVar* CBotTwoOpExpr::Compute(int op, CBotVar* left, CBotVar* right, CBotError& err)
+{
+    CBotTypResult       type1 = left->GetTypResult();      // what kind of results?
+    CBotTypResult       type2 = right->GetTypResult();
+
     // creates a temporary variable to put the result
     // what kind of result?
     int TypeRes = std::max(type1.GetType(), type2.GetType());
 
     // see "any type convertible chain" in compile method
-    if ( GetTokenType() == ID_ADD &&
+    if ( op == ID_ADD &&
         (type1.Eq(CBotTypString) || type2.Eq(CBotTypString)) )
     {
         TypeRes = CBotTypString;
     }
 
-    switch ( GetTokenType() )
+    switch ( op )
     {
     case ID_LOG_OR:
     case ID_LOG_AND:
@@ -409,7 +496,7 @@ bool CBotTwoOpExpr::Execute(CBotStack* &pStack)
     if ( TypeRes != CBotTypString )                                     // keep string conversion
         TypeRes = std::max(type1.GetType(), type2.GetType());
 
-    if ( GetTokenType() == ID_ADD && type1.Eq(CBotTypString) )
+    if ( op == ID_ADD && type1.Eq(CBotTypString) )
     {
         TypeRes = CBotTypString;
     }
@@ -420,12 +507,8 @@ bool CBotTwoOpExpr::Execute(CBotStack* &pStack)
     if ( TypeRes == CBotTypClass ) temp = CBotVar::Create("", CBotTypResult(CBotTypIntrinsic, type1.GetClass() ) );
     else                           temp = CBotVar::Create("", TypeRes );
 
-    CBotError err = CBotNoErr;
     // is a operation according to request
-    CBotVar*    left  = pStk1->GetVar();
-    CBotVar*    right = pStk2->GetVar();
-
-    switch (GetTokenType())
+    switch (op)
     {
     case ID_ADD:
         if ( !IsNan(left, right, &err) )    result->Add(left , right);      // addition
@@ -500,11 +583,69 @@ bool CBotTwoOpExpr::Execute(CBotStack* &pStack)
     }
     delete temp;
 
-    pStk2->SetVar(result);                      // puts the result on the stack
-    if ( err ) pStk2->SetError(err, &m_token);  // and the possible error (division by zero)
+    return result;
+}
 
-//  pStk1->Return(pStk2);                       // releases the stack
-    return pStack->Return(pStk2);               // transmits the result
+////////////////////////////////////////////////////////////////////////////////
+float CBotTwoOpExpr::GetNumericValue(CBotVar* var) const
+{
+    if ( m_operandType == CBotTypInt ) return static_cast<float>(static_cast<CBotVarInt*>(var)->m_val);
+    return static_cast<CBotVarFloat*>(var)->m_val;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotTwoOpExpr::ExecuteNumeric(CBotVar* left, CBotStack* pStk2)
+{
+    CBotVar*    right = pStk2->GetVar();
+
+    // anything unexpected (like nan) goes through Compute()
+    if ( left->GetType() != m_operandType || right->GetType() != m_operandType ) return false;
+    if ( !left->IsDefined() || !right->IsDefined() ) return false;
+
+    // same computations as CBotVarNumber, which works on floats
+    float   l = GetNumericValue(left);
+    float   r = GetNumericValue(right);
+    float   value;
+    switch (GetTokenType())
+    {
+    case ID_ADD:
+        value = l + r;
+        break;
+    case ID_SUB:
+        value = l - r;
+        break;
+    case ID_MUL:
+        value = l * r;
+        break;
+    case ID_DIV:
+        if ( r == 0 ) return false;                 // the error is set by Compute()
+        value = l / r;
+        break;
+    default:
+    {
+        bool test = false;
+        switch (GetTokenType())
+        {
+        case ID_LO: test = l <  r; break;
+        case ID_HI: test = l >  r; break;
+        case ID_LS: test = l <= r; break;
+        case ID_HS: test = l >= r; break;
+        case ID_EQ: test = l == r; break;
+        case ID_NE: test = l != r; break;
+        default:
+            assert(0);
+        }
+        CBotVar*    result = CBotVar::Create("", CBotTypBoolean);
+        result->SetValInt(test);
+        pStk2->SetVar(result);
+        return true;
+    }
+    }
+
+    // the right operand is a temporary value owned by the stack, it becomes the result
+    if ( m_operandType == CBotTypInt ) right->SetValInt(static_cast<int>(value));
+    else                               right->SetValFloat(value);
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -533,6 +674,33 @@ void CBotTwoOpExpr::RestoreState(CBotStack* &pStack, bool bMain)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotTwoOpExpr::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    int left;
+    if (!compiler.CompileOperand(m_leftop, left)) return false;
+    left = compiler.KeepOperand(this, 0, left);
+
+    // for OR and AND logic, the right operand is evaluated only if necessary
+    int jumpEnd = -1;
+    int type = GetTokenType();
+    if (type == ID_LOG_AND || type == ID_TXT_AND || type == ID_LOG_OR || type == ID_TXT_OR)
+    {
+        bool isOr = (type == ID_LOG_OR || type == ID_TXT_OR);
+        result = compiler.AllocTemp();
+        compiler.EmitMove(result, compiler.AddConstant(isOr));
+        jumpEnd = compiler.EmitJump(left, isOr);
+    }
+
+    int right;
+    if (!compiler.CompileOperand(m_rightop, right)) return false;
+    compiler.EndOperands(this);
+
+    result = compiler.EmitBinary(type, left, right, &m_token, jumpEnd >= 0 ? result : -1);
+    compiler.SetJumpTarget(jumpEnd);
+    return result >= 0;
+}
+
 std::string CBotTwoOpExpr::GetDebugData()
 {
     return m_token.GetString();
@@ -81,16 +81,56 @@ public:
      */
     void RestoreState(CBotStack* &pj, bool bMain) override;
 
+    bool CompileBytecode(CBotBytecodeCompiler& compiler, int& result) override;
+
 protected:
     virtual const std::string GetDebugName() override { return "CBotTwoOpExpr"; }
     virtual std::string GetDebugData() override;
     virtual std::map<std::string, CBotInstr*> GetDebugLinks() override;
 
+private:
+    /*!
+     * \brief Performs the operation on the values of the operands
+     * \param op The operation (::TokenId)
+     * \param left The left operand
+     * \param right The right operand
+     * \param[out] err Error of the operation (like division by zero)
+     * \return New variable holding the result
+     */
+    static CBotVar* Compute(int op, CBotVar* left, CBotVar* right, CBotError& err);
+
+    /*!
+     * \brief Type of the operands if the operation can be done by ExecuteNumeric()
+     * \return ::CBotTypInt or ::CBotTypFloat, ::CBotTypVoid if the operation has to use Compute()
+     */
+    static CBotType GetNumericType(int op, const CBotTypResult& type1, const CBotTypResult& type2);
+
+    /*!
+     * \brief Replaces the operation by a literal if both operands are number literals
+     * \param inst The operation, deleted if it was replaced
+     * \return The literal, or inst if it cannot be computed at compile time
+     */
+    static CBotInstr* FoldConstants(CBotTwoOpExpr* inst);
+
+    /*!
+     * \brief Performs the operation directly on the values of int or float operands
+     *
+     * The result replaces the right operand on pStk2.
+     *
+     * \param left The left operand
+     * \param pStk2 Stack holding the right operand
+     * \return false if the operands are not as expected at compile time, or the operation would fail
+     */
+    bool ExecuteNumeric(CBotVar* left, CBotStack* pStk2);
+    float GetNumericValue(CBotVar* var) const;
+
 private:
     //! Left element
     CBotInstr* m_leftop;
     //! Right element
     CBotInstr* m_rightop;
+    //! Type of both operands for ExecuteNumeric(), ::CBotTypVoid if not used (see GetNumericType())
+    CBotType m_operandType = CBotTypVoid;
 };
 
 } // namespace CBot
@@ -18,6 +18,8 @@
  */
 
 #include "CBot/CBotInstr/CBotWhile.h"
+
+#include "CBot/CBotBytecode.h"
 #include "CBot/CBotInstr/CBotBlock.h"
 #include "CBot/CBotInstr/CBotCondition.h"
 
@@ -149,6 +151,24 @@ void CBotWhile::RestoreState(CBotStack* &pj, bool bMain)
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+bool CBotWhile::CompileBytecode(CBotBytecodeCompiler& compiler, int& result)
+{
+    compiler.BeginLoop(m_label);
+    int start = compiler.GetPosition();
+
+    int condition;
+    if (!compiler.CompileOperand(m_condition, condition)) return false;
+    int jumpEnd = compiler.EmitJump(condition);
+
+    if (m_block != nullptr && !compiler.CompileStatement(m_block)) return false;
+    compiler.EmitJumpTo(start);
+
+    compiler.SetJumpTarget(jumpEnd);
+    compiler.EndLoop(start);
+    return true;
+}
+
 std::string CBotWhile::GetDebugData()
 {
     return !m_label.empty() ? "m_label = "+m_label : "";
@@ -0,0 +1,218 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "CBot/CBotMemoryPool.h"
+
+#include <new>
+
+namespace CBot
+{
+
+namespace
+{
+const std::size_t GRANULARITY = 16;
+const std::size_t MAX_POOLED_SIZE = 256;
+const int SIZE_CLASSES = MAX_POOLED_SIZE / GRANULARITY;
+//! Maximum number of free blocks kept for each size class
+const int MAX_FREE_BLOCKS = 1024;
+//! Maximum number of free stack blocks
+const int MAX_FREE_STACKS = 4;
+
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+struct FreeStack
+{
+    void* ptr;
+    std::size_t size;
+};
+
+/**
+ * Free lists of one thread
+ *
+ * This has to be trivially destructible so that it stays usable while other thread_local
+ * and static objects are destroyed (they may still free variables). The cached memory is
+ * released by ThreadPoolGuard instead.
+ */
+struct ThreadPool
+{
+    FreeBlock* freeBlocks[SIZE_CLASSES] = {};
+    int freeCount[SIZE_CLASSES] = {};
+    FreeStack freeStacks[MAX_FREE_STACKS] = {};
+    int freeStackCount = 0;
+    bool guardInitialized = false;
+    bool destroyed = false;
+    CBotAllocationStats stats;
+};
+
+thread_local ThreadPool g_pool;
+
+void ReleaseAll()
+{
+    for (int i = 0; i < SIZE_CLASSES; i++)
+    {
+        while (g_pool.freeBlocks[i] != nullptr)
+        {
+            FreeBlock* block = g_pool.freeBlocks[i];
+            g_pool.freeBlocks[i] = block->next;
+            ::operator delete(block);
+        }
+        g_pool.freeCount[i] = 0;
+    }
+    for (int i = 0; i < g_pool.freeStackCount; i++)
+    {
+        ::operator delete(g_pool.freeStacks[i].ptr);
+    }
+    g_pool.freeStackCount = 0;
+}
+
+struct ThreadPoolGuard
+{
+    void Touch() {}
+
+    ~ThreadPoolGuard()
+    {
+        ReleaseAll();
+        g_pool.destroyed = true;    // from now on, everything goes straight back to the heap
+    }
+};
+
+thread_local ThreadPoolGuard g_poolGuard;
+
+//! Returns false if no more memory should be cached on this thread
+bool CanCache()
+{
+    if (g_pool.destroyed) return false;
+    if (!g_pool.guardInitialized)
+    {
+        g_pool.guardInitialized = true;
+        g_poolGuard.Touch();    // makes sure the cache is released when the thread ends
+    }
+    return true;
+}
+
+int GetSizeClass(std::size_t size)
+{
+    return (size + GRANULARITY - 1) / GRANULARITY - 1;
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void* CBotMemoryPool::Allocate(std::size_t size)
+{
+    g_pool.stats.allocations++;
+    if (size > MAX_POOLED_SIZE || size == 0)
+    {
+        g_pool.stats.heapAllocations++;
+        return ::operator new(size);
+    }
+
+    int sizeClass = GetSizeClass(size);
+    FreeBlock* block = g_pool.freeBlocks[sizeClass];
+    if (block != nullptr)
+    {
+        g_pool.freeBlocks[sizeClass] = block->next;
+        g_pool.freeCount[sizeClass]--;
+        return block;
+    }
+
+    g_pool.stats.heapAllocations++;
+    return ::operator new((sizeClass + 1) * GRANULARITY);
+}
+
+void CBotMemoryPool::Free(void* ptr, std::size_t size)
+{
+    if (ptr == nullptr) return;
+    g_pool.stats.frees++;
+
+    if (size > MAX_POOLED_SIZE || size == 0 || !CanCache())
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    int sizeClass = GetSizeClass(size);
+    if (g_pool.freeCount[sizeClass] >= MAX_FREE_BLOCKS)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = g_pool.freeBlocks[sizeClass];
+    g_pool.freeBlocks[sizeClass] = block;
+    g_pool.freeCount[sizeClass]++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void* CBotMemoryPool::AllocateStack(std::size_t size)
+{
+    g_pool.stats.stackAllocations++;
+    for (int i = g_pool.freeStackCount - 1; i >= 0; i--)
+    {
+        if (g_pool.freeStacks[i].size != size) continue;
+
+        void* ptr = g_pool.freeStacks[i].ptr;
+        g_pool.freeStackCount--;
+        g_pool.freeStacks[i] = g_pool.freeStacks[g_pool.freeStackCount];
+        return ptr;
+    }
+
+    g_pool.stats.stackHeapAllocations++;
+    return ::operator new(size);
+}
+
+void CBotMemoryPool::FreeStack(void* ptr, std::size_t size)
+{
+    if (ptr == nullptr) return;
+
+    if (!CanCache())
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    if (g_pool.freeStackCount >= MAX_FREE_STACKS)
+    {
+        // drop the oldest one
+        ::operator delete(g_pool.freeStacks[0].ptr);
+        for (int i = 1; i < g_pool.freeStackCount; i++)
+            g_pool.freeStacks[i - 1] = g_pool.freeStacks[i];
+        g_pool.freeStackCount--;
+    }
+
+    g_pool.freeStacks[g_pool.freeStackCount].ptr = ptr;
+    g_pool.freeStacks[g_pool.freeStackCount].size = size;
+    g_pool.freeStackCount++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CBotAllocationStats CBotMemoryPool::GetStats()
+{
+    return g_pool.stats;
+}
+
+void CBotMemoryPool::ResetStats()
+{
+    g_pool.stats = CBotAllocationStats();
+}
+
+} // namespace CBot
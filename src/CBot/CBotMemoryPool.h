@@ -0,0 +1,96 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace CBot
+{
+
+/**
+ * \brief Allocation counters of CBotMemoryPool
+ *
+ * Only allocations going through the pool are counted.
+ */
+struct CBotAllocationStats
+{
+    //! Number of objects allocated
+    long long allocations = 0;
+    //! Number of objects freed
+    long long frees = 0;
+    //! Number of allocations which had to go to the heap because there was no free block to reuse
+    long long heapAllocations = 0;
+    //! Number of stack blocks allocated (see CBotStack::AllocateStack())
+    long long stackAllocations = 0;
+    //! Number of stack block allocations which had to go to the heap
+    long long stackHeapAllocations = 0;
+};
+
+/**
+ * \brief Recycles the memory of short-lived interpreter objects
+ *
+ * Temporary variables (CBotVarInt, CBotVarFloat, CBotVarBoolean, CBotVarString), their name tokens and
+ * execution stacks are created and destroyed all the time while a program runs. Instead of going back
+ * to the heap, freed memory is kept in free lists and handed out again by the next allocation of the same size.
+ *
+ * Free lists are kept per thread, so no locking is needed. Memory allocated on one thread may be freed on
+ * another one (programs can move between threads, see CBotExecutionContext) - it simply ends up in the
+ * free list of that thread. The number of cached blocks is limited, everything above goes back to the heap.
+ */
+class CBotMemoryPool
+{
+public:
+    /**
+     * \brief Allocate memory for a small object
+     * \param size Size of the object in bytes
+     * \return Pointer to the memory, never nullptr
+     */
+    static void* Allocate(std::size_t size);
+    /**
+     * \brief Free memory allocated with Allocate()
+     * \param ptr Pointer returned by Allocate()
+     * \param size The same size that was passed to Allocate()
+     */
+    static void Free(void* ptr, std::size_t size);
+
+    /**
+     * \brief Allocate memory for an execution stack
+     *
+     * Stacks are big, so only a few blocks are kept, for the sizes that were freed last.
+     * The memory is not cleared.
+     *
+     * \param size Size of the block in bytes
+     * \return Pointer to the memory, never nullptr
+     */
+    static void* AllocateStack(std::size_t size);
+    /**
+     * \brief Free memory allocated with AllocateStack()
+     * \param ptr Pointer returned by AllocateStack()
+     * \param size The same size that was passed to AllocateStack()
+     */
+    static void FreeStack(void* ptr, std::size_t size);
+
+    //! Returns the allocation counters of the calling thread
+    static CBotAllocationStats GetStats();
+    //! Resets the allocation counters of the calling thread
+    static void ResetStats();
+};
+
+} // namespace CBot
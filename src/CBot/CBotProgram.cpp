@@ -20,6 +20,7 @@
 #include "CBot/CBotVar/CBotVar.h"
 
 #include "CBot/CBotExternalCall.h"
+#include "CBot/CBotExecutionContext.h"
 #include "CBot/CBotStack.h"
 #include "CBot/CBotCStack.h"
 #include "CBot/CBotClass.h"
@@ -35,42 +36,84 @@
 namespace CBot
 {
 
+struct CBotProgram::SharedFunctions
+{
+    std::list<CBotFunction*> functions;
+    std::vector<std::string> externFunctions;
+
+    ~SharedFunctions()
+    {
+        for (CBotFunction* f : functions) delete f;
+    }
+};
+
 CBotExternalCallList* CBotProgram::m_externalCalls = new CBotExternalCallList();
+std::unordered_map<std::string, std::weak_ptr<CBotProgram::SharedFunctions>> CBotProgram::m_sharedFunctionsCache;
+std::mutex CBotProgram::m_sharedFunctionsMutex;
+std::atomic<long> CBotProgram::m_definitionsRevision(0);
+std::atomic<long> CBotProgram::m_instancesThreadSafe(-1);
 
 CBotProgram::CBotProgram()
+: m_ownContext(new CBotExecutionContext())
 {
+    m_context = m_ownContext.get();
 }
 
 CBotProgram::CBotProgram(CBotVar* thisVar)
-: m_thisVar(thisVar)
+: m_thisVar(thisVar),
+  m_ownContext(new CBotExecutionContext())
 {
+    m_context = m_ownContext.get();
 }
 
 CBotProgram::~CBotProgram()
 {
-//  delete  m_classes;
-    for (CBotClass* c : m_classes)
-        c->Purge();
-    m_classes.clear();
+    ReleaseCode();
 
     CBotClass::FreeLock(this);
-
-    for (CBotFunction* f : m_functions) delete f;
-    m_functions.clear();
 }
 
-bool CBotProgram::Compile(const std::string& program, std::vector<std::string>& externFunctions, void* pUser)
+void CBotProgram::ReleaseCode()
 {
-    // Cleanup the previously compiled program
-    Stop();
+    if (HasPublicDefinitions())
+        m_definitionsRevision++;
 
     for (CBotClass* c : m_classes)
         c->Purge();      // purge the old definitions of classes
                          // but without destroying the object
-
     m_classes.clear();
-    for (CBotFunction* f : m_functions) delete f;
+
+    if (m_sharedFunctions == nullptr)
+    {
+        for (CBotFunction* f : m_functions) delete f;
+    }
+    m_sharedFunctions.reset();
     m_functions.clear();
+}
+
+bool CBotProgram::HasPublicDefinitions()
+{
+    if (!m_classes.empty()) return true;
+    return std::any_of(m_functions.begin(), m_functions.end(), [](CBotFunction* f) { return f->IsPublic(); });
+}
+
+bool CBotProgram::AreInstancesThreadSafe()
+{
+    // Classes only change along with the revision, checking them is only needed once per revision
+    long revision = m_definitionsRevision;
+    long cached = m_instancesThreadSafe;
+    if (cached >= 0 && cached/2 == revision) return cached%2 != 0;
+
+    bool safe = CBotClass::AreInstancesThreadSafe();
+    m_instancesThreadSafe = revision*2 + (safe ? 1 : 0);
+    return safe;
+}
+
+bool CBotProgram::Compile(const std::string& program, std::vector<std::string>& externFunctions, void* pUser)
+{
+    // Cleanup the previously compiled program
+    Stop();
+    ReleaseCode();
 
     externFunctions.clear();
     m_error = CBotNoErr;
@@ -113,6 +156,8 @@ bool CBotProgram::Compile(const std::string& program, std::vector<std::string>&
         m_error = pStack->GetError(m_errorStart, m_errorEnd);
         for (CBotFunction* f : m_functions) delete f;
         m_functions.clear();
+        if (HasPublicDefinitions())
+            m_definitionsRevision++;
         return false;
     }
 
@@ -144,10 +189,66 @@ bool CBotProgram::Compile(const std::string& program, std::vector<std::string>&
         for (CBotFunction* f : m_functions) delete f;
         m_functions.clear();
     }
+    else
+    {
+        // Step 4. Lowering into bytecode, done even if it is not enabled yet so that
+        // the program can be switched to it later and saved states can be restored either way
+        for (CBotFunction* f : m_functions) f->CompileBytecode();
+    }
+
+    if (HasPublicDefinitions())
+        m_definitionsRevision++;
 
     return !m_functions.empty();
 }
 
+bool CBotProgram::CompileShared(const std::string& program, std::vector<std::string>& externFunctions, void* pUser, const std::string& context)
+{
+    std::string key = context + '\0' + std::to_string(m_definitionsRevision) + '\0' + program;
+
+    std::shared_ptr<SharedFunctions> shared;
+    {
+        std::lock_guard<std::mutex> lock(m_sharedFunctionsMutex);
+        auto it = m_sharedFunctionsCache.find(key);
+        if (it != m_sharedFunctionsCache.end())
+            shared = it->second.lock();
+    }
+
+    if (shared != nullptr)
+    {
+        Stop();
+        ReleaseCode();
+
+        m_sharedFunctions = shared;
+        m_functions = shared->functions;
+        externFunctions = shared->externFunctions;
+        m_error = CBotNoErr;
+        return true;
+    }
+
+    if (!Compile(program, externFunctions, pUser)) return false;
+    if (HasPublicDefinitions()) return true;
+
+    // The functions now run in the program calling them
+    for (CBotFunction* f : m_functions) f->m_pProg = nullptr;
+
+    shared = std::make_shared<SharedFunctions>();
+    shared->functions = m_functions;
+    shared->externFunctions = externFunctions;
+    m_sharedFunctions = shared;
+
+    std::lock_guard<std::mutex> lock(m_sharedFunctionsMutex);
+    for (auto it = m_sharedFunctionsCache.begin(); it != m_sharedFunctionsCache.end();)
+    {
+        if (it->second.expired())
+            it = m_sharedFunctionsCache.erase(it);
+        else
+            ++it;
+    }
+    m_sharedFunctionsCache[key] = shared;
+    return true;
+}
+
 bool CBotProgram::Start(const std::string& name)
 {
     Stop();
@@ -160,7 +261,7 @@ bool CBotProgram::Start(const std::string& name)
     }
     m_entryPoint = *it;
 
-    m_stack = CBotStack::AllocateStack();
+    m_stack = CBotStack::AllocateStack(m_context);
     m_stack->SetProgram(this);
 
     return true; // we are ready for Run()
@@ -185,12 +286,21 @@ bool CBotProgram::Run(void* pUser, int timer)
 
     m_error = CBotNoErr;
 
+    // stacks created during execution (destructors, ...) share our context
+    CBotExecutionContext::Scope scope(m_context);
+
     m_stack->SetUserPtr(pUser);
-    if ( timer >= 0 ) m_stack->SetTimer(timer); // TODO: Check if changing order here fixed ipf()
+    if ( timer >= 0 ) m_context->SetTimerLimit(timer); // TODO: Check if changing order here fixed ipf()
     m_stack->Reset();                         // reset the possible previous error, and resets the timer
 
     m_stack->SetProgram(this);                     // bases for routines
 
+    // destructors and field initializers can't be interrupted, if one may run
+    // more than constants the whole program is deferred to the main thread
+    if (m_context->GetDeferExternalAccess() && !AreInstancesThreadSafe() && !m_stack->CanAccessExternal()) return false;
+
+    long long instructionCount = m_context->GetInstructionCount();
+
     // resumes execution on the top of the stack
     bool ok = m_stack->Execute();
     if (ok)
@@ -199,6 +309,8 @@ bool CBotProgram::Run(void* pUser, int timer)
         ok = m_entryPoint->Execute(nullptr, m_stack, m_thisVar);
     }
 
+    m_instructionCount += m_context->GetInstructionCount() - instructionCount;
+
     // completed on a mistake?
     if (ok || !m_stack->IsOk())
     {
@@ -217,6 +329,7 @@ void CBotProgram::Stop()
 {
     if (m_stack != nullptr)
     {
+        CBotExecutionContext::Scope scope(m_context);
         m_stack->Delete();
         m_stack = nullptr;
     }
@@ -224,6 +337,32 @@ void CBotProgram::Stop()
     CBotClass::FreeLock(this);
 }
 
+void CBotProgram::SetExecutionContext(CBotExecutionContext* context)
+{
+    Stop();
+    m_context = context != nullptr ? context : m_ownContext.get();
+}
+
+CBotExecutionContext* CBotProgram::GetExecutionContext()
+{
+    return m_context;
+}
+
+long long CBotProgram::GetInstructionCount()
+{
+    return m_instructionCount;
+}
+
+void CBotProgram::EnableBytecode(bool enable)
+{
+    m_bytecode = enable;
+}
+
+bool CBotProgram::IsBytecodeEnabled()
+{
+    return m_bytecode;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotProgram::GetRunPos(std::string& functionName, int& start, int& end)
 {
@@ -320,14 +459,19 @@ bool rSizeOf( CBotVar* pVar, CBotVar* pResult, int& ex, void* pUser )
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotProgram::AddFunction(const std::string& name,
                               bool rExec(CBotVar* pVar, CBotVar* pResult, int& Exception, void* pUser),
-                              CBotTypResult rCompile(CBotVar*& pVar, void* pUser))
+                              CBotTypResult rCompile(CBotVar*& pVar, void* pUser),
+                              bool threadSafe)
 {
-    return m_externalCalls->AddFunction(name, std::unique_ptr<CBotExternalCall>(new CBotExternalCallDefault(rExec, rCompile)));
+    auto call = std::unique_ptr<CBotExternalCall>(new CBotExternalCallDefault(rExec, rCompile));
+    call->SetThreadSafe(threadSafe);
+    m_definitionsRevision++;
+    return m_externalCalls->AddFunction(name, std::move(call));
 }
 
 bool CBotProgram::DefineNum(const std::string& name, long val)
 {
     CBotToken::DefineNum(name, val);
+    m_definitionsRevision++;
     return true;
 }
 
@@ -373,7 +517,7 @@ bool CBotProgram::RestoreState(FILE* pf)
     }
 
     // retrieves the stack from the memory
-    m_stack = CBotStack::AllocateStack();
+    m_stack = CBotStack::AllocateStack(m_context);
     if (!m_stack->RestoreState(pf, m_stack)) return false;
     m_stack->SetProgram(this);                     // bases for routines
 
@@ -404,7 +548,7 @@ void CBotProgram::Init()
     CBotProgram::DefineNum("CBotErrStackOver",  CBotErrStackOver);   // Stack overflow
     CBotProgram::DefineNum("CBotErrDeletedPtr", CBotErrDeletedPtr);  // Attempted to use deleted object
 
-    CBotProgram::AddFunction("sizeof", rSizeOf, cSizeOf);
+    CBotProgram::AddFunction("sizeof", rSizeOf, cSizeOf, true);
 
     InitStringFunctions();
     InitMathFunctions();
@@ -413,6 +557,7 @@ void CBotProgram::Init()
 
 void CBotProgram::Free()
 {
+    m_definitionsRevision++;
     CBotToken::ClearDefineNum();
     m_externalCalls->Clear();
     CBotClass::ClearPublic();
@@ -22,8 +22,13 @@
 #include "CBot/CBotTypResult.h"
 #include "CBot/CBotEnums.h"
 
+#include <atomic>
 #include <vector>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace CBot
 {
@@ -33,6 +38,7 @@ class CBotClass;
 class CBotStack;
 class CBotVar;
 class CBotExternalCallList;
+class CBotExecutionContext;
 
 /**
  * \brief Class that manages a CBot program. This is the main entry point into the CBot engine.
@@ -132,6 +138,26 @@ public:
      */
     bool Compile(const std::string& program, std::vector<std::string>& externFunctions, void* pUser = nullptr);
 
+    /**
+     * \brief Compile the program, reusing the functions of a program compiled before from the same code
+     *
+     * Instruction trees are never changed while running, everything a running program changes
+     * is kept in its CBotStack. So programs compiled from the same code in the same context can
+     * share their functions, instead of each of them compiling its own copy.
+     *
+     * Only programs without classes and public functions are shared, as these are registered
+     * for all programs. Anything else is simply compiled with Compile().
+     *
+     * \param program Code to compile
+     * \param[out] externFunctions Returns the names of functions declared as extern
+     * \param pUser Optional pointer to be passed to compile function (see AddFunction())
+     * \param context Anything else than the code that changes the result of compilation,
+     *                like what the compile functions of external calls check in pUser
+     * \return true if compilation is successful, false if an compilation error occurs
+     * \see GetError() to retrieve the error
+     */
+    bool CompileShared(const std::string& program, std::vector<std::string>& externFunctions, void* pUser, const std::string& context);
+
     /**
      * \brief Returns the last error
      * \return Error code
@@ -172,12 +198,48 @@ public:
      * \param timer
      * \parblock
      * * timer < 0 do nothing
-     * * timer >= 0 call SetTimer(int timer) before executing
+     * * timer >= 0 use this timer for this and all following Run() calls (see CBotExecutionContext::SetTimerLimit())
      * \endparblock
      * \return true if the program execution finished, false if the program is suspended (you then have to call Run() again)
+     *
+     * Programs using different execution contexts can be run at the same time on different threads.
      */
     bool Run(void* pUser = nullptr, int timer = -1);
 
+    /**
+     * \brief Sets the execution context used to run this program
+     *
+     * By default, each program owns its own context. Programs sharing a context must not be run at the same time.
+     * Stops the program if it is running.
+     *
+     * \param context Context to borrow, it has to outlive this program; nullptr to use the program's own context again
+     */
+    void SetExecutionContext(CBotExecutionContext* context);
+    /**
+     * \brief Returns the execution context used to run this program
+     */
+    CBotExecutionContext* GetExecutionContext();
+
+    /**
+     * \brief Returns the number of steps (parts of instructions) executed by Run() since this program was created
+     */
+    long long GetInstructionCount();
+
+    /**
+     * \brief Runs the functions of this program on the bytecode VM when possible
+     *
+     * Every function is lowered into bytecode when compiled if it only works on int, float and bool values
+     * (see CBotBytecode), others are always run by the tree interpreter. Functions run by the VM use
+     * a different number of timer ticks, so programs run at a different speed. Off by default.
+     *
+     * A function which is already running keeps running the way it was started.
+     *
+     * \param enable true to use the bytecode
+     */
+    void EnableBytecode(bool enable);
+    //! Returns the value set by EnableBytecode()
+    bool IsBytecodeEnabled();
+
     /**
      * \brief Gives the current position in the executing program
      * \param[out] functionName Name of the currently executed function
@@ -204,6 +266,8 @@ public:
      * \brief Sets the number of steps (parts of instructions) to execute in Run() before suspending the program execution
      * \param n new timer value
      *
+     * This is the default for programs which were never given their own timer in Run()
+     *
      * FIXME: Seems to be currently kind of broken (see issue #410)
      */
     static void SetTimer(int n);
@@ -268,11 +332,13 @@ public:
      * \param name Name of the function
      * \param rExec Execution function
      * \param rCompile Compilation function
+     * \param threadSafe true if the function only works on its parameters, see CBotExternalCall::SetThreadSafe()
      * \return true
      */
     static bool AddFunction(const std::string& name,
                             bool rExec(CBotVar* pVar, CBotVar* pResult, int& Exception, void* pUser),
-                            CBotTypResult rCompile(CBotVar*& pVar, void* pUser));
+                            CBotTypResult rCompile(CBotVar*& pVar, void* pUser),
+                            bool threadSafe = false);
 
     /**
      * \copydoc CBotToken::DefineNum()
@@ -344,9 +410,39 @@ public:
      */
     static CBotExternalCallList* GetExternalCalls();
 
+private:
+    //! Functions compiled by CompileShared(), used by all programs compiled from the same code
+    struct SharedFunctions;
+
+    /**
+     * \brief Removes the classes and functions of the program
+     */
+    void ReleaseCode();
+
+    /**
+     * \brief Returns true if the program has classes or public functions, which are visible to other programs
+     */
+    bool HasPublicDefinitions();
+
+    /**
+     * \brief CBotClass::AreInstancesThreadSafe(), computed again only when m_definitionsRevision changes
+     */
+    static bool AreInstancesThreadSafe();
+
 private:
     //! All external calls
     static CBotExternalCallList* m_externalCalls;
+    //! Shared functions by compilation context and code, see CompileShared()
+    static std::unordered_map<std::string, std::weak_ptr<SharedFunctions>> m_sharedFunctionsCache;
+    //! Guards m_sharedFunctionsCache
+    static std::mutex m_sharedFunctionsMutex;
+    //! Changed whenever external calls, constants, classes or public functions are defined,
+    //! as they can change the result of compilation of any program
+    static std::atomic<long> m_definitionsRevision;
+    //! Last result of AreInstancesThreadSafe() as 2*revision+result, -1 if not computed yet
+    static std::atomic<long> m_instancesThreadSafe;
+    //! Functions shared with other programs, m_functions are then only a copy of the list
+    std::shared_ptr<SharedFunctions> m_sharedFunctions;
     //! All user-defined functions
     std::list<CBotFunction*> m_functions{};
     //! The entry point function
@@ -357,6 +453,14 @@ private:
     CBotStack* m_stack = nullptr;
     //! "this" variable
     CBotVar* m_thisVar = nullptr;
+    //! Execution context owned by this program
+    std::unique_ptr<CBotExecutionContext> m_ownContext;
+    //! Execution context used to run this program, either m_ownContext or a borrowed one
+    CBotExecutionContext* m_context = nullptr;
+    //! Steps executed so far, see GetInstructionCount()
+    long long m_instructionCount = 0;
+    //! Functions are run on the bytecode VM, see EnableBytecode()
+    bool m_bytecode = false;
     friend class CBotFunction;
     friend class CBotDebug;
 
@@ -27,9 +27,11 @@
 #include "CBot/CBotVar/CBotVarClass.h"
 
 #include "CBot/CBotFileUtils.h"
+#include "CBot/CBotMemoryPool.h"
 #include "CBot/CBotUtils.h"
 #include "CBot/CBotExternalCall.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
@@ -38,33 +40,33 @@
 namespace CBot
 {
 
+namespace
+{
 const int DEFAULT_TIMER = 100;
 
-int         CBotStack::m_initimer = DEFAULT_TIMER;
-int         CBotStack::m_timer = 0;
-CBotVar*    CBotStack::m_retvar = nullptr;
-CBotError   CBotStack::m_error = CBotNoErr;
-int         CBotStack::m_start = 0;
-int         CBotStack::m_end   = 0;
-std::string  CBotStack::m_labelBreak="";
-void*       CBotStack::m_pUser = nullptr;
+std::atomic<int> g_initimer(DEFAULT_TIMER);
+}
 
 ////////////////////////////////////////////////////////////////////////////////
-CBotStack* CBotStack::AllocateStack()
+CBotStack* CBotStack::AllocateStack(CBotExecutionContext* context)
 {
+    if (context == nullptr) context = CBotExecutionContext::GetCurrent();
+
     CBotStack*    p;
 
     long    size = sizeof(CBotStack);
     size    *= (MAXSTACK+10);
 
-    // request a slice of memory for the stack
-    p = static_cast<CBotStack*>(malloc(size));
+    // request a slice of memory for the stack, usually one freed by a previous stack
+    p = static_cast<CBotStack*>(CBotMemoryPool::AllocateStack(size));
 
     // completely empty
     memset(p, 0, size);
 
     p->m_block = BlockVisibilityType::BLOCK;
-    m_timer = m_initimer;                // sets the timer at the beginning
+    p->m_context = context;
+    context->m_timer = context->GetTimerLimit();    // sets the timer at the beginning
+    context->m_externalAccessDeferred = false;
 
     CBotStack* pp = p;
     pp += MAXSTACK;
@@ -75,7 +77,7 @@ CBotStack* CBotStack::AllocateStack()
         pp ++;
     }
 
-    m_error = CBotNoErr;    // avoids deadlocks because m_error is static
+    context->m_error = CBotNoErr;    // avoids deadlocks because the error is shared with other stacks of this context
     return p;
 }
 
@@ -105,7 +107,7 @@ void CBotStack::Delete()
     m_bOver    = bOver;
 
     if ( p == nullptr )
-        free( this );
+        CBotMemoryPool::FreeStack(this, sizeof(CBotStack) * (MAXSTACK+10));
 }
 
 // routine improved
@@ -128,6 +130,7 @@ CBotStack* CBotStack::AddStack(CBotInstr* instr, BlockVisibilityType bBlock)
     p->m_block  = bBlock;
     p->m_instr  = instr;
     p->m_prog   = m_prog;
+    p->m_context = m_context;
     p->m_step   = 0;
     p->m_prev   = this;
     p->m_state  = 0;
@@ -169,6 +172,7 @@ CBotStack* CBotStack::AddStack2(BlockVisibilityType bBlock)
 
     m_next2 = p;                                // chain an element
     p->m_prev = this;
+    p->m_context = m_context;
     p->m_block = bBlock;
     p->m_prog = m_prog;
     p->m_step = 0;
@@ -222,18 +226,14 @@ bool CBotStack::ReturnKeep(CBotStack* pfils)
 bool CBotStack::StackOver()
 {
     if (!m_bOver) return false;
-    m_error = CBotErrStackOver;
+    m_context->m_error = CBotErrStackOver;
     return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void CBotStack::Reset()
 {
-    m_timer = m_initimer; // resets the timer
-    m_error    = CBotNoErr;
-//    m_start = 0;
-//    m_end    = 0;
-    m_labelBreak.clear();
+    m_context->Reset(); // resets the timer and the error
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -260,35 +260,35 @@ CBotStack* CBotStack::RestoreStackEOX(CBotExternalCall* instr)
 // routine for execution step by step
 bool CBotStack::IfStep()
 {
-    if ( m_initimer > 0 || m_step++ > 0 ) return false;
+    if ( m_context->GetTimerLimit() > 0 || m_step++ > 0 ) return false;
     return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotStack::BreakReturn(CBotStack* pfils, const std::string& name)
 {
-    if ( m_error>=0 ) return false;                // normal output
-    if ( m_error==CBotError(-3) ) return false;            // normal output (return current)
+    if ( m_context->m_error>=0 ) return false;                // normal output
+    if ( m_context->m_error==CBotError(-3) ) return false;            // normal output (return current)
 
-    if (!m_labelBreak.empty() && (name.empty() || m_labelBreak != name))
+    if (!m_context->m_labelBreak.empty() && (name.empty() || m_context->m_labelBreak != name))
         return false;                            // it's not for me
 
-    m_error = CBotNoErr;
-    m_labelBreak.clear();
+    m_context->m_error = CBotNoErr;
+    m_context->m_labelBreak.clear();
     return Return(pfils);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotStack::IfContinue(int state, const std::string& name)
 {
-    if ( m_error != CBotError(-2) ) return false;
+    if ( m_context->m_error != CBotError(-2) ) return false;
 
-    if (!m_labelBreak.empty() && (name.empty() || m_labelBreak != name))
+    if (!m_context->m_labelBreak.empty() && (name.empty() || m_context->m_labelBreak != name))
         return false;                            // it's not for me
 
     m_state = state;                            // where again?
-    m_error = CBotNoErr;
-    m_labelBreak.clear();
+    m_context->m_error = CBotNoErr;
+    m_context->m_labelBreak.clear();
     if (m_next != nullptr) m_next->Delete();            // purge above stack
     return true;
 }
@@ -296,11 +296,12 @@ bool CBotStack::IfContinue(int state, const std::string& name)
 ////////////////////////////////////////////////////////////////////////////////
 void CBotStack::SetBreak(int val, const std::string& name)
 {
-    m_error = static_cast<CBotError>(-val);                                // reacts as an Exception
-    m_labelBreak = name;
+    m_context->m_error = static_cast<CBotError>(-val);                                // reacts as an Exception
+    m_context->m_labelBreak = name;
     if (val == 3)    // for a return
     {
-        m_retvar = m_var;
+        delete m_context->m_retvar;
+        m_context->m_retvar = m_var;
         m_var = nullptr;
     }
 }
@@ -309,12 +310,12 @@ void CBotStack::SetBreak(int val, const std::string& name)
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotStack::GetRetVar(bool bRet)
 {
-    if (m_error == CBotError(-3))
+    if (m_context->m_error == CBotError(-3))
     {
         if ( m_var ) delete m_var;
-        m_var        = m_retvar;
-        m_retvar    = nullptr;
-        m_error      = CBotNoErr;
+        m_var        = m_context->m_retvar;
+        m_context->m_retvar = nullptr;
+        m_context->m_error  = CBotNoErr;
         return        true;
     }
     return bRet;                        // interrupted by something other than return
@@ -334,7 +335,7 @@ CBotVar* CBotStack::FindVar(CBotToken*& pToken, bool bUpdate)
             if (pp->GetName() == name)
             {
                 if ( bUpdate )
-                    pp->Update(m_pUser);
+                    pp->Update(m_context->m_pUser);
 
                 return pp;
             }
@@ -374,10 +375,10 @@ CBotVar* CBotStack::FindVar(long ident, bool bUpdate)
         CBotVar*    pp = p->m_listVar;
         while ( pp != nullptr)
         {
-            if (pp->GetUniqNum() == ident)
+            if (pp->m_ident == ident)
             {
                 if ( bUpdate )
-                    pp->Update(m_pUser);
+                    pp->Update(m_context->m_pUser);
 
                 return pp;
             }
@@ -388,6 +389,65 @@ CBotVar* CBotStack::FindVar(long ident, bool bUpdate)
     return nullptr;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+CBotVar* CBotStack::FindVar(long ident, int& blockLevel, bool bUpdate)
+{
+    CBotStack*    p = this;
+    CBotVar*      pVar = nullptr;
+
+    // first try only the block where the variable was last time
+    int level = blockLevel;
+    while (p != nullptr && level >= 0)
+    {
+        if (p->m_block != BlockVisibilityType::INSTRUCTION)
+        {
+            if (level == 0)
+            {
+                for (CBotVar* pp = p->m_listVar; pp != nullptr && pVar == nullptr; pp = pp->m_next)
+                {
+                    if (pp->m_ident == ident) pVar = pp;
+                }
+                break;
+            }
+            // never look into the caller's variables
+            if (p->m_block == BlockVisibilityType::FUNCTION) break;
+            level--;
+        }
+        p = p->m_prev;
+    }
+
+    // otherwise search all blocks and remember where the variable was found
+    if (pVar == nullptr)
+    {
+        bool inFunction = true;
+        level = 0;
+        blockLevel = -1;
+        for (p = this; p != nullptr && pVar == nullptr; p = p->m_prev)
+        {
+            for (CBotVar* pp = p->m_listVar; pp != nullptr; pp = pp->m_next)
+            {
+                if (pp->m_ident == ident)
+                {
+                    pVar = pp;
+                    if (inFunction) blockLevel = level;
+                    break;
+                }
+            }
+
+            if (p->m_block != BlockVisibilityType::INSTRUCTION)
+            {
+                if (p->m_block == BlockVisibilityType::FUNCTION) inFunction = false;
+                level++;
+            }
+        }
+    }
+
+    if (pVar != nullptr && bUpdate)
+        pVar->Update(m_context->m_pUser);
+
+    return pVar;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar* CBotStack::FindVar(CBotToken& pToken, bool bUpdate)
 {
@@ -412,8 +472,9 @@ bool CBotStack::SetState(int n, int limite)
 {
     m_state = n;
 
-    m_timer--;                                    // decrement the timer
-    return ( m_timer > limite );                    // interrupted if timer pass
+    m_context->m_timer--;                                    // decrement the timer
+    m_context->m_instructionCount++;
+    return ( m_context->m_timer > limite );                    // interrupted if timer pass
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -421,46 +482,47 @@ bool CBotStack::IncState(int limite)
 {
     m_state++;
 
-    m_timer--;                                    // decrement the timer
-    return ( m_timer > limite );                    // interrupted if timer pass
+    m_context->m_timer--;                                    // decrement the timer
+    m_context->m_instructionCount++;
+    return ( m_context->m_timer > limite );                    // interrupted if timer pass
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void CBotStack::SetError(CBotError n, CBotToken* token)
 {
-    if (n != CBotNoErr && m_error != CBotNoErr) return;    // does not change existing error
-    m_error = n;
+    if (n != CBotNoErr && m_context->m_error != CBotNoErr) return;    // does not change existing error
+    m_context->m_error = n;
     if (token != nullptr)
     {
-        m_start = token->GetStart();
-        m_end   = token->GetEnd();
+        m_context->m_start = token->GetStart();
+        m_context->m_end   = token->GetEnd();
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void CBotStack::ResetError(CBotError n, int start, int end)
 {
-    m_error = n;
-    m_start    = start;
-    m_end    = end;
+    m_context->m_error = n;
+    m_context->m_start = start;
+    m_context->m_end   = end;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void CBotStack::SetPosError(CBotToken* token)
 {
-    m_start = token->GetStart();
-    m_end   = token->GetEnd();
+    m_context->m_start = token->GetStart();
+    m_context->m_end   = token->GetEnd();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void CBotStack::SetTimer(int n)
 {
-    m_initimer = n;
+    g_initimer = n;
 }
 
 int CBotStack::GetTimer()
 {
-    return m_initimer;
+    return g_initimer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -484,6 +546,8 @@ bool CBotStack::Execute()
 
     if ( instr == nullptr ) return true;                // normal execution request
 
+    if (!instr->IsThreadSafe() && !CanAccessExternal()) return false;
+
     if (!instr->Run(nullptr, pile)) return false;            // resume interrupted execution
 
     if (pile->m_next != nullptr) pile->m_next->Delete();
@@ -558,12 +622,38 @@ CBotProgram*  CBotStack::GetProgram(bool bFirst)
 ////////////////////////////////////////////////////////////////////////////////
 void* CBotStack::GetUserPtr()
 {
-    return m_pUser;
+    return m_context->m_pUser;
 }
 
 void CBotStack::SetUserPtr(void* user)
 {
-    m_pUser = user;
+    m_context->m_pUser = user;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool CBotStack::CanAccessExternal()
+{
+    if (!m_context->m_deferExternalAccess) return true;
+    if (GetProgram(true) == nullptr) return true;    // independent stack, can't be interrupted
+
+    m_context->m_externalAccessDeferred = true;
+    return false;
+}
+
+bool CBotStack::CanUpdateVar(CBotVar* var)
+{
+    if (!m_context->m_deferExternalAccess) return true;
+
+    CBotType type = var->GetType();
+    if (type != CBotTypPointer && type != CBotTypClass) return true;
+
+    // only instances attached to something outside of CBot have their update function called
+    CBotVarClass* instance = var->GetPointer();
+    if (instance == nullptr) return true;
+    void* user = instance->GetUserPtr();
+    if (user == OBJECTCREATED || user == OBJECTDELETED) return true;
+
+    return CanAccessExternal();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,7 @@
 #include "CBot/CBotDefines.h"
 #include "CBot/CBotTypResult.h"
 #include "CBot/CBotEnums.h"
+#include "CBot/CBotExecutionContext.h"
 #include "CBot/CBotVar/CBotVar.h"
 
 #include <cstdio>
@@ -62,9 +63,10 @@ public:
 
     /**
      * \brief Allocate the stack
+     * \param context Execution context shared by all levels of the new stack, nullptr to use CBotExecutionContext::GetCurrent()
      * \return pointer to created stack
      */
-    static CBotStack* AllocateStack();
+    static CBotStack* AllocateStack(CBotExecutionContext* context = nullptr);
 
     /** \brief Remove the current stack */
     void Delete();
@@ -83,8 +85,7 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /** \name Error management
      *
-     * BE CAREFUL - errors are stored in static variables!
-     * \todo Refactor that
+     * Errors are shared by all levels of the stack, they are stored in its CBotExecutionContext
      */
     //@{
 
@@ -94,14 +95,14 @@ public:
      * \param[out] end Ending position in code of the error
      * \return Error number
      */
-    CBotError GetError(int& start, int& end) { start = m_start; end = m_end; return m_error; }
+    CBotError GetError(int& start, int& end) { return m_context->GetError(start, end); }
 
     /**
      * \brief Get last error
      * \return Error number
      * \see GetError(int&, int&) for error position in code
      */
-    CBotError GetError() { return m_error; }
+    CBotError GetError() { return m_context->m_error; }
 
     /**
      * \brief Check if there was an error
@@ -110,7 +111,7 @@ public:
      */
     bool IsOk()
     {
-        return m_error == CBotNoErr;
+        return m_context->m_error == CBotNoErr;
     }
 
     /**
@@ -190,6 +191,21 @@ public:
      */
     CBotVar* FindVar(long ident, bool bUpdate);
 
+    /**
+     * \brief Fetch a variable according to its unique identifier, starting with the block it is expected in
+     *
+     * Only the variables of the block \a blockLevel blocks up from this one are compared, the
+     * blocks in between are skipped. If the variable is not there, all blocks are searched like in
+     * FindVar(long, bool) and \a blockLevel is updated, so the caller can keep it for the next lookup.
+     *
+     * \param ident Unique identifier of a variable
+     * \param[in,out] blockLevel Number of blocks between this stack and the block declaring the variable,
+     * -1 if unknown or the variable is not local to the current function; see also CBotCStack::FindVar(CBotToken*&, int&)
+     * \param bUpdate true to automatically call update function for classes, see CBotClass::SetUpdateFunc()
+     * \return Found variable, nullptr if not found
+     */
+    CBotVar* FindVar(long ident, int& blockLevel, bool bUpdate);
+
     /**
      * \brief Find variable by its token and returns a copy of it
      *
@@ -357,7 +373,7 @@ public:
     /**
      * \todo Document
      *
-     * Copies the result value from static m_retvar (m_var at a moment of SetBreak(3)) to this stack result
+     * Copies the result value from the context's m_retvar (m_var at a moment of SetBreak(3)) to this stack result
      */
     bool            GetRetVar(bool bRet);
 
@@ -401,6 +417,29 @@ public:
      */
     void*           GetUserPtr();
 
+    /**
+     * \brief Get the execution context shared by all levels of this stack
+     */
+    CBotExecutionContext* GetExecutionContext() { return m_context; }
+
+    /**
+     * \brief Check if code outside of CBot may be run now
+     *
+     * If the execution context defers external access (see CBotExecutionContext::SetDeferExternalAccess()),
+     * marks the access as deferred and returns false - the instruction has to interrupt the program and try again on the next run.
+     * Stacks not belonging to a program (destructors, field initializers) can't be interrupted, for them this always returns true.
+     *
+     * \return true if the code may be run, false if the program has to be interrupted
+     */
+    bool CanAccessExternal();
+    /**
+     * \brief Check if the update function of the class of given variable may be called now
+     * \param var Variable to be updated, see CBotVar::Update()
+     * \return true if the update may be done, false if the program has to be interrupted
+     * \see CanAccessExternal()
+     */
+    bool CanUpdateVar(CBotVar* var);
+
     /**
      * \brief Get the block type this stack represents - instruction, code block or function
      * \see BlockVisibilityType enum
@@ -442,7 +481,8 @@ public:
     /**
      * \brief Set the maximum number of "timer ticks" (parts of instructions) to execute
      *
-     * This setting gets applied on next call to Reset()
+     * This setting gets applied on next call to Reset(), for contexts without their own limit
+     * (see CBotExecutionContext::SetTimerLimit())
      *
      * \todo Full documentation of the timer
      */
@@ -470,16 +510,17 @@ public:
     bool            IsCallFinished();
 
 private:
+    //! Keeps its registers in the variables and the result of its frame, see CBotBytecode::Suspend()
+    friend class CBotBytecode;
+
     CBotStack*        m_next;
     CBotStack*        m_next2;
     CBotStack*        m_prev;
 
     int               m_state;
     int               m_step;
-    static CBotError  m_error;
-    static int        m_start;
-    static int        m_end;
-    static CBotVar*   m_retvar;                    // result of a return
+    //! State shared by all levels of this stack
+    CBotExecutionContext* m_context;
 
     CBotVar*        m_var;                        // result of the operations
     CBotVar*        m_listVar;                    // variables declared at this level
@@ -489,11 +530,6 @@ private:
     //! CBotProgram instance the execution is in in this stack level
     CBotProgram*    m_prog;
 
-    static int      m_initimer;
-    static int      m_timer;
-    static std::string m_labelBreak;
-    static void*    m_pUser;
-
     //! The corresponding instruction
     CBotInstr* m_instr;
     //! If this stack level holds a function call
@@ -19,8 +19,13 @@
 
 #include "CBot/CBotToken.h"
 
+#include "CBot/CBotMemoryPool.h"
+
+#include <algorithm>
 #include <cstdarg>
 #include <cassert>
+#include <iterator>
+#include <map>
 
 namespace CBot
 {
@@ -120,12 +125,114 @@ static const std::map<TokenId, const std::string> KEYWORDS = {
 namespace
 {
 static const std::string emptyString = "";
+
+/**
+ * \brief Trie of all the strings in KEYWORDS
+ *
+ * Used to recognize keywords without comparing the word with every one of them,
+ * and to extend operators one character at a time (see CBotToken::NextToken()).
+ * Children of each node are stored in a flat table indexed by the position of the
+ * character in the alphabet made of all the characters used by keywords.
+ */
+class CBotKeywordTrie
+{
+public:
+    CBotKeywordTrie()
+    {
+        std::fill(std::begin(m_alphabet), std::end(m_alphabet), -1);
+        for (const auto& it : KEYWORDS)
+        {
+            for (char c : it.second)
+            {
+                unsigned char index = static_cast<unsigned char>(c);
+                if (m_alphabet[index] < 0) m_alphabet[index] = m_alphabetSize++;
+            }
+        }
+
+        AddNode();
+        for (const auto& it : KEYWORDS)
+        {
+            int node = 0;
+            for (char c : it.second)
+            {
+                int slot = node * m_alphabetSize + m_alphabet[static_cast<unsigned char>(c)];
+                if (m_children[slot] == 0)
+                {
+                    int newNode = AddNode();
+                    m_children[slot] = newNode;
+                }
+                node = m_children[slot];
+            }
+            // Some strings are used by two keywords, the one with the lowest ID wins
+            if (m_keywords[node] < 0) m_keywords[node] = it.first;
+        }
+    }
+
+    //! Returns the root node, which stands for the empty string
+    int GetRoot() const
+    {
+        return 0;
+    }
+
+    //! Returns the node for the string of given node followed by the character, -1 if no keyword starts like that
+    int GetNext(int node, char c) const
+    {
+        int index = m_alphabet[static_cast<unsigned char>(c)];
+        if (index < 0) return -1;
+        int child = m_children[node * m_alphabetSize + index];
+        return child != 0 ? child : -1;
+    }
+
+    //! Returns the keyword ID of given node, -1 if its string is only the beginning of a keyword
+    int GetKeyword(int node) const
+    {
+        return m_keywords[node];
+    }
+
+    //! Returns the keyword ID of the word, -1 if it is not a keyword
+    int Find(const std::string& word) const
+    {
+        int node = GetRoot();
+        for (char c : word)
+        {
+            node = GetNext(node, c);
+            if (node < 0) return -1;
+        }
+        return GetKeyword(node);
+    }
+
+private:
+    int AddNode()
+    {
+        m_keywords.push_back(-1);
+        m_children.resize(m_children.size() + m_alphabetSize, 0);
+        return static_cast<int>(m_keywords.size()) - 1;
+    }
+
+private:
+    //! Position of each character in the alphabet, -1 if it is never used by a keyword
+    int m_alphabet[256];
+    int m_alphabetSize = 0;
+    //! Keyword ID of each node
+    std::vector<int> m_keywords;
+    //! Children of each node, 0 if none (the root is never a child)
+    std::vector<int> m_children;
+};
+
+const CBotKeywordTrie& GetKeywordTrie()
+{
+    static const CBotKeywordTrie trie;
+    return trie;
 }
+
+} // namespace
+
 const std::string& LoadString(TokenId id)
 {
-    if (KEYWORDS.find(id) != KEYWORDS.end())
+    auto it = KEYWORDS.find(id);
+    if (it != KEYWORDS.end())
     {
-        return KEYWORDS.at(id);
+        return it->second;
     }
     else
     {
@@ -134,7 +241,7 @@ const std::string& LoadString(TokenId id)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-std::map<std::string, long> CBotToken::m_defineNum;
+std::unordered_map<std::string, long> CBotToken::m_defineNum;
 ////////////////////////////////////////////////////////////////////////////////
 CBotToken::CBotToken()
 {
@@ -196,6 +303,17 @@ const CBotToken& CBotToken::operator=(const CBotToken& src)
     return *this;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void* CBotToken::operator new(std::size_t size)
+{
+    return CBotMemoryPool::Allocate(size);
+}
+
+void CBotToken::operator delete(void* ptr, std::size_t size)
+{
+    CBotMemoryPool::Free(ptr, size);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int CBotToken::GetType()
 {
@@ -240,18 +358,6 @@ void CBotToken::SetPos(int start, int end)
     m_end   = end;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-bool CharInList(const char c, const char* list)
-{
-    int     i = 0;
-
-    while (true)
-    {
-        if (c == list[i++]) return true;
-        if (list[i] == 0) return false;
-    }
-}
-
 static char    sep1[] = " \r\n\t,:()[]{}-+*/=;><!~^|&%.";
 static char    sep2[] = " \r\n\t";                           // only separators
 static char    sep3[] = ",:()[]{}-+*/=;<>!~^|&%.";           // operational separators
@@ -259,12 +365,66 @@ static char    num[]  = "0123456789";                        // point (single) i
 static char    hexnum[]   = "0123456789ABCDEFabcdef";
 static char    nch[]  = "\"\r\n\t";                          // forbidden in chains
 
+namespace
+{
+
+//! Character classes used by the lexer, a character can be in several classes
+enum CharClass
+{
+    CHAR_SEPARATOR   = 1 << 0,  //!< ends a word (sep1)
+    CHAR_BLANK       = 1 << 1,  //!< only separates tokens (sep2)
+    CHAR_OPERATOR    = 1 << 2,  //!< begins an operator (sep3)
+    CHAR_DIGIT       = 1 << 3,  //!< decimal digit (num)
+    CHAR_HEXDIGIT    = 1 << 4,  //!< hexadecimal digit (hexnum)
+    CHAR_STRINGBREAK = 1 << 5,  //!< forbidden in strings (nch)
+};
+
+//! Classes of every character, so that the lexer does not have to search the lists above
+class CBotCharClasses
+{
+public:
+    CBotCharClasses()
+    {
+        std::fill(std::begin(m_classes), std::end(m_classes), 0);
+        Add(sep1, CHAR_SEPARATOR);
+        Add(sep2, CHAR_BLANK);
+        Add(sep3, CHAR_OPERATOR);
+        Add(num, CHAR_DIGIT);
+        Add(hexnum, CHAR_HEXDIGIT);
+        Add(nch, CHAR_STRINGBREAK);
+    }
+
+    bool Is(char c, int charClass) const
+    {
+        return (m_classes[static_cast<unsigned char>(c)] & charClass) != 0;
+    }
+
+private:
+    void Add(const char* list, int charClass)
+    {
+        for (; *list != 0; list++)
+            m_classes[static_cast<unsigned char>(*list)] |= charClass;
+    }
+
+private:
+    unsigned char m_classes[256];
+};
+
+const CBotCharClasses& GetCharClasses()
+{
+    static const CBotCharClasses classes;
+    return classes;
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 CBotToken*  CBotToken::NextToken(const char*& program, bool first)
 {
     std::string token; // found token
     std::string sep;   // separators after the token
     bool stop = first;
+    const CBotCharClasses& classes = GetCharClasses();
 
     if (*program == 0) return nullptr;
 
@@ -278,11 +438,12 @@ CBotToken*  CBotToken::NextToken(const char*& program, bool first)
         // special case for strings
         if (token[0] == '\"' )
         {
-            while (c != 0 && !CharInList(c, nch))
+            while (c != 0 && !classes.Is(c, CHAR_STRINGBREAK))
             {
                 if ( c == '\\' )
                 {
                     c   = *(program++);                 // next character
+                    if ( c == 0 ) break;                // backslash at the end of the program
                     if ( c == 'n' ) c = '\n';
                     if ( c == 'r' ) c = '\r';
                     if ( c == 't' ) c = '\t';
@@ -299,25 +460,25 @@ CBotToken*  CBotToken::NextToken(const char*& program, bool first)
         }
 
         // special case for numbers
-        if ( CharInList(token[0], num ))
+        if ( classes.Is(token[0], CHAR_DIGIT) )
         {
             bool    bdot = false;   // found a point?
             bool    bexp = false;   // found an exponent?
 
-            char*   liste = num;
+            int     liste = CHAR_DIGIT;
             if (token[0] == '0' && c == 'x')          // hexadecimal value?
             {
                 token += c;
                 c   = *(program++);                 // next character
-                liste = hexnum;
+                liste = CHAR_HEXDIGIT;
             }
 cw:
-            while (c != 0 && CharInList(c, liste))
+            while (c != 0 && classes.Is(c, liste))
             {
 cc:             token += c;
                 c   = *(program++);                 // next character
             }
-            if ( liste == num )                     // not for hexadecimal
+            if ( liste == CHAR_DIGIT )                     // not for hexadecimal
             {
                 if ( !bdot && c == '.' ) { bdot = true; goto cc; }
                 if ( !bexp && ( c == 'e' || c == 'E' ) )
@@ -334,10 +495,11 @@ cc:             token += c;
             stop = true;
         }
 
-        if (CharInList(token[0], sep3))               // an operational separator?
+        if (classes.Is(token[0], CHAR_OPERATOR))     // an operational separator?
         {
-            std::string  motc = token;
-            while (motc += c, c != 0 && GetKeyWord(motc) > 0)    // operand seeks the longest possible
+            const CBotKeywordTrie& keywords = GetKeywordTrie();
+            int node = keywords.GetNext(keywords.GetRoot(), token[0]);
+            while (c != 0 && (node = keywords.GetNext(node, c)) >= 0 && keywords.GetKeyword(node) > 0)    // operand seeks the longest possible
             {
                 token += c;                           // build the word
                 c = *(program++);                   // next character
@@ -351,11 +513,11 @@ cc:             token += c;
 
     while (true)
     {
-        if (stop || c == 0 || CharInList(c, sep1))
+        if (stop || c == 0 || classes.Is(c, CHAR_SEPARATOR))
         {
             if (!first && token.empty()) return nullptr;   // end of the analysis
 bis:
-            while (CharInList(c, sep2))
+            while (classes.Is(c, CHAR_BLANK))
             {
                 sep += c;                           // after all the separators
                 c = *(program++);
@@ -389,9 +551,9 @@ bis:
 
             program--;
 
-            CBotToken* t = new CBotToken(token, sep);
+            CBotToken* t = new CBotToken();
 
-            if (CharInList(token[0], num )) t->m_type = TokenTypNum;
+            if (classes.Is(token[0], CHAR_DIGIT)) t->m_type = TokenTypNum;
             if (token[0] == '\"') t->m_type = TokenTypString;
             if (first) t->m_type = TokenTypNone;
 
@@ -399,6 +561,9 @@ bis:
             if (t->m_keywordId > 0) t->m_type = TokenTypKeyWord;
             else GetDefineNum(token, t) ;         // treats DefineNum
 
+            t->m_text = std::move(token);
+            t->m_sep  = std::move(sep);
+
             return t;
         }
 
@@ -447,24 +612,122 @@ std::unique_ptr<CBotToken> CBotToken::CompileTokens(const std::string& program)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-int CBotToken::GetKeyWord(const std::string& w)
+std::vector<std::pair<int, int>> CBotToken::FindMultiLineBlocks(const std::string& program)
 {
-    for (const auto& it : KEYWORDS)
+    int stop = program.size()+1;    // never stops before the end
+    return FindMultiLineBlocks(program, program.size(), 0, stop);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::pair<int, int>> CBotToken::FindMultiLineBlocks(const std::string& program, int length,
+                                                                int startPos, int& stopPos)
+{
+    std::vector<std::pair<int, int>> blocks;
+    const CBotCharClasses& classes = GetCharClasses();
+    const char* start = program.c_str();
+    const char* last = start + length;
+    const char* p = start + startPos;
+    // the text may go on after length, reads it as the end of the program
+    auto at = [last](const char* q) { return q < last ? *q : '\0'; };
+
+    // same rules as NextToken(), without building the tokens
+    while (true)
     {
-        if (it.second == w) return it.first;
+        while (classes.Is(at(p), CHAR_BLANK))
+        {
+            p++;
+            if (p[-1] == '\n' && p - start >= stopPos)
+            {
+                stopPos = p - start;    // beginning of a line outside of the blocks
+                return blocks;
+            }
+        }
+        if (at(p) == '/' && at(p+1) == '/')
+        {
+            while (at(p) != '\n' && at(p) != 0) p++;
+            continue;
+        }
+        if (at(p) == '/' && at(p+1) == '*')
+        {
+            const char* begin = p++;
+            while (at(p) != 0 && (at(p) != '*' || at(p+1) != '/')) p++;
+            if (at(p) != 0) p += 2;
+            blocks.emplace_back(begin - start, p - start);
+            continue;
+        }
+        if (at(p) == 0) break;
+
+        const char* begin = p;
+        char c = *(p++);
+        if (c == '\"')
+        {
+            bool multiline = false;
+            while (at(p) != 0 && !classes.Is(at(p), CHAR_STRINGBREAK))
+            {
+                if (at(p) == '\\' && at(p+1) != 0)
+                {
+                    p++;
+                    if (at(p) == '\n') multiline = true;    // an escaped line break goes on with the string
+                }
+                p++;
+            }
+            if (at(p) == '\"') p++;
+            if (multiline) blocks.emplace_back(begin - start, p - start);
+        }
+        else if (classes.Is(c, CHAR_DIGIT))
+        {
+            bool bdot = false;
+            bool bexp = false;
+            int liste = CHAR_DIGIT;
+            if (c == '0' && at(p) == 'x')
+            {
+                p++;
+                liste = CHAR_HEXDIGIT;
+            }
+            while (true)
+            {
+                while (at(p) != 0 && classes.Is(at(p), liste)) p++;
+                if (liste != CHAR_DIGIT) break;
+                if (!bdot && at(p) == '.')
+                {
+                    bdot = true;
+                    p++;
+                }
+                else if (!bexp && (at(p) == 'e' || at(p) == 'E'))
+                {
+                    bexp = true;
+                    p++;
+                    if (at(p) == '-' || at(p) == '+') p++;
+                }
+                else break;
+            }
+        }
+        else if (!classes.Is(c, CHAR_OPERATOR))
+        {
+            while (at(p) != 0 && !classes.Is(at(p), CHAR_SEPARATOR)) p++;
+        }
+        // no operator goes on with '/', so operators can be skipped one character at a time
     }
 
-    return -1;
+    stopPos = length;
+    return blocks;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int CBotToken::GetKeyWord(const std::string& w)
+{
+    return GetKeywordTrie().Find(w);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool CBotToken::GetDefineNum(const std::string& name, CBotToken* token)
 {
-    if (m_defineNum.count(name) == 0)
+    auto it = m_defineNum.find(name);
+    if (it == m_defineNum.end())
         return false;
 
     token->m_type = TokenTypDef;
-    token->m_keywordId = m_defineNum[name];
+    token->m_keywordId = it->second;
     return true;
 }
 
@@ -26,6 +26,7 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <unordered_map>
 
 namespace CBot
 {
@@ -156,6 +157,12 @@ public:
      */
     const CBotToken& operator=(const CBotToken& src);
 
+    /**
+     * \brief Every variable has its own copy of its name token, so tokens are allocated from CBotMemoryPool
+     */
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size);
+
     /**
      * \brief Transforms a CBot program from a string to a list of tokens
      * \param prog The program string
@@ -163,6 +170,29 @@ public:
      */
     static std::unique_ptr<CBotToken> CompileTokens(const std::string& prog);
 
+    /**
+     * \brief Find the parts of a CBot program going over several lines, without building its tokens
+     *
+     * These are the block comments and the strings continued by an escaped line break. Knowing them
+     * allows to tokenize again only the modified lines of a program.
+     *
+     * \param prog The program string
+     * \return Beginning and ending location of each part, in order
+     */
+    static std::vector<std::pair<int, int>> FindMultiLineBlocks(const std::string& prog);
+
+    /**
+     * \brief Find the parts of a CBot program going over several lines, in a part of the program
+     *
+     * \param prog The program string, only its first \a length characters are used
+     * \param length Length of the program
+     * \param start Where to begin, outside of any token (e.g. at the beginning of a line outside of the blocks)
+     * \param[in,out] stop The search ends at the first beginning of a line at or after this which is outside
+     *                 of the blocks, set to where the search ended (\a length if it reached the end)
+     * \return Beginning and ending location of each part found, in order
+     */
+    static std::vector<std::pair<int, int>> FindMultiLineBlocks(const std::string& prog, int length, int start, int& stop);
+
     /**
      * \brief Define a new constant
      * \param name Name of the constant
@@ -206,7 +236,7 @@ private:
     int m_end = 0;
 
     //! Map of all defined constants (see DefineNum())
-    static std::map<std::string, long> m_defineNum;
+    static std::unordered_map<std::string, long> m_defineNum;
 
     /**
      * \brief Check if the word is a keyword
@@ -46,7 +46,7 @@ namespace CBot
 {
 
 ////////////////////////////////////////////////////////////////////////////////
-long CBotVar::m_identcpt = 0;
+std::atomic<long> CBotVar::m_identcpt(9999); // identifiers start at 10000
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar::CBotVar( )
@@ -109,8 +109,7 @@ void CBotVar::SetUniqNum(long n)
 ////////////////////////////////////////////////////////////////////////////////
 long CBotVar::NextUniqNum()
 {
-    if (++m_identcpt < 10000) m_identcpt = 10000;
-    return m_identcpt;
+    return ++m_identcpt;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
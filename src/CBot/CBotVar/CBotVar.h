@@ -24,6 +24,7 @@
 #include "CBot/CBotEnums.h"
 #include "CBot/CBotUtils.h"
 
+#include <atomic>
 #include <string>
 
 namespace CBot
@@ -678,8 +679,8 @@ protected:
      */
     long m_ident;
 
-    //! TODO: ?
-    static long m_identcpt;
+    //! Last identifier returned by NextUniqNum(), shared by all threads
+    static std::atomic<long> m_identcpt;
 
     friend class CBotStack;
     friend class CBotCStack;
@@ -34,6 +34,7 @@ namespace CBot
 
 ////////////////////////////////////////////////////////////////////////////////
 std::set<CBotVarClass*> CBotVarClass::m_instances{};
+std::mutex CBotVarClass::m_instancesMutex{};
 
 ////////////////////////////////////////////////////////////////////////////////
 CBotVarClass::CBotVarClass(const CBotToken& name, const CBotTypResult& type)
@@ -66,7 +67,10 @@ CBotVarClass::CBotVarClass(const CBotToken& name, const CBotTypResult& type)
     m_ItemIdent = type.Eq(CBotTypIntrinsic) ? 0 : CBotVar::NextUniqNum();
 
     // add to the list
-    m_instances.insert(this);
+    {
+        std::lock_guard<std::mutex> lock(m_instancesMutex);
+        m_instances.insert(this);
+    }
 
     CBotClass* pClass = type.GetClass();
     if ( pClass != nullptr && pClass->GetParent() != nullptr )
@@ -89,7 +93,10 @@ CBotVarClass::~CBotVarClass( )
     m_pParent = nullptr;
 
     // removes the class list
-    m_instances.erase(this);
+    {
+        std::lock_guard<std::mutex> lock(m_instancesMutex);
+        m_instances.erase(this);
+    }
 
     delete    m_pVar;
 }
@@ -131,14 +138,16 @@ void CBotVarClass::Copy(CBotVar* pSrc, bool bName)
 
     delete        m_pVar;
     m_pVar        = nullptr;
+    m_items.clear();
 
     CBotVar*    pv = p->m_pVar;
+    CBotVar**   pLast = &m_pVar;
     while( pv != nullptr )
     {
         CBotVar*    pn = CBotVar::Create(pv);
         pn->Copy( pv );
-        if ( m_pVar == nullptr ) m_pVar = pn;
-        else m_pVar->AddNext(pn);
+        *pLast = pn;                    // added after
+        pLast = &pn->m_next;
 
         pv = pv->GetNext();
     }
@@ -162,6 +171,7 @@ void CBotVarClass::SetClass(CBotClass* pClass)//, int &nIdent)
     // initializes the variables associated with this class
     delete m_pVar;
     m_pVar = nullptr;
+    m_items.clear();
 
     if (pClass == nullptr) return;
 
@@ -271,32 +281,36 @@ CBotVar* CBotVarClass::GetItemRef(int nIdent)
 ////////////////////////////////////////////////////////////////////////////////
 CBotVar* CBotVarClass::GetItem(int n, bool bExtend)
 {
-    CBotVar*    p = m_pVar;
-
     if ( n < 0 ) return nullptr;
     if ( n > MAXARRAYSIZE ) return nullptr;
 
     if ( m_type.GetLimite() >= 0 && n >= m_type.GetLimite() ) return nullptr;
 
-    if ( p == nullptr && bExtend )
+    if ( n < static_cast<int>(m_items.size()) ) return m_items[n];
+
+    // the elements stay chained in m_pVar, m_items only indexes them
+    if ( m_items.empty() )
     {
-        p = CBotVar::Create("", m_type.GetTypElem());
-        m_pVar = p;
+        if ( m_pVar == nullptr )
+        {
+            if ( !bExtend ) return nullptr;
+            m_pVar = CBotVar::Create("", m_type.GetTypElem());
+        }
+        m_items.push_back(m_pVar);
     }
 
-    if ( n == 0 ) return p;
-
-    while ( n-- > 0 )
+    while ( static_cast<int>(m_items.size()) <= n )
     {
+        CBotVar*    p = m_items.back();
         if ( p->m_next == nullptr )
         {
-            if ( bExtend ) p->m_next = CBotVar::Create("", m_type.GetTypElem());
-            if ( p->m_next == nullptr ) return nullptr;
+            if ( !bExtend ) return nullptr;
+            p->m_next = CBotVar::Create("", m_type.GetTypElem());
         }
-        p = p->m_next;
+        m_items.push_back(p->m_next);
     }
 
-    return p;
+    return m_items[n];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -372,8 +386,7 @@ void CBotVarClass::IncrementUse()
 ////////////////////////////////////////////////////////////////////////////////
 void CBotVarClass::DecrementUse()
 {
-    m_CptUse--;
-    if ( m_CptUse == 0 )
+    if ( --m_CptUse == 0 )
     {
         // if there is one, call the destructor
         // but only if a constructor had been called.
@@ -381,14 +394,13 @@ void CBotVarClass::DecrementUse()
         {
             m_CptUse++;    // does not return to the destructor
 
-            // m_error is static in the stack
+            // the error is shared by all stacks of the execution context
             // saves the value for return
             CBotError err;
             int start, end;
-            CBotStack*    pile = nullptr;
-            err = pile->GetError(start,end);    // stack == nullptr it does not bother!
+            err = CBotExecutionContext::GetCurrent()->GetError(start, end);
 
-            pile = CBotStack::AllocateStack();        // clears the error
+            CBotStack*    pile = CBotStack::AllocateStack();        // clears the error
             CBotVar*    ppVars[1];
             ppVars[0] = nullptr;
 
@@ -422,6 +434,7 @@ CBotVarClass* CBotVarClass::GetPointer()
 ////////////////////////////////////////////////////////////////////////////////
 CBotVarClass* CBotVarClass::Find(long id)
 {
+    std::lock_guard<std::mutex> lock(m_instancesMutex);
     for (CBotVarClass* p : m_instances)
     {
         if (p->m_ItemIdent == id) return p;
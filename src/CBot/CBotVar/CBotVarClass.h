@@ -21,7 +21,10 @@
 
 #include "CBot/CBotVar/CBotVar.h"
 
+#include <atomic>
+#include <mutex>
 #include <set>
+#include <vector>
 
 namespace CBot
 {
@@ -97,14 +100,18 @@ public:
 private:
     //! List of all class instances - first
     static std::set<CBotVarClass*> m_instances;
+    //! Guards m_instances, instances are created and destroyed by all running programs
+    static std::mutex m_instancesMutex;
     //! Class definition
     CBotClass* m_pClass;
     //! Parent class instance
     CBotVarClass* m_pParent;
-    //! Class members
+    //! Class members, or elements of an array
     CBotVar* m_pVar;
-    //! Reference counter
-    int m_CptUse;
+    //! Index of the m_pVar list for arrays, filled as elements are accessed, see GetItem(int, bool)
+    std::vector<CBotVar*> m_items;
+    //! Reference counter, instances of objects outside of CBot are shared by all programs
+    std::atomic<int> m_CptUse;
     //! Identifier (unique) of an instance
     long m_ItemIdent;
     //! Set after constructor is called, allows destructor to be called
@@ -33,6 +33,9 @@ public:
     CBotVarFloat(const CBotToken &name) : CBotVarNumber(name) {}
 
     bool Save1State(FILE* pf) override;
+
+private:
+    friend class CBotTwoOpExpr;
 };
 
 } // namespace CBot
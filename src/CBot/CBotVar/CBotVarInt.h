@@ -57,6 +57,8 @@ protected:
     //! The name if given by DefineNum.
     std::string m_defnum;
     friend class CBotVar;
+    friend class CBotBytecode;
+    friend class CBotTwoOpExpr;
 };
 
 } // namespace CBot
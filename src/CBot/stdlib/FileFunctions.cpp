@@ -22,6 +22,7 @@
 #include "CBot/CBot.h"
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <cassert>
 
@@ -33,6 +34,8 @@ namespace
 std::unique_ptr<CBotFileAccessHandler> g_fileHandler;
 std::unordered_map<int, std::unique_ptr<CBotFile>> g_files;
 int g_nextFileId = 1;
+//! Guards g_files and g_nextFileId, programs may be run on several threads
+std::mutex g_filesMutex;
 }
 
 
@@ -76,6 +79,7 @@ bool FileClassOpenFile(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exc
 
     if (!file->Opened()) { Exception = CBotErrFileOpen; return false; }
 
+    std::lock_guard<std::mutex> lock(g_filesMutex);
     int fileHandle = g_nextFileId++;
     g_files[fileHandle] = std::move(file);
 
@@ -133,6 +137,7 @@ bool rfdestruct (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception
     pVar = pThis->GetItem("handle");
 
     if (!pVar->IsDefined()) return true; // file not opened
+    std::lock_guard<std::mutex> lock(g_filesMutex);
     g_files.erase(pVar->GetValInt());
 
     pVar->SetInit(CBotVar::InitType::IS_NAN);
@@ -196,6 +201,7 @@ bool rfclose (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, v
 
     int fileHandle = pVar->GetValInt();
 
+    std::lock_guard<std::mutex> lock(g_filesMutex);
     const auto handleIter = g_files.find(fileHandle);
     if (handleIter == g_files.end())
     {
@@ -239,6 +245,7 @@ bool rfwrite (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, v
 
     int fileHandle = pVar->GetValInt();
 
+    std::lock_guard<std::mutex> lock(g_filesMutex);
     const auto handleIter = g_files.find(fileHandle);
     if (handleIter == g_files.end())
     {
@@ -285,6 +292,7 @@ bool rfread(CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, voi
 
     int fileHandle = pVar->GetValInt();
 
+    std::lock_guard<std::mutex> lock(g_filesMutex);
     const auto handleIter = g_files.find(fileHandle);
     if (handleIter == g_files.end())
     {
@@ -327,6 +335,7 @@ bool rfeof (CBotVar* pThis, CBotVar* pVar, CBotVar* pResult, int& Exception, voi
 
     int fileHandle = pVar->GetValInt();
 
+    std::lock_guard<std::mutex> lock(g_filesMutex);
     const auto handleIter = g_files.find(fileHandle);
     if (handleIter == g_files.end())
     {
@@ -19,6 +19,7 @@
 
 #include "app/app.h"
 
+#include "app/batch_runner.h"
 #include "app/controller.h"
 #include "app/input.h"
 #include "app/pathman.h"
@@ -240,7 +241,13 @@ ParseArgsStatus CApplication::ParseArguments(int argc, char *argv[])
         OPT_HEADLESS,
         OPT_DEVICE,
         OPT_OPENGL_VERSION,
-        OPT_OPENGL_PROFILE
+        OPT_OPENGL_PROFILE,
+        OPT_FIXEDSTEP,
+        OPT_TICKS,
+        OPT_BATCH,
+        OPT_BATCHRESULT,
+        OPT_PROFILETRACE,
+        OPT_PROFILETRACEFILE
     };
 
     option options[] =
@@ -259,6 +266,12 @@ ParseArgsStatus CApplication::ParseArguments(int argc, char *argv[])
         { "graphics", required_argument, nullptr, OPT_DEVICE },
         { "glversion", required_argument, nullptr, OPT_OPENGL_VERSION },
         { "glprofile", required_argument, nullptr, OPT_OPENGL_PROFILE },
+        { "fixedstep", required_argument, nullptr, OPT_FIXEDSTEP },
+        { "ticks", required_argument, nullptr, OPT_TICKS },
+        { "batch", required_argument, nullptr, OPT_BATCH },
+        { "batchresult", required_argument, nullptr, OPT_BATCHRESULT },
+        { "profiletrace", required_argument, nullptr, OPT_PROFILETRACE },
+        { "profiletracefile", required_argument, nullptr, OPT_PROFILETRACEFILE },
         { nullptr, 0, nullptr, 0}
     };
 
@@ -304,6 +317,12 @@ ParseArgsStatus CApplication::ParseArguments(int argc, char *argv[])
                 GetLogger()->Message("  -graphics           changes graphics device (one of: default, auto, opengl, gl14, gl21, gl33\n");
                 GetLogger()->Message("  -glversion          sets OpenGL context version to use (either default or version in format #.#)\n");
                 GetLogger()->Message("  -glprofile          sets OpenGL context profile to use (one of: default, core, compatibility, opengles)\n");
+                GetLogger()->Message("  -fixedstep rate     run the simulation in fixed steps of 1/rate seconds (0 to follow real time)\n");
+                GetLogger()->Message("  -ticks N            exit after N simulation ticks (in batch mode, end each match after N ticks)\n");
+                GetLogger()->Message("  -batch sceneNNN     run given scene headless until the mission ends, can be given multiple times\n");
+                GetLogger()->Message("  -batchresult file   write the JSON summary of batch matches to file instead of standard output\n");
+                GetLogger()->Message("  -profiletrace N-M   export a profiler trace of frames N to M (see -profiletracefile)\n");
+                GetLogger()->Message("  -profiletracefile file  file to export the profiler trace to (default: profiler_trace.json)\n");
                 return PARSE_ARGS_HELP;
             }
             case OPT_DEBUG:
@@ -401,6 +420,68 @@ ParseArgsStatus CApplication::ParseArguments(int argc, char *argv[])
                 m_headless = true;
                 break;
             }
+            case OPT_FIXEDSTEP:
+            {
+                int rate = -1;
+                if (sscanf(optarg, "%d", &rate) < 1 || rate < 0)
+                {
+                    GetLogger()->Error("Invalid fixed step rate: %s\n", optarg);
+                    return PARSE_ARGS_FAIL;
+                }
+
+                SetFixedStepRate(rate);
+                m_fixedStepOverride = true;
+                break;
+            }
+            case OPT_TICKS:
+            {
+                long long ticks = -1;
+                if (sscanf(optarg, "%lld", &ticks) < 1 || ticks <= 0)
+                {
+                    GetLogger()->Error("Invalid number of ticks: %s\n", optarg);
+                    return PARSE_ARGS_FAIL;
+                }
+
+                m_tickLimit = ticks;
+                GetLogger()->Info("Exiting after %lld simulation ticks\n", ticks);
+                break;
+            }
+            case OPT_BATCH:
+            {
+                if (m_batchRunner == nullptr)
+                    m_batchRunner = MakeUnique<CBatchRunner>(m_systemUtils);
+
+                if (!m_batchRunner->AddMatch(optarg))
+                {
+                    GetLogger()->Error("Invalid batch scene: '%s'\n", optarg);
+                    return PARSE_ARGS_FAIL;
+                }
+                m_headless = true;
+                break;
+            }
+            case OPT_BATCHRESULT:
+            {
+                m_batchResultFile = optarg;
+                break;
+            }
+            case OPT_PROFILETRACE:
+            {
+                long long first = 0, last = 0;
+                if (sscanf(optarg, "%lld-%lld", &first, &last) < 2 || first <= 0 || last < first)
+                {
+                    GetLogger()->Error("Invalid profiler trace frames: %s\n", optarg);
+                    return PARSE_ARGS_FAIL;
+                }
+
+                m_profilerTraceFirstFrame = first;
+                m_profilerTraceLastFrame = last;
+                break;
+            }
+            case OPT_PROFILETRACEFILE:
+            {
+                m_profilerTraceFile = optarg;
+                break;
+            }
             case OPT_DEVICE:
             {
                 m_graphics = optarg;
@@ -467,6 +548,9 @@ ParseArgsStatus CApplication::ParseArguments(int argc, char *argv[])
         }
     }
 
+    if (m_profilerTraceLastFrame > 0)
+        CProfiler::RequestTrace(m_profilerTraceFile, m_profilerTraceFirstFrame, m_profilerTraceLastFrame);
+
     return PARSE_ARGS_OK;
 }
 
@@ -489,6 +573,22 @@ bool CApplication::Create()
         GetLogger()->Warn("Config could not be loaded. Default values will be used!\n");
     }
 
+    int fixedStepRate = 0;
+    if (!m_fixedStepOverride && GetConfigFile().GetIntProperty("Setup", "FixedStepRate", fixedStepRate) && fixedStepRate > 0)
+    {
+        SetFixedStepRate(fixedStepRate);
+    }
+
+    if (m_batchRunner != nullptr)
+    {
+        // Batch matches have to be reproducible
+        if (m_fixedStepRate == 0)
+            SetFixedStepRate(30);
+
+        m_batchRunner->SetTickLimit(m_tickLimit);
+        m_batchRunner->SetResultFile(m_batchResultFile);
+    }
+
     // Create the sound instance.
     #ifdef OPENAL_SOUND
     if (!m_headless)
@@ -690,7 +790,12 @@ bool CApplication::Create()
     "Sound loading thread");
     musicLoadThread.Start();
 
-    if (m_runSceneCategory == LevelCategory::Max)
+    if (m_batchRunner != nullptr)
+    {
+        m_controller->GetRobotMain()->UpdateCustomLevelList(); // To load the userlevels
+        m_batchRunner->Start(m_controller.get());
+    }
+    else if (m_runSceneCategory == LevelCategory::Max)
         m_controller->StartApp();
     else
     {
@@ -1095,10 +1200,14 @@ int CApplication::Run()
 
             CProfiler::StartPerformanceCounter(PCNT_UPDATE_ALL);
 
-            // Prepare and process step simulation event
-            Event event = CreateUpdateEvent();
-            if (event.type != EVENT_NULL && m_controller != nullptr)
+            // Prepare and process step simulation events
+            int ticks = GetPendingSimulationTicks();
+            for (int i = 0; i < ticks; i++)
             {
+                Event event = CreateUpdateEvent();
+                if (event.type == EVENT_NULL || m_controller == nullptr)
+                    break;
+
                 LogEvent(event);
 
                 m_sound->FrameMove(m_relTime);
@@ -1110,21 +1219,41 @@ int CApplication::Run()
                 CProfiler::StartPerformanceCounter(PCNT_UPDATE_ENGINE);
                 m_engine->FrameUpdate();
                 CProfiler::StopPerformanceCounter(PCNT_UPDATE_ENGINE);
+
+                m_tickCount++;
+                if (m_batchRunner == nullptr && m_tickLimit > 0 && m_tickCount >= m_tickLimit)
+                {
+                    GetLogger()->Info("Reached the limit of %lld simulation ticks\n", m_tickLimit);
+                    m_eventQueue->AddEvent(Event(EVENT_SYS_QUIT));
+                    break;
+                }
             }
 
             CProfiler::StopPerformanceCounter(PCNT_UPDATE_ALL);
 
-            /* Update mouse position explicitly right before rendering
-             * because mouse events are usually way behind */
-            UpdateMouse();
+            if (m_batchRunner != nullptr && !m_batchRunner->Update(m_controller.get(), m_tickCount))
+            {
+                m_exitCode = m_batchRunner->GetExitCode();
+                m_eventQueue->AddEvent(Event(EVENT_SYS_QUIT));
+            }
+
+            // In headless fixed step mode, nobody looks at the result - just run the next ticks
+            if (!m_headless || m_fixedStepRate == 0)
+            {
+                /* Update mouse position explicitly right before rendering
+                 * because mouse events are usually way behind */
+                UpdateMouse();
 
-            Render();
+                Render();
+            }
 
             CProfiler::StopPerformanceCounter(PCNT_ALL);
         }
     }
 
 end:
+    CProfiler::LogFrameStatistics();
+
     return m_exitCode;
 }
 
@@ -1455,6 +1584,7 @@ void CApplication::InternalResumeSimulation()
     m_systemUtils->CopyTimeStamp(m_curTimeStamp, m_baseTimeStamp);
     m_realAbsTimeBase = m_realAbsTime;
     m_absTimeBase = m_exactAbsTime;
+    m_fixedStepAccumulator = 0LL;
 }
 
 bool CApplication::GetSimulationSuspended() const
@@ -1473,11 +1603,83 @@ void CApplication::SetSimulationSpeed(float speed)
     GetLogger()->Info("Simulation speed = %.2f\n", speed);
 }
 
+void CApplication::SetFixedStepRate(int rate)
+{
+    m_fixedStepRate = rate;
+    m_fixedStep = rate > 0 ? 1000000000LL / rate : 0LL;
+    InternalResumeSimulation();
+
+    if (rate > 0)
+        GetLogger()->Info("Fixed step simulation, %d ticks per second\n", rate);
+    else
+        GetLogger()->Info("Real time simulation\n");
+}
+
+int CApplication::GetFixedStepRate() const
+{
+    return m_fixedStepRate;
+}
+
+long long CApplication::GetSimulationTickCount() const
+{
+    return m_tickCount;
+}
+
+int CApplication::GetPendingSimulationTicks()
+{
+    if (m_fixedStepRate == 0)
+        return 1;
+
+    if (m_headless)
+        return 1;    // as fast as possible, the main loop doesn't wait for anything
+
+    if (m_simulationSuspended)
+        return 0;
+
+    // Simulation speed changes how much simulation time passes per real time, not the length of a tick
+    m_systemUtils->CopyTimeStamp(m_lastTimeStamp, m_curTimeStamp);
+    m_systemUtils->GetCurrentTimeStamp(m_curTimeStamp);
+    long long realDiff = m_systemUtils->TimeStampExactDiff(m_lastTimeStamp, m_curTimeStamp);
+    if (realDiff > 0)
+        m_fixedStepAccumulator += static_cast<long long>(m_simulationSpeed * realDiff);
+
+    long long ticks = m_fixedStepAccumulator / m_fixedStep;
+    m_fixedStepAccumulator -= ticks * m_fixedStep;
+
+    // If we can't keep up, slow down instead of running more and more ticks per frame
+    const int maxTicksPerFrame = 10;
+    if (ticks > maxTicksPerFrame)
+    {
+        ticks = maxTicksPerFrame;
+        m_fixedStepAccumulator = 0LL;
+    }
+
+    return static_cast<int>(ticks);
+}
+
 Event CApplication::CreateUpdateEvent()
 {
     if (m_simulationSuspended)
         return Event(EVENT_NULL);
 
+    if (m_fixedStepRate > 0)
+    {
+        // Time is counted in ticks, not measured
+        m_exactRelTime = m_fixedStep;
+        m_exactAbsTime += m_fixedStep;
+        m_absTime = m_exactAbsTime / 1e9f;
+        m_relTime = m_exactRelTime / 1e9f;
+
+        m_realRelTime = m_simulationSpeed > 0.0f ? static_cast<long long>(m_fixedStep / m_simulationSpeed) : 0LL;
+        m_realAbsTime += m_realRelTime;
+
+        Event frameEvent(EVENT_FRAME);
+        frameEvent.rTime = m_relTime;
+        m_input->EventProcess(frameEvent);
+
+        return frameEvent;
+    }
+
     m_systemUtils->CopyTimeStamp(m_lastTimeStamp, m_curTimeStamp);
     m_systemUtils->GetCurrentTimeStamp(m_curTimeStamp);
 
@@ -1854,6 +2056,11 @@ bool CApplication::GetSceneTestMode()
     return m_sceneTest;
 }
 
+bool CApplication::GetBatchMode()
+{
+    return m_batchRunner != nullptr;
+}
+
 void CApplication::SetTextInput(bool textInputEnabled)
 {
     if (textInputEnabled)
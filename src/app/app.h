@@ -37,6 +37,7 @@
 #include <vector>
 
 
+class CBatchRunner;
 class CEventQueue;
 class CController;
 class CSoundInterface;
@@ -200,6 +201,22 @@ public:
     float           GetSimulationSpeed() const;
     //@}
 
+    //! Management of fixed step simulation
+    /**
+     * In fixed step mode every simulation tick advances the time by exactly 1/rate seconds,
+     * regardless of how long the frame took, so a game played with the same input gives the same result.
+     * Simulation speed changes the number of ticks run per frame instead of their length.
+     * In headless mode, ticks are run back to back as fast as possible and nothing is rendered.
+     * Rate 0 disables fixed step mode (the default).
+     */
+    //@{
+    void            SetFixedStepRate(int rate);
+    int             GetFixedStepRate() const;
+    //@}
+
+    //! Returns the number of simulation ticks run so far
+    long long       GetSimulationTickCount() const;
+
     //! Returns the absolute time counter [seconds]
     float       GetAbsTime() const;
     //! Returns the exact absolute time counter [nanoseconds]
@@ -265,6 +282,8 @@ public:
     //@}
 
     bool        GetSceneTestMode();
+    //! Returns true if missions are run by CBatchRunner, without user interaction
+    bool        GetBatchMode();
 
     //! Renders the image in window
     void        Render();
@@ -287,6 +306,8 @@ protected:
     Event       CreateVirtualEvent(const Event& sourceEvent);
     //! Prepares a simulation update event
     TEST_VIRTUAL Event CreateUpdateEvent();
+    //! Returns the number of simulation ticks to run in this frame
+    int         GetPendingSimulationTicks();
     //! Logs debug data for event
     void        LogEvent(const Event& event);
 
@@ -319,6 +340,8 @@ protected:
     std::unique_ptr<CInput> m_input;
     //! Path manager
     std::unique_ptr<CPathManager> m_pathManager;
+    //! Batch match runner, only in batch mode
+    std::unique_ptr<CBatchRunner> m_batchRunner;
 
     //! Code to return at exit
     int             m_exitCode;
@@ -357,6 +380,30 @@ protected:
     bool            m_simulationSuspended;
     //@}
 
+    //! Fixed step simulation
+    //@{
+    //! Number of ticks per second of simulation time, 0 if the simulation follows the real time
+    int             m_fixedStepRate = 0;
+    //! Length of one tick [nanoseconds]
+    long long       m_fixedStep = 0LL;
+    //! Simulation time which passed but wasn't simulated yet [nanoseconds]
+    long long       m_fixedStepAccumulator = 0LL;
+    bool            m_fixedStepOverride = false;
+    //@}
+
+    //! Number of simulation ticks run so far
+    long long       m_tickCount = 0LL;
+    //! Exit after this many simulation ticks, 0 for no limit (in batch mode, limit for each match)
+    long long       m_tickLimit = 0LL;
+
+    //! File to write the batch mode summary to
+    std::string     m_batchResultFile;
+
+    //! Frames to export a profiler trace of, given on the command line (see CProfiler::RequestTrace())
+    long long       m_profilerTraceFirstFrame = 0LL;
+    long long       m_profilerTraceLastFrame = 0LL;
+    std::string     m_profilerTraceFile = "profiler_trace.json";
+
     SystemTimeStamp* m_manualFrameLast;
     SystemTimeStamp* m_manualFrameTime;
 
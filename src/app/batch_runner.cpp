@@ -0,0 +1,332 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "app/batch_runner.h"
+
+#include "app/controller.h"
+
+#include "common/logger.h"
+#include "common/profiler.h"
+#include "common/stringutils.h"
+
+#include "common/system/system.h"
+
+#include "level/robotmain.h"
+#include "level/scoreboard.h"
+
+#include "level/parser/parserparam.h"
+
+#include "object/object.h"
+#include "object/object_manager.h"
+
+#include "object/interface/program_storage_object.h"
+
+#include "script/script.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+
+std::string EscapeJson(const std::string& str)
+{
+    std::string result;
+    for (char c : str)
+    {
+        switch (c)
+        {
+            case '"':  result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n";  break;
+            case '\r': result += "\\r";  break;
+            case '\t': result += "\\t";  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    result += StrUtils::Format("\\u%04x", static_cast<unsigned char>(c));
+                else
+                    result += c;
+        }
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+CBatchRunner::CBatchRunner(CSystemUtils* systemUtils)
+    : m_systemUtils(systemUtils)
+{
+    m_matchStartTime = m_systemUtils->CreateTimeStamp();
+    m_currentTime = m_systemUtils->CreateTimeStamp();
+}
+
+CBatchRunner::~CBatchRunner()
+{
+    m_systemUtils->DestroyTimeStamp(m_matchStartTime);
+    m_systemUtils->DestroyTimeStamp(m_currentTime);
+}
+
+bool CBatchRunner::AddMatch(const std::string& scene)
+{
+    if (scene.size() <= 3)
+        return false;
+
+    Match match;
+    match.scene = scene;
+    match.category = GetLevelCategoryFromDir(scene.substr(0, scene.size()-3));
+    match.rank = StrUtils::FromString<int>(scene.substr(scene.size()-3, 3));
+    if (match.category == LevelCategory::Max)
+        return false;
+
+    m_matches.push_back(match);
+    return true;
+}
+
+void CBatchRunner::SetTickLimit(long long ticks)
+{
+    m_tickLimit = ticks;
+}
+
+void CBatchRunner::SetResultFile(const std::string& filename)
+{
+    m_resultFile = filename;
+}
+
+int CBatchRunner::GetExitCode() const
+{
+    return m_exitCode;
+}
+
+void CBatchRunner::Start(CController* controller)
+{
+    m_currentMatch = 0;
+    m_results.clear();
+    StartMatch(controller, 0);
+}
+
+void CBatchRunner::StartMatch(CController* controller, long long tickCount)
+{
+    const Match& match = m_matches[m_currentMatch];
+    GetLogger()->Info("Batch: starting match %d/%d: %s\n", static_cast<int>(m_currentMatch+1), static_cast<int>(m_matches.size()), match.scene.c_str());
+
+    m_matchStartTick = tickCount;
+    m_systemUtils->GetCurrentTimeStamp(m_matchStartTime);
+    controller->StartGame(match.category, match.rank/100, match.rank%100);
+}
+
+bool CBatchRunner::Update(CController* controller, long long tickCount)
+{
+    if (m_currentMatch >= m_matches.size())
+        return false;
+
+    CRobotMain* main = controller->GetRobotMain();
+
+    std::string result;
+    if (main->GetPhase() == PHASE_SIMUL)
+    {
+        Error endResult = main->GetEndMissionResult();
+        if (endResult == ERR_OK)
+            result = "win";
+        else if (endResult == INFO_LOST || endResult == INFO_LOSTq)
+            result = "lost";
+        else if (m_tickLimit > 0 && tickCount - m_matchStartTick >= m_tickLimit)
+            result = "timeout";
+    }
+    else if (main->GetPhase() == PHASE_WIN)
+    {
+        result = "win";
+    }
+    else if (main->GetPhase() == PHASE_LOST)
+    {
+        result = "lost";
+    }
+    else
+    {
+        result = "error";  // the scene failed to load
+    }
+
+    if (result.empty())
+        return true;
+
+    FinishMatch(main, result, tickCount);
+
+    m_currentMatch++;
+    if (m_currentMatch < m_matches.size())
+    {
+        StartMatch(controller, tickCount);
+        return true;
+    }
+
+    if (!WriteSummary())
+        m_exitCode = 2;
+    return false;
+}
+
+void CBatchRunner::FinishMatch(CRobotMain* main, const std::string& result, long long tickCount)
+{
+    m_systemUtils->GetCurrentTimeStamp(m_currentTime);
+
+    MatchResult match;
+    match.scene = m_matches[m_currentMatch].scene;
+    match.result = result;
+    match.gameTime = main->GetGameTime();
+    match.ticks = tickCount - m_matchStartTick;
+    match.realTime = m_systemUtils->TimeStampDiff(m_matchStartTime, m_currentTime, STU_SEC);
+
+    if (result == "timeout" || result == "error")
+        m_exitCode = 1;
+
+    CScoreboard* scoreboard = main->GetScoreboard();
+    if (scoreboard != nullptr)
+    {
+        for (int team : main->GetAllTeams())
+        {
+            match.teams.push_back({ team, main->GetTeamName(team), scoreboard->GetScore(team) });
+        }
+    }
+
+    // Only programs of objects which are still alive are counted
+    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    {
+        if (!obj->Implements(ObjectInterfaceType::ProgramStorage)) continue;
+
+        auto& programs = dynamic_cast<CProgramStorageObject*>(obj)->GetPrograms();
+        for (unsigned int i = 0; i < programs.size(); i++)
+        {
+            CScript* script = programs[i]->script.get();
+            if (script->GetInstructionCount() == 0) continue;
+
+            ProgramResult program;
+            program.objectId = obj->GetID();
+            program.objectType = CLevelParserParam::FromObjectType(obj->GetType());
+            program.team = obj->GetTeam();
+            program.index = i;
+            program.title = script->GetTitle();
+            program.instructions = script->GetInstructionCount();
+            match.programs.push_back(program);
+        }
+    }
+
+    GetLogger()->Info("Batch: match %s finished: %s after %lld ticks (%.2f s of game time, %.2f s of real time)\n",
+                      match.scene.c_str(), match.result.c_str(), match.ticks, match.gameTime, match.realTime);
+
+    m_results.push_back(match);
+}
+
+bool CBatchRunner::WriteSummary()
+{
+    if (m_resultFile.empty())
+    {
+        WriteSummary(std::cout);
+        std::cout.flush();
+        return true;
+    }
+
+    std::ofstream file(m_resultFile);
+    if (!file.good())
+    {
+        GetLogger()->Error("Batch: unable to write results to '%s'\n", m_resultFile.c_str());
+        return false;
+    }
+
+    WriteSummary(file);
+    GetLogger()->Info("Batch: results written to '%s'\n", m_resultFile.c_str());
+    return file.good();
+}
+
+void CBatchRunner::WriteSummary(std::ostream& stream)
+{
+    stream << "{\n  \"matches\": [";
+    for (unsigned int i = 0; i < m_results.size(); i++)
+    {
+        const MatchResult& match = m_results[i];
+        float ticksPerSecond = match.realTime > 0.0f ? match.ticks / match.realTime : 0.0f;
+
+        stream << (i == 0 ? "\n" : ",\n");
+        stream << "    {\n";
+        stream << "      \"scene\": \"" << EscapeJson(match.scene) << "\",\n";
+        stream << "      \"result\": \"" << match.result << "\",\n";
+        stream << "      \"gameTime\": " << match.gameTime << ",\n";
+        stream << "      \"ticks\": " << match.ticks << ",\n";
+        stream << "      \"realTime\": " << match.realTime << ",\n";
+        stream << "      \"ticksPerSecond\": " << ticksPerSecond << ",\n";
+
+        stream << "      \"teams\": [";
+        for (unsigned int j = 0; j < match.teams.size(); j++)
+        {
+            const TeamResult& team = match.teams[j];
+            stream << (j == 0 ? "\n" : ",\n");
+            stream << "        { \"team\": " << team.team
+                   << ", \"name\": \"" << EscapeJson(team.name) << "\""
+                   << ", \"score\": " << team.score << " }";
+        }
+        stream << (match.teams.empty() ? "],\n" : "\n      ],\n");
+
+        stream << "      \"programs\": [";
+        for (unsigned int j = 0; j < match.programs.size(); j++)
+        {
+            const ProgramResult& program = match.programs[j];
+            stream << (j == 0 ? "\n" : ",\n");
+            stream << "        { \"object\": " << program.objectId
+                   << ", \"type\": \"" << EscapeJson(program.objectType) << "\""
+                   << ", \"team\": " << program.team
+                   << ", \"program\": " << program.index
+                   << ", \"title\": \"" << EscapeJson(program.title) << "\""
+                   << ", \"instructions\": " << program.instructions << " }";
+        }
+        stream << (match.programs.empty() ? "]\n" : "\n      ]\n");
+        stream << "    }";
+    }
+    stream << (m_results.empty() ? "],\n" : "\n  ],\n");
+
+    // Times are in milliseconds
+    const FrameStatistics& statistics = CProfiler::GetFrameStatistics();
+    auto writeHistogram = [&stream](const std::string& name, const CTimeHistogram& histogram)
+    {
+        stream << "    \"" << name << "\": { \"p50\": " << histogram.GetPercentile(0.5f) / 1e6f
+               << ", \"p95\": " << histogram.GetPercentile(0.95f) / 1e6f
+               << ", \"p99\": " << histogram.GetPercentile(0.99f) / 1e6f
+               << ", \"max\": " << histogram.GetMax() / 1e6f << " },\n";
+    };
+
+    stream << "  \"frameStatistics\": {\n";
+    stream << "    \"frames\": " << statistics.frameTimes.GetCount() << ",\n";
+    writeHistogram("frameTime", statistics.frameTimes);
+    writeHistogram("updateTime", statistics.updateTimes);
+    stream << "    \"hitchThreshold\": " << CProfiler::GetHitchThreshold() / 1e6f << ",\n";
+    stream << "    \"hitchCount\": " << statistics.hitchCount << ",\n";
+    stream << "    \"hitches\": [";
+    for (unsigned int i = 0; i < statistics.hitches.size(); i++)
+    {
+        const ProfilerHitch& hitch = statistics.hitches[i];
+        long long causeTime = 0;
+        PerformanceCounter cause = CProfiler::GetHitchCause(hitch, &causeTime);
+        stream << (i == 0 ? "\n" : ",\n");
+        stream << "      { \"frame\": " << hitch.frame
+               << ", \"time\": " << hitch.counters[PCNT_ALL] / 1e6f
+               << ", \"update\": " << hitch.counters[PCNT_UPDATE_ALL] / 1e6f
+               << ", \"cbot\": " << hitch.counters[PCNT_UPDATE_CBOT] / 1e6f
+               << ", \"render\": " << hitch.counters[PCNT_RENDER_ALL] / 1e6f
+               << ", \"cause\": \"" << EscapeJson(CProfiler::GetPerformanceCounterName(cause)) << "\""
+               << ", \"causeTime\": " << causeTime / 1e6f << " }";
+    }
+    stream << (statistics.hitches.empty() ? "]\n" : "\n    ]\n");
+    stream << "  }\n";
+    stream << "}\n";
+}
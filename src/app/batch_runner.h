@@ -0,0 +1,128 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file app/batch_runner.h
+ * \brief CBatchRunner class
+ */
+
+#pragma once
+
+#include "level/level_category.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+class CController;
+class CRobotMain;
+class CSystemUtils;
+struct SystemTimeStamp;
+
+/**
+ * \class CBatchRunner
+ * \brief Runs a list of missions one after another without user interaction
+ *
+ * Used with the -batch command line switch. Each match is run until the mission ends
+ * (see CRobotMain::GetEndMissionResult()) or the tick limit is reached, then the next
+ * one is loaded. When all matches are done, a JSON summary is written, together with
+ * the frame statistics of the whole run (see CProfiler::GetFrameStatistics()).
+ */
+class CBatchRunner
+{
+public:
+    CBatchRunner(CSystemUtils* systemUtils);
+    ~CBatchRunner();
+
+    //! Adds a match to run, the scene is given like for -runscene (e.g. "custom101")
+    /** \return false if the scene name is invalid */
+    bool AddMatch(const std::string& scene);
+
+    //! Sets the maximum number of simulation ticks of each match, 0 for no limit
+    void SetTickLimit(long long ticks);
+    //! Sets the file to write the summary to, empty to write it to the standard output
+    void SetResultFile(const std::string& filename);
+
+    //! Starts the first match
+    void Start(CController* controller);
+    //! Checks the state of the current match, called once per main loop iteration
+    /**
+     * \param tickCount total number of simulation ticks run by the application
+     * \return false when all matches are finished and the application should exit
+     */
+    bool Update(CController* controller, long long tickCount);
+
+    //! Returns the exit code for the application
+    /** 0 if all matches ended normally, 1 if any of them failed to load or reached the tick limit, 2 if the summary could not be written */
+    int GetExitCode() const;
+
+private:
+    struct Match
+    {
+        std::string scene;
+        LevelCategory category;
+        int rank;
+    };
+
+    struct TeamResult
+    {
+        int team;
+        std::string name;
+        int score;
+    };
+
+    struct ProgramResult
+    {
+        int objectId;
+        std::string objectType;
+        int team;
+        int index;
+        std::string title;
+        long long instructions;
+    };
+
+    struct MatchResult
+    {
+        std::string scene;
+        std::string result;
+        float gameTime;
+        long long ticks;
+        float realTime;
+        std::vector<TeamResult> teams;
+        std::vector<ProgramResult> programs;
+    };
+
+    void StartMatch(CController* controller, long long tickCount);
+    void FinishMatch(CRobotMain* main, const std::string& result, long long tickCount);
+    bool WriteSummary();
+    void WriteSummary(std::ostream& stream);
+
+private:
+    CSystemUtils* m_systemUtils;
+    SystemTimeStamp* m_matchStartTime;
+    SystemTimeStamp* m_currentTime;
+
+    std::vector<Match> m_matches;
+    std::vector<MatchResult> m_results;
+    std::size_t m_currentMatch = 0;
+    long long m_matchStartTick = 0;
+    long long m_tickLimit = 0;
+    std::string m_resultFile;
+    int m_exitCode = 0;
+};
@@ -113,7 +113,7 @@ int main(int argc, char *argv[])
     auto systemUtils = CSystemUtils::Create(); // platform-specific utils
     systemUtils->Init();
 
-    CProfiler::SetSystemUtils(systemUtils.get());
+    CProfiler::SetThreadName("Main thread");
 
     // Add file output to the logger
     std::string logFileName;
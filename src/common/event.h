@@ -401,6 +401,7 @@ enum EventType
     EVENT_DBG_CRASHSPHERES  = 856,
     EVENT_DBG_LIGHTS        = 857,
     EVENT_DBG_LIGHTS_DUMP   = 858,
+    EVENT_DBG_PROFILER_TRACE = 859,
 
     EVENT_SPAWN_CANCEL      = 860,
     EVENT_SPAWN_ME          = 861,
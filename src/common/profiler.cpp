@@ -19,46 +19,302 @@
 
 #include "common/profiler.h"
 
-#include "common/system/system.h"
+#include "common/logger.h"
+#include "common/make_unique.h"
+#include "common/stringutils.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
 
-CSystemUtils* CProfiler::m_systemUtils = nullptr;
-long long CProfiler::m_performanceCounters[PCNT_MAX] = {0};
-long long CProfiler::m_prevPerformanceCounters[PCNT_MAX] = {0};
-std::stack<SystemTimeStamp*> CProfiler::m_runningPerformanceCounters;
-std::stack<PerformanceCounter> CProfiler::m_runningPerformanceCountersType;
+namespace
+{
+
+//! Zone names of PerformanceCounter counters
+const char* const COUNTER_ZONE_NAMES[PCNT_MAX] =
+{
+    "Event processing",
+    "Frame update",
+    "Engine update",
+    "Particle update",
+    "Game update",
+    "CBot programs",
+    "Frame render",
+    "Particle render",
+    "Interface particle render",
+    "Water render",
+    "Terrain render",
+    "Objects render",
+    "Interface render",
+    "Shadow map render",
+    "Swap buffers",
+    "Frame",
+};
+
+//! Counter each counter is nested in, PCNT_MAX for PCNT_ALL
+const PerformanceCounter COUNTER_PARENTS[PCNT_MAX] =
+{
+    PCNT_ALL,                   // PCNT_EVENT_PROCESSING
+    PCNT_ALL,                   // PCNT_UPDATE_ALL
+    PCNT_UPDATE_ALL,            // PCNT_UPDATE_ENGINE
+    PCNT_UPDATE_ENGINE,         // PCNT_UPDATE_PARTICLE
+    PCNT_UPDATE_ALL,            // PCNT_UPDATE_GAME
+    PCNT_UPDATE_GAME,           // PCNT_UPDATE_CBOT
+    PCNT_ALL,                   // PCNT_RENDER_ALL
+    PCNT_RENDER_ALL,            // PCNT_RENDER_PARTICLE_WORLD
+    PCNT_RENDER_INTERFACE,      // PCNT_RENDER_PARTICLE_IFACE
+    PCNT_RENDER_ALL,            // PCNT_RENDER_WATER
+    PCNT_RENDER_ALL,            // PCNT_RENDER_TERRAIN
+    PCNT_RENDER_ALL,            // PCNT_RENDER_OBJECTS
+    PCNT_RENDER_ALL,            // PCNT_RENDER_INTERFACE
+    PCNT_RENDER_ALL,            // PCNT_RENDER_SHADOW_MAP
+    PCNT_ALL,                   // PCNT_SWAP_BUFFERS
+    PCNT_MAX,                   // PCNT_ALL
+};
+
+//! Durations up to this one (in nanoseconds) go to the first histogram bucket
+const double HISTOGRAM_MIN_TIME = 1e5;
+//! Ratio of the ends of consecutive histogram buckets
+const double HISTOGRAM_BUCKET_RATIO = 1.05;
+
+//! Number of frames in one period of recent frame statistics
+const long long RECENT_FRAMES = 300;
+//! Number of hitches kept in frame statistics
+const std::size_t MAX_HITCHES = 16;
+
+//! Zones nested deeper than this are not recorded
+const int MAX_ZONE_DEPTH = 64;
+//! Number of finished zones kept for each thread
+const std::size_t ZONE_BUFFER_SIZE = 1 << 15;
+
+struct ZoneRecord
+{
+    const char* name = nullptr;
+    long long   frame = 0;
+    long long   start = 0;
+    long long   end = 0;
+};
+
+struct RunningZone
+{
+    const char* name = nullptr;
+    long long   frame = 0;
+    long long   start = 0;
+};
+
+struct ThreadBuffer
+{
+    int         id = 0;
+
+    //! Guards the fields below, only contended while a trace is exported
+    std::mutex  mutex;
+    std::string name;
+    std::vector<ZoneRecord> records;
+    std::size_t next = 0;
+
+    //! Zones started but not stopped yet, only used by the thread itself
+    RunningZone running[MAX_ZONE_DEPTH];
+    int         depth = 0;
+};
+
+//! Buffers of all threads which ever used the profiler, they are kept after the thread ends
+std::mutex g_threadBuffersMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> g_threadBuffers;
+thread_local ThreadBuffer* t_threadBuffer = nullptr;
+
+std::mutex g_zoneNamesMutex;
+std::unordered_set<std::string> g_zoneNames;
+
+std::atomic<long long> g_frame(0);
+
+long long GetTime()
+{
+    auto time = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+}
+
+ThreadBuffer& GetThreadBuffer()
+{
+    if (t_threadBuffer == nullptr)
+    {
+        auto buffer = MakeUnique<ThreadBuffer>();
+
+        std::lock_guard<std::mutex> lock(g_threadBuffersMutex);
+        buffer->id = static_cast<int>(g_threadBuffers.size()) + 1;
+        buffer->name = "Thread " + StrUtils::ToString(buffer->id);
+        t_threadBuffer = buffer.get();
+        g_threadBuffers.push_back(std::move(buffer));
+    }
+    return *t_threadBuffer;
+}
+
+//! Stops the last zone of the current thread, returns its duration
+/** \param expectedName if not null, name the zone should have */
+long long FinishZone(const char* expectedName = nullptr)
+{
+    long long end = GetTime();
+
+    ThreadBuffer& buffer = GetThreadBuffer();
+    assert(buffer.depth > 0);
+    buffer.depth--;
+    if (buffer.depth >= MAX_ZONE_DEPTH)
+        return 0;
+
+    const RunningZone& zone = buffer.running[buffer.depth];
+    assert(expectedName == nullptr || zone.name == expectedName);
+
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.records.empty())  // allocated on first use, threads which only have a name don't need it
+        buffer.records.resize(ZONE_BUFFER_SIZE);
+    ZoneRecord& record = buffer.records[buffer.next % ZONE_BUFFER_SIZE];
+    record.name = zone.name;
+    record.frame = zone.frame;
+    record.start = zone.start;
+    record.end = end;
+    buffer.next++;
+
+    return end - zone.start;
+}
+
+void AddHitches(FrameStatistics& statistics, const std::vector<ProfilerHitch>& hitches)
+{
+    statistics.hitches.insert(statistics.hitches.end(), hitches.begin(), hitches.end());
+    if (statistics.hitches.size() > MAX_HITCHES)
+        statistics.hitches.erase(statistics.hitches.begin(), statistics.hitches.end() - MAX_HITCHES);
+}
+
+void AddFrame(FrameStatistics& statistics, const ProfilerHitch& frame, bool hitch)
+{
+    statistics.frameTimes.Add(frame.counters[PCNT_ALL]);
+    statistics.updateTimes.Add(frame.counters[PCNT_UPDATE_ALL]);
+    if (hitch)
+    {
+        statistics.hitchCount++;
+        AddHitches(statistics, { frame });
+    }
+}
 
-void CProfiler::SetSystemUtils(CSystemUtils* systemUtils)
+std::string EscapeJson(const std::string& str)
 {
-    m_systemUtils = systemUtils;
+    std::string result;
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+            result += std::string("\\") + c;
+        else if (static_cast<unsigned char>(c) < 0x20)
+            result += StrUtils::Format("\\u%04x", static_cast<unsigned char>(c));
+        else
+            result += c;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+CTimeHistogram::CTimeHistogram()
+{
+    Clear();
+}
+
+void CTimeHistogram::Add(long long time)
+{
+    int bucket = 0;
+    if (time > HISTOGRAM_MIN_TIME)
+    {
+        bucket = static_cast<int>(std::ceil(std::log(time / HISTOGRAM_MIN_TIME) / std::log(HISTOGRAM_BUCKET_RATIO)));
+        bucket = std::min(bucket, BUCKET_COUNT - 1);
+    }
+
+    m_buckets[bucket]++;
+    m_count++;
+    m_max = std::max(m_max, time);
 }
 
+void CTimeHistogram::Add(const CTimeHistogram& other)
+{
+    for (int i = 0; i < BUCKET_COUNT; i++)
+        m_buckets[i] += other.m_buckets[i];
+    m_count += other.m_count;
+    m_max = std::max(m_max, other.m_max);
+}
+
+void CTimeHistogram::Clear()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_max = 0;
+}
+
+long long CTimeHistogram::GetCount() const
+{
+    return m_count;
+}
+
+long long CTimeHistogram::GetMax() const
+{
+    return m_max;
+}
+
+long long CTimeHistogram::GetPercentile(float fraction) const
+{
+    if (m_count == 0)
+        return 0;
+
+    long long rank = std::max(static_cast<long long>(std::ceil(fraction * m_count)), 1LL);
+    long long count = 0;
+    int bucket = 0;
+    for (; bucket < BUCKET_COUNT - 1; bucket++)
+    {
+        count += m_buckets[bucket];
+        if (count >= rank) break;
+    }
+
+    long long bucketEnd = static_cast<long long>(HISTOGRAM_MIN_TIME * std::pow(HISTOGRAM_BUCKET_RATIO, bucket));
+    return std::min(bucketEnd, m_max);
+}
+
+long long CProfiler::m_performanceCounters[PCNT_MAX] = {0};
+long long CProfiler::m_prevPerformanceCounters[PCNT_MAX] = {0};
+std::string CProfiler::m_traceFile;
+long long CProfiler::m_traceFirstFrame = 0;
+long long CProfiler::m_traceLastFrame = 0;
+long long CProfiler::m_hitchThreshold = 100000000LL;
+FrameStatistics CProfiler::m_frameStatistics;
+FrameStatistics CProfiler::m_recentFrameStatistics[2];
+
 void CProfiler::StartPerformanceCounter(PerformanceCounter counter)
 {
     if (counter == PCNT_ALL)
+    {
         ResetPerformanceCounters();
+        g_frame++;
+    }
 
-    SystemTimeStamp* timeStamp = m_systemUtils->CreateTimeStamp();
-    m_systemUtils->GetCurrentTimeStamp(timeStamp);
-    m_runningPerformanceCounters.push(timeStamp);
-    m_runningPerformanceCountersType.push(counter);
+    StartZone(COUNTER_ZONE_NAMES[counter]);
 }
 
 void CProfiler::StopPerformanceCounter(PerformanceCounter counter)
 {
-    assert(m_runningPerformanceCountersType.top() == counter);
-    m_runningPerformanceCountersType.pop();
-
-    SystemTimeStamp* timeStamp = m_systemUtils->CreateTimeStamp();
-    m_systemUtils->GetCurrentTimeStamp(timeStamp);
-    m_performanceCounters[counter] += m_systemUtils->TimeStampExactDiff(m_runningPerformanceCounters.top(), timeStamp);
-    m_systemUtils->DestroyTimeStamp(timeStamp);
-    m_systemUtils->DestroyTimeStamp(m_runningPerformanceCounters.top());
-    m_runningPerformanceCounters.pop();
+    m_performanceCounters[counter] += FinishZone(COUNTER_ZONE_NAMES[counter]);
 
     if (counter == PCNT_ALL)
+    {
         SavePerformanceCounters();
+        RecordFrameStatistics();
+
+        if (!m_traceFile.empty() && GetFrame() >= m_traceLastFrame)
+        {
+            ExportTrace(m_traceFile, m_traceFirstFrame, m_traceLastFrame);
+            m_traceFile.clear();
+        }
+    }
 }
 
 long long CProfiler::GetPerformanceCounterTime(PerformanceCounter counter)
@@ -71,6 +327,218 @@ float CProfiler::GetPerformanceCounterFraction(PerformanceCounter counter)
     return static_cast<float>(m_prevPerformanceCounters[counter]) / static_cast<float>(m_prevPerformanceCounters[PCNT_ALL]);
 }
 
+const char* CProfiler::GetPerformanceCounterName(PerformanceCounter counter)
+{
+    return COUNTER_ZONE_NAMES[counter];
+}
+
+const char* CProfiler::GetZoneName(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(g_zoneNamesMutex);
+    return g_zoneNames.insert(name).first->c_str();
+}
+
+void CProfiler::StartZone(const char* name)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    if (buffer.depth < MAX_ZONE_DEPTH)
+    {
+        RunningZone& zone = buffer.running[buffer.depth];
+        zone.name = name;
+        zone.frame = g_frame.load(std::memory_order_relaxed);
+        zone.start = GetTime();
+    }
+    buffer.depth++;
+}
+
+void CProfiler::StopZone()
+{
+    FinishZone();
+}
+
+void CProfiler::SetThreadName(const std::string& name)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
+
+long long CProfiler::GetFrame()
+{
+    return g_frame.load(std::memory_order_relaxed);
+}
+
+bool CProfiler::ExportTrace(const std::string& filename, long long firstFrame, long long lastFrame)
+{
+    struct ThreadInfo
+    {
+        int         id;
+        std::string name;
+    };
+    struct TraceZone
+    {
+        int         threadId;
+        ZoneRecord  record;
+    };
+
+    std::vector<ThreadInfo> threads;
+    std::vector<TraceZone> zones;
+    {
+        std::lock_guard<std::mutex> lock(g_threadBuffersMutex);
+        for (const auto& buffer : g_threadBuffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            threads.push_back({ buffer->id, buffer->name });
+
+            std::size_t count = std::min(buffer->next, ZONE_BUFFER_SIZE);
+            for (std::size_t i = buffer->next - count; i < buffer->next; i++)
+            {
+                const ZoneRecord& record = buffer->records[i % ZONE_BUFFER_SIZE];
+                if (record.frame < firstFrame || record.frame > lastFrame) continue;
+                zones.push_back({ buffer->id, record });
+            }
+        }
+    }
+
+    std::sort(zones.begin(), zones.end(), [](const TraceZone& a, const TraceZone& b)
+    {
+        return a.record.start < b.record.start;
+    });
+
+    std::ofstream file(filename);
+    if (!file.good())
+    {
+        GetLogger()->Error("Unable to write profiler trace to '%s'\n", filename.c_str());
+        return false;
+    }
+
+    long long origin = zones.empty() ? 0 : zones.front().record.start;
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const ThreadInfo& thread : threads)
+    {
+        file << (first ? "\n" : ",\n");
+        first = false;
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.id
+             << ",\"args\":{\"name\":\"" << EscapeJson(thread.name) << "\"}}";
+    }
+    for (const TraceZone& zone : zones)
+    {
+        file << (first ? "\n" : ",\n");
+        first = false;
+        const char* name = zone.record.name != nullptr ? zone.record.name : "?";
+        file << "{\"name\":\"" << EscapeJson(name) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << zone.threadId
+             << ",\"ts\":" << StrUtils::Format("%.3f", (zone.record.start - origin) / 1000.0)
+             << ",\"dur\":" << StrUtils::Format("%.3f", (zone.record.end - zone.record.start) / 1000.0)
+             << ",\"args\":{\"frame\":" << zone.record.frame << "}}";
+    }
+    file << "\n]}\n";
+
+    if (!file.good())
+    {
+        GetLogger()->Error("Unable to write profiler trace to '%s'\n", filename.c_str());
+        return false;
+    }
+
+    GetLogger()->Info("Profiler trace of frames %lld to %lld written to '%s' (%d zones)\n",
+                      firstFrame, lastFrame, filename.c_str(), static_cast<int>(zones.size()));
+    return true;
+}
+
+void CProfiler::RequestTrace(const std::string& filename, long long firstFrame, long long lastFrame)
+{
+    m_traceFile = filename;
+    m_traceFirstFrame = firstFrame;
+    m_traceLastFrame = lastFrame;
+}
+
+void CProfiler::SetHitchThreshold(long long time)
+{
+    m_hitchThreshold = time;
+}
+
+long long CProfiler::GetHitchThreshold()
+{
+    return m_hitchThreshold;
+}
+
+PerformanceCounter CProfiler::GetHitchCause(const ProfilerHitch& hitch, long long* time)
+{
+    long long selfTimes[PCNT_MAX];
+    for (int i = 0; i < PCNT_MAX; ++i)
+        selfTimes[i] = hitch.counters[i];
+    for (int i = 0; i < PCNT_MAX; ++i)
+    {
+        if (COUNTER_PARENTS[i] != PCNT_MAX)
+            selfTimes[COUNTER_PARENTS[i]] -= hitch.counters[i];
+    }
+
+    int cause = PCNT_ALL;
+    for (int i = 0; i < PCNT_MAX; ++i)
+    {
+        if (selfTimes[i] > selfTimes[cause])
+            cause = i;
+    }
+
+    if (time != nullptr)
+        *time = selfTimes[cause];
+    return static_cast<PerformanceCounter>(cause);
+}
+
+const FrameStatistics& CProfiler::GetFrameStatistics()
+{
+    return m_frameStatistics;
+}
+
+FrameStatistics CProfiler::GetRecentFrameStatistics()
+{
+    FrameStatistics statistics = m_recentFrameStatistics[0];
+    const FrameStatistics& current = m_recentFrameStatistics[1];
+    statistics.frameTimes.Add(current.frameTimes);
+    statistics.updateTimes.Add(current.updateTimes);
+    statistics.hitchCount += current.hitchCount;
+    AddHitches(statistics, current.hitches);
+    return statistics;
+}
+
+void CProfiler::ResetFrameStatistics()
+{
+    m_frameStatistics = FrameStatistics();
+    m_recentFrameStatistics[0] = FrameStatistics();
+    m_recentFrameStatistics[1] = FrameStatistics();
+}
+
+void CProfiler::LogFrameStatistics()
+{
+    const FrameStatistics& statistics = m_frameStatistics;
+    if (statistics.frameTimes.GetCount() == 0)
+        return;
+
+    auto logHistogram = [](const char* name, const CTimeHistogram& histogram)
+    {
+        GetLogger()->Info("  %s: p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms\n", name,
+                          histogram.GetPercentile(0.5f) / 1e6f, histogram.GetPercentile(0.95f) / 1e6f,
+                          histogram.GetPercentile(0.99f) / 1e6f, histogram.GetMax() / 1e6f);
+    };
+
+    GetLogger()->Info("Frame statistics of %lld frames:\n", statistics.frameTimes.GetCount());
+    logHistogram("frame time", statistics.frameTimes);
+    logHistogram("update time", statistics.updateTimes);
+
+    if (m_hitchThreshold <= 0)
+        return;
+
+    GetLogger()->Info("  %lld frames longer than %.2f ms, the last ones:\n", statistics.hitchCount, m_hitchThreshold / 1e6f);
+    for (const ProfilerHitch& hitch : statistics.hitches)
+    {
+        long long causeTime = 0;
+        PerformanceCounter cause = GetHitchCause(hitch, &causeTime);
+        GetLogger()->Info("    frame %lld: %.2f ms, longest part: %s (%.2f ms)\n", hitch.frame,
+                          hitch.counters[PCNT_ALL] / 1e6f, GetPerformanceCounterName(cause), causeTime / 1e6f);
+    }
+}
+
 void CProfiler::ResetPerformanceCounters()
 {
     for (int i = 0; i < PCNT_MAX; ++i)
@@ -81,10 +549,36 @@ void CProfiler::ResetPerformanceCounters()
 
 void CProfiler::SavePerformanceCounters()
 {
-    assert(m_runningPerformanceCounters.empty());
+    assert(GetThreadBuffer().depth == 0);
 
     for (int i = 0; i < PCNT_MAX; ++i)
     {
         m_prevPerformanceCounters[i] = m_performanceCounters[i];
     }
 }
+
+void CProfiler::RecordFrameStatistics()
+{
+    ProfilerHitch frame;
+    frame.frame = GetFrame();
+    for (int i = 0; i < PCNT_MAX; ++i)
+        frame.counters[i] = m_performanceCounters[i];
+
+    bool hitch = m_hitchThreshold > 0 && frame.counters[PCNT_ALL] > m_hitchThreshold;
+    if (hitch)
+    {
+        long long causeTime = 0;
+        PerformanceCounter cause = GetHitchCause(frame, &causeTime);
+        GetLogger()->Info("Hitch in frame %lld: %.2f ms, longest part: %s (%.2f ms)\n", frame.frame,
+                          frame.counters[PCNT_ALL] / 1e6f, GetPerformanceCounterName(cause), causeTime / 1e6f);
+    }
+
+    if (m_recentFrameStatistics[1].frameTimes.GetCount() >= RECENT_FRAMES)
+    {
+        m_recentFrameStatistics[0] = std::move(m_recentFrameStatistics[1]);
+        m_recentFrameStatistics[1] = FrameStatistics();
+    }
+
+    AddFrame(m_frameStatistics, frame, hitch);
+    AddFrame(m_recentFrameStatistics[1], frame, hitch);
+}
@@ -19,10 +19,9 @@
 
 #pragma once
 
-class CSystemUtils;
-struct SystemTimeStamp;
-
-#include <stack>
+#include <array>
+#include <string>
+#include <vector>
 
 /**
  * \enum PerformanceCounter
@@ -54,27 +53,171 @@ enum PerformanceCounter
     PCNT_MAX
 };
 
-class CProfiler
+/**
+ * \class CTimeHistogram
+ * \brief Distribution of durations, used to get percentiles of frame times
+ *
+ * Buckets grow exponentially by 5%, so percentiles are precise to about 5%
+ * whatever the durations are, and adding a duration takes constant time.
+ */
+class CTimeHistogram
 {
 public:
-    static void SetSystemUtils(CSystemUtils* systemUtils);
+    CTimeHistogram();
+
+    //! Adds a duration in nanoseconds
+    void Add(long long time);
+    //! Adds all durations of other histogram
+    void Add(const CTimeHistogram& other);
+    //! Removes all durations
+    void Clear();
+
+    //! Returns the number of durations added
+    long long GetCount() const;
+    //! Returns the longest duration added, 0 if there is none
+    long long GetMax() const;
+    //! Returns the duration that given fraction (0 to 1) of added durations does not exceed
+    long long GetPercentile(float fraction) const;
+
+private:
+    static const int BUCKET_COUNT = 300;
+
+    std::array<long long, BUCKET_COUNT> m_buckets;
+    long long m_count;
+    long long m_max;
+};
+
+/**
+ * \struct ProfilerHitch
+ * \brief Performance counters of a frame which took longer than the hitch threshold
+ */
+struct ProfilerHitch
+{
+    long long frame = 0;
+    long long counters[PCNT_MAX] = {};
+};
+
+/**
+ * \struct FrameStatistics
+ * \brief Distribution of frame times and the hitches seen over some period
+ */
+struct FrameStatistics
+{
+    //! Times of PCNT_ALL
+    CTimeHistogram frameTimes;
+    //! Times of PCNT_UPDATE_ALL
+    CTimeHistogram updateTimes;
+    //! Number of frames longer than the hitch threshold
+    long long hitchCount = 0;
+    //! Last few hitches, oldest first
+    std::vector<ProfilerHitch> hitches;
+};
 
+/**
+ * \class CProfiler
+ * \brief Measures the time spent in named zones of code
+ *
+ * Zones are started and stopped on each thread like a stack, so they form a hierarchy.
+ * Every finished zone is recorded in a ring buffer of its thread, the buffers keep
+ * the last few seconds of the game so that a hitch can be looked at after it happened.
+ * The recorded zones can be exported for given frames as a Chrome trace
+ * (open it with chrome://tracing or https://ui.perfetto.dev).
+ *
+ * The PerformanceCounter counters are zones too, their total time over the previous
+ * frame is also kept for the stats overlay (see CEngine::DrawStats()).
+ * PCNT_ALL is the zone of the whole frame and starting it begins a new frame.
+ *
+ * Frame and update times of all frames are gathered in histograms (see FrameStatistics),
+ * and the counters of every frame longer than the hitch threshold are kept and logged,
+ * so that it is known afterwards what caused the hitch.
+ */
+class CProfiler
+{
+public:
     static void StartPerformanceCounter(PerformanceCounter counter);
     static void StopPerformanceCounter(PerformanceCounter counter);
     static long long GetPerformanceCounterTime(PerformanceCounter counter);
     static float GetPerformanceCounterFraction(PerformanceCounter counter);
+    //! Returns the name of the counter, which is also the name of its zone
+    static const char* GetPerformanceCounterName(PerformanceCounter counter);
+
+    //! Returns a copy of name that stays valid until the end of the program, to be used as zone name
+    static const char* GetZoneName(const std::string& name);
+    //! Starts a zone on the current thread, name has to stay valid until the end of the program
+    static void StartZone(const char* name);
+    //! Stops the last zone started on the current thread
+    static void StopZone();
+    //! Sets the name of the current thread, as shown in exported traces
+    static void SetThreadName(const std::string& name);
+
+    //! Returns the number of the current frame
+    static long long GetFrame();
+
+    //! Writes the recorded zones of frames from firstFrame to lastFrame to a file in Chrome trace format
+    /** Only the frames still kept in the ring buffers can be exported */
+    static bool ExportTrace(const std::string& filename, long long firstFrame, long long lastFrame);
+    //! Exports a trace with ExportTrace() as soon as lastFrame is finished
+    static void RequestTrace(const std::string& filename, long long firstFrame, long long lastFrame);
+
+    //! Sets the frame time in nanoseconds above which a frame is a hitch, 0 to disable hitch detection
+    static void SetHitchThreshold(long long time);
+    static long long GetHitchThreshold();
+    //! Returns the counter which took most of the hitch, not counting the time of counters nested in it
+    /** \param[out] time if not null, time of the returned counter without its nested counters */
+    static PerformanceCounter GetHitchCause(const ProfilerHitch& hitch, long long* time = nullptr);
+
+    //! Returns statistics of all frames since the start or the last ResetFrameStatistics()
+    static const FrameStatistics& GetFrameStatistics();
+    //! Returns statistics of the last few hundred frames
+    static FrameStatistics GetRecentFrameStatistics();
+    //! Forgets all frame statistics
+    static void ResetFrameStatistics();
+    //! Writes the statistics of all frames to the log
+    static void LogFrameStatistics();
 
 private:
     static void ResetPerformanceCounters();
     static void SavePerformanceCounters();
+    static void RecordFrameStatistics();
 
 private:
-    static CSystemUtils* m_systemUtils;
-
     static long long m_performanceCounters[PCNT_MAX];
     static long long m_prevPerformanceCounters[PCNT_MAX];
-    static std::stack<SystemTimeStamp*> m_runningPerformanceCounters;
-    static std::stack<PerformanceCounter> m_runningPerformanceCountersType;
-};
 
+    static std::string m_traceFile;
+    static long long m_traceFirstFrame;
+    static long long m_traceLastFrame;
+
+    static long long m_hitchThreshold;
+    static FrameStatistics m_frameStatistics;
+    //! Statistics of the current and the previous period of recent frames
+    static FrameStatistics m_recentFrameStatistics[2];
+};
 
+/**
+ * \class CProfilerZone
+ * \brief Profiler zone lasting as long as the object exists
+ *
+ * \code
+ * {
+ *     CProfilerZone zone("Physics");
+ *     ...
+ * }
+ * \endcode
+ */
+class CProfilerZone
+{
+public:
+    explicit CProfilerZone(const char* name)
+    {
+        CProfiler::StartZone(name);
+    }
+
+    ~CProfilerZone()
+    {
+        CProfiler::StopZone();
+    }
+
+    CProfilerZone(const CProfilerZone&) = delete;
+    CProfilerZone& operator=(const CProfilerZone&) = delete;
+};
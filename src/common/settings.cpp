@@ -24,9 +24,11 @@
 
 #include "common/config_file.h"
 #include "common/logger.h"
+#include "common/profiler.h"
 
 #include "graphics/engine/camera.h"
 #include "graphics/engine/engine.h"
+#include "graphics/engine/particle.h"
 
 #include "level/robotmain.h"
 
@@ -88,11 +90,16 @@ void CSettings::SaveSettings()
     GetConfigFile().SetBoolProperty("Setup", "Autosave", main->GetAutosave());
     GetConfigFile().SetIntProperty("Setup", "AutosaveInterval", main->GetAutosaveInterval());
     GetConfigFile().SetIntProperty("Setup", "AutosaveSlots", main->GetAutosaveSlots());
+    GetConfigFile().SetIntProperty("Setup", "ScriptThreads", main->GetScriptThreads());
+    GetConfigFile().SetBoolProperty("Setup", "ScriptBytecode", main->GetScriptBytecode());
+    GetConfigFile().SetStringProperty("Setup", "PathPlanner", GetPathPlannerName(main->GetPathPlanner()));
     GetConfigFile().SetBoolProperty("Setup", "ObjectDirty", engine->GetDirty());
     GetConfigFile().SetBoolProperty("Setup", "FogMode", engine->GetFog());
     GetConfigFile().SetBoolProperty("Setup", "LightMode", engine->GetLightMode());
     GetConfigFile().SetIntProperty("Setup", "JoystickIndex", app->GetJoystickEnabled() ? app->GetJoystick().index : -1);
     GetConfigFile().SetFloatProperty("Setup", "ParticleDensity", engine->GetParticleDensity());
+    GetConfigFile().SetIntProperty("Setup", "ParticleLimit", engine->GetParticle()->GetParticleLimit());
+    GetConfigFile().SetIntProperty("Setup", "HitchThreshold", static_cast<int>(CProfiler::GetHitchThreshold() / 1000000));
     GetConfigFile().SetFloatProperty("Setup", "ClippingDistance", engine->GetClippingDistance());
     GetConfigFile().SetIntProperty("Setup", "AudioVolume", sound->GetAudioVolume());
     GetConfigFile().SetIntProperty("Setup", "MusicVolume", sound->GetMusicVolume());
@@ -180,6 +187,15 @@ void CSettings::LoadSettings()
     if (GetConfigFile().GetIntProperty("Setup", "AutosaveSlots", iValue))
         main->SetAutosaveSlots(iValue);
 
+    if (GetConfigFile().GetIntProperty("Setup", "ScriptThreads", iValue))
+        main->SetScriptThreads(iValue);
+
+    if (GetConfigFile().GetBoolProperty("Setup", "ScriptBytecode", bValue))
+        main->SetScriptBytecode(bValue);
+
+    if (GetConfigFile().GetStringProperty("Setup", "PathPlanner", sValue))
+        main->SetPathPlanner(ParsePathPlannerType(sValue, PathPlannerType::Beam));
+
     if (GetConfigFile().GetBoolProperty("Setup", "ObjectDirty", bValue))
         engine->SetDirty(bValue);
 
@@ -215,6 +231,12 @@ void CSettings::LoadSettings()
     if (GetConfigFile().GetFloatProperty("Setup", "ParticleDensity", fValue))
         engine->SetParticleDensity(fValue);
 
+    if (GetConfigFile().GetIntProperty("Setup", "ParticleLimit", iValue))
+        engine->GetParticle()->SetParticleLimit(iValue);
+
+    if (GetConfigFile().GetIntProperty("Setup", "HitchThreshold", iValue))
+        CProfiler::SetHitchThreshold(static_cast<long long>(iValue) * 1000000);
+
     if (GetConfigFile().GetFloatProperty("Setup", "ClippingDistance", fValue))
         engine->SetClippingDistance(fValue);
 
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "common/make_unique.h"
+#include "common/profiler.h"
 
 #include "common/thread/resource_owning_thread.h"
 
@@ -40,6 +41,7 @@ private:
     struct ThreadData
     {
         ThreadFunctionPtr func;
+        std::string name;
     };
 
 public:
@@ -52,6 +54,7 @@ public:
     {
         std::unique_ptr<ThreadData> data = MakeUnique<ThreadData>();
         data->func = m_func;
+        data->name = m_name;
         m_thread = MakeUnique<CResourceOwningThread<ThreadData>>(Run, std::move(data), m_name);
         m_thread->Start();
     }
@@ -68,6 +71,8 @@ public:
 private:
     static void Run(std::unique_ptr<ThreadData> data)
     {
+        if (!data->name.empty())
+            CProfiler::SetThreadName(data->name);
         data->func();
     }
 
@@ -0,0 +1,123 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include "common/make_unique.h"
+
+#include "common/thread/sdl_cond_wrapper.h"
+#include "common/thread/sdl_mutex_wrapper.h"
+#include "common/thread/worker_thread.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \class CWorkerPool
+ * \brief Fixed set of worker threads running independent tasks
+ *
+ * The calling thread takes part in the work too, so a pool with no threads
+ * just runs everything on the calling thread.
+ */
+class CWorkerPool
+{
+public:
+    using TaskFunctionPtr = std::function<void(int)>;
+
+public:
+    CWorkerPool(int threadCount, std::string name = "")
+    {
+        for (int i = 0; i < threadCount; i++)
+        {
+            m_threads.push_back(MakeUnique<CWorkerThread>(name));
+        }
+    }
+
+    //! Returns the number of worker threads, not counting the calling thread
+    int GetThreadCount() const
+    {
+        return m_threads.size();
+    }
+
+    //! Calls func(i) for each i in [0, count) and waits until all calls are done
+    /** The calls are spread over all threads in no particular order */
+    void ParallelFor(int count, const TaskFunctionPtr& func)
+    {
+        std::atomic<int> next(0);
+        auto runTasks = [&]()
+        {
+            for (int i = next++; i < count; i = next++)
+            {
+                func(i);
+            }
+        };
+
+        int started = std::min(static_cast<int>(m_threads.size()), count - 1);
+        m_pending = started;
+        for (int i = 0; i < started; i++)
+        {
+            m_threads[i]->Start([&]()
+            {
+                runTasks();
+
+                m_mutex.Lock();
+                m_pending--;
+                m_cond.Signal();
+                m_mutex.Unlock();
+            });
+        }
+
+        runTasks();
+
+        m_mutex.Lock();
+        while (m_pending > 0)
+        {
+            m_cond.Wait(*m_mutex);
+        }
+        m_mutex.Unlock();
+    }
+
+    //! Queues func to be run by one of the threads and returns at once
+    /** With no threads, func is run right away on the calling thread */
+    void Run(const std::function<void()>& func)
+    {
+        if (m_threads.empty())
+        {
+            func();
+            return;
+        }
+
+        m_threads[m_nextThread]->Start(func);
+        m_nextThread = (m_nextThread + 1) % m_threads.size();
+    }
+
+    CWorkerPool(const CWorkerPool&) = delete;
+    CWorkerPool& operator=(const CWorkerPool&) = delete;
+
+private:
+    std::vector<std::unique_ptr<CWorkerThread>> m_threads;
+    CSDLMutexWrapper m_mutex;
+    CSDLCondWrapper m_cond;
+    int m_pending = 0;
+    std::size_t m_nextThread = 0;
+};
@@ -79,7 +79,11 @@ private:
 
             ThreadFunctionPtr func = m_queue.front();
             m_queue.pop();
+
+            // New functions can be queued while this one runs
+            m_mutex.Unlock();
             func();
+            m_mutex.Lock();
         }
         m_mutex.Unlock();
     }
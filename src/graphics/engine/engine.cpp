@@ -207,8 +207,10 @@ CEngine::CEngine(CApplication *app, CSystemUtils* systemUtils)
     m_pauseBlurEnabled = true;
 
 
-    m_updateGeometry = false;
-    m_updateStaticBuffers = false;
+    m_staticBufferUploads = 0;
+    m_statisticStaticBufferUploads = 0;
+    m_geometryUpdates = 0;
+    m_statisticGeometryUpdates = 0;
 
     m_interfaceMode = false;
 
@@ -715,6 +717,8 @@ void CEngine::DeleteAllBaseObjects()
     }
 
     m_baseObjects.clear();
+    m_updateGeometry.clear();
+    m_updateStaticBuffers.clear();
 }
 
 void CEngine::CopyBaseObject(int sourceBaseObjRank, int destBaseObjRank)
@@ -726,9 +730,17 @@ void CEngine::CopyBaseObject(int sourceBaseObjRank, int destBaseObjRank)
 
     EngineBaseObject& p1 = m_baseObjects[destBaseObjRank];
 
+    // The copy is not in the lists of objects to update yet
+    bool updateGeometry = p1.updateGeometry;
+    p1.updateGeometry = false;
+    p1.updateStaticBuffers = false;
+
     if (! p1.used)
         return;
 
+    if (updateGeometry)
+        InvalidateGeometry(destBaseObjRank);
+
     for (int l2 = 0; l2 < static_cast<int>( p1.next.size() ); l2++)
     {
         EngineBaseObjTexTier& p2 = p1.next[l2];
@@ -737,6 +749,8 @@ void CEngine::CopyBaseObject(int sourceBaseObjRank, int destBaseObjRank)
         {
             EngineBaseObjDataTier& p3 = p2.next[l3];
             p3.staticBufferId = 0;
+            if (p3.updateStaticBuffer)
+                InvalidateStaticBuffer(destBaseObjRank, p3);
         }
     }
 }
@@ -753,8 +767,7 @@ void CEngine::AddBaseObjTriangles(int baseObjRank, const std::vector<VertexTex2>
 
     p3.vertices.insert(p3.vertices.end(), vertices.begin(), vertices.end());
 
-    p3.updateStaticBuffer = true;
-    m_updateStaticBuffers = true;
+    InvalidateStaticBuffer(baseObjRank, p3);
 
     for (int i = 0; i < static_cast<int>( vertices.size() ); i++)
     {
@@ -788,7 +801,7 @@ void CEngine::AddBaseObjQuick(int baseObjRank, const EngineBaseObjDataTier& buff
 
     if (globalUpdate)
     {
-        m_updateGeometry = true;
+        InvalidateGeometry(baseObjRank);
     }
     else
     {
@@ -1647,17 +1660,27 @@ void CEngine::ComputeDistance()
     }
 }
 
-void CEngine::UpdateGeometry()
+void CEngine::InvalidateGeometry(int baseObjRank)
 {
-    if (! m_updateGeometry)
+    EngineBaseObject& p1 = m_baseObjects[baseObjRank];
+    if (p1.updateGeometry)
         return;
 
-    for (int baseObjRank = 0; baseObjRank < static_cast<int>( m_baseObjects.size() ); baseObjRank++)
+    p1.updateGeometry = true;
+    m_updateGeometry.push_back(baseObjRank);
+}
+
+void CEngine::UpdateGeometry()
+{
+    for (int baseObjRank : m_updateGeometry)
     {
         EngineBaseObject &p1 = m_baseObjects[baseObjRank];
-        if (! p1.used)
+        if (! p1.used || ! p1.updateGeometry)
             continue;
 
+        p1.updateGeometry = false;
+        m_geometryUpdates++;
+
         p1.bboxMin.LoadZero();
         p1.bboxMax.LoadZero();
         p1.radius = 0;
@@ -1685,7 +1708,19 @@ void CEngine::UpdateGeometry()
         }
     }
 
-    m_updateGeometry = false;
+    m_updateGeometry.clear();
+}
+
+void CEngine::InvalidateStaticBuffer(int baseObjRank, EngineBaseObjDataTier& p4)
+{
+    p4.updateStaticBuffer = true;
+
+    EngineBaseObject& p1 = m_baseObjects[baseObjRank];
+    if (p1.updateStaticBuffers)
+        return;
+
+    p1.updateStaticBuffers = true;
+    m_updateStaticBuffers.push_back(baseObjRank);
 }
 
 void CEngine::UpdateStaticBuffer(EngineBaseObjDataTier& p4)
@@ -1702,21 +1737,19 @@ void CEngine::UpdateStaticBuffer(EngineBaseObjDataTier& p4)
         m_device->UpdateStaticBuffer(p4.staticBufferId, type, &p4.vertices[0], p4.vertices.size());
 
     p4.updateStaticBuffer = false;
+    m_staticBufferUploads++;
 }
 
 void CEngine::UpdateStaticBuffers()
 {
-    if (!m_updateStaticBuffers)
-        return;
-
-    m_updateStaticBuffers = false;
-
-    for (int baseObjRank = 0; baseObjRank < static_cast<int>( m_baseObjects.size() ); baseObjRank++)
+    for (int baseObjRank : m_updateStaticBuffers)
     {
         EngineBaseObject& p1 = m_baseObjects[baseObjRank];
-        if (! p1.used)
+        if (! p1.used || ! p1.updateStaticBuffers)
             continue;
 
+        p1.updateStaticBuffers = false;
+
         for (int l2 = 0; l2 < static_cast<int>( p1.next.size() ); l2++)
         {
             EngineBaseObjTexTier& p2 = p1.next[l2];
@@ -1732,6 +1765,8 @@ void CEngine::UpdateStaticBuffers()
             }
         }
     }
+
+    m_updateStaticBuffers.clear();
 }
 
 void CEngine::Update()
@@ -3179,6 +3214,10 @@ void CEngine::Render()
         return;
 
     m_statisticTriangle = 0;
+    m_statisticStaticBufferUploads = m_staticBufferUploads;
+    m_staticBufferUploads = 0;
+    m_statisticGeometryUpdates = m_geometryUpdates;
+    m_geometryUpdates = 0;
     m_lastState = -1;
     m_lastColor = Color(-1.0f);
     m_lastMaterial = Material();
@@ -3201,7 +3240,9 @@ void CEngine::Render()
     // use currently captured scene for world
     if (m_worldCaptured && !m_captureWorld)
     {
+        CProfiler::StartZone("Captured scene render");
         DrawCaptured3DScene();
+        CProfiler::StopZone();
     }
     else
     {
@@ -3211,10 +3252,16 @@ void CEngine::Render()
 
         UseMSAA(true);
 
+        CProfiler::StartZone("Background render");
         DrawBackground();                // draws the background
+        CProfiler::StopZone();
 
         if (m_drawWorld)
+        {
+            CProfiler::StartZone("3D scene render");
             Draw3DScene();
+            CProfiler::StopZone();
+        }
 
         UseMSAA(false);
 
@@ -5048,7 +5095,7 @@ void CEngine::DrawStats()
 
     float height = m_text->GetAscent(FONT_COLOBOT, 13.0f);
     float width = 0.4f;
-    const int TOTAL_LINES = 22;
+    const int TOTAL_LINES = 29;
 
     Math::Point pos(0.05f * m_size.x/m_size.y, 0.05f + TOTAL_LINES * height);
 
@@ -5136,8 +5183,36 @@ void CEngine::DrawStats()
     drawStatsCounter("Swap buffers & VSync",  PCNT_SWAP_BUFFERS);
     drawStatsLine(   "", "", "");
     drawStatsLine(   "Triangles",         StrUtils::ToString<int>(m_statisticTriangle), "");
+    drawStatsLine(   "Buffer uploads",    StrUtils::ToString<int>(m_statisticStaticBufferUploads), "");
+    drawStatsLine(   "Bounds updates",    StrUtils::ToString<int>(m_statisticGeometryUpdates), "");
     drawStatsLine(   "FPS",               StrUtils::Format("%.3f", m_fps), "");
     drawStatsLine(   "", "", "");
+
+    FrameStatistics frameStatistics = CProfiler::GetRecentFrameStatistics();
+
+    auto drawStatsPercentiles = [&](const std::string& name, const CTimeHistogram& histogram)
+    {
+        drawStatsLine(name, StrUtils::Format("%.1f / %.1f / %.1f", histogram.GetPercentile(0.5f)/1e6f,
+                                             histogram.GetPercentile(0.95f)/1e6f, histogram.GetPercentile(0.99f)/1e6f),
+                      StrUtils::Format("max %.1f ms", histogram.GetMax()/1e6f));
+    };
+
+    drawStatsPercentiles("Frame p50/p95/p99",  frameStatistics.frameTimes);
+    drawStatsPercentiles("Update p50/p95/p99", frameStatistics.updateTimes);
+    drawStatsLine(   StrUtils::Format("Hitches (> %.0f ms)", CProfiler::GetHitchThreshold()/1e6f),
+                     StrUtils::ToString<long long>(frameStatistics.hitchCount),
+                     frameStatistics.hitches.empty() ? "" : StrUtils::Format("last %.1f ms", frameStatistics.hitches.back().counters[PCNT_ALL]/1e6f));
+    if (!frameStatistics.hitches.empty())
+    {
+        long long causeTime = 0;
+        PerformanceCounter cause = CProfiler::GetHitchCause(frameStatistics.hitches.back(), &causeTime);
+        drawStatsLine("    Longest part", CProfiler::GetPerformanceCounterName(cause), StrUtils::Format("%.1f ms", causeTime/1e6f));
+    }
+    else
+    {
+        drawStatsLine("", "", "");
+    }
+    drawStatsLine(   "", "", "");
     std::stringstream str;
     str << std::fixed << std::setprecision(2) << m_statisticPos.x << "; " << m_statisticPos.z;
     drawStatsLine(   "Position",          str.str(), "");
@@ -248,6 +248,10 @@ struct EngineBaseObject
     Math::Vector           bboxMax;
     //! Radius of the sphere at the origin
     float                  radius = 0.0f;
+    //! Bounding box and radius have to be computed again (see CEngine::UpdateGeometry())
+    bool                   updateGeometry = false;
+    //! Some data tier has its updateStaticBuffer flag set (see CEngine::UpdateStaticBuffers())
+    bool                   updateStaticBuffers = false;
     //! Next tier (Tex)
     std::vector<EngineBaseObjTexTier> next;
 
@@ -1254,9 +1258,13 @@ protected:
     //! Calculates the distances between the viewpoint and the origin of different objects
     void        ComputeDistance();
 
-    //! Updates geometric parameters of objects (bounding box and radius)
+    //! Marks the bounding box and radius of base object to be computed again on next update
+    void        InvalidateGeometry(int baseObjRank);
+    //! Updates geometric parameters (bounding box and radius) of changed base objects
     void        UpdateGeometry();
 
+    //! Marks the static buffer of a data tier of base object to be updated on next update
+    void        InvalidateStaticBuffer(int baseObjRank, EngineBaseObjDataTier& p4);
     //! Updates a given static buffer
     void        UpdateStaticBuffer(EngineBaseObjDataTier& p4);
 
@@ -1366,8 +1374,16 @@ protected:
     Color           m_waterAddColor;
     int             m_statisticTriangle;
     Math::Vector    m_statisticPos;
-    bool            m_updateGeometry;
-    bool            m_updateStaticBuffers;
+    //! Static buffers uploaded since the last frame was rendered, and during the previous frame
+    int             m_staticBufferUploads;
+    int             m_statisticStaticBufferUploads;
+    //! Base objects whose bounds were computed again since the last frame was rendered, and during the previous frame
+    int             m_geometryUpdates;
+    int             m_statisticGeometryUpdates;
+    //! Base objects which have updateGeometry set, may contain deleted or repeated ranks
+    std::vector<int> m_updateGeometry;
+    //! Base objects which have updateStaticBuffers set, may contain deleted or repeated ranks
+    std::vector<int> m_updateStaticBuffers;
     bool            m_firstGroundSpot;
     std::string     m_secondTex;
     bool            m_backgroundFull;
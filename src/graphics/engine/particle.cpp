@@ -42,9 +42,13 @@
 
 #include "object/subclass/shielder.h"
 
+#include "object/task/taskshield.h"
+
 #include "sound/sound.h"
 
+#include <algorithm>
 #include <cstring>
+#include <functional>
 
 
 // Graphics module namespace
@@ -76,6 +80,7 @@ CParticle::CParticle(CEngine* engine)
     : m_engine(engine)
 {
     std::fill_n(m_frameUpdate, SH_MAX, true);
+    FlushParticle();
 }
 
 CParticle::~CParticle()
@@ -89,8 +94,12 @@ void CParticle::SetDevice(CDevice* device)
 
 void CParticle::FlushParticle()
 {
-    for (int i = 0; i < MAXPARTICULE*MAXPARTITYPE; i++)
-        m_particle[i].used = false;
+    int total = m_maxParticles*MAXPARTITYPE;
+    m_particle.assign(total, Particle());
+    m_particleMotion.assign(total, ParticleMotion());
+    m_triangle.resize(m_maxParticles);
+    m_alive.clear();
+    m_listed.assign(total, false);
 
     for (int i = 0; i < MAXPARTITYPE; i++)
     {
@@ -98,6 +107,11 @@ void CParticle::FlushParticle()
         {
             m_totalInterface[i][j] = 0;
         }
+
+        m_freeRanks[i].clear();
+        for (int j = 0; j < m_maxParticles; j++)
+            m_freeRanks[i].push_back(m_maxParticles*i+j);  // sorted, so already a heap
+        m_limitReached[i] = false;
     }
 
     for (int i = 0; i < MAXTRACK; i++)
@@ -115,12 +129,12 @@ void CParticle::FlushParticle()
 
 void CParticle::FlushParticle(int sheet)
 {
-    for (int i = 0; i < MAXPARTICULE*MAXPARTITYPE; i++)
+    for (int i : m_alive)
     {
         if (!m_particle[i].used) continue;
-        if (m_particle[i].sheet != sheet) continue;
+        if (m_particleMotion[i].sheet != sheet) continue;
 
-        m_particle[i].used = false;
+        DeleteRank(i);
     }
 
     for (int i = 0; i < MAXPARTITYPE; i++)
@@ -136,6 +150,20 @@ void CParticle::FlushParticle(int sheet)
     }
 }
 
+void CParticle::SetParticleLimit(int limit)
+{
+    limit = Math::Clamp(limit, 1, MAXPARTICULE_LIMIT);
+    if (limit == m_maxParticles) return;
+
+    m_maxParticles = limit;
+    FlushParticle();
+}
+
+int CParticle::GetParticleLimit()
+{
+    return m_maxParticles;
+}
+
 
 //! Returns file name of the effect effectNN.png, with NN = number
 void NameParticle(std::string &name, int num)
@@ -175,6 +203,110 @@ char RandomLetter()
     return chars[rand()%chars.size()];
 }
 
+//! Returns the texture type of the particle (see DrawParticle()), -1 if it can't be created with CreateParticle()
+int GetParticleTexture(ParticleType type)
+{
+    switch (type)
+    {
+        case PARTIEXPLOT:
+        case PARTIEXPLOO:
+        case PARTIMOTOR:
+        case PARTIBLITZ:
+        case PARTICRASH:
+        case PARTIVAPOR:
+        case PARTIGAS:
+        case PARTIBASE:
+        case PARTIFIRE:
+        case PARTIFIREZ:
+        case PARTIBLUE:
+        case PARTIROOT:
+        case PARTIRECOVER:
+        case PARTIEJECT:
+        case PARTISCRAPS:
+        case PARTIGUN2:
+        case PARTIGUN3:
+        case PARTIGUN4:
+        case PARTIQUEUE:
+        case PARTIORGANIC1:
+        case PARTIORGANIC2:
+        case PARTIFLAME:
+        case PARTIBUBBLE:
+        case PARTIERROR:
+        case PARTIWARNING:  // same value as PARTIINFO
+        case PARTISPHERE1:
+        case PARTISPHERE2:
+        case PARTISPHERE4:
+        case PARTISPHERE5:
+        case PARTISPHERE6:
+        case PARTIPLOUF0:
+        case PARTITRACK1:
+        case PARTITRACK2:
+        case PARTITRACK3:
+        case PARTITRACK4:
+        case PARTITRACK5:
+        case PARTITRACK6:
+        case PARTITRACK7:
+        case PARTITRACK8:
+        case PARTITRACK9:
+        case PARTITRACK10:
+        case PARTITRACK11:
+        case PARTITRACK12:
+        case PARTILENS1:
+        case PARTILENS2:
+        case PARTILENS3:
+        case PARTILENS4:
+        case PARTIGFLAT:
+        case PARTIDROP:
+        case PARTIWATER:
+        case PARTILIMIT1:
+        case PARTILIMIT2:
+        case PARTILIMIT3:
+        case PARTIEXPLOG1:
+        case PARTIEXPLOG2:
+            return 1;  // effect00
+
+        case PARTIGLINT:
+        case PARTIGLINTb:
+        case PARTIGLINTr:
+        case PARTITOTO:
+        case PARTISELY:
+        case PARTISELR:
+        case PARTIQUARTZ:
+        case PARTIGUNDEL:
+        case PARTICONTROL:
+        case PARTISHOW:
+        case PARTICHOC:
+        case PARTIFOG4:
+        case PARTIFOG5:
+        case PARTIFOG6:
+        case PARTIFOG7:
+            return 2;  // effect01
+
+        case PARTIGUN1:
+        case PARTIFLIC:
+        case PARTISPHERE0:
+        case PARTISPHERE3:
+        case PARTIFOG0:
+        case PARTIFOG1:
+        case PARTIFOG2:
+        case PARTIFOG3:
+            return 3;  // effect02
+
+        case PARTISMOKE1:
+        case PARTISMOKE2:
+        case PARTISMOKE3:
+        case PARTIBLOOD:
+        case PARTIBLOODM:
+            return 4;  // effect03 (ENG_RSTATE_TTEXTURE_WHITE)
+
+        case PARTIVIRUS:
+            return 5;  // text render
+
+        default:
+            return -1;
+    }
+}
+
 /** Returns the channel of the particle created or -1 on error. */
 int CParticle::CreateParticle(Math::Vector pos, Math::Vector speed, Math::Point dim,
                               ParticleType type,
@@ -184,175 +316,66 @@ int CParticle::CreateParticle(Math::Vector pos, Math::Vector speed, Math::Point
     if (m_main == nullptr)
         m_main = CRobotMain::GetInstancePointer();
 
-    int t = -1;
-    if ( type == PARTIEXPLOT   ||
-         type == PARTIEXPLOO   ||
-         type == PARTIMOTOR    ||
-         type == PARTIBLITZ    ||
-         type == PARTICRASH    ||
-         type == PARTIVAPOR    ||
-         type == PARTIGAS      ||
-         type == PARTIBASE     ||
-         type == PARTIFIRE     ||
-         type == PARTIFIREZ    ||
-         type == PARTIBLUE     ||
-         type == PARTIROOT     ||
-         type == PARTIRECOVER  ||
-         type == PARTIEJECT    ||
-         type == PARTISCRAPS   ||
-         type == PARTIGUN2     ||
-         type == PARTIGUN3     ||
-         type == PARTIGUN4     ||
-         type == PARTIQUEUE    ||
-         type == PARTIORGANIC1 ||
-         type == PARTIORGANIC2 ||
-         type == PARTIFLAME    ||
-         type == PARTIBUBBLE   ||
-         type == PARTIERROR    ||
-         type == PARTIWARNING  ||
-         type == PARTIINFO     ||
-         type == PARTISPHERE1  ||
-         type == PARTISPHERE2  ||
-         type == PARTISPHERE4  ||
-         type == PARTISPHERE5  ||
-         type == PARTISPHERE6  ||
-         type == PARTIPLOUF0   ||
-         type == PARTITRACK1   ||
-         type == PARTITRACK2   ||
-         type == PARTITRACK3   ||
-         type == PARTITRACK4   ||
-         type == PARTITRACK5   ||
-         type == PARTITRACK6   ||
-         type == PARTITRACK7   ||
-         type == PARTITRACK8   ||
-         type == PARTITRACK9   ||
-         type == PARTITRACK10  ||
-         type == PARTITRACK11  ||
-         type == PARTITRACK12  ||
-         type == PARTILENS1    ||
-         type == PARTILENS2    ||
-         type == PARTILENS3    ||
-         type == PARTILENS4    ||
-         type == PARTIGFLAT    ||
-         type == PARTIDROP     ||
-         type == PARTIWATER    ||
-         type == PARTILIMIT1   ||
-         type == PARTILIMIT2   ||
-         type == PARTILIMIT3   ||
-         type == PARTIEXPLOG1  ||
-         type == PARTIEXPLOG2  )
-    {
-        t = 1;  // effect00
-    }
-    if ( type == PARTIGLINT   ||
-         type == PARTIGLINTb  ||
-         type == PARTIGLINTr  ||
-         type == PARTITOTO    ||
-         type == PARTISELY    ||
-         type == PARTISELR    ||
-         type == PARTIQUARTZ  ||
-         type == PARTIGUNDEL  ||
-         type == PARTICONTROL ||
-         type == PARTISHOW    ||
-         type == PARTICHOC    ||
-         type == PARTIFOG4    ||
-         type == PARTIFOG5    ||
-         type == PARTIFOG6    ||
-         type == PARTIFOG7    )
-    {
-        t = 2;  // effect01
-    }
-    if ( type == PARTIGUN1    ||
-         type == PARTIFLIC    ||
-         type == PARTISPHERE0 ||
-         type == PARTISPHERE3 ||
-         type == PARTIFOG0    ||
-         type == PARTIFOG1    ||
-         type == PARTIFOG2    ||
-         type == PARTIFOG3    )
+    int t = GetParticleTexture(type);
+    if (t == -1) return -1;
+
+    int i = AllocateRank(t);
+    if (i == -1) return -1;
+
+    m_particle[i].ray       = false;
+    m_particleMotion[i].sheet = sheet;
+    m_particleMotion[i].mass = mass;
+    m_particle[i].duration  = duration;
+    m_particleMotion[i].pos = pos;
+    m_particle[i].goal      = pos;
+    m_particleMotion[i].speed = speed;
+    m_particleMotion[i].windSensitivity = windSensitivity;
+    m_particle[i].dim       = dim;
+    m_particle[i].zoom      = 1.0f;
+    m_particle[i].angle     = 0.0f;
+    m_particle[i].intensity = 1.0f;
+    m_particle[i].type      = type;
+    m_particleMotion[i].moving = (type != PARTIQUARTZ);
+    m_particleMotion[i].alwaysUpdate = (type == PARTISHOW);
+    m_particle[i].phase     = PARPHSTART;
+    m_particle[i].texSup.x  = 0.0f;
+    m_particle[i].texSup.y  = 0.0f;
+    m_particle[i].texInf.x  = 0.0f;
+    m_particle[i].texInf.y  = 0.0f;
+    m_particle[i].time      = 0.0f;
+    m_particle[i].phaseTime = 0.0f;
+    m_particle[i].testTime  = 0.0f;
+    m_particle[i].objLink   = nullptr;
+    m_particle[i].objFather = nullptr;
+    m_particle[i].trackRank = -1;
+
+    m_totalInterface[t][sheet] ++;
+
+    if ( type == PARTIEXPLOT ||
+         type == PARTIEXPLOO )
     {
-        t = 3;  // effect02
+        m_particle[i].angle = Math::Rand()*Math::PI*2.0f;
     }
-    if ( type == PARTISMOKE1  ||
-         type == PARTISMOKE2  ||
-         type == PARTISMOKE3  ||
-         type == PARTIBLOOD   ||
-         type == PARTIBLOODM  )
+
+    if ( type == PARTIGUN1 ||
+         type == PARTIGUN4 )
     {
-        t = 4;  // effect03 (ENG_RSTATE_TTEXTURE_WHITE)
+        m_particle[i].testTime = 1.0f;  // impact immediately
     }
+
     if ( type == PARTIVIRUS )
     {
-        t = 5; // text render
+        m_particle[i].text = RandomLetter();
     }
-    if (t >= MAXPARTITYPE) return -1;
-    if (t == -1) return -1;
 
-    for (int j = 0; j < MAXPARTICULE; j++)
+    if ( type >= PARTIFOG0 &&
+         type <= PARTIFOG7 )
     {
-        int i = MAXPARTICULE*t+j;
-
-        if (! m_particle[i].used)
-        {
-            m_particle[i] = Particle();
-            m_particle[i].used      = true;
-            m_particle[i].ray       = false;
-            m_particle[i].uniqueStamp = m_uniqueStamp++;
-            m_particle[i].sheet     = sheet;
-            m_particle[i].mass      = mass;
-            m_particle[i].duration  = duration;
-            m_particle[i].pos       = pos;
-            m_particle[i].goal      = pos;
-            m_particle[i].speed     = speed;
-            m_particle[i].windSensitivity = windSensitivity;
-            m_particle[i].dim       = dim;
-            m_particle[i].zoom      = 1.0f;
-            m_particle[i].angle     = 0.0f;
-            m_particle[i].intensity = 1.0f;
-            m_particle[i].type      = type;
-            m_particle[i].phase     = PARPHSTART;
-            m_particle[i].texSup.x  = 0.0f;
-            m_particle[i].texSup.y  = 0.0f;
-            m_particle[i].texInf.x  = 0.0f;
-            m_particle[i].texInf.y  = 0.0f;
-            m_particle[i].time      = 0.0f;
-            m_particle[i].phaseTime = 0.0f;
-            m_particle[i].testTime  = 0.0f;
-            m_particle[i].objLink   = nullptr;
-            m_particle[i].objFather = nullptr;
-            m_particle[i].trackRank = -1;
-
-            m_totalInterface[t][sheet] ++;
-
-            if ( type == PARTIEXPLOT ||
-                 type == PARTIEXPLOO )
-            {
-                m_particle[i].angle = Math::Rand()*Math::PI*2.0f;
-            }
-
-            if ( type == PARTIGUN1 ||
-                 type == PARTIGUN4 )
-            {
-                m_particle[i].testTime = 1.0f;  // impact immediately
-            }
-
-            if ( type == PARTIVIRUS )
-            {
-                m_particle[i].text = RandomLetter();
-            }
-
-            if ( type >= PARTIFOG0 &&
-                 type <= PARTIFOG7 )
-            {
-                if (m_fogTotal < MAXPARTIFOG)
-                m_fog[m_fogTotal++] = i;
-            }
-
-            return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
-        }
+        if (m_fogTotal < MAXPARTIFOG)
+        m_fog[m_fogTotal++] = i;
     }
 
-    return -1;
+    return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
 }
 
 /** Returns the channel of the particle created or -1 on error */
@@ -363,100 +386,90 @@ int CParticle::CreateFrag(Math::Vector pos, Math::Vector speed,
                           float windSensitivity, int sheet)
 {
     int t = 0;
-    for (int j = 0; j < MAXPARTICULE; j++)
-    {
-        int i = MAXPARTICULE*t+j;
-
-        if (!m_particle[i].used)
-        {
-            m_particle[i] = Particle();
-            m_particle[i].used      = true;
-            m_particle[i].ray       = false;
-            m_particle[i].uniqueStamp = m_uniqueStamp++;
-            m_particle[i].sheet     = sheet;
-            m_particle[i].mass      = mass;
-            m_particle[i].duration  = duration;
-            m_particle[i].pos       = pos;
-            m_particle[i].goal      = pos;
-            m_particle[i].speed     = speed;
-            m_particle[i].windSensitivity = windSensitivity;
-            m_particle[i].zoom      = 1.0f;
-            m_particle[i].angle     = 0.0f;
-            m_particle[i].intensity = 1.0f;
-            m_particle[i].type      = type;
-            m_particle[i].phase     = PARPHSTART;
-            m_particle[i].texSup.x  = 0.0f;
-            m_particle[i].texSup.y  = 0.0f;
-            m_particle[i].texInf.x  = 0.0f;
-            m_particle[i].texInf.y  = 0.0f;
-            m_particle[i].time      = 0.0f;
-            m_particle[i].phaseTime = 0.0f;
-            m_particle[i].testTime  = 0.0f;
-            m_particle[i].objLink   = nullptr;
-            m_particle[i].objFather = nullptr;
-            m_particle[i].trackRank = -1;
-            m_triangle[i] = *triangle;
-
-            m_totalInterface[t][sheet] ++;
-
-            Math::Vector    p1;
-            p1.x = m_triangle[i].triangle[0].coord.x;
-            p1.y = m_triangle[i].triangle[0].coord.y;
-            p1.z = m_triangle[i].triangle[0].coord.z;
-
-            Math::Vector p2;
-            p2.x = m_triangle[i].triangle[1].coord.x;
-            p2.y = m_triangle[i].triangle[1].coord.y;
-            p2.z = m_triangle[i].triangle[1].coord.z;
-
-            Math::Vector p3;
-            p3.x = m_triangle[i].triangle[2].coord.x;
-            p3.y = m_triangle[i].triangle[2].coord.y;
-            p3.z = m_triangle[i].triangle[2].coord.z;
-
-            float l1 = Math::Distance(p1, p2);
-            float l2 = Math::Distance(p2, p3);
-            float l3 = Math::Distance(p3, p1);
-            float dx = fabs(Math::Min(l1, l2, l3))*0.5f;
-            float dy = fabs(Math::Max(l1, l2, l3))*0.5f;
-            p1 = Math::Vector(-dx,  dy, 0.0f);
-            p2 = Math::Vector( dx,  dy, 0.0f);
-            p3 = Math::Vector(-dx, -dy, 0.0f);
-
-            m_triangle[i].triangle[0].coord.x = p1.x;
-            m_triangle[i].triangle[0].coord.y = p1.y;
-            m_triangle[i].triangle[0].coord.z = p1.z;
-
-            m_triangle[i].triangle[1].coord.x = p2.x;
-            m_triangle[i].triangle[1].coord.y = p2.y;
-            m_triangle[i].triangle[1].coord.z = p2.z;
-
-            m_triangle[i].triangle[2].coord.x = p3.x;
-            m_triangle[i].triangle[2].coord.y = p3.y;
-            m_triangle[i].triangle[2].coord.z = p3.z;
-
-            Math::Vector n(0.0f, 0.0f, -1.0f);
-
-            m_triangle[i].triangle[0].normal.x = n.x;
-            m_triangle[i].triangle[0].normal.y = n.y;
-            m_triangle[i].triangle[0].normal.z = n.z;
-
-            m_triangle[i].triangle[1].normal.x = n.x;
-            m_triangle[i].triangle[1].normal.y = n.y;
-            m_triangle[i].triangle[1].normal.z = n.z;
-
-            m_triangle[i].triangle[2].normal.x = n.x;
-            m_triangle[i].triangle[2].normal.y = n.y;
-            m_triangle[i].triangle[2].normal.z = n.z;
-
-            if (type == PARTIFRAG)
-                m_particle[i].angle = Math::Rand()*Math::PI*2.0f;
-
-            return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
-        }
-    }
+    int i = AllocateRank(t);
+    if (i == -1) return -1;
+
+    m_particle[i].ray       = false;
+    m_particleMotion[i].sheet = sheet;
+    m_particleMotion[i].mass = mass;
+    m_particle[i].duration  = duration;
+    m_particleMotion[i].pos = pos;
+    m_particle[i].goal      = pos;
+    m_particleMotion[i].speed = speed;
+    m_particleMotion[i].windSensitivity = windSensitivity;
+    m_particle[i].zoom      = 1.0f;
+    m_particle[i].angle     = 0.0f;
+    m_particle[i].intensity = 1.0f;
+    m_particle[i].type      = type;
+    m_particle[i].phase     = PARPHSTART;
+    m_particle[i].texSup.x  = 0.0f;
+    m_particle[i].texSup.y  = 0.0f;
+    m_particle[i].texInf.x  = 0.0f;
+    m_particle[i].texInf.y  = 0.0f;
+    m_particle[i].time      = 0.0f;
+    m_particle[i].phaseTime = 0.0f;
+    m_particle[i].testTime  = 0.0f;
+    m_particle[i].objLink   = nullptr;
+    m_particle[i].objFather = nullptr;
+    m_particle[i].trackRank = -1;
+    m_triangle[i] = *triangle;
+
+    m_totalInterface[t][sheet] ++;
+
+    Math::Vector    p1;
+    p1.x = m_triangle[i].triangle[0].coord.x;
+    p1.y = m_triangle[i].triangle[0].coord.y;
+    p1.z = m_triangle[i].triangle[0].coord.z;
+
+    Math::Vector p2;
+    p2.x = m_triangle[i].triangle[1].coord.x;
+    p2.y = m_triangle[i].triangle[1].coord.y;
+    p2.z = m_triangle[i].triangle[1].coord.z;
+
+    Math::Vector p3;
+    p3.x = m_triangle[i].triangle[2].coord.x;
+    p3.y = m_triangle[i].triangle[2].coord.y;
+    p3.z = m_triangle[i].triangle[2].coord.z;
+
+    float l1 = Math::Distance(p1, p2);
+    float l2 = Math::Distance(p2, p3);
+    float l3 = Math::Distance(p3, p1);
+    float dx = fabs(Math::Min(l1, l2, l3))*0.5f;
+    float dy = fabs(Math::Max(l1, l2, l3))*0.5f;
+    p1 = Math::Vector(-dx,  dy, 0.0f);
+    p2 = Math::Vector( dx,  dy, 0.0f);
+    p3 = Math::Vector(-dx, -dy, 0.0f);
+
+    m_triangle[i].triangle[0].coord.x = p1.x;
+    m_triangle[i].triangle[0].coord.y = p1.y;
+    m_triangle[i].triangle[0].coord.z = p1.z;
+
+    m_triangle[i].triangle[1].coord.x = p2.x;
+    m_triangle[i].triangle[1].coord.y = p2.y;
+    m_triangle[i].triangle[1].coord.z = p2.z;
+
+    m_triangle[i].triangle[2].coord.x = p3.x;
+    m_triangle[i].triangle[2].coord.y = p3.y;
+    m_triangle[i].triangle[2].coord.z = p3.z;
 
-    return -1;
+    Math::Vector n(0.0f, 0.0f, -1.0f);
+
+    m_triangle[i].triangle[0].normal.x = n.x;
+    m_triangle[i].triangle[0].normal.y = n.y;
+    m_triangle[i].triangle[0].normal.z = n.z;
+
+    m_triangle[i].triangle[1].normal.x = n.x;
+    m_triangle[i].triangle[1].normal.y = n.y;
+    m_triangle[i].triangle[1].normal.z = n.z;
+
+    m_triangle[i].triangle[2].normal.x = n.x;
+    m_triangle[i].triangle[2].normal.y = n.y;
+    m_triangle[i].triangle[2].normal.z = n.z;
+
+    if (type == PARTIFRAG)
+        m_particle[i].angle = Math::Rand()*Math::PI*2.0f;
+
+    return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
 }
 
 
@@ -467,45 +480,35 @@ int CParticle::CreatePart(Math::Vector pos, Math::Vector speed,
                           float windSensitivity, int sheet)
 {
     int t = 0;
-    for (int j = 0; j < MAXPARTICULE; j++)
-    {
-        int i = MAXPARTICULE*t+j;
-
-        if (!m_particle[i].used)
-        {
-            m_particle[i] = Particle();
-            m_particle[i].used      = true;
-            m_particle[i].ray       = false;
-            m_particle[i].uniqueStamp = m_uniqueStamp++;
-            m_particle[i].sheet     = sheet;
-            m_particle[i].mass      = mass;
-            m_particle[i].weight    = weight;
-            m_particle[i].duration  = duration;
-            m_particle[i].pos       = pos;
-            m_particle[i].goal      = pos;
-            m_particle[i].speed     = speed;
-            m_particle[i].windSensitivity = windSensitivity;
-            m_particle[i].zoom      = 1.0f;
-            m_particle[i].angle     = 0.0f;
-            m_particle[i].intensity = 1.0f;
-            m_particle[i].type      = type;
-            m_particle[i].phase     = PARPHSTART;
-            m_particle[i].texSup.x  = 0.0f;
-            m_particle[i].texSup.y  = 0.0f;
-            m_particle[i].texInf.x  = 0.0f;
-            m_particle[i].texInf.y  = 0.0f;
-            m_particle[i].time      = 0.0f;
-            m_particle[i].phaseTime = 0.0f;
-            m_particle[i].testTime  = 0.0f;
-            m_particle[i].trackRank = -1;
-
-            m_totalInterface[t][sheet] ++;
-
-            return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
-        }
-    }
-
-    return -1;
+    int i = AllocateRank(t);
+    if (i == -1) return -1;
+
+    m_particle[i].ray       = false;
+    m_particleMotion[i].sheet = sheet;
+    m_particleMotion[i].mass = mass;
+    m_particle[i].weight    = weight;
+    m_particle[i].duration  = duration;
+    m_particleMotion[i].pos = pos;
+    m_particle[i].goal      = pos;
+    m_particleMotion[i].speed = speed;
+    m_particleMotion[i].windSensitivity = windSensitivity;
+    m_particle[i].zoom      = 1.0f;
+    m_particle[i].angle     = 0.0f;
+    m_particle[i].intensity = 1.0f;
+    m_particle[i].type      = type;
+    m_particle[i].phase     = PARPHSTART;
+    m_particle[i].texSup.x  = 0.0f;
+    m_particle[i].texSup.y  = 0.0f;
+    m_particle[i].texInf.x  = 0.0f;
+    m_particle[i].texInf.y  = 0.0f;
+    m_particle[i].time      = 0.0f;
+    m_particle[i].phaseTime = 0.0f;
+    m_particle[i].testTime  = 0.0f;
+    m_particle[i].trackRank = -1;
+
+    m_totalInterface[t][sheet] ++;
+
+    return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
 }
 
 /** Returns the channel of the particle created or -1 on error */
@@ -523,47 +526,37 @@ int CParticle::CreateRay(Math::Vector pos, Math::Vector goal,
     if (t >= MAXPARTITYPE) return -1;
     if (t == -1) return -1;
 
-    for (int j = 0; j < MAXPARTICULE; j++)
-    {
-        int i = MAXPARTICULE*t+j;
-
-        if (!m_particle[i].used)
-        {
-            m_particle[i] = Particle();
-            m_particle[i].used      = true;
-            m_particle[i].ray       = true;
-            m_particle[i].uniqueStamp = m_uniqueStamp++;
-            m_particle[i].sheet     = sheet;
-            m_particle[i].mass      = 0.0f;
-            m_particle[i].duration  = duration;
-            m_particle[i].pos       = pos;
-            m_particle[i].goal      = goal;
-            m_particle[i].speed     = Math::Vector(0.0f, 0.0f, 0.0f);
-            m_particle[i].windSensitivity = 0.0f;
-            m_particle[i].dim       = dim;
-            m_particle[i].zoom      = 1.0f;
-            m_particle[i].angle     = 0.0f;
-            m_particle[i].intensity = 1.0f;
-            m_particle[i].type      = type;
-            m_particle[i].phase     = PARPHSTART;
-            m_particle[i].texSup.x  = 0.0f;
-            m_particle[i].texSup.y  = 0.0f;
-            m_particle[i].texInf.x  = 0.0f;
-            m_particle[i].texInf.y  = 0.0f;
-            m_particle[i].time      = 0.0f;
-            m_particle[i].phaseTime = 0.0f;
-            m_particle[i].testTime  = 0.0f;
-            m_particle[i].objLink   = nullptr;
-            m_particle[i].objFather = nullptr;
-            m_particle[i].trackRank = -1;
-
-            m_totalInterface[t][sheet] ++;
-
-            return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
-        }
-    }
-
-    return -1;
+    int i = AllocateRank(t);
+    if (i == -1) return -1;
+
+    m_particle[i].ray       = true;
+    m_particleMotion[i].sheet = sheet;
+    m_particleMotion[i].mass = 0.0f;
+    m_particle[i].duration  = duration;
+    m_particleMotion[i].pos = pos;
+    m_particle[i].goal      = goal;
+    m_particleMotion[i].speed = Math::Vector(0.0f, 0.0f, 0.0f);
+    m_particleMotion[i].windSensitivity = 0.0f;
+    m_particle[i].dim       = dim;
+    m_particle[i].zoom      = 1.0f;
+    m_particle[i].angle     = 0.0f;
+    m_particle[i].intensity = 1.0f;
+    m_particle[i].type      = type;
+    m_particle[i].phase     = PARPHSTART;
+    m_particle[i].texSup.x  = 0.0f;
+    m_particle[i].texSup.y  = 0.0f;
+    m_particle[i].texInf.x  = 0.0f;
+    m_particle[i].texInf.y  = 0.0f;
+    m_particle[i].time      = 0.0f;
+    m_particle[i].phaseTime = 0.0f;
+    m_particle[i].testTime  = 0.0f;
+    m_particle[i].objLink   = nullptr;
+    m_particle[i].objFather = nullptr;
+    m_particle[i].trackRank = -1;
+
+    m_totalInterface[t][sheet] ++;
+
+    return i | ((m_particle[i].uniqueStamp&0xffff)<<16);
 }
 
 /** "length" is the length of the tail of drag (in seconds)! */
@@ -643,7 +636,7 @@ bool CParticle::CheckChannel(int &channel)
     channel &= 0xffff;
 
     if (channel < 0)  return false;
-    if (channel >= MAXPARTICULE*MAXPARTITYPE) return false;
+    if (channel >= static_cast<int>(m_particle.size())) return false;
 
     if (!m_particle[channel].used)
     {
@@ -660,21 +653,68 @@ bool CParticle::CheckChannel(int &channel)
     return true;
 }
 
+int CParticle::AllocateRank(int texture)
+{
+    std::vector<int>& freeRanks = m_freeRanks[texture];
+    if (freeRanks.empty())
+    {
+        if (!m_limitReached[texture])
+        {
+            GetLogger()->Warn("Limit of %d particles of texture type %d reached, new particles are dropped\n", m_maxParticles, texture);
+            m_limitReached[texture] = true;
+        }
+        return -1;
+    }
+
+    std::pop_heap(freeRanks.begin(), freeRanks.end(), std::greater<int>());
+    int rank = freeRanks.back();
+    freeRanks.pop_back();
+
+    m_particle[rank] = Particle();
+    m_particleMotion[rank] = ParticleMotion();
+    m_particle[rank].used = true;
+    m_particle[rank].uniqueStamp = m_uniqueStamp++;
+
+    if (!m_listed[rank])
+    {
+        m_alive.push_back(rank);
+        m_listed[rank] = true;
+    }
+    return rank;
+}
+
 void CParticle::DeleteRank(int rank)
 {
-    if (m_totalInterface[rank/MAXPARTICULE][m_particle[rank].sheet] > 0)
-        m_totalInterface[rank/MAXPARTICULE][m_particle[rank].sheet]--;
+    if (!m_particle[rank].used) return;
+
+    int t = rank/m_maxParticles;
+    if (m_totalInterface[t][m_particleMotion[rank].sheet] > 0)
+        m_totalInterface[t][m_particleMotion[rank].sheet]--;
 
     int i = m_particle[rank].trackRank;
     if (i != -1)  // drag associated?
         m_track[i].used = false;  // frees the drag
 
     m_particle[rank].used = false;
+    m_freeRanks[t].push_back(rank);
+    std::push_heap(m_freeRanks[t].begin(), m_freeRanks[t].end(), std::greater<int>());
+}
+
+void CParticle::CompactAlive()
+{
+    auto dead = [this](int rank)
+    {
+        if (m_particle[rank].used) return false;
+        m_listed[rank] = false;
+        return true;
+    };
+    m_alive.erase(std::remove_if(m_alive.begin(), m_alive.end(), dead), m_alive.end());
+    std::sort(m_alive.begin(), m_alive.end());
 }
 
 void CParticle::DeleteParticle(ParticleType type)
 {
-    for (int i = 0; i < MAXPARTICULE*MAXPARTITYPE; i++)
+    for (int i : m_alive)
     {
         if (!m_particle[i].used) continue;
         if (m_particle[i].type != type) continue;
@@ -687,14 +727,7 @@ void CParticle::DeleteParticle(int channel)
 {
     if (!CheckChannel(channel)) return;
 
-    if (m_totalInterface[channel/MAXPARTICULE][m_particle[channel].sheet] > 0 )
-        m_totalInterface[channel/MAXPARTICULE][m_particle[channel].sheet]--;
-
-    int i = m_particle[channel].trackRank;
-    if (i != -1)  // drag associated?
-        m_track[i].used = false;  // frees the drag
-
-    m_particle[channel].used = false;
+    DeleteRank(channel);
 }
 
 void CParticle::SetObjectLink(int channel, CObject *object)
@@ -712,7 +745,7 @@ void CParticle::SetObjectFather(int channel, CObject *object)
 void CParticle::SetPosition(int channel, Math::Vector pos)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].pos = pos;
+    m_particleMotion[channel].pos = pos;
 }
 
 void CParticle::SetDimension(int channel, Math::Point dim)
@@ -743,7 +776,7 @@ void CParticle::SetParam(int channel, Math::Vector pos, Math::Point dim, float z
                           float angle, float intensity)
 {
     if (!CheckChannel(channel))  return;
-    m_particle[channel].pos       = pos;
+    m_particleMotion[channel].pos = pos;
     m_particle[channel].dim       = dim;
     m_particle[channel].zoom      = zoom;
     m_particle[channel].angle     = angle;
@@ -761,7 +794,7 @@ void CParticle::SetPhase(int channel, ParticlePhase phase, float duration)
 bool CParticle::GetPosition(int channel, Math::Vector &pos)
 {
     if (!CheckChannel(channel))  return false;
-    pos = m_particle[channel].pos;
+    pos = m_particleMotion[channel].pos;
     return true;
 }
 
@@ -770,6 +803,23 @@ void CParticle::SetFrameUpdate(int sheet, bool update)
     m_frameUpdate[sheet] = update;
 }
 
+void CParticle::MoveParticle(int i, float rTime, const Math::Vector& wind)
+{
+    ParticleMotion& motion = m_particleMotion[i];
+
+    if (motion.moving)
+        motion.pos += motion.speed*rTime;
+
+    if (motion.sheet == SH_WORLD)
+    {
+        float h = rTime*motion.windSensitivity*Math::Rand()*2.0f;
+        motion.pos += wind*h;
+    }
+
+    if (motion.mass != 0.0f && motion.moving)
+        motion.speed.y -= motion.mass*rTime;  // gravity
+}
+
 void CParticle::FrameParticle(float rTime)
 {
     if (m_main == nullptr)
@@ -795,41 +845,48 @@ void CParticle::FrameParticle(float rTime)
     Math::Point ts, ti;
     Math::Vector pos;
 
-    for (int i = 0; i < MAXPARTICULE*MAXPARTITYPE; i++)
+    CompactAlive();
+
+    // Moves all the particles in one pass, going only through their motion data.
+    std::size_t moved = m_alive.size();
+    for (std::size_t k = 0; k < moved; k++)
+    {
+        const ParticleMotion& motion = m_particleMotion[m_alive[k]];
+        if (!m_frameUpdate[motion.sheet]) continue;
+        if (pause && !motion.alwaysUpdate && motion.sheet != SH_INTERFACE) continue;
+
+        MoveParticle(m_alive[k], rTime, wind);
+    }
+
+    // Particles created during the loop are added at the end of m_alive.
+    for (std::size_t k = 0; k < m_alive.size(); k++)
     {
+        int i = m_alive[k];
         if (!m_particle[i].used) continue;
-        if (!m_frameUpdate[m_particle[i].sheet]) continue;
+        if (!m_frameUpdate[m_particleMotion[i].sheet]) continue;
 
         if (m_particle[i].type != PARTISHOW)
         {
-            if (pause && m_particle[i].sheet != SH_INTERFACE) continue;
+            if (pause && m_particleMotion[i].sheet != SH_INTERFACE) continue;
         }
 
-        if (m_particle[i].type != PARTIQUARTZ)
-            m_particle[i].pos += m_particle[i].speed*rTime;
-
-        if (m_particle[i].sheet == SH_WORLD)
-        {
-            float h = rTime*m_particle[i].windSensitivity*Math::Rand()*2.0f;
-            m_particle[i].pos += wind*h;
-        }
+        if (k >= moved)  // created by another particle in this frame?
+            MoveParticle(i, rTime, wind);
 
         float progress = (m_particle[i].time-m_particle[i].phaseTime)/m_particle[i].duration;
 
         // Manages the particles with mass that bounce.
-        if ( m_particle[i].mass != 0.0f        &&
+        if ( m_particleMotion[i].mass != 0.0f        &&
              m_particle[i].type != PARTIQUARTZ )
         {
-            m_particle[i].speed.y -= m_particle[i].mass*rTime;
-
             float h;
-            if (m_particle[i].sheet == SH_INTERFACE)
+            if (m_particleMotion[i].sheet == SH_INTERFACE)
                 h = 0.0f;
             else
-                h = m_terrain->GetFloorLevel(m_particle[i].pos, true);
+                h = m_terrain->GetFloorLevel(m_particleMotion[i].pos, true);
 
             h += m_particle[i].dim.y*0.75f;
-            if (m_particle[i].pos.y < h)  // impact with the ground?
+            if (m_particleMotion[i].pos.y < h)  // impact with the ground?
             {
                 if ( m_particle[i].type == PARTIPART &&
                      m_particle[i].weight > 3.0f &&  // heavy enough?
@@ -840,21 +897,21 @@ void CParticle::FrameParticle(float rTime)
                     if (amplitude > 1.0f)  amplitude = 1.0f;
                     if (amplitude > 0.0f)
                     {
-                        Play(SOUND_BOUM, m_particle[i].pos, amplitude);
+                        Play(SOUND_BOUM, m_particleMotion[i].pos, amplitude);
                     }
                 }
 
                 if (m_particle[i].bounce < 3)
                 {
-                    m_particle[i].pos.y = h;
-                    m_particle[i].speed.y *= -0.4f;
-                    m_particle[i].speed.x *=  0.4f;
-                    m_particle[i].speed.z *=  0.4f;
+                    m_particleMotion[i].pos.y = h;
+                    m_particleMotion[i].speed.y *= -0.4f;
+                    m_particleMotion[i].speed.x *=  0.4f;
+                    m_particleMotion[i].speed.z *=  0.4f;
                     m_particle[i].bounce ++;  // more impact
                 }
                 else    // disappears after 3 bounces?
                 {
-                    if ( m_particle[i].pos.y < h-10.0f ||
+                    if ( m_particleMotion[i].pos.y < h-10.0f ||
                          m_particle[i].time >= 20.0f   )
                     {
                         DeleteRank(i);
@@ -868,7 +925,7 @@ void CParticle::FrameParticle(float rTime)
         int r = m_particle[i].trackRank;
         if (r != -1)  // drag exists?
         {
-            if (TrackMove(r, m_particle[i].pos, progress))
+            if (TrackMove(r, m_particleMotion[i].pos, progress))
             {
                 DeleteRank(i);
                 continue;
@@ -950,8 +1007,8 @@ void CParticle::FrameParticle(float rTime)
 
         if (m_particle[i].type == PARTITRACK11)  // phazer shot?
         {
-            CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-            m_particle[i].goal = m_particle[i].pos;
+            CObject* object = SearchObjectGun(m_particle[i].goal, m_particleMotion[i].pos, m_particle[i].type, m_particle[i].objFather);
+            m_particle[i].goal = m_particleMotion[i].pos;
             if (object != nullptr && object->Implements(ObjectInterfaceType::Damageable))
             {
                 dynamic_cast<CDamageableObject*>(object)->DamageObject(DamageType::Phazer, 0.002f, m_particle[i].objFather);
@@ -1110,7 +1167,7 @@ void CParticle::FrameParticle(float rTime)
             {
                 m_particle[i].testTime = 0.0f;
 
-                if (m_terrain->GetHeightToFloor(m_particle[i].pos, true) < -2.0f)
+                if (m_terrain->GetHeightToFloor(m_particleMotion[i].pos, true) < -2.0f)
                 {
                     m_exploGunCounter++;
 
@@ -1151,8 +1208,8 @@ void CParticle::FrameParticle(float rTime)
                     continue;
                 }
 
-                CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-                m_particle[i].goal = m_particle[i].pos;
+                CObject* object = SearchObjectGun(m_particle[i].goal, m_particleMotion[i].pos, m_particle[i].type, m_particle[i].objFather);
+                m_particle[i].goal = m_particleMotion[i].pos;
                 if (object != nullptr)
                 {
                     if (object->Implements(ObjectInterfaceType::Damageable))
@@ -1164,7 +1221,7 @@ void CParticle::FrameParticle(float rTime)
 
                     if (m_exploGunCounter % 2 == 0)
                     {
-                        pos = m_particle[i].pos;
+                        pos = m_particleMotion[i].pos;
                         Math::Vector speed;
                         speed.x = 0.0f;
                         speed.z = 0.0f;
@@ -1219,17 +1276,17 @@ void CParticle::FrameParticle(float rTime)
             if (m_particle[i].testTime >= 0.1f)
             {
                 m_particle[i].testTime = 0.0f;
-                CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-                m_particle[i].goal = m_particle[i].pos;
+                CObject* object = SearchObjectGun(m_particle[i].goal, m_particleMotion[i].pos, m_particle[i].type, m_particle[i].objFather);
+                m_particle[i].goal = m_particleMotion[i].pos;
                 if (object != nullptr)
                 {
                     if (object->GetType() == OBJECT_MOBILErs && dynamic_cast<CShielder*>(object)->GetActiveShieldRadius() > 0.0f)  // protected by shield?
                     {
-                        CreateParticle(m_particle[i].pos, Math::Vector(0.0f, 0.0f, 0.0f), Math::Point(6.0f, 6.0f), PARTIGUNDEL, 2.0f);
+                        CreateParticle(m_particleMotion[i].pos, Math::Vector(0.0f, 0.0f, 0.0f), Math::Point(6.0f, 6.0f), PARTIGUNDEL, 2.0f);
                         if (m_lastTimeGunDel > 0.2f)
                         {
                             m_lastTimeGunDel = 0.0f;
-                            Play(SOUND_GUNDEL, m_particle[i].pos, 1.0f);
+                            Play(SOUND_GUNDEL, m_particleMotion[i].pos, 1.0f);
                         }
                         DeleteRank(i);
                         continue;
@@ -1237,7 +1294,7 @@ void CParticle::FrameParticle(float rTime)
                     else
                     {
                         if (object->GetType() != OBJECT_HUMAN)
-                            Play(SOUND_TOUCH, m_particle[i].pos, 1.0f);
+                            Play(SOUND_TOUCH, m_particleMotion[i].pos, 1.0f);
 
                         if (object->Implements(ObjectInterfaceType::Damageable))
                         {
@@ -1267,17 +1324,17 @@ void CParticle::FrameParticle(float rTime)
             if (m_particle[i].testTime >= 0.1f)
             {
                 m_particle[i].testTime = 0.0f;
-                CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-                m_particle[i].goal = m_particle[i].pos;
+                CObject* object = SearchObjectGun(m_particle[i].goal, m_particleMotion[i].pos, m_particle[i].type, m_particle[i].objFather);
+                m_particle[i].goal = m_particleMotion[i].pos;
                 if (object != nullptr)
                 {
                     if (object->GetType() == OBJECT_MOBILErs && dynamic_cast<CShielder*>(object)->GetActiveShieldRadius() > 0.0f)
                     {
-                        CreateParticle(m_particle[i].pos, Math::Vector(0.0f, 0.0f, 0.0f), Math::Point(6.0f, 6.0f), PARTIGUNDEL, 2.0f);
+                        CreateParticle(m_particleMotion[i].pos, Math::Vector(0.0f, 0.0f, 0.0f), Math::Point(6.0f, 6.0f), PARTIGUNDEL, 2.0f);
                         if (m_lastTimeGunDel > 0.2f)
                         {
                             m_lastTimeGunDel = 0.0f;
-                            Play(SOUND_GUNDEL, m_particle[i].pos, 1.0f);
+                            Play(SOUND_GUNDEL, m_particleMotion[i].pos, 1.0f);
                         }
                         DeleteRank(i);
                         continue;
@@ -1310,7 +1367,7 @@ void CParticle::FrameParticle(float rTime)
             {
                 m_particle[i].testTime = 0.0f;
 
-                if (m_terrain->GetHeightToFloor(m_particle[i].pos, true) < -2.0f)
+                if (m_terrain->GetHeightToFloor(m_particleMotion[i].pos, true) < -2.0f)
                 {
                     m_exploGunCounter ++;
 
@@ -1339,8 +1396,8 @@ void CParticle::FrameParticle(float rTime)
                     continue;
                 }
 
-                CObject* object = SearchObjectGun(m_particle[i].goal, m_particle[i].pos, m_particle[i].type, m_particle[i].objFather);
-                m_particle[i].goal = m_particle[i].pos;
+                CObject* object = SearchObjectGun(m_particle[i].goal, m_particleMotion[i].pos, m_particle[i].type, m_particle[i].objFather);
+                m_particle[i].goal = m_particleMotion[i].pos;
                 if (object != nullptr)
                 {
                     if (object->Implements(ObjectInterfaceType::Damageable))
@@ -1352,7 +1409,7 @@ void CParticle::FrameParticle(float rTime)
 
                     if (m_exploGunCounter % 2 == 0)
                     {
-                        pos = m_particle[i].pos;
+                        pos = m_particleMotion[i].pos;
                         Math::Vector speed;
                         speed.x = 0.0f;
                         speed.z = 0.0f;
@@ -1601,15 +1658,15 @@ void CParticle::FrameParticle(float rTime)
         {
             float h = 10.0f;
 
-            if ( m_particle[i].pos.y >= eye.y   &&
-                 m_particle[i].pos.y <  eye.y+h )
+            if ( m_particleMotion[i].pos.y >= eye.y   &&
+                 m_particleMotion[i].pos.y <  eye.y+h )
             {
-                m_particle[i].intensity *= (m_particle[i].pos.y-eye.y)/h;
+                m_particle[i].intensity *= (m_particleMotion[i].pos.y-eye.y)/h;
             }
-            if ( m_particle[i].pos.y >  eye.y-h &&
-                 m_particle[i].pos.y <  eye.y   )
+            if ( m_particleMotion[i].pos.y >  eye.y-h &&
+                 m_particleMotion[i].pos.y <  eye.y   )
             {
-                m_particle[i].intensity *= (eye.y-m_particle[i].pos.y)/h;
+                m_particle[i].intensity *= (eye.y-m_particleMotion[i].pos.y)/h;
             }
         }
 
@@ -1690,7 +1747,7 @@ void CParticle::FrameParticle(float rTime)
         if (m_particle[i].type == PARTIBUBBLE)
         {
             if ( progress >= 1.0f ||
-                 m_particle[i].pos.y >= m_water->GetLevel() )
+                 m_particleMotion[i].pos.y >= m_water->GetLevel() )
             {
                 DeleteRank(i);
                 continue;
@@ -1897,7 +1954,7 @@ void CParticle::FrameParticle(float rTime)
             {
                 m_particle[i].testTime = 0.0f;
 
-                pos = m_particle[i].pos;
+                pos = m_particleMotion[i].pos;
                 Math::Vector speed = Math::Vector(0.0f, 0.0f, 0.0f);
                 Math::Point dim;
                 dim.x = 1.0f*(Math::Rand()*0.8f+0.6f);
@@ -1917,12 +1974,12 @@ void CParticle::FrameParticle(float rTime)
             {
                 DeleteRank(i);
 
-                pos = m_particle[i].pos;
+                pos = m_particleMotion[i].pos;
                 Math::Point dim;
                 dim.x    = m_particle[i].dim.x/4.0f;
                 dim.y    = dim.x;
                 float duration = m_particle[i].duration;
-                float mass     = m_particle[i].mass;
+                float mass     = m_particleMotion[i].mass;
                 int total = static_cast<int>((10.0f*m_engine->GetParticleDensity()));
                 for (int j = 0; j < total; j++)
                 {
@@ -2095,9 +2152,9 @@ void CParticle::FrameParticle(float rTime)
             {
                 m_particle[i].time = 0.0f;
                 m_particle[i].duration = 0.5f+Math::Rand()*2.0f;
-                m_particle[i].pos.x = m_particle[i].speed.x + (Math::Rand()-0.5f)*m_particle[i].mass;
-                m_particle[i].pos.y = m_particle[i].speed.y + (Math::Rand()-0.5f)*m_particle[i].mass;
-                m_particle[i].pos.z = m_particle[i].speed.z + (Math::Rand()-0.5f)*m_particle[i].mass;
+                m_particleMotion[i].pos.x = m_particleMotion[i].speed.x + (Math::Rand()-0.5f)*m_particleMotion[i].mass;
+                m_particleMotion[i].pos.y = m_particleMotion[i].speed.y + (Math::Rand()-0.5f)*m_particleMotion[i].mass;
+                m_particleMotion[i].pos.z = m_particleMotion[i].speed.z + (Math::Rand()-0.5f)*m_particleMotion[i].mass;
                 m_particle[i].dim.x = 0.5f+Math::Rand()*1.5f;
                 m_particle[i].dim.y = m_particle[i].dim.x;
                 progress = 0.0f;
@@ -2375,7 +2432,7 @@ void CParticle::FrameParticle(float rTime)
         if (m_particle[i].type == PARTIDROP)
         {
             if (progress >= 1.0f ||
-                m_particle[i].pos.y < m_water->GetLevel())
+                m_particleMotion[i].pos.y < m_water->GetLevel())
             {
                 DeleteRank(i);
                 continue;
@@ -2393,7 +2450,7 @@ void CParticle::FrameParticle(float rTime)
         if (m_particle[i].type == PARTIWATER)
         {
             if (progress >= 1.0f ||
-                m_particle[i].pos.y < m_water->GetLevel())
+                m_particleMotion[i].pos.y < m_water->GetLevel())
             {
                 DeleteRank(i);
                 continue;
@@ -2418,7 +2475,7 @@ void CParticle::FrameParticle(float rTime)
             if (m_particle[i].testTime >= 0.2f)
             {
                 m_particle[i].testTime = 0.0f;
-                CObject* object = SearchObjectRay(m_particle[i].pos, m_particle[i].goal,
+                CObject* object = SearchObjectRay(m_particleMotion[i].pos, m_particle[i].goal,
                                          m_particle[i].type, m_particle[i].objFather);
                 if (object != nullptr)
                 {
@@ -2678,7 +2735,7 @@ void CParticle::DrawParticleTriangle(int i)
     if (m_particle[i].zoom == 0.0f)  return;
 
     Math::Vector eye = m_engine->GetEyePt();
-    Math::Vector pos = m_particle[i].pos;
+    Math::Vector pos = m_particleMotion[i].pos;
 
     CObject* object = m_particle[i].objLink;
     if (object != nullptr)
@@ -2711,9 +2768,9 @@ void CParticle::DrawParticleNorm(int i)
     Math::Vector corner[4];
     Vertex vertex[4];
 
-    if (m_particle[i].sheet == SH_INTERFACE)
+    if (m_particleMotion[i].sheet == SH_INTERFACE)
     {
-        Math::Vector pos = m_particle[i].pos;
+        Math::Vector pos = m_particleMotion[i].pos;
 
         Math::Vector n(0.0f, 0.0f, -1.0f);
 
@@ -2748,7 +2805,7 @@ void CParticle::DrawParticleNorm(int i)
     else
     {
         Math::Vector eye = m_engine->GetEyePt();
-        Math::Vector pos = m_particle[i].pos;
+        Math::Vector pos = m_particleMotion[i].pos;
 
         CObject* object = m_particle[i].objLink;
         if (object != nullptr)
@@ -2803,7 +2860,7 @@ void CParticle::DrawParticleFlat(int i)
     if (m_particle[i].zoom == 0.0f) return;
     if (m_particle[i].intensity == 0.0f) return;
 
-    Math::Vector pos = m_particle[i].pos;
+    Math::Vector pos = m_particleMotion[i].pos;
 
     CObject* object = m_particle[i].objLink;
     if (object != nullptr)
@@ -2866,7 +2923,7 @@ void CParticle::DrawParticleFog(int i)
     if (!m_engine->GetFog()) return;
     if (m_particle[i].intensity == 0.0f) return;
 
-    Math::Vector pos = m_particle[i].pos;
+    Math::Vector pos = m_particleMotion[i].pos;
 
     Math::Point dim;
     dim.x = m_particle[i].dim.x;
@@ -2954,7 +3011,7 @@ void CParticle::DrawParticleRay(int i)
     if (m_particle[i].intensity == 0.0f)  return;
 
     Math::Vector eye = m_engine->GetEyePt();
-    Math::Vector pos = m_particle[i].pos;
+    Math::Vector pos = m_particleMotion[i].pos;
     Math::Vector goal = m_particle[i].goal;
 
     CObject* object = m_particle[i].objLink;
@@ -3119,9 +3176,9 @@ void CParticle::DrawParticleSphere(int i)
     mat.Set(1, 1, zoom);
     mat.Set(2, 2, zoom);
     mat.Set(3, 3, zoom);
-    mat.Set(1, 4, m_particle[i].pos.x);
-    mat.Set(2, 4, m_particle[i].pos.y);
-    mat.Set(3, 4, m_particle[i].pos.z);
+    mat.Set(1, 4, m_particleMotion[i].pos.x);
+    mat.Set(2, 4, m_particleMotion[i].pos.y);
+    mat.Set(3, 4, m_particleMotion[i].pos.z);
 
     if (m_particle[i].angle != 0.0f)
     {
@@ -3228,9 +3285,9 @@ void CParticle::DrawParticleCylinder(int i)
     mat.Set(1, 1, zoom);
     mat.Set(2, 2, zoom);
     mat.Set(3, 3, zoom);
-    mat.Set(1, 4, m_particle[i].pos.x);
-    mat.Set(2, 4, m_particle[i].pos.y);
-    mat.Set(3, 4, m_particle[i].pos.z);
+    mat.Set(1, 4, m_particleMotion[i].pos.x);
+    mat.Set(2, 4, m_particleMotion[i].pos.y);
+    mat.Set(3, 4, m_particleMotion[i].pos.z);
     m_device->SetTransform(TRANSFORM_WORLD, mat);
 
     Math::Point ts, ti;
@@ -3381,10 +3438,11 @@ void CParticle::DrawParticle(int sheet)
     // Draw the basic particles of triangles.
     if (m_totalInterface[0][sheet] > 0)
     {
-        for (int i = 0; i < MAXPARTICULE; i++)
+        for (int i : m_alive)
         {
+            if (i >= m_maxParticles)  continue;
             if (!m_particle[i].used)  continue;
-            if (m_particle[i].sheet != sheet)  continue;
+            if (m_particleMotion[i].sheet != sheet)  continue;
             if (m_particle[i].type == PARTIPART)  continue;
 
             m_engine->SetTexture(!m_triangle[i].tex1Name.empty() ? "textures/"+m_triangle[i].tex1Name : "");
@@ -3426,11 +3484,11 @@ void CParticle::DrawParticle(int sheet)
         else        state = ENG_RSTATE_TTEXTURE_BLACK;  // effect[00..02].png
         m_engine->SetState(state);
 
-        for (int j = 0; j < MAXPARTICULE; j++)
+        for (int i : m_alive)
         {
-            int i = MAXPARTICULE*t+j;
+            if (i/m_maxParticles != t)  continue;
             if (!m_particle[i].used)  continue;
-            if (m_particle[i].sheet != sheet)  continue;
+            if (m_particleMotion[i].sheet != sheet)  continue;
 
             if (!loadTexture && t != 5)
             {
@@ -3487,11 +3545,39 @@ void CParticle::DrawParticle(int sheet)
     }
 }
 
+// Bounds of the hit tests below, used to get only the objects around the segment
+// from the object spatial index. An object passing the box test and the distance
+// test to the (infinite) line of a segment is never further than sqrt(13) times
+// the tested distance from the segment itself.
+const float SEARCH_RANGE_FACTOR = sqrtf(13.0f) * 1.01f;
+
+float CParticle::GetSearchGunRange(ParticleType type)
+{
+    float min = 5.0f;
+    if (type == PARTIGUN2) min = 2.0f;  // shooting insect?
+    if (type == PARTIGUN3) min = 3.0f;  // suiciding spider?
+
+    float reach = CObjectManager::GetInstancePointer()->GetMaxCollisionReach();
+    float range = Math::Max((min + reach) * SEARCH_RANGE_FACTOR, min + 4.0f);
+    if (type == PARTIGUN2 || type == PARTIGUN3)
+        range = Math::Max(range, RADIUS_SHIELD_MAX);
+    return range;
+}
+
 CObject* CParticle::SearchObjectGun(Math::Vector old, Math::Vector pos,
                                     ParticleType type, CObject *father)
 {
     if (m_main->GetMovieLock()) return nullptr;  // current movie?
 
+    CObjectManager* objectManager = CObjectManager::GetInstancePointer();
+    return SearchObjectGun(old, pos, type, father,
+                           objectManager->GetObjectsNearSegment(old, pos, GetSearchGunRange(type)));
+}
+
+CObject* CParticle::SearchObjectGun(Math::Vector old, Math::Vector pos,
+                                    ParticleType type, CObject *father,
+                                    const std::vector<CObject*>& objects)
+{
     float min = 5.0f;
     if (type == PARTIGUN2) min = 2.0f;  // shooting insect?
     if (type == PARTIGUN3) min = 3.0f;  // suiciding spider?
@@ -3511,7 +3597,7 @@ CObject* CParticle::SearchObjectGun(Math::Vector old, Math::Vector pos,
     CObject* best = nullptr;
     float best_dist = std::numeric_limits<float>::infinity();
     bool shield = false;
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : objects)
     {
         if (!obj->GetDetectable()) continue;  // inactive?
         if (obj == father) continue;
@@ -3606,6 +3692,15 @@ CObject* CParticle::SearchObjectRay(Math::Vector pos, Math::Vector goal,
 {
     if (m_main->GetMovieLock()) return nullptr;  // current movie?
 
+    CObjectManager* objectManager = CObjectManager::GetInstancePointer();
+    return SearchObjectRay(pos, goal, type, father,
+                           objectManager->GetObjectsNearSegment(pos, goal, 10.0f * SEARCH_RANGE_FACTOR));
+}
+
+CObject* CParticle::SearchObjectRay(Math::Vector pos, Math::Vector goal,
+                                    ParticleType type, CObject *father,
+                                    const std::vector<CObject*>& objects)
+{
     float min = 10.0f;
 
     Math::Vector box1 = pos;
@@ -3620,7 +3715,7 @@ CObject* CParticle::SearchObjectRay(Math::Vector pos, Math::Vector goal,
     box2.y += min;
     box2.z += min;
 
-    for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    for (CObject* obj : objects)
     {
         if (!obj->GetDetectable()) continue;  // inactive?
         if (obj == father) continue;
@@ -3654,6 +3749,22 @@ CObject* CParticle::SearchObjectRay(Math::Vector pos, Math::Vector goal,
     return nullptr;
 }
 
+CObject* CParticle::SearchObjectHit(Math::Vector start, Math::Vector end, ParticleType type, CObject* father)
+{
+    CObjectManager* objectManager = CObjectManager::GetInstancePointer();
+    if (type == PARTIRAY1)
+        return SearchObjectRay(start, end, type, father, objectManager->GetObjectsNearSegment(start, end, 10.0f * SEARCH_RANGE_FACTOR));
+    return SearchObjectGun(start, end, type, father, objectManager->GetObjectsNearSegment(start, end, GetSearchGunRange(type)));
+}
+
+CObject* CParticle::SearchObjectHit(Math::Vector start, Math::Vector end, ParticleType type, CObject* father,
+                                    const std::vector<CObject*>& objects)
+{
+    if (type == PARTIRAY1)
+        return SearchObjectRay(start, end, type, father, objects);
+    return SearchObjectGun(start, end, type, father, objects);
+}
+
 void CParticle::Play(SoundType sound, Math::Vector pos, float amplitude)
 {
     if (m_sound == nullptr)
@@ -3674,20 +3785,20 @@ Color CParticle::GetFogColor(Math::Vector pos)
     {
         int i = m_fog[fog];  // i = rank of the particle
 
-        if (pos.y >= m_particle[i].pos.y+FOG_HSUP)  continue;
-        if (pos.y <= m_particle[i].pos.y-FOG_HINF)  continue;
+        if (pos.y >= m_particleMotion[i].pos.y+FOG_HSUP)  continue;
+        if (pos.y <= m_particleMotion[i].pos.y-FOG_HINF)  continue;
 
-        float dist = Math::DistanceProjected(pos, m_particle[i].pos);
+        float dist = Math::DistanceProjected(pos, m_particleMotion[i].pos);
         if (dist >= m_particle[i].dim.x*1.5f)  continue;
 
         // Calculates the horizontal distance.
         float factor = 1.0f-powf(dist/(m_particle[i].dim.x*1.5f), 4.0f);
 
         // Calculates the vertical distance.
-        if (pos.y > m_particle[i].pos.y)
-            factor *= 1.0f-(pos.y-m_particle[i].pos.y)/FOG_HSUP;
+        if (pos.y > m_particleMotion[i].pos.y)
+            factor *= 1.0f-(pos.y-m_particleMotion[i].pos.y)/FOG_HSUP;
         else
-            factor *= 1.0f-(m_particle[i].pos.y-pos.y)/FOG_HINF;
+            factor *= 1.0f-(m_particleMotion[i].pos.y-pos.y)/FOG_HINF;
 
         factor *= 0.3f;
 
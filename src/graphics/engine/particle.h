@@ -31,6 +31,8 @@
 
 #include "sound/sound_type.h"
 
+#include <vector>
+
 
 class CRobotMain;
 class CObject;
@@ -41,7 +43,10 @@ class CSoundInterface;
 namespace Gfx
 {
 
+//! Default number of particles of each texture type (see CParticle::SetParticleLimit())
 const short MAXPARTICULE = 500;
+//! Highest number of particles of each texture type, the rank must fit in 16 bits of the channel
+const int MAXPARTICULE_LIMIT = 10000;
 const short MAXPARTITYPE = 6;
 const short MAXTRACK = 100;
 const short MAXTRACKLEN = 10;
@@ -160,21 +165,34 @@ enum ParticlePhase
     PARPHEND        = 1,
 };
 
+/**
+ * \struct ParticleMotion
+ * \brief Part of a particle read and written by the motion pass of CParticle::FrameParticle()
+ *
+ * Kept apart from the other data of the particle (see Particle), so that moving
+ * all particles only goes through a small contiguous array.
+ */
+struct ParticleMotion
+{
+    Math::Vector    pos;        // absolute position (relative if object links)
+    Math::Vector    speed;      // speed of displacement
+    float           mass = 0.0f;       // mass of the particle (in rebounding)
+    float           windSensitivity = 0.0f;
+    short           sheet = 0;      // sheet (0..n)
+    bool            moving = true;     // FALSE -> position set by the particle itself (PARTIQUARTZ)
+    bool            alwaysUpdate = false;  // TRUE -> updated even during pause (PARTISHOW)
+};
+
 struct Particle
 {
     bool            used = false;      // TRUE -> particle used
     bool            ray = false;       // TRUE -> ray with goal
     unsigned short  uniqueStamp = 0;    // unique mark
-    short           sheet = 0;      // sheet (0..n)
     ParticleType    type = {};       // type PARTI*
     ParticlePhase   phase = {};      // phase PARPH*
-    float           mass = 0.0f;       // mass of the particle (in rebounding)
     float           weight = 0.0f;     // weight of the particle (for noise)
     float           duration = 0.0f;   // length of life
-    Math::Vector    pos;        // absolute position (relative if object links)
     Math::Vector    goal;       // goal position (if ray)
-    Math::Vector    speed;      // speed of displacement
-    float           windSensitivity = 0.0f;
     short           bounce = 0;     // number of rebounds
     Math::Point     dim;        // dimensions of the rectangle
     float           zoom = 0.0f;       // zoom (0..1)
@@ -235,6 +253,17 @@ public:
     //! Removes all particles of a sheet
     void        FlushParticle(int sheet);
 
+    //! Sets the number of particles of each texture type, removes all particles
+    void        SetParticleLimit(int limit);
+    int         GetParticleLimit();
+
+    //! Returns the object hit by a bullet moving from \a start to \a end, or by a ray (PARTIRAY1) between them
+    /** The objects near the segment are taken from the object spatial index, like in the game */
+    CObject*    SearchObjectHit(Math::Vector start, Math::Vector end, ParticleType type, CObject* father);
+    //! Same as above, testing only \a objects, used to check the spatial index (see test/benchmark/hit_benchmark.cpp)
+    CObject*    SearchObjectHit(Math::Vector start, Math::Vector end, ParticleType type, CObject* father,
+                                const std::vector<CObject*>& objects);
+
     //! Creates a new particle
     int         CreateParticle(Math::Vector pos, Math::Vector speed, Math::Point dim,
                                ParticleType type, float duration = 1.0f, float mass = 0.0f,
@@ -292,8 +321,14 @@ public:
     void        DrawParticle(int sheet);
 
 protected:
+    //! Takes the lowest free rank for a particle of given texture type, returns -1 if there is none
+    int         AllocateRank(int texture);
     //! Removes a particle of given rank
     void        DeleteRank(int rank);
+    //! Removes the dead particles from the list of particles alive and sorts it by rank
+    void        CompactAlive();
+    //! Applies speed, wind and gravity to a particle
+    void        MoveParticle(int i, float rTime, const Math::Vector& wind);
     /**
      * \brief Adapts the channel so it can be used as an offset in m_particle
      * \param channel Channel number to process, will be modified to be index of particle in m_particle
@@ -320,8 +355,16 @@ protected:
     void        DrawParticleWheel(int i);
     //! Seeks if an object collided with a bullet
     CObject*    SearchObjectGun(Math::Vector old, Math::Vector pos, ParticleType type, CObject *father);
+    //! Seeks if an object collided with a bullet, among given objects sorted by id
+    CObject*    SearchObjectGun(Math::Vector old, Math::Vector pos, ParticleType type, CObject *father,
+                                const std::vector<CObject*>& objects);
     //! Seeks if an object collided with a ray
     CObject*    SearchObjectRay(Math::Vector pos, Math::Vector goal, ParticleType type, CObject *father);
+    //! Seeks if an object collided with a ray, among given objects sorted by id
+    CObject*    SearchObjectRay(Math::Vector pos, Math::Vector goal, ParticleType type, CObject *father,
+                                const std::vector<CObject*>& objects);
+    //! Returns the projected distance from the segment beyond which no object can be hit by a bullet
+    float       GetSearchGunRange(ParticleType type);
     //! Sounded one
     void        Play(SoundType sound, Math::Vector pos, float amplitude);
     //! Moves a drag; returns true if the drag is finished
@@ -337,8 +380,18 @@ protected:
     CRobotMain*       m_main = nullptr;
     CSoundInterface*  m_sound = nullptr;
 
-    Particle       m_particle[MAXPARTICULE*MAXPARTITYPE];
-    EngineTriangle m_triangle[MAXPARTICULE];  // triangle if PartiType == 0
+    int            m_maxParticles = MAXPARTICULE;  // number of particles of each texture type
+    //! Particles of texture type t have ranks from m_maxParticles*t to m_maxParticles*(t+1)-1
+    std::vector<Particle>       m_particle;
+    std::vector<ParticleMotion> m_particleMotion;
+    std::vector<EngineTriangle> m_triangle;  // triangle if PartiType == 0
+    //! Ranks of the particles alive, sorted except for the ones created since the last frame
+    std::vector<int>  m_alive;
+    //! True if the rank is in m_alive, even if the particle is dead since
+    std::vector<bool> m_listed;
+    //! Free ranks of each texture type, as heaps giving the lowest rank first
+    std::vector<int>  m_freeRanks[MAXPARTITYPE];
+    bool          m_limitReached[MAXPARTITYPE] = {};
     Track          m_track[MAXTRACK];
     int           m_wheelTraceTotal = 0;
     int           m_wheelTraceIndex = 0;
@@ -59,6 +59,7 @@ CTerrain::CTerrain()
     m_useMaterials    = false;
 
     m_flyingMaxHeight = 0.0f;
+    m_reliefRevision = 0;
     m_maxMaterialID = 0;
     m_materialAutoID = 0;
     m_materialPointCount = 0;
@@ -93,6 +94,7 @@ bool CTerrain::Generate(int mosaicCount, int brickCountPow2, float brickSize,
 
     dim = (m_mosaicCount*m_brickCount+1)*(m_mosaicCount*m_brickCount+1);
     std::vector<float>(dim).swap(m_relief);
+    AddReliefChange(Math::Vector(), Math::Vector(), true);
 
     dim = m_mosaicCount*m_textureSubdivCount*m_mosaicCount*m_textureSubdivCount;
     std::vector<int>(dim).swap(m_textures);
@@ -273,6 +275,7 @@ TerrainRes CTerrain::GetResource(const Math::Vector &pos)
 void CTerrain::FlushRelief()
 {
     m_relief.clear();
+    AddReliefChange(Math::Vector(), Math::Vector(), true);
     m_resources.clear();
     m_textures.clear();
 
@@ -344,6 +347,7 @@ bool CTerrain::LoadRelief(const std::string &fileName, float scaleRelief,
         }
     }
 
+    AddReliefChange(Math::Vector(), Math::Vector(), true);
     return true;
 }
 
@@ -398,6 +402,8 @@ bool CTerrain::RandomizeRelief()
             m_relief[x2+y2*size] = value * 255.0f;
         }
     }
+
+    AddReliefChange(Math::Vector(), Math::Vector(), true);
     return true;
 }
 
@@ -422,15 +428,34 @@ bool CTerrain::AddReliefPoint(Math::Vector pos, float scaleRelief)
 }
 
 void CTerrain::AdjustRelief()
+{
+    Math::IntPoint min(0, 0);
+    Math::IntPoint max(m_mosaicCount*m_brickCount, m_mosaicCount*m_brickCount);
+    AdjustRelief(min, max);
+}
+
+void CTerrain::AdjustRelief(Math::IntPoint& min, Math::IntPoint& max)
 {
     if (m_depth == 1) return;
 
-    int ii = m_mosaicCount*m_brickCount+1;
+    int count = m_mosaicCount*m_brickCount;
+    int ii = count+1;
     int b = 1 << (m_depth-1);
 
-    for (int y = 0; y < m_mosaicCount*m_brickCount; y += b)
+    // Blocks of b x b points are adjusted from their corners, so every block
+    // having a point of the range (even on its edge) must be adjusted again
+    Math::IntPoint start, end;
+    start.x = Math::Max((Math::Max(min.x, 0)+b-1)/b-1, 0)*b;
+    start.y = Math::Max((Math::Max(min.y, 0)+b-1)/b-1, 0)*b;
+    end.x = Math::Min(Math::Min(max.x, count)/b*b, count-b);
+    end.y = Math::Min(Math::Min(max.y, count)/b*b, count-b);
+
+    min = start;
+    max = Math::IntPoint(end.x+b, end.y+b);
+
+    for (int y = start.y; y <= end.y; y += b)
     {
-        for (int x = 0; x < m_mosaicCount*m_brickCount; x += b)
+        for (int x = start.x; x <= end.x; x += b)
         {
             int xx = 0;
             int yy = 0;
@@ -729,7 +754,8 @@ bool CTerrain::CreateMosaic(int ox, int oy, int step, int objRank,
                     buffer.vertices.push_back(p2);
                 }
 
-                m_engine->AddBaseObjQuick(baseObjRank, buffer, texName1, texName2, true);
+                // Bounds of the base object are updated right away, instead of going through all base objects
+                m_engine->AddBaseObjQuick(baseObjRank, buffer, texName1, texName2, false);
             }
         }
     }
@@ -1250,15 +1276,32 @@ void CTerrain::FlushMaterialPoints()
 
 bool CTerrain::CreateSquare(int x, int y)
 {
-    Material mat;
-    mat.diffuse = Color(1.0f, 1.0f, 1.0f);
-    mat.ambient = Color(0.0f, 0.0f, 0.0f);
-
     int objRank = m_engine->CreateObject();
     m_engine->SetObjectType(objRank, ENG_OBJTYPE_TERRAIN);
 
     m_objRanks[x+y*m_mosaicCount] = objRank;
 
+    return CreateSquareGeometry(x, y, objRank);
+}
+
+bool CTerrain::RecreateSquare(int x, int y)
+{
+    // The engine object is kept, only its geometry is made again
+    int objRank = m_objRanks[x+y*m_mosaicCount];
+    int baseObjRank = m_engine->GetObjectBaseRank(objRank);
+    if (baseObjRank != -1)
+        m_engine->DeleteBaseObject(baseObjRank);
+    m_engine->SetObjectBaseRank(objRank, -1);
+
+    return CreateSquareGeometry(x, y, objRank);
+}
+
+bool CTerrain::CreateSquareGeometry(int x, int y, int objRank)
+{
+    Material mat;
+    mat.diffuse = Color(1.0f, 1.0f, 1.0f);
+    mat.ambient = Color(0.0f, 0.0f, 0.0f);
+
     for (int step = 0; step < m_depth; step++)
     {
         CreateMosaic(x, y, 1 << step, objRank, mat);
@@ -1340,35 +1383,75 @@ bool CTerrain::Terraform(const Math::Vector &p1, const Math::Vector &p2, float h
             }
         }
     }
-    AdjustRelief();
+    // Only the bricks around the changed points are adjusted
+    Math::IntPoint dirty1(tp1.x-1, tp1.y-1);
+    Math::IntPoint dirty2(tp2.x+1, tp2.y+1);
+    AdjustRelief(dirty1, dirty2);
 
+    // Vertex normals are computed from neighbor points, up to the biggest step of a mosaic
+    int margin = 1 << (m_depth-1);
     Math::IntPoint pp1, pp2;
-    pp1.x = (tp1.x-2)/m_brickCount;
-    pp1.y = (tp1.y-2)/m_brickCount;
-    pp2.x = (tp2.x+1)/m_brickCount;
-    pp2.y = (tp2.y+1)/m_brickCount;
+    pp1.x = (Math::Max(dirty1.x-margin, 0)+m_brickCount-1)/m_brickCount-1;
+    pp1.y = (Math::Max(dirty1.y-margin, 0)+m_brickCount-1)/m_brickCount-1;
+    pp2.x = (dirty2.x+margin)/m_brickCount;
+    pp2.y = (dirty2.y+margin)/m_brickCount;
 
     if (pp1.x <  0            ) pp1.x = 0;
-    if (pp1.x >= m_mosaicCount) pp1.x = m_mosaicCount-1;
     if (pp1.y <  0            ) pp1.y = 0;
-    if (pp1.y >= m_mosaicCount) pp1.y = m_mosaicCount-1;
+    if (pp2.x >= m_mosaicCount) pp2.x = m_mosaicCount-1;
+    if (pp2.y >= m_mosaicCount) pp2.y = m_mosaicCount-1;
 
     for (int y = pp1.y; y <= pp2.y; y++)
     {
         for (int x = pp1.x; x <= pp2.x; x++)
-        {
-            int objRank = m_objRanks[x+y*m_mosaicCount];
-            int baseObjRank = m_engine->GetObjectBaseRank(objRank);
-            m_engine->DeleteBaseObject(baseObjRank);
-            m_engine->DeleteObject(objRank);
-            CreateSquare(x, y);  // recreates the square
-        }
+            RecreateSquare(x, y);
     }
-    m_engine->Update();
+
+    // AdjustRelief() may have touched anything in the recreated squares
+    float mosaicSize = m_brickCount*m_brickSize;
+    AddReliefChange(Math::Vector(pp1.x*mosaicSize-dim, 0.0f, pp1.y*mosaicSize-dim),
+                    Math::Vector((pp2.x+1)*mosaicSize-dim, 0.0f, (pp2.y+1)*mosaicSize-dim),
+                    false);
 
     return true;
 }
 
+int CTerrain::GetReliefRevision()
+{
+    return m_reliefRevision;
+}
+
+bool CTerrain::GetReliefChange(int revision, Math::Vector& min, Math::Vector& max)
+{
+    for (const ReliefChange& change : m_reliefChanges)
+    {
+        if (change.revision != revision) continue;
+        if (change.whole) return false;
+
+        min = change.min;
+        max = change.max;
+        return true;
+    }
+    return false;
+}
+
+void CTerrain::AddReliefChange(const Math::Vector& min, const Math::Vector& max, bool whole)
+{
+    const std::size_t MAX_RELIEF_CHANGES = 16;
+
+    m_reliefRevision++;
+
+    ReliefChange change;
+    change.revision = m_reliefRevision;
+    change.min = min;
+    change.max = max;
+    change.whole = whole;
+
+    if (m_reliefChanges.size() >= MAX_RELIEF_CHANGES)
+        m_reliefChanges.erase(m_reliefChanges.begin());
+    m_reliefChanges.push_back(change);
+}
+
 void CTerrain::SetWind(Math::Vector speed)
 {
     m_wind = speed;
@@ -27,6 +27,7 @@
 #include "graphics/core/vertex.h"
 
 #include "math/const.h"
+#include "math/intpoint.h"
 #include "math/point.h"
 #include "math/vector.h"
 
@@ -182,6 +183,15 @@ public:
     //! Modifies the terrain's relief
     bool        Terraform(const Math::Vector& p1, const Math::Vector& p2, float height);
 
+    //! Returns a number incremented every time the relief changes
+    int         GetReliefRevision();
+    //! Gives the area (XZ) changed by the given relief revision
+    /**
+     * Lets caches of terrain data update only what changed since the revision they were built from.
+     * \return false if the whole relief changed or the revision is too old to be remembered
+     */
+    bool        GetReliefChange(int revision, Math::Vector& min, Math::Vector& max);
+
     //@{
     //! Management of the wind
     void         SetWind(Math::Vector speed);
@@ -251,6 +261,9 @@ protected:
     bool        AddReliefPoint(Math::Vector pos, float scaleRelief);
     //! Adjust the edges of each mosaic to be compatible with all lower resolutions
     void        AdjustRelief();
+    //! Adjust the edges only around the given range of relief points
+    /** The range is extended to all the points which may have been changed */
+    void        AdjustRelief(Math::IntPoint& min, Math::IntPoint& max);
     //! Calculates a vector of the terrain
     Math::Vector GetVector(int x, int y);
     //! Calculates a vertex of the terrain
@@ -259,6 +272,10 @@ protected:
     bool        CreateMosaic(int ox, int oy, int step, int objRank, const Material& mat);
     //! Creates all objects in a mesh square ground
     bool        CreateSquare(int x, int y);
+    //! Recreates the geometry of a mesh square ground after its relief has changed
+    bool        RecreateSquare(int x, int y);
+    //! Creates the mosaics of all levels of detail of a mesh square ground in the given engine object
+    bool        CreateSquareGeometry(int x, int y, int objRank);
 
     struct TerrainMaterial;
     //! Seeks a material based on its ID
@@ -285,6 +302,9 @@ protected:
     //! Adjusts a position according to a possible rise
     void        AdjustBuildingLevel(Math::Vector &p);
 
+    //! Records a change of the relief in the given area (XZ), or in the whole relief
+    void        AddReliefChange(const Math::Vector& min, const Math::Vector& max, bool whole);
+
 protected:
     CEngine*        m_engine;
     CWater*         m_water;
@@ -404,6 +424,22 @@ protected:
     };
     //! List of local flight limits
     std::vector<FlyingLimit> m_flyingLimits;
+
+    /**
+     * \struct ReliefChange
+     * \brief Area modified by one change of the relief
+     */
+    struct ReliefChange
+    {
+        int          revision = 0;
+        Math::Vector min;
+        Math::Vector max;
+        bool         whole = true;
+    };
+    //! Last changes of the relief, oldest first
+    std::vector<ReliefChange> m_reliefChanges;
+    //! Revision of the relief, see GetReliefRevision()
+    int             m_reliefRevision;
 };
 
 
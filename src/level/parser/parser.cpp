@@ -210,14 +210,7 @@ void CLevelParser::Load()
             {
                 if (translatableLines.count(baseCommand) > 0)
                 {
-                    auto it = std::remove_if(
-                        m_lines.begin(),
-                        m_lines.end(),
-                        [&baseCommand](const CLevelParserLineUPtr& line)
-                        {
-                            return line->GetCommand() == baseCommand;
-                        });
-                    m_lines.erase(it, m_lines.end());
+                    RemoveLines(baseCommand);
                 }
 
                 translatableLines.insert(baseCommand);
@@ -354,9 +347,27 @@ const std::string& CLevelParser::GetFilename()
 void CLevelParser::AddLine(CLevelParserLineUPtr line)
 {
     line->SetLevel(this);
+    m_commandIndex[line->GetCommand()].push_back(line.get());
     m_lines.push_back(std::move(line));
 }
 
+void CLevelParser::RemoveLines(const std::string& command)
+{
+    auto index = m_commandIndex.find(command);
+    if (index == m_commandIndex.end())
+        return;
+    m_commandIndex.erase(index);
+
+    auto it = std::remove_if(
+        m_lines.begin(),
+        m_lines.end(),
+        [&command](const CLevelParserLineUPtr& line)
+        {
+            return line->GetCommand() == command;
+        });
+    m_lines.erase(it, m_lines.end());
+}
+
 CLevelParserLine* CLevelParser::Get(const std::string& command)
 {
     CLevelParserLine* line = GetIfDefined(command);
@@ -367,21 +378,16 @@ CLevelParserLine* CLevelParser::Get(const std::string& command)
 
 CLevelParserLine* CLevelParser::GetIfDefined(const std::string& command)
 {
-    for (auto& line : m_lines)
-    {
-        if (line->GetCommand() == command)
-            return line.get();
-    }
-    return nullptr;
+    auto it = m_commandIndex.find(command);
+    if (it == m_commandIndex.end())
+        return nullptr;
+    return it->second.front();
 }
 
 int CLevelParser::CountLines(const std::string& command)
 {
-    int count = 0;
-    for (auto& line : m_lines)
-    {
-        if (line->GetCommand() == command)
-            count++;
-    }
-    return count;
+    auto it = m_commandIndex.find(command);
+    if (it == m_commandIndex.end())
+        return 0;
+    return static_cast<int>(it->second.size());
 }
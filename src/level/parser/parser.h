@@ -34,6 +34,7 @@
 #include "level/parser/parserparam.h"
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -94,9 +95,15 @@ public:
     //! Count lines with given command
     int CountLines(const std::string& command);
 
+private:
+    //! Removes all lines with given command
+    void RemoveLines(const std::string& command);
+
 private:
     std::string m_filename;
     std::vector<CLevelParserLineUPtr> m_lines;
+    //! Lines of each command, in file order
+    std::unordered_map<std::string, std::vector<CLevelParserLine*>> m_commandIndex;
 
     std::string m_pathCat;
     std::string m_pathChap;
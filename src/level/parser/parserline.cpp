@@ -64,7 +64,7 @@ const std::string& CLevelParserLine::GetLevelFilename()
     return m_levelFilename;
 }
 
-std::string CLevelParserLine::GetCommand()
+const std::string& CLevelParserLine::GetCommand()
 {
     return m_command;
 }
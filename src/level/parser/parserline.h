@@ -50,7 +50,8 @@ public:
 
     const std::string& GetLevelFilename();
 
-    std::string GetCommand();
+    const std::string& GetCommand();
+    //! Changes the command, only allowed before the line is added to a level (see CLevelParser::AddLine())
     void SetCommand(std::string command);
 
     CLevelParserParam* GetParam(std::string name);
@@ -31,6 +31,9 @@
 
 #include "level/parser/parser.h"
 
+#include <map>
+#include <unordered_map>
+
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 
@@ -154,7 +157,12 @@ int CLevelParserParam::AsInt()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return Cast<int>("int");
+    if (!m_cache.hasInt)
+    {
+        m_cache.intValue = Cast<int>("int");
+        m_cache.hasInt = true;
+    }
+    return m_cache.intValue;
 }
 
 
@@ -170,7 +178,12 @@ float CLevelParserParam::AsFloat()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return Cast<float>("float");
+    if (!m_cache.hasFloat)
+    {
+        m_cache.floatValue = Cast<float>("float");
+        m_cache.hasFloat = true;
+    }
+    return m_cache.floatValue;
 }
 
 float CLevelParserParam::AsFloat(float def)
@@ -332,403 +345,417 @@ Math::Vector CLevelParserParam::AsPoint(Math::Vector def)
 }
 
 
-ObjectType CLevelParserParam::ToObjectType(std::string value)
+ObjectType CLevelParserParam::ToObjectType(const std::string& value)
 {
-    if (value == "All"               ) return OBJECT_NULL; // For use in NewScript
-    if (value == "Any"               ) return OBJECT_NULL; // For use in type= in ending conditions
-    if (value == "Portico"           ) return OBJECT_PORTICO;
-    if (value == "SpaceShip"         ) return OBJECT_BASE;
-    if (value == "PracticeBot"       ) return OBJECT_MOBILEwt;
-    if (value == "WingedGrabber"     ) return OBJECT_MOBILEfa;
-    if (value == "TrackedGrabber"    ) return OBJECT_MOBILEta;
-    if (value == "WheeledGrabber"    ) return OBJECT_MOBILEwa;
-    if (value == "LeggedGrabber"     ) return OBJECT_MOBILEia;
-    if (value == "WingedShooter"     ) return OBJECT_MOBILEfc;
-    if (value == "TrackedShooter"    ) return OBJECT_MOBILEtc;
-    if (value == "WheeledShooter"    ) return OBJECT_MOBILEwc;
-    if (value == "LeggedShooter"     ) return OBJECT_MOBILEic;
-    if (value == "WingedOrgaShooter" ) return OBJECT_MOBILEfi;
-    if (value == "TrackedOrgaShooter") return OBJECT_MOBILEti;
-    if (value == "WheeledOrgaShooter") return OBJECT_MOBILEwi;
-    if (value == "LeggedOrgaShooter" ) return OBJECT_MOBILEii;
-    if (value == "WingedSniffer"     ) return OBJECT_MOBILEfs;
-    if (value == "TrackedSniffer"    ) return OBJECT_MOBILEts;
-    if (value == "WheeledSniffer"    ) return OBJECT_MOBILEws;
-    if (value == "LeggedSniffer"     ) return OBJECT_MOBILEis;
-    if (value == "Thumper"           ) return OBJECT_MOBILErt;
-    if (value == "PhazerShooter"     ) return OBJECT_MOBILErc;
-    if (value == "Recycler"          ) return OBJECT_MOBILErr;
-    if (value == "Shielder"          ) return OBJECT_MOBILErs;
-    if (value == "Subber"            ) return OBJECT_MOBILEsa;
-    if (value == "TargetBot"         ) return OBJECT_MOBILEtg;
-    if (value == "Scribbler"         ) return OBJECT_MOBILEdr;
-    if (value == "PowerSpot"         ) return OBJECT_MARKPOWER;
-    if (value == "TitaniumSpot"      ) return OBJECT_MARKSTONE;
-    if (value == "UraniumSpot"       ) return OBJECT_MARKURANIUM;
-    if (value == "PlatinumSpot"      ) return OBJECT_MARKURANIUM;
-    if (value == "KeyASpot"          ) return OBJECT_MARKKEYa;
-    if (value == "KeyBSpot"          ) return OBJECT_MARKKEYb;
-    if (value == "KeyCSpot"          ) return OBJECT_MARKKEYc;
-    if (value == "KeyDSpot"          ) return OBJECT_MARKKEYd;
-    if (value == "WayPoint"          ) return OBJECT_WAYPOINT;
-    if (value == "BlueFlag"          ) return OBJECT_FLAGb;
-    if (value == "RedFlag"           ) return OBJECT_FLAGr;
-    if (value == "GreenFlag"         ) return OBJECT_FLAGg;
-    if (value == "YellowFlag"        ) return OBJECT_FLAGy;
-    if (value == "VioletFlag"        ) return OBJECT_FLAGv;
-    if (value == "PowerCell"         ) return OBJECT_POWER;
-    if (value == "FuelCellPlant"     ) return OBJECT_NUCLEAR;
-    if (value == "FuelCell"          ) return OBJECT_ATOMIC;
-    if (value == "NuclearCell"       ) return OBJECT_ATOMIC;
-    if (value == "TitaniumOre"       ) return OBJECT_STONE;
-    if (value == "UraniumOre"        ) return OBJECT_URANIUM;
-    if (value == "PlatinumOre"       ) return OBJECT_URANIUM;
-    if (value == "Titanium"          ) return OBJECT_METAL;
-    if (value == "OrgaMatter"        ) return OBJECT_BULLET;
-    if (value == "BlackBox"          ) return OBJECT_BBOX;
-    if (value == "KeyA"              ) return OBJECT_KEYa;
-    if (value == "KeyB"              ) return OBJECT_KEYb;
-    if (value == "KeyC"              ) return OBJECT_KEYc;
-    if (value == "KeyD"              ) return OBJECT_KEYd;
-    if (value == "TNT"               ) return OBJECT_TNT;
-    if (value == "Mine"              ) return OBJECT_BOMB;
-    if (value == "Firework"          ) return OBJECT_WINFIRE;
-    if (value == "Bag"               ) return OBJECT_BAG;
-    if (value == "Greenery0"         ) return OBJECT_PLANT0;
-    if (value == "Greenery1"         ) return OBJECT_PLANT1;
-    if (value == "Greenery2"         ) return OBJECT_PLANT2;
-    if (value == "Greenery3"         ) return OBJECT_PLANT3;
-    if (value == "Greenery4"         ) return OBJECT_PLANT4;
-    if (value == "Greenery5"         ) return OBJECT_PLANT5;
-    if (value == "Greenery6"         ) return OBJECT_PLANT6;
-    if (value == "Greenery7"         ) return OBJECT_PLANT7;
-    if (value == "Greenery8"         ) return OBJECT_PLANT8;
-    if (value == "Greenery9"         ) return OBJECT_PLANT9;
-    if (value == "Greenery10"        ) return OBJECT_PLANT10;
-    if (value == "Greenery11"        ) return OBJECT_PLANT11;
-    if (value == "Greenery12"        ) return OBJECT_PLANT12;
-    if (value == "Greenery13"        ) return OBJECT_PLANT13;
-    if (value == "Greenery14"        ) return OBJECT_PLANT14;
-    if (value == "Greenery15"        ) return OBJECT_PLANT15;
-    if (value == "Greenery16"        ) return OBJECT_PLANT16;
-    if (value == "Greenery17"        ) return OBJECT_PLANT17;
-    if (value == "Greenery18"        ) return OBJECT_PLANT18;
-    if (value == "Greenery19"        ) return OBJECT_PLANT19;
-    if (value == "Tree0"             ) return OBJECT_TREE0;
-    if (value == "Tree1"             ) return OBJECT_TREE1;
-    if (value == "Tree2"             ) return OBJECT_TREE2;
-    if (value == "Tree3"             ) return OBJECT_TREE3;
-    if (value == "Tree4"             ) return OBJECT_TREE4;
-    if (value == "Tree5"             ) return OBJECT_TREE5;
-    if (value == "Mushroom1"         ) return OBJECT_MUSHROOM1;
-    if (value == "Mushroom2"         ) return OBJECT_MUSHROOM2;
-    if (value == "Home"              ) return OBJECT_HOME1;
-    if (value == "Derrick"           ) return OBJECT_DERRICK;
-    if (value == "BotFactory"        ) return OBJECT_FACTORY;
-    if (value == "PowerStation"      ) return OBJECT_STATION;
-    if (value == "Converter"         ) return OBJECT_CONVERT;
-    if (value == "RepairCenter"      ) return OBJECT_REPAIR;
-    if (value == "Destroyer"         ) return OBJECT_DESTROYER;
-    if (value == "DefenseTower"      ) return OBJECT_TOWER;
-    if (value == "AlienNest"         ) return OBJECT_NEST;
-    if (value == "ResearchCenter"    ) return OBJECT_RESEARCH;
-    if (value == "RadarStation"      ) return OBJECT_RADAR;
-    if (value == "ExchangePost"      ) return OBJECT_INFO;
-    if (value == "PowerPlant"        ) return OBJECT_ENERGY;
-    if (value == "AutoLab"           ) return OBJECT_LABO;
-    if (value == "NuclearPlant"      ) return OBJECT_NUCLEAR;
-    if (value == "PowerCaptor"       ) return OBJECT_PARA;
-    if (value == "Vault"             ) return OBJECT_SAFE;
-    if (value == "Houston"           ) return OBJECT_HUSTON;
-    if (value == "Target1"           ) return OBJECT_TARGET1;
-    if (value == "Target2"           ) return OBJECT_TARGET2;
-    if (value == "StartArea"         ) return OBJECT_START;
-    if (value == "GoalArea"          ) return OBJECT_END;
-    if (value == "AlienQueen"        ) return OBJECT_MOTHER;
-    if (value == "AlienEgg"          ) return OBJECT_EGG;
-    if (value == "AlienAnt"          ) return OBJECT_ANT;
-    if (value == "AlienSpider"       ) return OBJECT_SPIDER;
-    if (value == "AlienWasp"         ) return OBJECT_BEE;
-    if (value == "AlienWorm"         ) return OBJECT_WORM;
-    if (value == "WreckBotw1"        ) return OBJECT_RUINmobilew1;
-    if (value == "WreckBotw2"        ) return OBJECT_RUINmobilew2;
-    if (value == "WreckBott1"        ) return OBJECT_RUINmobilet1;
-    if (value == "WreckBott2"        ) return OBJECT_RUINmobilet2;
-    if (value == "WreckBotr1"        ) return OBJECT_RUINmobiler1;
-    if (value == "WreckBotr2"        ) return OBJECT_RUINmobiler2;
-    if (value == "RuinBotFactory"    ) return OBJECT_RUINfactory;
-    if (value == "RuinDoor"          ) return OBJECT_RUINdoor;
-    if (value == "RuinSupport"       ) return OBJECT_RUINsupport;
-    if (value == "RuinRadar"         ) return OBJECT_RUINradar;
-    if (value == "RuinConvert"       ) return OBJECT_RUINconvert;
-    if (value == "RuinBaseCamp"      ) return OBJECT_RUINbase;
-    if (value == "RuinHeadCamp"      ) return OBJECT_RUINhead;
-    if (value == "Barrier0"          ) return OBJECT_BARRIER0;
-    if (value == "Barrier1"          ) return OBJECT_BARRIER1;
-    if (value == "Barrier2"          ) return OBJECT_BARRIER2;
-    if (value == "Barrier3"          ) return OBJECT_BARRIER3;
-    if (value == "Barricade0"        ) return OBJECT_BARRICADE0;
-    if (value == "Barricade1"        ) return OBJECT_BARRICADE1;
-    if (value == "Teen0"             ) return OBJECT_TEEN0;
-    if (value == "Teen1"             ) return OBJECT_TEEN1;
-    if (value == "Teen2"             ) return OBJECT_TEEN2;
-    if (value == "Teen3"             ) return OBJECT_TEEN3;
-    if (value == "Teen4"             ) return OBJECT_TEEN4;
-    if (value == "Teen5"             ) return OBJECT_TEEN5;
-    if (value == "Teen6"             ) return OBJECT_TEEN6;
-    if (value == "Teen7"             ) return OBJECT_TEEN7;
-    if (value == "Teen8"             ) return OBJECT_TEEN8;
-    if (value == "Teen9"             ) return OBJECT_TEEN9;
-    if (value == "Teen10"            ) return OBJECT_TEEN10;
-    if (value == "Teen11"            ) return OBJECT_TEEN11;
-    if (value == "Teen12"            ) return OBJECT_TEEN12;
-    if (value == "Teen13"            ) return OBJECT_TEEN13;
-    if (value == "Teen14"            ) return OBJECT_TEEN14;
-    if (value == "Teen15"            ) return OBJECT_TEEN15;
-    if (value == "Teen16"            ) return OBJECT_TEEN16;
-    if (value == "Teen17"            ) return OBJECT_TEEN17;
-    if (value == "Teen18"            ) return OBJECT_TEEN18;
-    if (value == "Teen19"            ) return OBJECT_TEEN19;
-    if (value == "Teen20"            ) return OBJECT_TEEN20;
-    if (value == "Teen21"            ) return OBJECT_TEEN21;
-    if (value == "Teen22"            ) return OBJECT_TEEN22;
-    if (value == "Teen23"            ) return OBJECT_TEEN23;
-    if (value == "Teen24"            ) return OBJECT_TEEN24;
-    if (value == "Teen25"            ) return OBJECT_TEEN25;
-    if (value == "Teen26"            ) return OBJECT_TEEN26;
-    if (value == "Teen27"            ) return OBJECT_TEEN27;
-    if (value == "Teen28"            ) return OBJECT_TEEN28;
-    if (value == "Teen29"            ) return OBJECT_TEEN29;
-    if (value == "Teen30"            ) return OBJECT_TEEN30;
-    if (value == "Teen31"            ) return OBJECT_TEEN31;
-    if (value == "Teen32"            ) return OBJECT_TEEN32;
-    if (value == "Teen33"            ) return OBJECT_TEEN33;
-    if (value == "Stone"             ) return OBJECT_TEEN34;
-    if (value == "Teen35"            ) return OBJECT_TEEN35;
-    if (value == "Teen36"            ) return OBJECT_TEEN36;
-    if (value == "Teen37"            ) return OBJECT_TEEN37;
-    if (value == "Teen38"            ) return OBJECT_TEEN38;
-    if (value == "Teen39"            ) return OBJECT_TEEN39;
-    if (value == "Teen40"            ) return OBJECT_TEEN40;
-    if (value == "Teen41"            ) return OBJECT_TEEN41;
-    if (value == "Teen42"            ) return OBJECT_TEEN42;
-    if (value == "Teen43"            ) return OBJECT_TEEN43;
-    if (value == "Teen44"            ) return OBJECT_TEEN44;
-    if (value == "Quartz0"           ) return OBJECT_QUARTZ0;
-    if (value == "Quartz1"           ) return OBJECT_QUARTZ1;
-    if (value == "Quartz2"           ) return OBJECT_QUARTZ2;
-    if (value == "Quartz3"           ) return OBJECT_QUARTZ3;
-    if (value == "MegaStalk0"        ) return OBJECT_ROOT0;
-    if (value == "MegaStalk1"        ) return OBJECT_ROOT1;
-    if (value == "MegaStalk2"        ) return OBJECT_ROOT2;
-    if (value == "MegaStalk3"        ) return OBJECT_ROOT3;
-    if (value == "MegaStalk4"        ) return OBJECT_ROOT4;
-    if (value == "MegaStalk5"        ) return OBJECT_ROOT5;
-    if (value == "ApolloLEM"         ) return OBJECT_APOLLO1;
-    if (value == "ApolloJeep"        ) return OBJECT_APOLLO2;
-    if (value == "ApolloFlag"        ) return OBJECT_APOLLO3;
-    if (value == "ApolloModule"      ) return OBJECT_APOLLO4;
-    if (value == "ApolloAntenna"     ) return OBJECT_APOLLO5;
-    if (value == "Me"                ) return OBJECT_HUMAN;
-    if (value == "Tech"              ) return OBJECT_TECH;
-    if (value == "MissionController" ) return OBJECT_CONTROLLER;
+    static const std::unordered_map<std::string, ObjectType> types =
+    {
+        { "All",                OBJECT_NULL }, // For use in NewScript
+        { "Any",                OBJECT_NULL }, // For use in type= in ending conditions
+        { "Portico",            OBJECT_PORTICO },
+        { "SpaceShip",          OBJECT_BASE },
+        { "PracticeBot",        OBJECT_MOBILEwt },
+        { "WingedGrabber",      OBJECT_MOBILEfa },
+        { "TrackedGrabber",     OBJECT_MOBILEta },
+        { "WheeledGrabber",     OBJECT_MOBILEwa },
+        { "LeggedGrabber",      OBJECT_MOBILEia },
+        { "WingedShooter",      OBJECT_MOBILEfc },
+        { "TrackedShooter",     OBJECT_MOBILEtc },
+        { "WheeledShooter",     OBJECT_MOBILEwc },
+        { "LeggedShooter",      OBJECT_MOBILEic },
+        { "WingedOrgaShooter",  OBJECT_MOBILEfi },
+        { "TrackedOrgaShooter", OBJECT_MOBILEti },
+        { "WheeledOrgaShooter", OBJECT_MOBILEwi },
+        { "LeggedOrgaShooter",  OBJECT_MOBILEii },
+        { "WingedSniffer",      OBJECT_MOBILEfs },
+        { "TrackedSniffer",     OBJECT_MOBILEts },
+        { "WheeledSniffer",     OBJECT_MOBILEws },
+        { "LeggedSniffer",      OBJECT_MOBILEis },
+        { "Thumper",            OBJECT_MOBILErt },
+        { "PhazerShooter",      OBJECT_MOBILErc },
+        { "Recycler",           OBJECT_MOBILErr },
+        { "Shielder",           OBJECT_MOBILErs },
+        { "Subber",             OBJECT_MOBILEsa },
+        { "TargetBot",          OBJECT_MOBILEtg },
+        { "Scribbler",          OBJECT_MOBILEdr },
+        { "PowerSpot",          OBJECT_MARKPOWER },
+        { "TitaniumSpot",       OBJECT_MARKSTONE },
+        { "UraniumSpot",        OBJECT_MARKURANIUM },
+        { "PlatinumSpot",       OBJECT_MARKURANIUM },
+        { "KeyASpot",           OBJECT_MARKKEYa },
+        { "KeyBSpot",           OBJECT_MARKKEYb },
+        { "KeyCSpot",           OBJECT_MARKKEYc },
+        { "KeyDSpot",           OBJECT_MARKKEYd },
+        { "WayPoint",           OBJECT_WAYPOINT },
+        { "BlueFlag",           OBJECT_FLAGb },
+        { "RedFlag",            OBJECT_FLAGr },
+        { "GreenFlag",          OBJECT_FLAGg },
+        { "YellowFlag",         OBJECT_FLAGy },
+        { "VioletFlag",         OBJECT_FLAGv },
+        { "PowerCell",          OBJECT_POWER },
+        { "FuelCellPlant",      OBJECT_NUCLEAR },
+        { "FuelCell",           OBJECT_ATOMIC },
+        { "NuclearCell",        OBJECT_ATOMIC },
+        { "TitaniumOre",        OBJECT_STONE },
+        { "UraniumOre",         OBJECT_URANIUM },
+        { "PlatinumOre",        OBJECT_URANIUM },
+        { "Titanium",           OBJECT_METAL },
+        { "OrgaMatter",         OBJECT_BULLET },
+        { "BlackBox",           OBJECT_BBOX },
+        { "KeyA",               OBJECT_KEYa },
+        { "KeyB",               OBJECT_KEYb },
+        { "KeyC",               OBJECT_KEYc },
+        { "KeyD",               OBJECT_KEYd },
+        { "TNT",                OBJECT_TNT },
+        { "Mine",               OBJECT_BOMB },
+        { "Firework",           OBJECT_WINFIRE },
+        { "Bag",                OBJECT_BAG },
+        { "Greenery0",          OBJECT_PLANT0 },
+        { "Greenery1",          OBJECT_PLANT1 },
+        { "Greenery2",          OBJECT_PLANT2 },
+        { "Greenery3",          OBJECT_PLANT3 },
+        { "Greenery4",          OBJECT_PLANT4 },
+        { "Greenery5",          OBJECT_PLANT5 },
+        { "Greenery6",          OBJECT_PLANT6 },
+        { "Greenery7",          OBJECT_PLANT7 },
+        { "Greenery8",          OBJECT_PLANT8 },
+        { "Greenery9",          OBJECT_PLANT9 },
+        { "Greenery10",         OBJECT_PLANT10 },
+        { "Greenery11",         OBJECT_PLANT11 },
+        { "Greenery12",         OBJECT_PLANT12 },
+        { "Greenery13",         OBJECT_PLANT13 },
+        { "Greenery14",         OBJECT_PLANT14 },
+        { "Greenery15",         OBJECT_PLANT15 },
+        { "Greenery16",         OBJECT_PLANT16 },
+        { "Greenery17",         OBJECT_PLANT17 },
+        { "Greenery18",         OBJECT_PLANT18 },
+        { "Greenery19",         OBJECT_PLANT19 },
+        { "Tree0",              OBJECT_TREE0 },
+        { "Tree1",              OBJECT_TREE1 },
+        { "Tree2",              OBJECT_TREE2 },
+        { "Tree3",              OBJECT_TREE3 },
+        { "Tree4",              OBJECT_TREE4 },
+        { "Tree5",              OBJECT_TREE5 },
+        { "Mushroom1",          OBJECT_MUSHROOM1 },
+        { "Mushroom2",          OBJECT_MUSHROOM2 },
+        { "Home",               OBJECT_HOME1 },
+        { "Derrick",            OBJECT_DERRICK },
+        { "BotFactory",         OBJECT_FACTORY },
+        { "PowerStation",       OBJECT_STATION },
+        { "Converter",          OBJECT_CONVERT },
+        { "RepairCenter",       OBJECT_REPAIR },
+        { "Destroyer",          OBJECT_DESTROYER },
+        { "DefenseTower",       OBJECT_TOWER },
+        { "AlienNest",          OBJECT_NEST },
+        { "ResearchCenter",     OBJECT_RESEARCH },
+        { "RadarStation",       OBJECT_RADAR },
+        { "ExchangePost",       OBJECT_INFO },
+        { "PowerPlant",         OBJECT_ENERGY },
+        { "AutoLab",            OBJECT_LABO },
+        { "NuclearPlant",       OBJECT_NUCLEAR },
+        { "PowerCaptor",        OBJECT_PARA },
+        { "Vault",              OBJECT_SAFE },
+        { "Houston",            OBJECT_HUSTON },
+        { "Target1",            OBJECT_TARGET1 },
+        { "Target2",            OBJECT_TARGET2 },
+        { "StartArea",          OBJECT_START },
+        { "GoalArea",           OBJECT_END },
+        { "AlienQueen",         OBJECT_MOTHER },
+        { "AlienEgg",           OBJECT_EGG },
+        { "AlienAnt",           OBJECT_ANT },
+        { "AlienSpider",        OBJECT_SPIDER },
+        { "AlienWasp",          OBJECT_BEE },
+        { "AlienWorm",          OBJECT_WORM },
+        { "WreckBotw1",         OBJECT_RUINmobilew1 },
+        { "WreckBotw2",         OBJECT_RUINmobilew2 },
+        { "WreckBott1",         OBJECT_RUINmobilet1 },
+        { "WreckBott2",         OBJECT_RUINmobilet2 },
+        { "WreckBotr1",         OBJECT_RUINmobiler1 },
+        { "WreckBotr2",         OBJECT_RUINmobiler2 },
+        { "RuinBotFactory",     OBJECT_RUINfactory },
+        { "RuinDoor",           OBJECT_RUINdoor },
+        { "RuinSupport",        OBJECT_RUINsupport },
+        { "RuinRadar",          OBJECT_RUINradar },
+        { "RuinConvert",        OBJECT_RUINconvert },
+        { "RuinBaseCamp",       OBJECT_RUINbase },
+        { "RuinHeadCamp",       OBJECT_RUINhead },
+        { "Barrier0",           OBJECT_BARRIER0 },
+        { "Barrier1",           OBJECT_BARRIER1 },
+        { "Barrier2",           OBJECT_BARRIER2 },
+        { "Barrier3",           OBJECT_BARRIER3 },
+        { "Barricade0",         OBJECT_BARRICADE0 },
+        { "Barricade1",         OBJECT_BARRICADE1 },
+        { "Teen0",              OBJECT_TEEN0 },
+        { "Teen1",              OBJECT_TEEN1 },
+        { "Teen2",              OBJECT_TEEN2 },
+        { "Teen3",              OBJECT_TEEN3 },
+        { "Teen4",              OBJECT_TEEN4 },
+        { "Teen5",              OBJECT_TEEN5 },
+        { "Teen6",              OBJECT_TEEN6 },
+        { "Teen7",              OBJECT_TEEN7 },
+        { "Teen8",              OBJECT_TEEN8 },
+        { "Teen9",              OBJECT_TEEN9 },
+        { "Teen10",             OBJECT_TEEN10 },
+        { "Teen11",             OBJECT_TEEN11 },
+        { "Teen12",             OBJECT_TEEN12 },
+        { "Teen13",             OBJECT_TEEN13 },
+        { "Teen14",             OBJECT_TEEN14 },
+        { "Teen15",             OBJECT_TEEN15 },
+        { "Teen16",             OBJECT_TEEN16 },
+        { "Teen17",             OBJECT_TEEN17 },
+        { "Teen18",             OBJECT_TEEN18 },
+        { "Teen19",             OBJECT_TEEN19 },
+        { "Teen20",             OBJECT_TEEN20 },
+        { "Teen21",             OBJECT_TEEN21 },
+        { "Teen22",             OBJECT_TEEN22 },
+        { "Teen23",             OBJECT_TEEN23 },
+        { "Teen24",             OBJECT_TEEN24 },
+        { "Teen25",             OBJECT_TEEN25 },
+        { "Teen26",             OBJECT_TEEN26 },
+        { "Teen27",             OBJECT_TEEN27 },
+        { "Teen28",             OBJECT_TEEN28 },
+        { "Teen29",             OBJECT_TEEN29 },
+        { "Teen30",             OBJECT_TEEN30 },
+        { "Teen31",             OBJECT_TEEN31 },
+        { "Teen32",             OBJECT_TEEN32 },
+        { "Teen33",             OBJECT_TEEN33 },
+        { "Stone",              OBJECT_TEEN34 },
+        { "Teen35",             OBJECT_TEEN35 },
+        { "Teen36",             OBJECT_TEEN36 },
+        { "Teen37",             OBJECT_TEEN37 },
+        { "Teen38",             OBJECT_TEEN38 },
+        { "Teen39",             OBJECT_TEEN39 },
+        { "Teen40",             OBJECT_TEEN40 },
+        { "Teen41",             OBJECT_TEEN41 },
+        { "Teen42",             OBJECT_TEEN42 },
+        { "Teen43",             OBJECT_TEEN43 },
+        { "Teen44",             OBJECT_TEEN44 },
+        { "Quartz0",            OBJECT_QUARTZ0 },
+        { "Quartz1",            OBJECT_QUARTZ1 },
+        { "Quartz2",            OBJECT_QUARTZ2 },
+        { "Quartz3",            OBJECT_QUARTZ3 },
+        { "MegaStalk0",         OBJECT_ROOT0 },
+        { "MegaStalk1",         OBJECT_ROOT1 },
+        { "MegaStalk2",         OBJECT_ROOT2 },
+        { "MegaStalk3",         OBJECT_ROOT3 },
+        { "MegaStalk4",         OBJECT_ROOT4 },
+        { "MegaStalk5",         OBJECT_ROOT5 },
+        { "ApolloLEM",          OBJECT_APOLLO1 },
+        { "ApolloJeep",         OBJECT_APOLLO2 },
+        { "ApolloFlag",         OBJECT_APOLLO3 },
+        { "ApolloModule",       OBJECT_APOLLO4 },
+        { "ApolloAntenna",      OBJECT_APOLLO5 },
+        { "Me",                 OBJECT_HUMAN },
+        { "Tech",               OBJECT_TECH },
+        { "MissionController",  OBJECT_CONTROLLER },
+    };
+
+    auto it = types.find(value);
+    if (it != types.end())
+        return it->second;
     return static_cast<ObjectType>(Cast<int>(value, "object"));
 }
 
 const std::string CLevelParserParam::FromObjectType(ObjectType value)
 {
-    if (value == OBJECT_PORTICO     ) return "Portico";
-    if (value == OBJECT_BASE        ) return "SpaceShip";
-    if (value == OBJECT_MOBILEwt    ) return "PracticeBot";
-    if (value == OBJECT_MOBILEfa    ) return "WingedGrabber";
-    if (value == OBJECT_MOBILEta    ) return "TrackedGrabber";
-    if (value == OBJECT_MOBILEwa    ) return "WheeledGrabber";
-    if (value == OBJECT_MOBILEia    ) return "LeggedGrabber";
-    if (value == OBJECT_MOBILEfc    ) return "WingedShooter";
-    if (value == OBJECT_MOBILEtc    ) return "TrackedShooter";
-    if (value == OBJECT_MOBILEwc    ) return "WheeledShooter";
-    if (value == OBJECT_MOBILEic    ) return "LeggedShooter";
-    if (value == OBJECT_MOBILEfi    ) return "WingedOrgaShooter";
-    if (value == OBJECT_MOBILEti    ) return "TrackedOrgaShooter";
-    if (value == OBJECT_MOBILEwi    ) return "WheeledOrgaShooter";
-    if (value == OBJECT_MOBILEii    ) return "LeggedOrgaShooter";
-    if (value == OBJECT_MOBILEfs    ) return "WingedSniffer";
-    if (value == OBJECT_MOBILEts    ) return "TrackedSniffer";
-    if (value == OBJECT_MOBILEws    ) return "WheeledSniffer";
-    if (value == OBJECT_MOBILEis    ) return "LeggedSniffer";
-    if (value == OBJECT_MOBILErt    ) return "Thumper";
-    if (value == OBJECT_MOBILErc    ) return "PhazerShooter";
-    if (value == OBJECT_MOBILErr    ) return "Recycler";
-    if (value == OBJECT_MOBILErs    ) return "Shielder";
-    if (value == OBJECT_MOBILEsa    ) return "Subber";
-    if (value == OBJECT_MOBILEtg    ) return "TargetBot";
-    if (value == OBJECT_MOBILEdr    ) return "Scribbler";
-    if (value == OBJECT_MARKPOWER   ) return "PowerSpot";
-    if (value == OBJECT_MARKSTONE   ) return "TitaniumSpot";
-    if (value == OBJECT_MARKURANIUM ) return "UraniumSpot";
-    if (value == OBJECT_MARKKEYa    ) return "KeyASpot";
-    if (value == OBJECT_MARKKEYb    ) return "KeyBSpot";
-    if (value == OBJECT_MARKKEYc    ) return "KeyCSpot";
-    if (value == OBJECT_MARKKEYd    ) return "KeyDSpot";
-    if (value == OBJECT_WAYPOINT    ) return "WayPoint";
-    if (value == OBJECT_FLAGb       ) return "BlueFlag";
-    if (value == OBJECT_FLAGr       ) return "RedFlag";
-    if (value == OBJECT_FLAGg       ) return "GreenFlag";
-    if (value == OBJECT_FLAGy       ) return "YellowFlag";
-    if (value == OBJECT_FLAGv       ) return "VioletFlag";
-    if (value == OBJECT_POWER       ) return "PowerCell";
-    if (value == OBJECT_ATOMIC      ) return "NuclearCell";
-    if (value == OBJECT_STONE       ) return "TitaniumOre";
-    if (value == OBJECT_URANIUM     ) return "UraniumOre";
-    if (value == OBJECT_METAL       ) return "Titanium";
-    if (value == OBJECT_BULLET      ) return "OrgaMatter";
-    if (value == OBJECT_BBOX        ) return "BlackBox";
-    if (value == OBJECT_KEYa        ) return "KeyA";
-    if (value == OBJECT_KEYb        ) return "KeyB";
-    if (value == OBJECT_KEYc        ) return "KeyC";
-    if (value == OBJECT_KEYd        ) return "KeyD";
-    if (value == OBJECT_TNT         ) return "TNT";
-    if (value == OBJECT_BOMB        ) return "Mine";
-    if (value == OBJECT_WINFIRE     ) return "Firework";
-    if (value == OBJECT_BAG         ) return "Bag";
-    if (value == OBJECT_PLANT0      ) return "Greenery0";
-    if (value == OBJECT_PLANT1      ) return "Greenery1";
-    if (value == OBJECT_PLANT2      ) return "Greenery2";
-    if (value == OBJECT_PLANT3      ) return "Greenery3";
-    if (value == OBJECT_PLANT4      ) return "Greenery4";
-    if (value == OBJECT_PLANT5      ) return "Greenery5";
-    if (value == OBJECT_PLANT6      ) return "Greenery6";
-    if (value == OBJECT_PLANT7      ) return "Greenery7";
-    if (value == OBJECT_PLANT8      ) return "Greenery8";
-    if (value == OBJECT_PLANT9      ) return "Greenery9";
-    if (value == OBJECT_PLANT10     ) return "Greenery10";
-    if (value == OBJECT_PLANT11     ) return "Greenery11";
-    if (value == OBJECT_PLANT12     ) return "Greenery12";
-    if (value == OBJECT_PLANT13     ) return "Greenery13";
-    if (value == OBJECT_PLANT14     ) return "Greenery14";
-    if (value == OBJECT_PLANT15     ) return "Greenery15";
-    if (value == OBJECT_PLANT16     ) return "Greenery16";
-    if (value == OBJECT_PLANT17     ) return "Greenery17";
-    if (value == OBJECT_PLANT18     ) return "Greenery18";
-    if (value == OBJECT_PLANT19     ) return "Greenery19";
-    if (value == OBJECT_TREE0       ) return "Tree0";
-    if (value == OBJECT_TREE1       ) return "Tree1";
-    if (value == OBJECT_TREE2       ) return "Tree2";
-    if (value == OBJECT_TREE3       ) return "Tree3";
-    if (value == OBJECT_TREE4       ) return "Tree4";
-    if (value == OBJECT_TREE5       ) return "Tree5";
-    if (value == OBJECT_MUSHROOM1   ) return "Mushroom1";
-    if (value == OBJECT_MUSHROOM2   ) return "Mushroom2";
-    if (value == OBJECT_HOME1       ) return "Home";
-    if (value == OBJECT_DERRICK     ) return "Derrick";
-    if (value == OBJECT_FACTORY     ) return "BotFactory";
-    if (value == OBJECT_STATION     ) return "PowerStation";
-    if (value == OBJECT_CONVERT     ) return "Converter";
-    if (value == OBJECT_REPAIR      ) return "RepairCenter";
-    if (value == OBJECT_DESTROYER   ) return "Destroyer";
-    if (value == OBJECT_TOWER       ) return "DefenseTower";
-    if (value == OBJECT_NEST        ) return "AlienNest";
-    if (value == OBJECT_RESEARCH    ) return "ResearchCenter";
-    if (value == OBJECT_RADAR       ) return "RadarStation";
-    if (value == OBJECT_INFO        ) return "ExchangePost";
-    if (value == OBJECT_ENERGY      ) return "PowerPlant";
-    if (value == OBJECT_LABO        ) return "AutoLab";
-    if (value == OBJECT_NUCLEAR     ) return "NuclearPlant";
-    if (value == OBJECT_PARA        ) return "PowerCaptor";
-    if (value == OBJECT_SAFE        ) return "Vault";
-    if (value == OBJECT_HUSTON      ) return "Houston";
-    if (value == OBJECT_TARGET1     ) return "Target1";
-    if (value == OBJECT_TARGET2     ) return "Target2";
-    if (value == OBJECT_START       ) return "StartArea";
-    if (value == OBJECT_END         ) return "GoalArea";
-    if (value == OBJECT_MOTHER      ) return "AlienQueen";
-    if (value == OBJECT_EGG         ) return "AlienEgg";
-    if (value == OBJECT_ANT         ) return "AlienAnt";
-    if (value == OBJECT_SPIDER      ) return "AlienSpider";
-    if (value == OBJECT_BEE         ) return "AlienWasp";
-    if (value == OBJECT_WORM        ) return "AlienWorm";
-    if (value == OBJECT_RUINmobilew1) return "WreckBotw1";
-    if (value == OBJECT_RUINmobilew2) return "WreckBotw2";
-    if (value == OBJECT_RUINmobilet1) return "WreckBott1";
-    if (value == OBJECT_RUINmobilet2) return "WreckBott2";
-    if (value == OBJECT_RUINmobiler1) return "WreckBotr1";
-    if (value == OBJECT_RUINmobiler2) return "WreckBotr2";
-    if (value == OBJECT_RUINfactory ) return "RuinBotFactory";
-    if (value == OBJECT_RUINdoor    ) return "RuinDoor";
-    if (value == OBJECT_RUINsupport ) return "RuinSupport";
-    if (value == OBJECT_RUINradar   ) return "RuinRadar";
-    if (value == OBJECT_RUINconvert ) return "RuinConvert";
-    if (value == OBJECT_RUINbase    ) return "RuinBaseCamp";
-    if (value == OBJECT_RUINhead    ) return "RuinHeadCamp";
-    if (value == OBJECT_BARRIER0    ) return "Barrier0";
-    if (value == OBJECT_BARRIER1    ) return "Barrier1";
-    if (value == OBJECT_BARRIER2    ) return "Barrier2";
-    if (value == OBJECT_BARRIER3    ) return "Barrier3";
-    if (value == OBJECT_BARRICADE0  ) return "Barricade0";
-    if (value == OBJECT_BARRICADE1  ) return "Barricade1";
-    if (value == OBJECT_TEEN0       ) return "Teen0";
-    if (value == OBJECT_TEEN1       ) return "Teen1";
-    if (value == OBJECT_TEEN2       ) return "Teen2";
-    if (value == OBJECT_TEEN3       ) return "Teen3";
-    if (value == OBJECT_TEEN4       ) return "Teen4";
-    if (value == OBJECT_TEEN5       ) return "Teen5";
-    if (value == OBJECT_TEEN6       ) return "Teen6";
-    if (value == OBJECT_TEEN7       ) return "Teen7";
-    if (value == OBJECT_TEEN8       ) return "Teen8";
-    if (value == OBJECT_TEEN9       ) return "Teen9";
-    if (value == OBJECT_TEEN10      ) return "Teen10";
-    if (value == OBJECT_TEEN11      ) return "Teen11";
-    if (value == OBJECT_TEEN12      ) return "Teen12";
-    if (value == OBJECT_TEEN13      ) return "Teen13";
-    if (value == OBJECT_TEEN14      ) return "Teen14";
-    if (value == OBJECT_TEEN15      ) return "Teen15";
-    if (value == OBJECT_TEEN16      ) return "Teen16";
-    if (value == OBJECT_TEEN17      ) return "Teen17";
-    if (value == OBJECT_TEEN18      ) return "Teen18";
-    if (value == OBJECT_TEEN19      ) return "Teen19";
-    if (value == OBJECT_TEEN20      ) return "Teen20";
-    if (value == OBJECT_TEEN21      ) return "Teen21";
-    if (value == OBJECT_TEEN22      ) return "Teen22";
-    if (value == OBJECT_TEEN23      ) return "Teen23";
-    if (value == OBJECT_TEEN24      ) return "Teen24";
-    if (value == OBJECT_TEEN25      ) return "Teen25";
-    if (value == OBJECT_TEEN26      ) return "Teen26";
-    if (value == OBJECT_TEEN27      ) return "Teen27";
-    if (value == OBJECT_TEEN28      ) return "Teen28";
-    if (value == OBJECT_TEEN29      ) return "Teen29";
-    if (value == OBJECT_TEEN30      ) return "Teen30";
-    if (value == OBJECT_TEEN31      ) return "Teen31";
-    if (value == OBJECT_TEEN32      ) return "Teen32";
-    if (value == OBJECT_TEEN33      ) return "Teen33";
-    if (value == OBJECT_TEEN34      ) return "Stone";
-    if (value == OBJECT_TEEN35      ) return "Teen35";
-    if (value == OBJECT_TEEN36      ) return "Teen36";
-    if (value == OBJECT_TEEN37      ) return "Teen37";
-    if (value == OBJECT_TEEN38      ) return "Teen38";
-    if (value == OBJECT_TEEN39      ) return "Teen39";
-    if (value == OBJECT_TEEN40      ) return "Teen40";
-    if (value == OBJECT_TEEN41      ) return "Teen41";
-    if (value == OBJECT_TEEN42      ) return "Teen42";
-    if (value == OBJECT_TEEN43      ) return "Teen43";
-    if (value == OBJECT_TEEN44      ) return "Teen44";
-    if (value == OBJECT_QUARTZ0     ) return "Quartz0";
-    if (value == OBJECT_QUARTZ1     ) return "Quartz1";
-    if (value == OBJECT_QUARTZ2     ) return "Quartz2";
-    if (value == OBJECT_QUARTZ3     ) return "Quartz3";
-    if (value == OBJECT_ROOT0       ) return "MegaStalk0";
-    if (value == OBJECT_ROOT1       ) return "MegaStalk1";
-    if (value == OBJECT_ROOT2       ) return "MegaStalk2";
-    if (value == OBJECT_ROOT3       ) return "MegaStalk3";
-    if (value == OBJECT_ROOT4       ) return "MegaStalk4";
-    if (value == OBJECT_ROOT5       ) return "MegaStalk5";
-    if (value == OBJECT_APOLLO1     ) return "ApolloLEM";
-    if (value == OBJECT_APOLLO2     ) return "ApolloJeep";
-    if (value == OBJECT_APOLLO3     ) return "ApolloFlag";
-    if (value == OBJECT_APOLLO4     ) return "ApolloModule";
-    if (value == OBJECT_APOLLO5     ) return "ApolloAntenna";
-    if (value == OBJECT_HUMAN       ) return "Me";
-    if (value == OBJECT_TECH        ) return "Tech";
-    if (value == OBJECT_CONTROLLER  ) return "MissionController";
+    static const std::map<ObjectType, std::string> names =
+    {
+        { OBJECT_PORTICO,      "Portico" },
+        { OBJECT_BASE,         "SpaceShip" },
+        { OBJECT_MOBILEwt,     "PracticeBot" },
+        { OBJECT_MOBILEfa,     "WingedGrabber" },
+        { OBJECT_MOBILEta,     "TrackedGrabber" },
+        { OBJECT_MOBILEwa,     "WheeledGrabber" },
+        { OBJECT_MOBILEia,     "LeggedGrabber" },
+        { OBJECT_MOBILEfc,     "WingedShooter" },
+        { OBJECT_MOBILEtc,     "TrackedShooter" },
+        { OBJECT_MOBILEwc,     "WheeledShooter" },
+        { OBJECT_MOBILEic,     "LeggedShooter" },
+        { OBJECT_MOBILEfi,     "WingedOrgaShooter" },
+        { OBJECT_MOBILEti,     "TrackedOrgaShooter" },
+        { OBJECT_MOBILEwi,     "WheeledOrgaShooter" },
+        { OBJECT_MOBILEii,     "LeggedOrgaShooter" },
+        { OBJECT_MOBILEfs,     "WingedSniffer" },
+        { OBJECT_MOBILEts,     "TrackedSniffer" },
+        { OBJECT_MOBILEws,     "WheeledSniffer" },
+        { OBJECT_MOBILEis,     "LeggedSniffer" },
+        { OBJECT_MOBILErt,     "Thumper" },
+        { OBJECT_MOBILErc,     "PhazerShooter" },
+        { OBJECT_MOBILErr,     "Recycler" },
+        { OBJECT_MOBILErs,     "Shielder" },
+        { OBJECT_MOBILEsa,     "Subber" },
+        { OBJECT_MOBILEtg,     "TargetBot" },
+        { OBJECT_MOBILEdr,     "Scribbler" },
+        { OBJECT_MARKPOWER,    "PowerSpot" },
+        { OBJECT_MARKSTONE,    "TitaniumSpot" },
+        { OBJECT_MARKURANIUM,  "UraniumSpot" },
+        { OBJECT_MARKKEYa,     "KeyASpot" },
+        { OBJECT_MARKKEYb,     "KeyBSpot" },
+        { OBJECT_MARKKEYc,     "KeyCSpot" },
+        { OBJECT_MARKKEYd,     "KeyDSpot" },
+        { OBJECT_WAYPOINT,     "WayPoint" },
+        { OBJECT_FLAGb,        "BlueFlag" },
+        { OBJECT_FLAGr,        "RedFlag" },
+        { OBJECT_FLAGg,        "GreenFlag" },
+        { OBJECT_FLAGy,        "YellowFlag" },
+        { OBJECT_FLAGv,        "VioletFlag" },
+        { OBJECT_POWER,        "PowerCell" },
+        { OBJECT_ATOMIC,       "NuclearCell" },
+        { OBJECT_STONE,        "TitaniumOre" },
+        { OBJECT_URANIUM,      "UraniumOre" },
+        { OBJECT_METAL,        "Titanium" },
+        { OBJECT_BULLET,       "OrgaMatter" },
+        { OBJECT_BBOX,         "BlackBox" },
+        { OBJECT_KEYa,         "KeyA" },
+        { OBJECT_KEYb,         "KeyB" },
+        { OBJECT_KEYc,         "KeyC" },
+        { OBJECT_KEYd,         "KeyD" },
+        { OBJECT_TNT,          "TNT" },
+        { OBJECT_BOMB,         "Mine" },
+        { OBJECT_WINFIRE,      "Firework" },
+        { OBJECT_BAG,          "Bag" },
+        { OBJECT_PLANT0,       "Greenery0" },
+        { OBJECT_PLANT1,       "Greenery1" },
+        { OBJECT_PLANT2,       "Greenery2" },
+        { OBJECT_PLANT3,       "Greenery3" },
+        { OBJECT_PLANT4,       "Greenery4" },
+        { OBJECT_PLANT5,       "Greenery5" },
+        { OBJECT_PLANT6,       "Greenery6" },
+        { OBJECT_PLANT7,       "Greenery7" },
+        { OBJECT_PLANT8,       "Greenery8" },
+        { OBJECT_PLANT9,       "Greenery9" },
+        { OBJECT_PLANT10,      "Greenery10" },
+        { OBJECT_PLANT11,      "Greenery11" },
+        { OBJECT_PLANT12,      "Greenery12" },
+        { OBJECT_PLANT13,      "Greenery13" },
+        { OBJECT_PLANT14,      "Greenery14" },
+        { OBJECT_PLANT15,      "Greenery15" },
+        { OBJECT_PLANT16,      "Greenery16" },
+        { OBJECT_PLANT17,      "Greenery17" },
+        { OBJECT_PLANT18,      "Greenery18" },
+        { OBJECT_PLANT19,      "Greenery19" },
+        { OBJECT_TREE0,        "Tree0" },
+        { OBJECT_TREE1,        "Tree1" },
+        { OBJECT_TREE2,        "Tree2" },
+        { OBJECT_TREE3,        "Tree3" },
+        { OBJECT_TREE4,        "Tree4" },
+        { OBJECT_TREE5,        "Tree5" },
+        { OBJECT_MUSHROOM1,    "Mushroom1" },
+        { OBJECT_MUSHROOM2,    "Mushroom2" },
+        { OBJECT_HOME1,        "Home" },
+        { OBJECT_DERRICK,      "Derrick" },
+        { OBJECT_FACTORY,      "BotFactory" },
+        { OBJECT_STATION,      "PowerStation" },
+        { OBJECT_CONVERT,      "Converter" },
+        { OBJECT_REPAIR,       "RepairCenter" },
+        { OBJECT_DESTROYER,    "Destroyer" },
+        { OBJECT_TOWER,        "DefenseTower" },
+        { OBJECT_NEST,         "AlienNest" },
+        { OBJECT_RESEARCH,     "ResearchCenter" },
+        { OBJECT_RADAR,        "RadarStation" },
+        { OBJECT_INFO,         "ExchangePost" },
+        { OBJECT_ENERGY,       "PowerPlant" },
+        { OBJECT_LABO,         "AutoLab" },
+        { OBJECT_NUCLEAR,      "NuclearPlant" },
+        { OBJECT_PARA,         "PowerCaptor" },
+        { OBJECT_SAFE,         "Vault" },
+        { OBJECT_HUSTON,       "Houston" },
+        { OBJECT_TARGET1,      "Target1" },
+        { OBJECT_TARGET2,      "Target2" },
+        { OBJECT_START,        "StartArea" },
+        { OBJECT_END,          "GoalArea" },
+        { OBJECT_MOTHER,       "AlienQueen" },
+        { OBJECT_EGG,          "AlienEgg" },
+        { OBJECT_ANT,          "AlienAnt" },
+        { OBJECT_SPIDER,       "AlienSpider" },
+        { OBJECT_BEE,          "AlienWasp" },
+        { OBJECT_WORM,         "AlienWorm" },
+        { OBJECT_RUINmobilew1, "WreckBotw1" },
+        { OBJECT_RUINmobilew2, "WreckBotw2" },
+        { OBJECT_RUINmobilet1, "WreckBott1" },
+        { OBJECT_RUINmobilet2, "WreckBott2" },
+        { OBJECT_RUINmobiler1, "WreckBotr1" },
+        { OBJECT_RUINmobiler2, "WreckBotr2" },
+        { OBJECT_RUINfactory,  "RuinBotFactory" },
+        { OBJECT_RUINdoor,     "RuinDoor" },
+        { OBJECT_RUINsupport,  "RuinSupport" },
+        { OBJECT_RUINradar,    "RuinRadar" },
+        { OBJECT_RUINconvert,  "RuinConvert" },
+        { OBJECT_RUINbase,     "RuinBaseCamp" },
+        { OBJECT_RUINhead,     "RuinHeadCamp" },
+        { OBJECT_BARRIER0,     "Barrier0" },
+        { OBJECT_BARRIER1,     "Barrier1" },
+        { OBJECT_BARRIER2,     "Barrier2" },
+        { OBJECT_BARRIER3,     "Barrier3" },
+        { OBJECT_BARRICADE0,   "Barricade0" },
+        { OBJECT_BARRICADE1,   "Barricade1" },
+        { OBJECT_TEEN0,        "Teen0" },
+        { OBJECT_TEEN1,        "Teen1" },
+        { OBJECT_TEEN2,        "Teen2" },
+        { OBJECT_TEEN3,        "Teen3" },
+        { OBJECT_TEEN4,        "Teen4" },
+        { OBJECT_TEEN5,        "Teen5" },
+        { OBJECT_TEEN6,        "Teen6" },
+        { OBJECT_TEEN7,        "Teen7" },
+        { OBJECT_TEEN8,        "Teen8" },
+        { OBJECT_TEEN9,        "Teen9" },
+        { OBJECT_TEEN10,       "Teen10" },
+        { OBJECT_TEEN11,       "Teen11" },
+        { OBJECT_TEEN12,       "Teen12" },
+        { OBJECT_TEEN13,       "Teen13" },
+        { OBJECT_TEEN14,       "Teen14" },
+        { OBJECT_TEEN15,       "Teen15" },
+        { OBJECT_TEEN16,       "Teen16" },
+        { OBJECT_TEEN17,       "Teen17" },
+        { OBJECT_TEEN18,       "Teen18" },
+        { OBJECT_TEEN19,       "Teen19" },
+        { OBJECT_TEEN20,       "Teen20" },
+        { OBJECT_TEEN21,       "Teen21" },
+        { OBJECT_TEEN22,       "Teen22" },
+        { OBJECT_TEEN23,       "Teen23" },
+        { OBJECT_TEEN24,       "Teen24" },
+        { OBJECT_TEEN25,       "Teen25" },
+        { OBJECT_TEEN26,       "Teen26" },
+        { OBJECT_TEEN27,       "Teen27" },
+        { OBJECT_TEEN28,       "Teen28" },
+        { OBJECT_TEEN29,       "Teen29" },
+        { OBJECT_TEEN30,       "Teen30" },
+        { OBJECT_TEEN31,       "Teen31" },
+        { OBJECT_TEEN32,       "Teen32" },
+        { OBJECT_TEEN33,       "Teen33" },
+        { OBJECT_TEEN34,       "Stone" },
+        { OBJECT_TEEN35,       "Teen35" },
+        { OBJECT_TEEN36,       "Teen36" },
+        { OBJECT_TEEN37,       "Teen37" },
+        { OBJECT_TEEN38,       "Teen38" },
+        { OBJECT_TEEN39,       "Teen39" },
+        { OBJECT_TEEN40,       "Teen40" },
+        { OBJECT_TEEN41,       "Teen41" },
+        { OBJECT_TEEN42,       "Teen42" },
+        { OBJECT_TEEN43,       "Teen43" },
+        { OBJECT_TEEN44,       "Teen44" },
+        { OBJECT_QUARTZ0,      "Quartz0" },
+        { OBJECT_QUARTZ1,      "Quartz1" },
+        { OBJECT_QUARTZ2,      "Quartz2" },
+        { OBJECT_QUARTZ3,      "Quartz3" },
+        { OBJECT_ROOT0,        "MegaStalk0" },
+        { OBJECT_ROOT1,        "MegaStalk1" },
+        { OBJECT_ROOT2,        "MegaStalk2" },
+        { OBJECT_ROOT3,        "MegaStalk3" },
+        { OBJECT_ROOT4,        "MegaStalk4" },
+        { OBJECT_ROOT5,        "MegaStalk5" },
+        { OBJECT_APOLLO1,      "ApolloLEM" },
+        { OBJECT_APOLLO2,      "ApolloJeep" },
+        { OBJECT_APOLLO3,      "ApolloFlag" },
+        { OBJECT_APOLLO4,      "ApolloModule" },
+        { OBJECT_APOLLO5,      "ApolloAntenna" },
+        { OBJECT_HUMAN,        "Me" },
+        { OBJECT_TECH,         "Tech" },
+        { OBJECT_CONTROLLER,   "MissionController" },
+    };
+
+    auto it = names.find(value);
+    if (it != names.end())
+        return it->second;
     return boost::lexical_cast<std::string>(static_cast<int>(value));
 }
 
@@ -736,7 +763,12 @@ ObjectType CLevelParserParam::AsObjectType()
 {
     if (m_empty)
         throw CLevelParserExceptionMissingParam(this);
-    return ToObjectType(m_value);
+    if (!m_cache.hasObjectType)
+    {
+        m_cache.objectType = ToObjectType(m_value);
+        m_cache.hasObjectType = true;
+    }
+    return m_cache.objectType;
 }
 
 ObjectType CLevelParserParam::AsObjectType(ObjectType def)
@@ -747,14 +779,21 @@ ObjectType CLevelParserParam::AsObjectType(ObjectType def)
 }
 
 
-DriveType CLevelParserParam::ToDriveType(std::string value)
+DriveType CLevelParserParam::ToDriveType(const std::string& value)
 {
-    if (value == "Wheeled") return DriveType::Wheeled;
-    if (value == "Tracked") return DriveType::Tracked;
-    if (value == "Winged" ) return DriveType::Winged;
-    if (value == "Legged" ) return DriveType::Legged;
-    if (value == "BigTracked") return DriveType::BigTracked;
-    if (value == "Other"  ) return DriveType::Other;
+    static const std::unordered_map<std::string, DriveType> types =
+    {
+        { "Wheeled", DriveType::Wheeled },
+        { "Tracked", DriveType::Tracked },
+        { "Winged",  DriveType::Winged },
+        { "Legged",  DriveType::Legged },
+        { "BigTracked", DriveType::BigTracked },
+        { "Other",   DriveType::Other },
+    };
+
+    auto it = types.find(value);
+    if (it != types.end())
+        return it->second;
     return static_cast<DriveType>(Cast<int>(value, "drive"));
 }
 
@@ -773,13 +812,20 @@ DriveType CLevelParserParam::AsDriveType(DriveType def)
 }
 
 
-ToolType CLevelParserParam::ToToolType(std::string value)
+ToolType CLevelParserParam::ToToolType(const std::string& value)
 {
-    if (value == "Grabber"    ) return ToolType::Grabber;
-    if (value == "Sniffer"    ) return ToolType::Sniffer;
-    if (value == "Shooter"    ) return ToolType::Shooter;
-    if (value == "OrgaShooter") return ToolType::OrganicShooter;
-    if (value == "Other"      ) return ToolType::Other;
+    static const std::unordered_map<std::string, ToolType> types =
+    {
+        { "Grabber",     ToolType::Grabber },
+        { "Sniffer",     ToolType::Sniffer },
+        { "Shooter",     ToolType::Shooter },
+        { "OrgaShooter", ToolType::OrganicShooter },
+        { "Other",       ToolType::Other },
+    };
+
+    auto it = types.find(value);
+    if (it != types.end())
+        return it->second;
     return static_cast<ToolType>(Cast<int>(value, "tool"));
 }
 
@@ -798,13 +844,20 @@ ToolType CLevelParserParam::AsToolType(ToolType def)
 }
 
 
-Gfx::WaterType CLevelParserParam::ToWaterType(std::string value)
+Gfx::WaterType CLevelParserParam::ToWaterType(const std::string& value)
 {
-    if (value == "nullptr") return Gfx::WATER_NULL;
-    if (value == "TT"  ) return Gfx::WATER_TT;
-    if (value == "TO"  ) return Gfx::WATER_TO;
-    if (value == "CT"  ) return Gfx::WATER_CT;
-    if (value == "CO"  ) return Gfx::WATER_CO;
+    static const std::unordered_map<std::string, Gfx::WaterType> types =
+    {
+        { "nullptr", Gfx::WATER_NULL },
+        { "TT",   Gfx::WATER_TT },
+        { "TO",   Gfx::WATER_TO },
+        { "CT",   Gfx::WATER_CT },
+        { "CO",   Gfx::WATER_CO },
+    };
+
+    auto it = types.find(value);
+    if (it != types.end())
+        return it->second;
     return static_cast<Gfx::WaterType>(Cast<int>(value, "watertype"));
 }
 
@@ -823,12 +876,19 @@ Gfx::WaterType CLevelParserParam::AsWaterType(Gfx::WaterType def)
 }
 
 
-Gfx::EngineObjectType CLevelParserParam::ToTerrainType(std::string value)
+Gfx::EngineObjectType CLevelParserParam::ToTerrainType(const std::string& value)
 {
-    if (value == "Terrain") return Gfx::ENG_OBJTYPE_TERRAIN;
-    if (value == "Object" ) return Gfx::ENG_OBJTYPE_FIX;
-    if (value == "Quartz" ) return Gfx::ENG_OBJTYPE_QUARTZ;
-    if (value == "Metal"  ) return Gfx::ENG_OBJTYPE_METAL;
+    static const std::unordered_map<std::string, Gfx::EngineObjectType> types =
+    {
+        { "Terrain", Gfx::ENG_OBJTYPE_TERRAIN },
+        { "Object",  Gfx::ENG_OBJTYPE_FIX },
+        { "Quartz",  Gfx::ENG_OBJTYPE_QUARTZ },
+        { "Metal",   Gfx::ENG_OBJTYPE_METAL },
+    };
+
+    auto it = types.find(value);
+    if (it != types.end())
+        return it->second;
     return static_cast<Gfx::EngineObjectType>(Cast<int>(value, "terraintype"));
 }
 
@@ -847,25 +907,32 @@ Gfx::EngineObjectType CLevelParserParam::AsTerrainType(Gfx::EngineObjectType def
 }
 
 
-int CLevelParserParam::ToBuildFlag(std::string value)
+int CLevelParserParam::ToBuildFlag(const std::string& value)
 {
-    if (value == "BotFactory"    ) return BUILD_FACTORY;
-    if (value == "Derrick"       ) return BUILD_DERRICK;
-    if (value == "Converter"     ) return BUILD_CONVERT;
-    if (value == "RadarStation"  ) return BUILD_RADAR;
-    if (value == "PowerPlant"    ) return BUILD_ENERGY;
-    if (value == "NuclearPlant"  ) return BUILD_NUCLEAR;
-    if (value == "FuelCellPlant" ) return BUILD_NUCLEAR;
-    if (value == "PowerStation"  ) return BUILD_STATION;
-    if (value == "RepairCenter"  ) return BUILD_REPAIR;
-    if (value == "DefenseTower"  ) return BUILD_TOWER;
-    if (value == "ResearchCenter") return BUILD_RESEARCH;
-    if (value == "AutoLab"       ) return BUILD_LABO;
-    if (value == "PowerCaptor"   ) return BUILD_PARA;
-    if (value == "ExchangePost"  ) return BUILD_INFO;
-    if (value == "Destroyer"     ) return BUILD_DESTROYER;
-    if (value == "FlatGround"    ) return BUILD_GFLAT;
-    if (value == "Flag"          ) return BUILD_FLAG;
+    static const std::unordered_map<std::string, int> flags =
+    {
+        { "BotFactory",     BUILD_FACTORY },
+        { "Derrick",        BUILD_DERRICK },
+        { "Converter",      BUILD_CONVERT },
+        { "RadarStation",   BUILD_RADAR },
+        { "PowerPlant",     BUILD_ENERGY },
+        { "NuclearPlant",   BUILD_NUCLEAR },
+        { "FuelCellPlant",  BUILD_NUCLEAR },
+        { "PowerStation",   BUILD_STATION },
+        { "RepairCenter",   BUILD_REPAIR },
+        { "DefenseTower",   BUILD_TOWER },
+        { "ResearchCenter", BUILD_RESEARCH },
+        { "AutoLab",        BUILD_LABO },
+        { "PowerCaptor",    BUILD_PARA },
+        { "ExchangePost",   BUILD_INFO },
+        { "Destroyer",      BUILD_DESTROYER },
+        { "FlatGround",     BUILD_GFLAT },
+        { "Flag",           BUILD_FLAG },
+    };
+
+    auto it = flags.find(value);
+    if (it != flags.end())
+        return it->second;
     return Cast<int>(value, "buildflag");
 }
 
@@ -884,21 +951,28 @@ int CLevelParserParam::AsBuildFlag(int def)
 }
 
 
-int CLevelParserParam::ToResearchFlag(std::string value)
+int CLevelParserParam::ToResearchFlag(const std::string& value)
 {
-    if (value == "TRACKER" ) return RESEARCH_TANK;
-    if (value == "WINGER"  ) return RESEARCH_FLY;
-    if (value == "THUMPER" ) return RESEARCH_THUMP;
-    if (value == "SHOOTER" ) return RESEARCH_CANON;
-    if (value == "TOWER"   ) return RESEARCH_TOWER;
-    if (value == "PHAZER"  ) return RESEARCH_PHAZER;
-    if (value == "SHIELDER") return RESEARCH_SHIELD;
-    if (value == "ATOMIC"  ) return RESEARCH_ATOMIC;
-    if (value == "iPAW"    ) return RESEARCH_iPAW;
-    if (value == "iGUN"    ) return RESEARCH_iGUN;
-    if (value == "RECYCLER") return RESEARCH_RECYCLER;
-    if (value == "SUBBER"  ) return RESEARCH_SUBM;
-    if (value == "SNIFFER" ) return RESEARCH_SNIFFER;
+    static const std::unordered_map<std::string, int> flags =
+    {
+        { "TRACKER",  RESEARCH_TANK },
+        { "WINGER",   RESEARCH_FLY },
+        { "THUMPER",  RESEARCH_THUMP },
+        { "SHOOTER",  RESEARCH_CANON },
+        { "TOWER",    RESEARCH_TOWER },
+        { "PHAZER",   RESEARCH_PHAZER },
+        { "SHIELDER", RESEARCH_SHIELD },
+        { "ATOMIC",   RESEARCH_ATOMIC },
+        { "iPAW",     RESEARCH_iPAW },
+        { "iGUN",     RESEARCH_iGUN },
+        { "RECYCLER", RESEARCH_RECYCLER },
+        { "SUBBER",   RESEARCH_SUBM },
+        { "SNIFFER",  RESEARCH_SNIFFER },
+    };
+
+    auto it = flags.find(value);
+    if (it != flags.end())
+        return it->second;
     return Cast<int>(value, "researchflag");
 }
 
@@ -917,26 +991,33 @@ int CLevelParserParam::AsResearchFlag(int def)
 }
 
 
-Gfx::PyroType CLevelParserParam::ToPyroType(std::string value)
+Gfx::PyroType CLevelParserParam::ToPyroType(const std::string& value)
 {
-    if (value == "FRAGt" ) return Gfx::PT_FRAGT;
-    if (value == "FRAGo" ) return Gfx::PT_FRAGO;
-    if (value == "FRAGw" ) return Gfx::PT_FRAGW;
-    if (value == "EXPLOt") return Gfx::PT_EXPLOT;
-    if (value == "EXPLOo") return Gfx::PT_EXPLOO;
-    if (value == "EXPLOw") return Gfx::PT_EXPLOW;
-    if (value == "SHOTt" ) return Gfx::PT_SHOTT;
-    if (value == "SHOTh" ) return Gfx::PT_SHOTH;
-    if (value == "SHOTm" ) return Gfx::PT_SHOTM;
-    if (value == "SHOTw" ) return Gfx::PT_SHOTW;
-    if (value == "EGG"   ) return Gfx::PT_EGG;
-    if (value == "BURNt" ) return Gfx::PT_BURNT;
-    if (value == "BURNo" ) return Gfx::PT_BURNO;
-    if (value == "SPIDER") return Gfx::PT_SPIDER;
-    if (value == "FALL"  ) return Gfx::PT_FALL;
-    if (value == "RESET" ) return Gfx::PT_RESET;
-    if (value == "WIN"   ) return Gfx::PT_WIN;
-    if (value == "LOST"  ) return Gfx::PT_LOST;
+    static const std::unordered_map<std::string, Gfx::PyroType> types =
+    {
+        { "FRAGt",  Gfx::PT_FRAGT },
+        { "FRAGo",  Gfx::PT_FRAGO },
+        { "FRAGw",  Gfx::PT_FRAGW },
+        { "EXPLOt", Gfx::PT_EXPLOT },
+        { "EXPLOo", Gfx::PT_EXPLOO },
+        { "EXPLOw", Gfx::PT_EXPLOW },
+        { "SHOTt",  Gfx::PT_SHOTT },
+        { "SHOTh",  Gfx::PT_SHOTH },
+        { "SHOTm",  Gfx::PT_SHOTM },
+        { "SHOTw",  Gfx::PT_SHOTW },
+        { "EGG",    Gfx::PT_EGG },
+        { "BURNt",  Gfx::PT_BURNT },
+        { "BURNo",  Gfx::PT_BURNO },
+        { "SPIDER", Gfx::PT_SPIDER },
+        { "FALL",   Gfx::PT_FALL },
+        { "RESET",  Gfx::PT_RESET },
+        { "WIN",    Gfx::PT_WIN },
+        { "LOST",   Gfx::PT_LOST },
+    };
+
+    auto it = types.find(value);
+    if (it != types.end())
+        return it->second;
     return static_cast<Gfx::PyroType>(Cast<int>(value, "pyrotype"));
 }
 
@@ -955,12 +1036,19 @@ Gfx::PyroType CLevelParserParam::AsPyroType(Gfx::PyroType def)
 }
 
 
-Gfx::CameraType CLevelParserParam::ToCameraType(std::string value)
+Gfx::CameraType CLevelParserParam::ToCameraType(const std::string& value)
 {
-    if (value == "BACK"   ) return Gfx::CAM_TYPE_BACK;
-    if (value == "PLANE"  ) return Gfx::CAM_TYPE_PLANE;
-    if (value == "ONBOARD") return Gfx::CAM_TYPE_ONBOARD;
-    if (value == "FIX"    ) return Gfx::CAM_TYPE_FIX;
+    static const std::unordered_map<std::string, Gfx::CameraType> types =
+    {
+        { "BACK",    Gfx::CAM_TYPE_BACK },
+        { "PLANE",   Gfx::CAM_TYPE_PLANE },
+        { "ONBOARD", Gfx::CAM_TYPE_ONBOARD },
+        { "FIX",     Gfx::CAM_TYPE_FIX },
+    };
+
+    auto it = types.find(value);
+    if (it != types.end())
+        return it->second;
     return static_cast<Gfx::CameraType>(Cast<int>(value, "camera"));
 }
 
@@ -985,11 +1073,18 @@ Gfx::CameraType CLevelParserParam::AsCameraType(Gfx::CameraType def)
     return AsCameraType();
 }
 
-MissionType CLevelParserParam::ToMissionType(std::string value)
+MissionType CLevelParserParam::ToMissionType(const std::string& value)
 {
-    if (value == "NORMAL"     ) return MISSION_NORMAL;
-    if (value == "RETRO"      ) return MISSION_RETRO;
-    if (value == "CODE_BATTLE") return MISSION_CODE_BATTLE;
+    static const std::unordered_map<std::string, MissionType> types =
+    {
+        { "NORMAL",      MISSION_NORMAL },
+        { "RETRO",       MISSION_RETRO },
+        { "CODE_BATTLE", MISSION_CODE_BATTLE },
+    };
+
+    auto it = types.find(value);
+    if (it != types.end())
+        return it->second;
     return static_cast<MissionType>(Cast<int>(value, "MissionType"));
 }
 
@@ -1040,6 +1135,7 @@ void CLevelParserParam::ParseArray()
 
 void CLevelParserParam::LoadArray()
 {
+    m_cache = ConversionCache();
     m_value = "";
     bool first = true;
     for (auto& value : m_array)
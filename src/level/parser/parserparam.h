@@ -132,16 +132,16 @@ private:
     template<typename T> T Cast(std::string requestedType);
 
     std::string ToPath(std::string path, const std::string defaultDir);
-    ObjectType ToObjectType(std::string value);
-    DriveType ToDriveType(std::string value);
-    ToolType ToToolType(std::string value);
-    Gfx::WaterType ToWaterType(std::string value);
-    Gfx::EngineObjectType ToTerrainType(std::string value);
-    int ToBuildFlag(std::string value);
-    int ToResearchFlag(std::string value);
-    Gfx::PyroType ToPyroType(std::string value);
-    Gfx::CameraType ToCameraType(std::string value);
-    MissionType ToMissionType(std::string value);
+    ObjectType ToObjectType(const std::string& value);
+    DriveType ToDriveType(const std::string& value);
+    ToolType ToToolType(const std::string& value);
+    Gfx::WaterType ToWaterType(const std::string& value);
+    Gfx::EngineObjectType ToTerrainType(const std::string& value);
+    int ToBuildFlag(const std::string& value);
+    int ToResearchFlag(const std::string& value);
+    Gfx::PyroType ToPyroType(const std::string& value);
+    Gfx::CameraType ToCameraType(const std::string& value);
+    MissionType ToMissionType(const std::string& value);
 
     const std::string FromCameraType(Gfx::CameraType value);
 
@@ -151,4 +151,16 @@ private:
     std::string m_name;
     std::string m_value;
     CLevelParserParamVec m_array;
+
+    //! Values converted so far, so that the string is parsed only once (cleared when m_value changes, see LoadArray())
+    struct ConversionCache
+    {
+        bool hasInt = false;
+        int intValue = 0;
+        bool hasFloat = false;
+        float floatValue = 0.0f;
+        bool hasObjectType = false;
+        ObjectType objectType = OBJECT_NULL;
+    };
+    ConversionCache m_cache;
 };
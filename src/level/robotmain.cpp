@@ -29,10 +29,13 @@
 #include "common/event.h"
 #include "common/logger.h"
 #include "common/make_unique.h"
+#include "common/profiler.h"
 #include "common/restext.h"
 #include "common/settings.h"
 #include "common/stringutils.h"
 
+#include "common/thread/worker_pool.h"
+
 #include "common/resources/inputstream.h"
 #include "common/resources/outputstream.h"
 #include "common/resources/resourcemanager.h"
@@ -62,9 +65,11 @@
 #include "math/const.h"
 #include "math/geometry.h"
 
+#include "object/drive_type.h"
 #include "object/object.h"
 #include "object/object_create_exception.h"
 #include "object/object_manager.h"
+#include "object/old_object.h"
 
 #include "object/auto/auto.h"
 
@@ -167,6 +172,8 @@ CRobotMain::CRobotMain()
 
     m_debugMenu   = MakeUnique<Ui::CDebugMenu>(this, m_engine, m_objMan.get(), m_sound);
 
+    m_pathWorkers = MakeUnique<CWorkerPool>(1, "Path finding thread");
+
     m_time = 0.0f;
     m_gameTime = 0.0f;
     m_gameTimeAbsolute = 0.0f;
@@ -2361,6 +2368,11 @@ bool CRobotMain::EventFrame(const Event &event)
     CObject* toto = nullptr;
     if (!m_pause->IsPauseType(PAUSE_OBJECT_UPDATES))
     {
+        m_objMan->UpdateMaxCollisionReach();
+
+        if (m_scriptWorkers != nullptr)
+            ContinueScriptsParallel();
+
         // Advances all the robots, but not toto.
         for (CObject* obj : m_objMan->GetAllObjects())
         {
@@ -2521,7 +2533,7 @@ bool CRobotMain::EventFrame(const Event &event)
     {
         if (!m_editLock && !m_engine->GetPause())
         {
-            CheckEndMission(true);
+            m_endMissionResult = CheckEndMission(true);
             UpdateAudio(true);
         }
 
@@ -2556,7 +2568,9 @@ bool CRobotMain::EventFrame(const Event &event)
         {
             // NOTE: It's important to do this AFTER the first update event finished processing
             //       because otherwise all robot parts are misplaced
-            m_userPause = m_pause->ActivatePause(PAUSE_ENGINE);
+            // In batch mode, there is nobody to press the start button
+            if (!m_app->GetBatchMode())
+                m_userPause = m_pause->ActivatePause(PAUSE_ENGINE);
             m_codeBattleInit = true; // Will start on resume
         }
 
@@ -2736,6 +2750,9 @@ void CRobotMain::CreateScene(bool soluce, bool fixScene, bool resetObject)
 
         m_missionResult = ERR_MISSION_NOTERM;
         m_missionResultFromScript = false;
+        m_endMissionResult = ERR_MISSION_NOTERM;
+
+        m_missionPathPlanner = m_pathPlanner;
     }
 
     // NOTE: Reset timer always, even when only resetting object positions
@@ -2801,7 +2818,7 @@ void CRobotMain::CreateScene(bool soluce, bool fixScene, bool resetObject)
 
                 m_immediatSatCom = line->GetParam("immediat")->AsBool(false);
                 m_beginSatCom = m_lockedSatCom = line->GetParam("lock")->AsBool(false);
-                if (m_app->GetSceneTestMode()) m_immediatSatCom = false;
+                if (m_app->GetSceneTestMode() || m_app->GetBatchMode()) m_immediatSatCom = false;
                 continue;
             }
 
@@ -2871,6 +2888,12 @@ void CRobotMain::CreateScene(bool soluce, bool fixScene, bool resetObject)
                 continue;
             }
 
+            if (line->GetCommand() == "PathPlanner" && !resetObject)
+            {
+                m_missionPathPlanner = ParsePathPlannerType(line->GetParam("type")->AsString(), m_pathPlanner);
+                continue;
+            }
+
             if (line->GetCommand() == "MissionTimer")
             {
                 m_missionTimerEnabled = line->GetParam("enabled")->AsBool();
@@ -5130,6 +5153,11 @@ Error CRobotMain::CheckEndMission(bool frame)
 }
 
 
+Error CRobotMain::GetEndMissionResult()
+{
+    return m_endMissionResult;
+}
+
 //! Returns the list instructions required in CBot program in level
 const std::map<std::string, MinMax>& CRobotMain::GetObligatoryTokenList()
 {
@@ -5521,6 +5549,80 @@ int CRobotMain::GetAutosaveSlots()
     return m_autosaveSlots;
 }
 
+void CRobotMain::SetScriptThreads(int threads)
+{
+    threads = std::max(threads, 0);
+    if (m_scriptThreads == threads) return;
+
+    m_scriptThreads = threads;
+    m_scriptWorkers.reset();
+    if (m_scriptThreads > 0)
+        m_scriptWorkers = MakeUnique<CWorkerPool>(m_scriptThreads, "CBot worker thread");
+}
+
+int CRobotMain::GetScriptThreads()
+{
+    return m_scriptThreads;
+}
+
+void CRobotMain::SetScriptBytecode(bool enable)
+{
+    m_scriptBytecode = enable;
+}
+
+bool CRobotMain::GetScriptBytecode()
+{
+    return m_scriptBytecode;
+}
+
+void CRobotMain::SetPathPlanner(PathPlannerType planner)
+{
+    m_pathPlanner = planner;
+}
+
+PathPlannerType CRobotMain::GetPathPlanner()
+{
+    return m_pathPlanner;
+}
+
+PathPlannerType CRobotMain::GetMissionPathPlanner()
+{
+    return m_missionPathPlanner;
+}
+
+CWorkerPool* CRobotMain::GetPathWorkers()
+{
+    return m_pathWorkers.get();
+}
+
+// Runs the CBot-only part of this frame's programs on the worker threads.
+// Each program runs until it uses up its instructions for the frame or until it
+// is about to touch anything outside of itself. The rest is done as usual from
+// CProgrammableObjectImpl::EventProcess(), in object order, so the result is the
+// same as without worker threads.
+void CRobotMain::ContinueScriptsParallel()
+{
+    std::vector<CScript*> scripts;
+    for (CObject* obj : m_objMan->GetAllObjects())
+    {
+        if (!obj->Implements(ObjectInterfaceType::Programmable)) continue;
+        if (obj->Implements(ObjectInterfaceType::Destroyable) && dynamic_cast<CDestroyableObject*>(obj)->IsDying()) continue;
+
+        CProgrammableObject* programmable = dynamic_cast<CProgrammableObject*>(obj);
+        if (!programmable->GetActivity() || !programmable->IsProgram()) continue;
+
+        CScript* script = programmable->GetCurrentProgram()->script.get();
+        if (script->CanContinueParallel())
+            scripts.push_back(script);
+    }
+
+    m_scriptWorkers->ParallelFor(scripts.size(), [&scripts](int i)
+    {
+        CProfilerZone zone(scripts[i]->GetZoneName());
+        scripts[i]->ContinueParallel();
+    });
+}
+
 // Remove oldest saves with autosave prefix
 void CRobotMain::AutosaveRotate()
 {
@@ -5883,7 +5985,7 @@ void CRobotMain::UpdateDebugCrashSpheres()
     {
         for (CObject* obj : m_objMan->GetAllObjects())
         {
-            auto crashSpheres = obj->GetAllCrashSpheres();
+            const auto& crashSpheres = obj->GetAllCrashSpheres();
             std::vector<Math::Sphere> displaySpheres;
             for (const auto& crashSphere : crashSpheres)
             {
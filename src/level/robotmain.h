@@ -41,6 +41,7 @@
 #include "object/drive_type.h"
 #include "object/mission_type.h"
 #include "object/object_type.h"
+#include "object/path_planner_type.h"
 #include "object/tool_type.h"
 
 #include <deque>
@@ -92,6 +93,7 @@ class CPlayerProfile;
 class CSettings;
 class COldObject;
 class CPauseManager;
+class CWorkerPool;
 struct ActivePause;
 
 namespace Gfx
@@ -238,6 +240,8 @@ public:
     void        UpdateAudio(bool frame);
     void        SetMissionResultFromScript(Error result, float delay);
     Error       CheckEndMission(bool frame);
+    //! Returns the result of the last end of mission check done by the simulation, ERR_MISSION_NOTERM while the mission goes on
+    Error       GetEndMissionResult();
     Error       ProcessEndMissionTake();
     Error       ProcessEndMissionTakeForGroup(std::vector<CSceneEndCondition*>& endTakes);
     const std::map<std::string, MinMax>& GetObligatoryTokenList();
@@ -356,6 +360,31 @@ public:
     int         GetAutosaveSlots();
     //@}
 
+    /**
+     * \name Parallel program execution
+     */
+    //@{
+    //! Set number of worker threads running programs, 0 runs them all on the main thread
+    void        SetScriptThreads(int threads);
+    int         GetScriptThreads();
+    //! Run programs on the CBot bytecode VM when possible, see CBot::CBotProgram::EnableBytecode()
+    void        SetScriptBytecode(bool enable);
+    bool        GetScriptBytecode();
+    //@}
+
+    /**
+     * \name Path finding
+     */
+    //@{
+    //! Set the algorithm used by goto() in missions which don't choose one
+    void        SetPathPlanner(PathPlannerType planner);
+    PathPlannerType GetPathPlanner();
+    //! Returns the algorithm used by goto() in the current mission
+    PathPlannerType GetMissionPathPlanner();
+    //! Returns the threads running the path searches of goto() (see CPathSearch)
+    CWorkerPool* GetPathWorkers();
+    //@}
+
     //! Enable mode where completing mission closes the game
     void        SetExitAfterMission(bool exit);
 
@@ -510,6 +539,7 @@ protected:
 
     void        AutosaveRotate();
     void        Autosave();
+    void        ContinueScriptsParallel();
     bool        DestroySelectedObject();
     void        PushToSelectionHistory(CObject* obj);
     CObject*    PopFromSelectionHistory();
@@ -687,6 +717,8 @@ protected:
     Error           m_missionResult = ERR_OK;
     //! true if m_missionResult has been set by LevelController script, this disables normal EndMissionTake processing
     bool            m_missionResultFromScript = false;
+    //! Last value returned by CheckEndMission() in EventFrame()
+    Error           m_endMissionResult = ERR_MISSION_NOTERM;
 
     ShowLimit       m_showLimit[MAXSHOWLIMIT];
 
@@ -705,6 +737,14 @@ protected:
     int             m_autosaveSlots = 0;
     float           m_autosaveLast = 0.0f;
 
+    int             m_scriptThreads = 0;
+    bool            m_scriptBytecode = false;
+
+    PathPlannerType m_pathPlanner = PathPlannerType::Beam;
+    PathPlannerType m_missionPathPlanner = PathPlannerType::Beam;
+    std::unique_ptr<CWorkerPool> m_pathWorkers;
+    std::unique_ptr<CWorkerPool> m_scriptWorkers;
+
     int             m_shotSaving = 0;
 
     std::deque<CObject*> m_selectionHistory;
@@ -499,6 +499,21 @@ inline float DistanceProjected(const Math::Vector &a, const Math::Vector &b)
                   (a.z-b.z)*(a.z-b.z) );
 }
 
+//! Returns the distance between point \a p and segment \a a - \a b, projected on the XZ plane
+inline float DistanceProjectedToSegment(const Math::Vector &a, const Math::Vector &b, const Math::Vector &p)
+{
+    float dx = b.x - a.x;
+    float dz = b.z - a.z;
+    float length2 = dx*dx + dz*dz;
+    float k = 0.0f;
+    if (length2 > 0.0f)
+        k = Clamp(((p.x - a.x)*dx + (p.z - a.z)*dz) / length2, 0.0f, 1.0f);
+
+    float x = a.x + k*dx - p.x;
+    float z = a.z + k*dz - p.z;
+    return sqrtf(x*x + z*z);
+}
+
 //! Returns the normal vector to a plane
 /**
  * \param p1,p2,p3 points defining the plane
@@ -78,6 +78,7 @@ bool CProgrammableObjectImpl::EventProcess(const Event &event)
             CProfiler::StartPerformanceCounter(PCNT_UPDATE_CBOT);
             if ( IsProgram() )  // current program?
             {
+                CProfilerZone zone(m_currentProgram->script->GetZoneName());
                 if ( m_currentProgram->script->Continue() )
                 {
                     StopProgram();
@@ -19,6 +19,8 @@
 
 #include "object/implementation/task_executor_impl.h"
 
+#include "common/profiler.h"
+
 #include "object/object.h"
 #include "object/old_object.h"
 
@@ -38,6 +40,32 @@
 #include "object/task/taskturn.h"
 #include "object/task/taskwait.h"
 
+#include <algorithm>
+#include <string>
+#include <typeinfo>
+
+namespace
+{
+
+//! Returns the profiler zone name for a task class, given the name of its type
+const char* MakeTaskZoneName(std::string name)
+{
+    // Strip the decorations compilers add to type names ("9CTaskGoto", "class CTaskGoto")
+    if (name.compare(0, 6, "class ") == 0)
+        name = name.substr(6);
+    name = name.substr(std::min(name.find_first_not_of("0123456789"), name.size()));
+    return CProfiler::GetZoneName(name);
+}
+
+template<typename TaskType>
+const char* GetTaskZoneName()
+{
+    static const char* zoneName = MakeTaskZoneName(typeid(TaskType).name());
+    return zoneName;
+}
+
+} // anonymous namespace
+
 CTaskExecutorObjectImpl::CTaskExecutorObjectImpl(ObjectInterfaceTypes& types, CObject* object)
     : CTaskExecutorObject(types)
     , m_object(object)
@@ -53,11 +81,13 @@ bool CTaskExecutorObjectImpl::EventProcess(const Event &event)
 
     if ( m_foregroundTask != nullptr )
     {
+        CProfilerZone zone(m_foregroundTaskZone);
         m_foregroundTask->EventProcess(event);
     }
 
     if ( m_backgroundTask != nullptr )
     {
+        CProfilerZone zone(m_backgroundTaskZone);
         m_backgroundTask->EventProcess(event);
     }
 
@@ -145,7 +175,10 @@ Error CTaskExecutorObjectImpl::StartForegroundTask(Args&&... args)
     std::unique_ptr<TaskType> task = MakeUnique<TaskType>(dynamic_cast<COldObject*>(m_object));
     Error err = task->Start(std::forward<Args>(args)...);
     if (err == ERR_OK)
+    {
         m_foregroundTask = std::move(task);
+        m_foregroundTaskZone = GetTaskZoneName<TaskType>();
+    }
     m_object->UpdateInterface();
     return err;
 }
@@ -171,7 +204,10 @@ Error CTaskExecutorObjectImpl::StartBackgroundTask(Args&&... args)
         std::unique_ptr<TaskType> newTask = MakeUnique<TaskType>(dynamic_cast<COldObject*>(m_object));
         err = newTask->Start(std::forward<Args>(args)...);
         if (err == ERR_OK)
+        {
             m_backgroundTask = std::move(newTask);
+            m_backgroundTaskZone = GetTaskZoneName<TaskType>();
+        }
     }
     m_object->UpdateInterface();
     return err;
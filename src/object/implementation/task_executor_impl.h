@@ -76,6 +76,9 @@ private:
 protected:
     std::unique_ptr<CForegroundTask> m_foregroundTask;
     std::unique_ptr<CBackgroundTask> m_backgroundTask;
+    //! Profiler zone names of the current tasks
+    const char* m_foregroundTaskZone = nullptr;
+    const char* m_backgroundTaskZone = nullptr;
 
 private:
     CObject* m_object;
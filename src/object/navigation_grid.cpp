@@ -0,0 +1,437 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "object/navigation_grid.h"
+
+#include "graphics/engine/terrain.h"
+#include "graphics/engine/water.h"
+
+#include "math/point.h"
+
+#include "object/object.h"
+
+#include "object/interface/transportable_object.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+
+namespace
+{
+
+const unsigned char CELL_KNOWN    = 1<<0;   // CELL_STEEP and CELL_WATER are computed
+const unsigned char CELL_STEEP    = 1<<1;   // too steep, or too high to fly over
+const unsigned char CELL_WATER    = 1<<2;   // under water
+const unsigned char CELL_RESOLVED = 1<<3;   // CELL_BLOCKED is computed
+const unsigned char CELL_BLOCKED  = 1<<4;
+
+//! Number of cells computed around a tested cell at once
+const int COMPUTE_MARGIN = 10;
+
+//! Unused layers are released when there are more than this
+const std::size_t MAX_LAYERS = 8;
+
+int GetCellCoord(float coord)
+{
+    return static_cast<int>((coord+1600.0f)/NAVIGATION_CELL_SIZE);
+}
+
+template<typename T>
+void ReleaseUnusedLayers(std::vector<std::shared_ptr<T>>& layers)
+{
+    if (layers.size() < MAX_LAYERS) return;
+
+    layers.erase(std::remove_if(layers.begin(), layers.end(),
+                                [](const std::shared_ptr<T>& layer) { return layer.use_count() == 1; }),
+                 layers.end());
+}
+
+} // anonymous namespace
+
+
+CNavigationTerrainLayer::CNavigationTerrainLayer(Gfx::CTerrain* terrain, Gfx::CWater* water,
+                                                 const NavigationDriveClass& driveClass)
+    : m_terrain(terrain),
+      m_water(water),
+      m_driveClass(driveClass),
+      m_cells(NAVIGATION_GRID_SIZE*NAVIGATION_GRID_SIZE, 0)
+{
+}
+
+CNavigationTerrainLayer::~CNavigationTerrainLayer()
+{
+}
+
+const NavigationDriveClass& CNavigationTerrainLayer::GetDriveClass() const
+{
+    return m_driveClass;
+}
+
+bool CNavigationTerrainLayer::IsBlocked(int x, int y)
+{
+    if (x < 0 || x >= NAVIGATION_GRID_SIZE ||
+        y < 0 || y >= NAVIGATION_GRID_SIZE) return false;
+
+    unsigned char& cell = m_cells[x+y*NAVIGATION_GRID_SIZE];
+    if (cell & CELL_RESOLVED) return (cell & CELL_BLOCKED) != 0;
+
+    bool blocked = (GetCell(x, y) & (CELL_STEEP | CELL_WATER)) != 0;
+
+    // Keeps robots one cell away from water they can't go in
+    if (!blocked)
+    {
+        blocked = IsUnderWater(x-1, y) || IsUnderWater(x+1, y) ||
+                  IsUnderWater(x, y-1) || IsUnderWater(x, y+1);
+    }
+
+    cell |= CELL_RESOLVED;
+    if (blocked) cell |= CELL_BLOCKED;
+    return blocked;
+}
+
+void CNavigationTerrainLayer::Invalidate(int minX, int minY, int maxX, int maxY)
+{
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, NAVIGATION_GRID_SIZE-1);
+    maxY = std::min(maxY, NAVIGATION_GRID_SIZE-1);
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        std::fill(m_cells.begin()+minX+y*NAVIGATION_GRID_SIZE,
+                  m_cells.begin()+maxX+1+y*NAVIGATION_GRID_SIZE, 0);
+    }
+}
+
+unsigned char CNavigationTerrainLayer::GetCell(int x, int y)
+{
+    unsigned char cell = m_cells[x+y*NAVIGATION_GRID_SIZE];
+    if (cell & CELL_KNOWN) return cell;
+
+    Compute(x-COMPUTE_MARGIN, y-COMPUTE_MARGIN, x+COMPUTE_MARGIN, y+COMPUTE_MARGIN);
+    return m_cells[x+y*NAVIGATION_GRID_SIZE];
+}
+
+bool CNavigationTerrainLayer::IsUnderWater(int x, int y)
+{
+    if (x < 0 || x >= NAVIGATION_GRID_SIZE ||
+        y < 0 || y >= NAVIGATION_GRID_SIZE) return false;
+
+    return (GetCell(x, y) & CELL_WATER) != 0;
+}
+
+void CNavigationTerrainLayer::Compute(int minX, int minY, int maxX, int maxY)
+{
+    minX = std::max(minX, 0);
+    minY = std::max(minY, 0);
+    maxX = std::min(maxX, NAVIGATION_GRID_SIZE-1);
+    maxY = std::min(maxY, NAVIGATION_GRID_SIZE-1);
+
+    float flyingLimit = m_terrain->GetFlyingMaxHeight()-5.0f;
+    float waterLimit = m_water->GetLevel()-2.0f;  // accepts that a robot is 50cm under water, for example Tropica 3!
+
+    for (int y = minY; y <= maxY; y++)
+    {
+        for (int x = minX; x <= maxX; x++)
+        {
+            unsigned char& cell = m_cells[x+y*NAVIGATION_GRID_SIZE];
+            if (cell & CELL_KNOWN) continue;
+
+            Math::Vector p;
+            p.x = x*NAVIGATION_CELL_SIZE-1600.0f;
+            p.z = y*NAVIGATION_CELL_SIZE-1600.0f;
+
+            cell = CELL_KNOWN;
+
+            if (m_driveClass.fly)  // flying robot?
+            {
+                if (m_terrain->GetFloorLevel(p, true) >= flyingLimit)
+                    cell |= CELL_STEEP;
+                continue;
+            }
+
+            if (!m_driveClass.acceptWater)  // not going underwater?
+            {
+                if (m_terrain->GetFloorLevel(p, true) < waterLimit)
+                {
+                    cell |= CELL_WATER;
+                    continue;
+                }
+            }
+
+            if (m_terrain->GetFineSlope(p) > m_driveClass.slopeLimit)
+                cell |= CELL_STEEP;
+        }
+    }
+}
+
+
+CNavigationObjectLayer::CNavigationObjectLayer(float margin, float altitude)
+    : m_margin(margin),
+      m_altitude(altitude),
+      m_counts(NAVIGATION_GRID_SIZE*NAVIGATION_GRID_SIZE, 0)
+{
+}
+
+CNavigationObjectLayer::~CNavigationObjectLayer()
+{
+}
+
+float CNavigationObjectLayer::GetMargin() const
+{
+    return m_margin;
+}
+
+float CNavigationObjectLayer::GetAltitude() const
+{
+    return m_altitude;
+}
+
+
+CNavigationGrid::CNavigationGrid(Gfx::CTerrain* terrain, Gfx::CWater* water)
+    : m_terrain(terrain),
+      m_water(water),
+      m_reliefRevision(0),
+      m_waterLevel(0.0f),
+      m_flyingMaxHeight(0.0f)
+{
+}
+
+CNavigationGrid::~CNavigationGrid()
+{
+}
+
+void CNavigationGrid::AddObject(CObject* object)
+{
+    assert(object != nullptr);
+    m_objects[object] = ObjectRecord();
+}
+
+void CNavigationGrid::RemoveObject(CObject* object)
+{
+    auto it = m_objects.find(object);
+    if (it == m_objects.end()) return;
+
+    Rasterize(it->second, -1);
+    m_objects.erase(it);
+}
+
+void CNavigationGrid::Clear()
+{
+    m_objects.clear();
+    m_terrainLayers.clear();
+    m_objectLayers.clear();
+}
+
+void CNavigationGrid::Update()
+{
+    bool terrainChanged = UpdateTerrain();
+
+    for (auto& it : m_objects)
+    {
+        CObject* object = it.first;
+        ObjectRecord& record = it.second;
+
+        int revision = object->GetCrashSpheresRevision();
+        bool transported = IsObjectBeingTransported(object);
+        if (record.valid && !terrainChanged &&
+            record.revision == revision &&
+            record.transported == transported) continue;
+
+        Rasterize(record, -1);
+        record.revision = revision;
+        record.transported = transported;
+        ReadObject(object, record);
+        Rasterize(record, 1);
+    }
+}
+
+std::shared_ptr<CNavigationTerrainLayer> CNavigationGrid::GetTerrainLayer(const NavigationDriveClass& driveClass)
+{
+    for (const auto& layer : m_terrainLayers)
+    {
+        const NavigationDriveClass& other = layer->GetDriveClass();
+        if (other.slopeLimit == driveClass.slopeLimit &&
+            other.acceptWater == driveClass.acceptWater &&
+            other.fly == driveClass.fly) return layer;
+    }
+
+    ReleaseUnusedLayers(m_terrainLayers);
+
+    auto layer = std::make_shared<CNavigationTerrainLayer>(m_terrain, m_water, driveClass);
+    m_terrainLayers.push_back(layer);
+    return layer;
+}
+
+std::shared_ptr<CNavigationObjectLayer> CNavigationGrid::GetObjectLayer(float margin, float altitude)
+{
+    for (const auto& layer : m_objectLayers)
+    {
+        if (layer->GetMargin() == margin &&
+            layer->GetAltitude() == altitude) return layer;
+    }
+
+    ReleaseUnusedLayers(m_objectLayers);
+
+    auto layer = std::make_shared<CNavigationObjectLayer>(margin, altitude);
+    for (const auto& it : m_objects)
+    {
+        Rasterize(it.second, *layer, 1);
+    }
+    m_objectLayers.push_back(layer);
+    return layer;
+}
+
+int CNavigationGrid::CountObjectCoverage(const CNavigationObjectLayer& layer, CObject* object, int x, int y) const
+{
+    auto it = m_objects.find(object);
+    if (it == m_objects.end()) return 0;
+
+    int count = 0;
+    for (const Math::Sphere& sphere : it->second.spheres)
+    {
+        Circle circle;
+        if (!GetCircle(it->second, sphere, layer, circle)) continue;
+
+        // The same test as in Rasterize()
+        int r = static_cast<int>(circle.radius);
+        if (abs(x-circle.x) > r || abs(y-circle.y) > r) continue;
+
+        float d = Math::Point(static_cast<float>(x-circle.x), static_cast<float>(y-circle.y)).Length();
+        if (d > circle.radius) continue;
+
+        count++;
+    }
+    return count;
+}
+
+void CNavigationGrid::ReadObject(CObject* object, ObjectRecord& record)
+{
+    record.valid = true;
+    record.para = object->GetType() == OBJECT_PARA;
+    record.spheres.clear();
+
+    if (record.transported) return;
+
+    record.floorLevel = m_terrain->GetFloorLevel(object->GetPosition(), false);
+    for (const auto& crashSphere : object->GetAllCrashSpheres())
+    {
+        record.spheres.push_back(crashSphere.sphere);
+    }
+}
+
+bool CNavigationGrid::GetCircle(const ObjectRecord& record, const Math::Sphere& sphere,
+                                const CNavigationObjectLayer& layer, Circle& circle) const
+{
+    float h = record.floorLevel + layer.m_altitude;
+    if (layer.m_altitude > 0.0f)  // flying?
+    {
+        if (sphere.pos.y-sphere.radius > h+8.0f ||
+            sphere.pos.y+sphere.radius < h-8.0f) return false;
+    }
+    else    // crawling?
+    {
+        if (sphere.pos.y-sphere.radius > h+8.0f) return false;
+    }
+
+    float radius = sphere.radius;
+    if (record.para) radius -= 2.0f;
+
+    circle.x = GetCellCoord(sphere.pos.x);
+    circle.y = GetCellCoord(sphere.pos.z);
+    circle.radius = (radius+layer.m_margin)/NAVIGATION_CELL_SIZE;
+    return true;
+}
+
+void CNavigationGrid::Rasterize(const ObjectRecord& record, CNavigationObjectLayer& layer, int delta)
+{
+    for (const Math::Sphere& sphere : record.spheres)
+    {
+        Circle circle;
+        if (!GetCircle(record, sphere, layer, circle)) continue;
+
+        int r = static_cast<int>(circle.radius);
+        for (int y = circle.y-r; y <= circle.y+r; y++)
+        {
+            if (y < 0 || y >= NAVIGATION_GRID_SIZE) continue;
+            for (int x = circle.x-r; x <= circle.x+r; x++)
+            {
+                if (x < 0 || x >= NAVIGATION_GRID_SIZE) continue;
+
+                float d = Math::Point(static_cast<float>(x-circle.x), static_cast<float>(y-circle.y)).Length();
+                if (d > circle.radius) continue;
+
+                layer.m_counts[x+y*NAVIGATION_GRID_SIZE] += delta;
+            }
+        }
+    }
+}
+
+void CNavigationGrid::Rasterize(const ObjectRecord& record, int delta)
+{
+    if (!record.valid) return;
+
+    for (const auto& layer : m_objectLayers)
+    {
+        Rasterize(record, *layer, delta);
+    }
+}
+
+bool CNavigationGrid::UpdateTerrain()
+{
+    int revision = m_terrain->GetReliefRevision();
+    float waterLevel = m_water->GetLevel();
+    float flyingMaxHeight = m_terrain->GetFlyingMaxHeight();
+
+    if (revision == m_reliefRevision &&
+        waterLevel == m_waterLevel &&
+        flyingMaxHeight == m_flyingMaxHeight) return false;
+
+    bool whole = waterLevel != m_waterLevel || flyingMaxHeight != m_flyingMaxHeight;
+    for (int i = m_reliefRevision+1; i <= revision && !whole; i++)
+    {
+        Math::Vector min, max;
+        if (!m_terrain->GetReliefChange(i, min, max))
+        {
+            whole = true;
+            break;
+        }
+
+        // One more cell on each side, the neighbours may be next to changed water
+        for (const auto& layer : m_terrainLayers)
+        {
+            layer->Invalidate(GetCellCoord(min.x)-1, GetCellCoord(min.z)-1,
+                              GetCellCoord(max.x)+1, GetCellCoord(max.z)+1);
+        }
+    }
+
+    if (whole)
+    {
+        for (const auto& layer : m_terrainLayers)
+        {
+            layer->Invalidate(0, 0, NAVIGATION_GRID_SIZE-1, NAVIGATION_GRID_SIZE-1);
+        }
+    }
+
+    m_reliefRevision = revision;
+    m_waterLevel = waterLevel;
+    m_flyingMaxHeight = flyingMaxHeight;
+    return true;
+}
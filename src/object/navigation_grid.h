@@ -0,0 +1,211 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file object/navigation_grid.h
+ * \brief Obstacle maps shared by all robots looking for a path
+ */
+
+#pragma once
+
+#include "math/sphere.h"
+#include "math/vector.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class CObject;
+
+namespace Gfx
+{
+class CTerrain;
+class CWater;
+} // namespace Gfx
+
+
+//! Size of one cell of the navigation grid
+/**
+ * Setting 5 means that 5x5 square (in game units) will be represented by one cell.
+ * Decreasing this value will make a bigger grid, and may increase goto() accuracy.
+ */
+const float NAVIGATION_CELL_SIZE = 5.0f;
+//! Number of cells on each side of the grid, which covers the whole 3200x3200 world
+const int NAVIGATION_GRID_SIZE = 640;
+
+
+/**
+ * \struct NavigationDriveClass
+ * \brief Describes which terrain a robot can move on
+ */
+struct NavigationDriveClass
+{
+    //! Steepest slope the robot can climb
+    float slopeLimit = 0.0f;
+    //! The robot can go underwater
+    bool  acceptWater = false;
+    //! The robot flies, only ground too close to the flying limit blocks it
+    bool  fly = false;
+};
+
+/**
+ * \class CNavigationTerrainLayer
+ * \brief Cells made impassable by the terrain for one drive class
+ *
+ * Cells are evaluated the first time they are tested, so only the parts
+ * of the world where robots actually look for paths are ever computed.
+ */
+class CNavigationTerrainLayer
+{
+public:
+    CNavigationTerrainLayer(Gfx::CTerrain* terrain, Gfx::CWater* water, const NavigationDriveClass& driveClass);
+    ~CNavigationTerrainLayer();
+
+    //! Returns the drive class this layer was made for
+    const NavigationDriveClass& GetDriveClass() const;
+
+    //! Returns true if the terrain blocks the cell, cells outside the grid are never blocked
+    bool IsBlocked(int x, int y);
+
+    //! Forgets everything computed in the given range of cells
+    void Invalidate(int minX, int minY, int maxX, int maxY);
+
+private:
+    unsigned char GetCell(int x, int y);
+    bool IsUnderWater(int x, int y);
+    void Compute(int minX, int minY, int maxX, int maxY);
+
+private:
+    Gfx::CTerrain*       m_terrain;
+    Gfx::CWater*         m_water;
+    NavigationDriveClass m_driveClass;
+    std::vector<unsigned char> m_cells;
+};
+
+/**
+ * \class CNavigationObjectLayer
+ * \brief Number of object crash spheres covering each cell
+ *
+ * Crash spheres are enlarged by the margin (radius of the moving robot plus some
+ * safety distance), so that the robot only has to keep its center out of covered cells.
+ */
+class CNavigationObjectLayer
+{
+public:
+    CNavigationObjectLayer(float margin, float altitude);
+    ~CNavigationObjectLayer();
+
+    //! Returns the distance by which crash spheres are enlarged
+    float GetMargin() const;
+    //! Returns the flying altitude of robots using this layer, 0 for robots on the ground
+    float GetAltitude() const;
+
+    //! Returns the number of crash spheres covering the cell, 0 outside the grid
+    int GetCount(int x, int y) const
+    {
+        if (x < 0 || x >= NAVIGATION_GRID_SIZE ||
+            y < 0 || y >= NAVIGATION_GRID_SIZE) return 0;
+        return m_counts[x+y*NAVIGATION_GRID_SIZE];
+    }
+
+private:
+    friend class CNavigationGrid;
+
+    float m_margin;
+    float m_altitude;
+    std::vector<unsigned short> m_counts;
+};
+
+/**
+ * \class CNavigationGrid
+ * \brief World obstacle maps used for path finding (see CTaskGoto)
+ *
+ * There is one terrain layer for each drive class and one object layer for each
+ * robot size and flying altitude in use. Layers are shared by all robots, each
+ * path search only has to ignore its own robot and the object it goes to
+ * (see CountObjectCoverage()).
+ *
+ * The maps are maintained incrementally: on Update(), objects are rasterized again only
+ * if their crash spheres changed (see CObject::GetCrashSpheresRevision()), and terrain
+ * cells are recomputed only in areas changed by CTerrain::Terraform().
+ */
+class CNavigationGrid
+{
+public:
+    CNavigationGrid(Gfx::CTerrain* terrain, Gfx::CWater* water);
+    ~CNavigationGrid();
+
+    //! Starts tracking a new object, it is added to the layers on next Update()
+    void AddObject(CObject* object);
+    //! Removes object from all layers
+    void RemoveObject(CObject* object);
+    //! Removes all objects and layers
+    void Clear();
+
+    //! Brings all layers up to date with the objects and the terrain
+    void Update();
+
+    //! Returns the terrain layer of given drive class, creating it if needed
+    std::shared_ptr<CNavigationTerrainLayer> GetTerrainLayer(const NavigationDriveClass& driveClass);
+    //! Returns the object layer of given margin and flying altitude, creating it if needed
+    std::shared_ptr<CNavigationObjectLayer> GetObjectLayer(float margin, float altitude);
+
+    //! Returns how many crash spheres of the object cover the cell in given layer
+    /** Used to ignore some objects (like the moving robot itself) without having a layer of their own */
+    int CountObjectCoverage(const CNavigationObjectLayer& layer, CObject* object, int x, int y) const;
+
+private:
+    //! State of an object as it was rasterized into the layers
+    struct ObjectRecord
+    {
+        bool  valid = false;
+        int   revision = 0;
+        bool  transported = false;
+        bool  para = false;
+        float floorLevel = 0.0f;
+        std::vector<Math::Sphere> spheres;
+    };
+
+    struct Circle
+    {
+        int   x = 0;
+        int   y = 0;
+        float radius = 0.0f;
+    };
+
+    void ReadObject(CObject* object, ObjectRecord& record);
+    bool GetCircle(const ObjectRecord& record, const Math::Sphere& sphere,
+                   const CNavigationObjectLayer& layer, Circle& circle) const;
+    void Rasterize(const ObjectRecord& record, CNavigationObjectLayer& layer, int delta);
+    void Rasterize(const ObjectRecord& record, int delta);
+    bool UpdateTerrain();
+
+private:
+    Gfx::CTerrain* m_terrain;
+    Gfx::CWater*   m_water;
+
+    std::unordered_map<CObject*, ObjectRecord> m_objects;
+    std::vector<std::shared_ptr<CNavigationTerrainLayer>> m_terrainLayers;
+    std::vector<std::shared_ptr<CNavigationObjectLayer>> m_objectLayers;
+
+    //! Terrain state the terrain layers were computed for
+    int   m_reliefRevision;
+    float m_waterLevel;
+    float m_flyingMaxHeight;
+};
@@ -30,6 +30,8 @@
 #include "level/parser/parserline.h"
 #include "level/parser/parserparam.h"
 
+#include "object/object_manager.h"
+
 #include "script/scriptfunc.h"
 
 #include <stdexcept>
@@ -41,6 +43,8 @@ CObject::CObject(int id, ObjectType type)
     , m_position(0.0f, 0.0f, 0.0f)
     , m_rotation(0.0f, 0.0f, 0.0f)
     , m_scale(1.0f, 1.0f, 1.0f)
+    , m_worldCrashSpheresValid(false)
+    , m_crashSpheresRevision(0)
     , m_animateOnReset(false)
     , m_collisions(true)
     , m_team(0)
@@ -86,29 +90,84 @@ void CObject::SetCrashSpheres(const std::vector<Gfx::ModelCrashSphere>& crashSph
 void CObject::AddCrashSphere(const CrashSphere& crashSphere)
 {
     m_crashSpheres.push_back(crashSphere);
+    InvalidateCrashSpheres();
+    UpdateCollisionReach();
 }
 
 CrashSphere CObject::GetFirstCrashSphere()
 {
     assert(m_crashSpheres.size() >= 1);
 
-    CrashSphere transformedFirstCrashSphere = m_crashSpheres[0];
-    TransformCrashSphere(transformedFirstCrashSphere.sphere);
-    return transformedFirstCrashSphere;
+    return GetAllCrashSpheres()[0];
 }
 
-std::vector<CrashSphere> CObject::GetAllCrashSpheres()
+const std::vector<CrashSphere>& CObject::GetAllCrashSpheres()
 {
-    std::vector<CrashSphere> allCrashSpheres;
+    PrepareCrashSphereTransform();
+    if (m_worldCrashSpheresValid)
+        return m_worldCrashSpheres;
 
-    for (const auto& crashSphere : m_crashSpheres)
+    // Overwrite in place, so that references held by callers stay valid
+    m_worldCrashSpheres.resize(m_crashSpheres.size());
+    for (std::size_t i = 0; i < m_crashSpheres.size(); ++i)
     {
-        CrashSphere transformedCrashSphere = crashSphere;
-        TransformCrashSphere(transformedCrashSphere.sphere);
-        allCrashSpheres.push_back(transformedCrashSphere);
+        m_worldCrashSpheres[i] = m_crashSpheres[i];
+        TransformCrashSphere(m_worldCrashSpheres[i].sphere);
     }
 
-    return allCrashSpheres;
+    m_worldCrashSpheresBounds = Math::Sphere();
+    if (!m_worldCrashSpheres.empty())
+    {
+        Math::Vector min = m_worldCrashSpheres[0].sphere.pos;
+        Math::Vector max = min;
+        for (const auto& crashSphere : m_worldCrashSpheres)
+        {
+            const Math::Sphere& sphere = crashSphere.sphere;
+            min = Math::Vector(Math::Min(min.x, sphere.pos.x), Math::Min(min.y, sphere.pos.y), Math::Min(min.z, sphere.pos.z));
+            max = Math::Vector(Math::Max(max.x, sphere.pos.x), Math::Max(max.y, sphere.pos.y), Math::Max(max.z, sphere.pos.z));
+        }
+        m_worldCrashSpheresBounds.pos = (min + max) / 2.0f;
+        for (const auto& crashSphere : m_worldCrashSpheres)
+        {
+            const Math::Sphere& sphere = crashSphere.sphere;
+            float radius = Math::Distance(m_worldCrashSpheresBounds.pos, sphere.pos) + sphere.radius;
+            m_worldCrashSpheresBounds.radius = Math::Max(m_worldCrashSpheresBounds.radius, radius);
+        }
+    }
+
+    m_worldCrashSpheresValid = true;
+    return m_worldCrashSpheres;
+}
+
+Math::Sphere CObject::GetCrashSpheresBounds()
+{
+    GetAllCrashSpheres();
+    return m_worldCrashSpheresBounds;
+}
+
+int CObject::GetCrashSpheresRevision()
+{
+    PrepareCrashSphereTransform();
+    return m_crashSpheresRevision;
+}
+
+void CObject::InvalidateCrashSpheres()
+{
+    m_worldCrashSpheresValid = false;
+    m_crashSpheresRevision++;
+}
+
+float CObject::GetCollisionReach()
+{
+    // We don't know how TransformCrashSphere() places the spheres, so assume they can be anywhere
+    return Math::HUGE_NUM;
+}
+
+void CObject::UpdateCollisionReach()
+{
+    CObjectManager* objectManager = CObjectManager::GetInstancePointer();
+    if (objectManager != nullptr)
+        objectManager->UpdateObjectCollisionReach(this);
 }
 
 bool CObject::CanCollideWith(CObject* other)
@@ -259,6 +318,7 @@ int CObject::GetCrashSphereCount()
 void CObject::DeleteAllCrashSpheres()
 {
     m_crashSpheres.clear();
+    InvalidateCrashSpheres();
 }
 
 void CObject::SetCameraCollisionSphere(const Math::Sphere& sphere)
@@ -149,12 +149,25 @@ public:
     /** Crash sphere position is returned in world coordinates */
     CrashSphere GetFirstCrashSphere();
     //! Returns all crash spheres
-    /** Crash sphere position is returned in world coordinates */
-    std::vector<CrashSphere> GetAllCrashSpheres();
+    /**
+     * Crash sphere position is returned in world coordinates.
+     * The spheres are cached until the object moves, so the reference
+     * is only valid until the object is changed.
+     */
+    const std::vector<CrashSphere>& GetAllCrashSpheres();
+    //! Returns sphere enclosing all crash spheres, in world coordinates
+    /** Radius is 0 if object has no crash spheres */
+    Math::Sphere GetCrashSpheresBounds();
+    //! Returns a number which changes every time the crash spheres in world coordinates may have changed
+    /** Lets caches built from GetAllCrashSpheres() find out whether they are still valid */
+    int GetCrashSpheresRevision();
     //! Removes all crash spheres
     void DeleteAllCrashSpheres();
     //! Returns true if this object can collide with the other one
     bool CanCollideWith(CObject* other);
+    //! Returns upper bound of projected distance from object's position to any point of its crash or jostling spheres
+    /** Used by the collision broad phase, see CObjectManager::GetMaxCollisionReach() */
+    virtual float GetCollisionReach();
 
     //! Returns sphere used to test for camera collisions
     Math::Sphere GetCameraCollisionSphere();
@@ -212,6 +225,15 @@ public:
     virtual bool IsBulletWall() { return false; }
 
 protected:
+    //! Tells the object manager that the collision reach of this object may have grown
+    void UpdateCollisionReach();
+
+    //! Marks crash spheres in world coordinates as outdated
+    void InvalidateCrashSpheres();
+    //! Brings up to date everything TransformCrashSphere() depends on
+    /** Called before the cache of crash spheres in world coordinates is checked */
+    virtual void PrepareCrashSphereTransform() {}
+
     //! Transform crash sphere by object's world matrix
     virtual void TransformCrashSphere(Math::Sphere& crashSphere) = 0;
     //! Transform crash sphere by object's world matrix
@@ -225,6 +247,10 @@ protected:
     Math::Vector m_rotation;
     Math::Vector m_scale;
     std::vector<CrashSphere> m_crashSpheres; //!< crash spheres
+    std::vector<CrashSphere> m_worldCrashSpheres; //!< crash spheres in world coordinates (cache)
+    Math::Sphere m_worldCrashSpheresBounds; //!< sphere enclosing m_worldCrashSpheres
+    bool m_worldCrashSpheresValid;
+    int m_crashSpheresRevision; //!< incremented every time crash spheres are invalidated
     Math::Sphere m_cameraCollisionSphere;
     bool m_animateOnReset;
     bool m_collisions;
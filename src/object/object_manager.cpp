@@ -22,12 +22,16 @@
 #include "common/global.h"
 #include "common/make_unique.h"
 
+#include "graphics/engine/engine.h"
+
 #include "math/all.h"
 
+#include "object/navigation_grid.h"
 #include "object/object.h"
 #include "object/object_create_exception.h"
 #include "object/object_create_params.h"
 #include "object/object_factory.h"
+#include "object/object_spatial_index.h"
 #include "object/old_object.h"
 
 #include "object/auto/auto.h"
@@ -50,6 +54,9 @@ CObjectManager::CObjectManager(Gfx::CEngine* engine,
                                                oldModelManager,
                                                modelManager,
                                                particle)),
+    m_spatialIndex(MakeUnique<CObjectSpatialIndex>()),
+    m_navigationGrid(MakeUnique<CNavigationGrid>(terrain, engine->GetWater())),
+    m_maxCollisionReach(0.0f),
     m_nextId(0),
     m_activeObjectIterators(0),
     m_shouldCleanRemovedObjects(false)
@@ -69,6 +76,9 @@ bool CObjectManager::DeleteObject(CObject* instance)
     if (oldObj != nullptr)
         oldObj->DeleteObject();
 
+    m_spatialIndex->Remove(instance);
+    m_navigationGrid->RemoveObject(instance);
+
     auto it = m_objects.find(instance->GetID());
     if (it != m_objects.end())
     {
@@ -112,6 +122,9 @@ void CObjectManager::DeleteAllObjects()
     }
 
     m_objects.clear();
+    m_spatialIndex->Clear();
+    m_navigationGrid->Clear();
+    m_maxCollisionReach = 0.0f;
 
     m_nextId = 0;
 }
@@ -156,6 +169,9 @@ CObject* CObjectManager::CreateObject(ObjectCreateParams params)
     CObject* objectPtr = objectUPtr.get();
 
     m_objects[params.id] = std::move(objectUPtr);
+    m_spatialIndex->Add(objectPtr);
+    m_navigationGrid->AddObject(objectPtr);
+    UpdateObjectCollisionReach(objectPtr);
 
     return objectPtr;
 }
@@ -171,6 +187,59 @@ CObject* CObjectManager::CreateObject(Math::Vector pos, float angle, ObjectType
     return CreateObject(params);
 }
 
+void CObjectManager::UpdateObjectPosition(CObject* object)
+{
+    m_spatialIndex->Update(object);
+}
+
+CNavigationGrid* CObjectManager::GetNavigationGrid()
+{
+    return m_navigationGrid.get();
+}
+
+std::vector<CObject*> CObjectManager::GetObjectsInRange(Math::Vector position, float maxDist)
+{
+    std::vector<CObject*> result;
+    for (CObject* object : m_spatialIndex->Query(position, 0.0f, maxDist))
+    {
+        if (Math::DistanceProjected(position, object->GetPosition()) <= maxDist)
+            result.push_back(object);
+    }
+    return result;
+}
+
+std::vector<CObject*> CObjectManager::GetObjectsNearSegment(Math::Vector a, Math::Vector b, float maxDist)
+{
+    std::vector<CObject*> result;
+    for (CObject* object : m_spatialIndex->QuerySegment(a, b, maxDist))
+    {
+        if (Math::DistanceProjectedToSegment(a, b, object->GetPosition()) <= maxDist)
+            result.push_back(object);
+    }
+    return result;
+}
+
+void CObjectManager::UpdateObjectCollisionReach(CObject* object)
+{
+    float reach = object->GetCollisionReach();
+    if (reach > m_maxCollisionReach)  // also skips NaN
+        m_maxCollisionReach = reach;
+}
+
+void CObjectManager::UpdateMaxCollisionReach()
+{
+    m_maxCollisionReach = 0.0f;
+    for (CObject* object : GetAllObjects())
+    {
+        UpdateObjectCollisionReach(object);
+    }
+}
+
+float CObjectManager::GetMaxCollisionReach()
+{
+    return m_maxCollisionReach;
+}
+
 std::vector<CObject*> CObjectManager::GetObjectsOfTeam(int team)
 {
     std::vector<CObject*> result;
@@ -266,7 +335,33 @@ std::vector<CObject*> CObjectManager::RadarAll(CObject* pThis, Math::Vector this
 
 std::vector<CObject*> CObjectManager::RadarAll(CObject* pThis, Math::Vector thisPosition, float thisAngle, std::vector<ObjectType> type, float angle, float focus, float minDist, float maxDist, bool furthest, RadarFilter filter, bool cbotTypes)
 {
-    CObject     *pObj;
+    std::vector<std::pair<float, CObject*>> best;
+    RadarSearch(best, pThis, thisPosition, thisAngle, type, angle, focus, minDist, maxDist, filter, cbotTypes);
+
+    // Objects at exactly the same distance from the origin stay in order of id
+    std::stable_sort(best.begin(), best.end(), [](const std::pair<float, CObject*>& a, const std::pair<float, CObject*>& b) { return a.first < b.first; });
+
+    std::vector<CObject*> sortedBest;
+    if (!furthest)
+    {
+        for (auto it = best.begin(); it != best.end(); ++it)
+        {
+            sortedBest.push_back(it->second);
+        }
+    }
+    else
+    {
+        for (auto it = best.rbegin(); it != best.rend(); ++it)
+        {
+            sortedBest.push_back(it->second);
+        }
+    }
+
+    return sortedBest;
+}
+
+void CObjectManager::RadarSearch(std::vector<std::pair<float, CObject*>>& found, CObject* pThis, Math::Vector thisPosition, float thisAngle, const std::vector<ObjectType>& type, float angle, float focus, float minDist, float maxDist, RadarFilter filter, bool cbotTypes)
+{
     Math::Vector    iPos, oPos;
     float       iAngle, d, a;
     ObjectType  oType;
@@ -282,16 +377,10 @@ std::vector<CObject*> CObjectManager::RadarAll(CObject* pThis, Math::Vector this
     RadarFilter filter_flying = static_cast<RadarFilter>(filter & (FILTER_ONLYLANDING | FILTER_ONLYFLYING));
     RadarFilter filter_enemy = static_cast<RadarFilter>(filter & (FILTER_FRIENDLY | FILTER_ENEMY | FILTER_NEUTRAL));
 
-    // Use a multimap to allow for multiple objects at exactly the same distance
-    // from the origin to be returned.
-    std::multimap<float, CObject*> best;
-
-    for ( auto it = m_objects.begin() ; it != m_objects.end() ; ++it )
+    for (CObject* pObj : m_spatialIndex->Query(iPos, minDist, maxDist, iAngle, focus))
     {
-        pObj = it->second.get();
         if ( pObj == pThis )  continue; // pThis may be nullptr but it doesn't matter
 
-        if (pObj == nullptr) continue;
         if (IsObjectBeingTransported(pObj))  continue;
         if ( !pObj->GetDetectable() )  continue;
         if ( pObj->GetProxyActivate() )  continue;
@@ -362,51 +451,63 @@ std::vector<CObject*> CObjectManager::RadarAll(CObject* pThis, Math::Vector this
         a = Math::RotateAngle(oPos.x-iPos.x, iPos.z-oPos.z);  // CW !
         if ( Math::TestAngle(a, iAngle-focus/2.0f, iAngle+focus/2.0f) || focus >= Math::PI*2.0f )
         {
-            best.insert(std::make_pair(d, pObj));
-        }
-    }
-
-    std::vector<CObject*> sortedBest;
-    if (!furthest)
-    {
-        for (auto it = best.begin(); it != best.end(); ++it)
-        {
-            sortedBest.push_back(it->second);
-        }
-    }
-    else
-    {
-        for (auto it = best.rbegin(); it != best.rend(); ++it)
-        {
-            sortedBest.push_back(it->second);
+            found.push_back(std::make_pair(d, pObj));
         }
     }
-
-    return sortedBest;
 }
 
 CObject* CObjectManager::Radar(CObject* pThis, ObjectType type, float angle, float focus, float minDist, float maxDist, bool furthest, RadarFilter filter, bool cbotTypes)
 {
-    std::vector<CObject*> best = RadarAll(pThis, type, angle, focus, minDist, maxDist, furthest, filter, cbotTypes);
-    return best.size() > 0 ? best[0] : nullptr;
+    std::vector<ObjectType> types;
+    if (type != OBJECT_NULL)
+        types.push_back(type);
+    return Radar(pThis, types, angle, focus, minDist, maxDist, furthest, filter, cbotTypes);
 }
 
 CObject* CObjectManager::Radar(CObject* pThis, std::vector<ObjectType> type, float angle, float focus, float minDist, float maxDist, bool furthest, RadarFilter filter, bool cbotTypes)
 {
-    std::vector<CObject*> best = RadarAll(pThis, type, angle, focus, minDist, maxDist, furthest, filter, cbotTypes);
-    return best.size() > 0 ? best[0] : nullptr;
+    Math::Vector iPos;
+    float iAngle;
+    if (pThis != nullptr)
+    {
+        iPos   = pThis->GetPosition();
+        iAngle = pThis->GetRotationY();
+        iAngle = Math::NormAngle(iAngle);  // 0..2*Math::PI
+    }
+    else
+    {
+        iPos   = Math::Vector();
+        iAngle = 0.0f;
+    }
+    return Radar(pThis, iPos, iAngle, type, angle, focus, minDist, maxDist, furthest, filter, cbotTypes);
 }
 
 CObject* CObjectManager::Radar(CObject* pThis, Math::Vector thisPosition, float thisAngle, ObjectType type, float angle, float focus, float minDist, float maxDist, bool furthest, RadarFilter filter, bool cbotTypes)
 {
-    std::vector<CObject*> best = RadarAll(pThis, thisPosition, thisAngle, type, angle, focus, minDist, maxDist, furthest, filter, cbotTypes);
-    return best.size() > 0 ? best[0] : nullptr;
+    std::vector<ObjectType> types;
+    if (type != OBJECT_NULL)
+        types.push_back(type);
+    return Radar(pThis, thisPosition, thisAngle, types, angle, focus, minDist, maxDist, furthest, filter, cbotTypes);
 }
 
 CObject* CObjectManager::Radar(CObject* pThis, Math::Vector thisPosition, float thisAngle, std::vector<ObjectType> type, float angle, float focus, float minDist, float maxDist, bool furthest, RadarFilter filter, bool cbotTypes)
 {
-    std::vector<CObject*> best = RadarAll(pThis, thisPosition, thisAngle, type, angle, focus, minDist, maxDist, furthest, filter, cbotTypes);
-    return best.size() > 0 ? best[0] : nullptr;
+    std::vector<std::pair<float, CObject*>> found;
+    RadarSearch(found, pThis, thisPosition, thisAngle, type, angle, focus, minDist, maxDist, filter, cbotTypes);
+
+    // Same object RadarAll() would return first, without sorting everything:
+    // on equal distance the nearest search keeps the lowest id, the furthest one the highest
+    CObject* best = nullptr;
+    float bestDist = 0.0f;
+    for (const auto& it : found)
+    {
+        if (best == nullptr || (furthest ? it.first >= bestDist : it.first < bestDist))
+        {
+            best = it.second;
+            bestDist = it.first;
+        }
+    }
+    return best;
 }
 
 CObject*  CObjectManager::FindNearest(CObject* pThis, ObjectType type, float maxDist, bool cbotTypes)
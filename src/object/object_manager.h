@@ -47,8 +47,10 @@ class CParticle;
 class CTerrain;
 } // namespace Gfx
 
+class CNavigationGrid;
 class CObject;
 class CObjectFactory;
+class CObjectSpatialIndex;
 
 enum RadarFilter
 {
@@ -186,6 +188,28 @@ public:
     //! Counts all objects implementing given interface
     int CountObjectsImplementing(ObjectInterfaceType interface);
 
+    //! Notifies the manager that object's position has changed
+    void      UpdateObjectPosition(CObject* object);
+
+    //! Returns obstacle maps of the world used for path finding
+    CNavigationGrid* GetNavigationGrid();
+
+    //! Returns all objects whose projected distance from given position is at most maxDist, in order of id
+    std::vector<CObject*> GetObjectsInRange(Math::Vector position, float maxDist);
+    //! Returns all objects whose projected distance from the segment from a to b is at most maxDist, in order of id
+    std::vector<CObject*> GetObjectsNearSegment(Math::Vector a, Math::Vector b, float maxDist);
+
+    //! Notifies the manager that object's collision reach (CObject::GetCollisionReach()) may have grown
+    void      UpdateObjectCollisionReach(CObject* object);
+    //! Recomputes the largest collision reach from scratch, called once per frame
+    void      UpdateMaxCollisionReach();
+    //! Returns upper bound of CObject::GetCollisionReach() of all objects
+    /**
+     * Objects further than this (plus own radius) from a crash sphere can't
+     * touch it, which lets collision detection look only at nearby objects.
+     */
+    float     GetMaxCollisionReach();
+
     //! Returns all objects
     CObjectContainerProxy GetAllObjects()
     {
@@ -304,9 +328,25 @@ public:
 private:
     void CleanRemovedObjectsIfNeeded();
 
+    //! Collects (distance, object) pairs matching radar() criteria, in order of id
+    void RadarSearch(std::vector<std::pair<float, CObject*>>& found,
+                     CObject* pThis,
+                     Math::Vector thisPosition,
+                     float thisAngle,
+                     const std::vector<ObjectType>& type,
+                     float angle,
+                     float focus,
+                     float minDist,
+                     float maxDist,
+                     RadarFilter filter,
+                     bool cbotTypes);
+
 private:
     CObjectMap m_objects;
     std::unique_ptr<CObjectFactory> m_objectFactory;
+    std::unique_ptr<CObjectSpatialIndex> m_spatialIndex;
+    std::unique_ptr<CNavigationGrid> m_navigationGrid;
+    float m_maxCollisionReach;
     int m_nextId;
     int m_activeObjectIterators;
     bool m_shouldCleanRemovedObjects;
@@ -0,0 +1,339 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "object/object_spatial_index.h"
+
+#include "math/func.h"
+#include "math/geometry.h"
+
+#include "object/object.h"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <limits>
+
+
+namespace
+{
+
+// Cells are tested against slightly enlarged bounds, so that float rounding
+// in the exact per-object tests can never make us skip a matching object
+const float CELL_MARGIN = 0.1f;
+const float ANGLE_MARGIN = 0.001f;
+
+// Objects with non-finite positions go to this cell, which every query visits
+const int INVALID_CELL = INT_MIN;
+
+// Largest cell coordinate we handle, keeps conversions to int well-defined
+const float MAX_COORDINATE = 1.0e8f;
+
+float SignedAngle(float angle)
+{
+    angle = Math::NormAngle(angle);
+    if (angle > Math::PI)
+        angle -= Math::PI*2.0f;
+    return angle;
+}
+
+} // anonymous namespace
+
+
+CObjectSpatialIndex::CObjectSpatialIndex(float cellSize)
+    : m_cellSize(cellSize)
+{
+    assert(cellSize > 0.0f);
+    Clear();
+}
+
+CObjectSpatialIndex::~CObjectSpatialIndex()
+{
+}
+
+void CObjectSpatialIndex::Add(CObject* object)
+{
+    assert(object != nullptr);
+    assert(m_objectCells.find(object) == m_objectCells.end());
+
+    Cell cell = GetCell(object->GetPosition());
+    m_objectCells[object] = cell;
+    AddToCell(object, cell);
+}
+
+void CObjectSpatialIndex::Remove(CObject* object)
+{
+    auto it = m_objectCells.find(object);
+    if (it == m_objectCells.end())
+        return;
+
+    RemoveFromCell(object, it->second);
+    m_objectCells.erase(it);
+}
+
+void CObjectSpatialIndex::Update(CObject* object)
+{
+    auto it = m_objectCells.find(object);
+    if (it == m_objectCells.end())
+        return;
+
+    Cell cell = GetCell(object->GetPosition());
+    if (cell.x == it->second.x && cell.z == it->second.z)
+        return;
+
+    RemoveFromCell(object, it->second);
+    AddToCell(object, cell);
+    it->second = cell;
+}
+
+void CObjectSpatialIndex::Clear()
+{
+    m_cells.clear();
+    m_objectCells.clear();
+    m_minCell = { INT_MAX, INT_MAX };
+    m_maxCell = { INT_MIN, INT_MIN };
+}
+
+std::vector<CObject*> CObjectSpatialIndex::Query(const Math::Vector& center,
+                                                 float minDist,
+                                                 float maxDist,
+                                                 float angle,
+                                                 float focus) const
+{
+    std::vector<CObject*> result;
+
+    // Comparisons with NaN never fail, so such a bound doesn't limit anything
+    if (std::isnan(minDist)) minDist = 0.0f;
+    if (std::isnan(maxDist)) maxDist = std::numeric_limits<float>::infinity();
+
+    auto invalid = m_cells.find(GetCellKey({ INVALID_CELL, INVALID_CELL }));
+    if (invalid != m_cells.end())
+        result.insert(result.end(), invalid->second.begin(), invalid->second.end());
+
+    if (maxDist >= 0.0f && minDist <= maxDist && m_minCell.x <= m_maxCell.x)
+    {
+        Cell from = GetCell(Math::Vector(center.x - maxDist, 0.0f, center.z - maxDist));
+        Cell to   = GetCell(Math::Vector(center.x + maxDist, 0.0f, center.z + maxDist));
+        if (from.x == INVALID_CELL || to.x == INVALID_CELL)  // infinite range
+        {
+            from = m_minCell;
+            to = m_maxCell;
+        }
+        from.x = std::max(from.x, m_minCell.x);
+        from.z = std::max(from.z, m_minCell.z);
+        to.x   = std::min(to.x, m_maxCell.x);
+        to.z   = std::min(to.z, m_maxCell.z);
+
+        if (from.x <= to.x && from.z <= to.z)
+        {
+            long long cellsInRange = static_cast<long long>(to.x - from.x + 1) * (to.z - from.z + 1);
+            if (cellsInRange <= static_cast<long long>(m_cells.size()))
+            {
+                for (int x = from.x; x <= to.x; ++x)
+                {
+                    for (int z = from.z; z <= to.z; ++z)
+                    {
+                        auto it = m_cells.find(GetCellKey({ x, z }));
+                        if (it == m_cells.end()) continue;
+                        if (!CellMayMatch({ x, z }, center, minDist, maxDist, angle, focus)) continue;
+                        result.insert(result.end(), it->second.begin(), it->second.end());
+                    }
+                }
+            }
+            else
+            {
+                // The range is larger than the occupied part of the world, walk the occupied cells instead
+                for (const auto& it : m_cells)
+                {
+                    if (it.second.empty()) continue;
+                    Cell cell = m_objectCells.at(it.second.front());
+                    if (cell.x < from.x || cell.x > to.x || cell.z < from.z || cell.z > to.z) continue;
+                    if (!CellMayMatch(cell, center, minDist, maxDist, angle, focus)) continue;
+                    result.insert(result.end(), it.second.begin(), it.second.end());
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](CObject* a, CObject* b) { return a->GetID() < b->GetID(); });
+    return result;
+}
+
+std::vector<CObject*> CObjectSpatialIndex::QuerySegment(const Math::Vector& a,
+                                                        const Math::Vector& b,
+                                                        float radius) const
+{
+    // A cell may contain a matching object if its center is close enough to the segment
+    float halfDiagonal = m_cellSize * 0.5f * sqrtf(2.0f) + CELL_MARGIN;
+    auto cellMayMatch = [&](Cell cell)
+    {
+        Math::Vector center((cell.x + 0.5f) * m_cellSize, 0.0f, (cell.z + 0.5f) * m_cellSize);
+        return Math::DistanceProjectedToSegment(a, b, center) <= radius + halfDiagonal;
+    };
+
+    std::vector<CObject*> result;
+
+    auto invalid = m_cells.find(GetCellKey({ INVALID_CELL, INVALID_CELL }));
+    if (invalid != m_cells.end())
+        result.insert(result.end(), invalid->second.begin(), invalid->second.end());
+
+    if (radius >= 0.0f && m_minCell.x <= m_maxCell.x)  // also skips NaN
+    {
+        Cell from = GetCell(Math::Vector(std::min(a.x, b.x) - radius, 0.0f, std::min(a.z, b.z) - radius));
+        Cell to   = GetCell(Math::Vector(std::max(a.x, b.x) + radius, 0.0f, std::max(a.z, b.z) + radius));
+        bool unbounded = (from.x == INVALID_CELL || to.x == INVALID_CELL);
+        if (unbounded)
+        {
+            from = m_minCell;
+            to = m_maxCell;
+        }
+        from.x = std::max(from.x, m_minCell.x);
+        from.z = std::max(from.z, m_minCell.z);
+        to.x   = std::min(to.x, m_maxCell.x);
+        to.z   = std::min(to.z, m_maxCell.z);
+
+        if (from.x <= to.x && from.z <= to.z)
+        {
+            long long cellsInRange = static_cast<long long>(to.x - from.x + 1) * (to.z - from.z + 1);
+            if (!unbounded && cellsInRange <= static_cast<long long>(m_cells.size()))
+            {
+                for (int x = from.x; x <= to.x; ++x)
+                {
+                    for (int z = from.z; z <= to.z; ++z)
+                    {
+                        if (!cellMayMatch({ x, z })) continue;
+                        auto it = m_cells.find(GetCellKey({ x, z }));
+                        if (it == m_cells.end()) continue;
+                        result.insert(result.end(), it->second.begin(), it->second.end());
+                    }
+                }
+            }
+            else
+            {
+                for (const auto& it : m_cells)
+                {
+                    if (it.second.empty()) continue;
+                    Cell cell = m_objectCells.at(it.second.front());
+                    if (cell.x < from.x || cell.x > to.x || cell.z < from.z || cell.z > to.z) continue;
+                    if (!unbounded && !cellMayMatch(cell)) continue;
+                    result.insert(result.end(), it.second.begin(), it.second.end());
+                }
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](CObject* first, CObject* second) { return first->GetID() < second->GetID(); });
+    return result;
+}
+
+CObjectSpatialIndex::Cell CObjectSpatialIndex::GetCell(const Math::Vector& pos) const
+{
+    float x = std::floor(pos.x / m_cellSize);
+    float z = std::floor(pos.z / m_cellSize);
+
+    // Also catches NaN
+    if (!(std::fabs(x) <= MAX_COORDINATE && std::fabs(z) <= MAX_COORDINATE))
+        return { INVALID_CELL, INVALID_CELL };
+
+    return { static_cast<int>(x), static_cast<int>(z) };
+}
+
+long long CObjectSpatialIndex::GetCellKey(Cell cell) const
+{
+    return (static_cast<long long>(cell.x) << 32) | static_cast<unsigned int>(cell.z);
+}
+
+void CObjectSpatialIndex::AddToCell(CObject* object, Cell cell)
+{
+    m_cells[GetCellKey(cell)].push_back(object);
+
+    if (cell.x == INVALID_CELL)
+        return;
+
+    m_minCell.x = std::min(m_minCell.x, cell.x);
+    m_minCell.z = std::min(m_minCell.z, cell.z);
+    m_maxCell.x = std::max(m_maxCell.x, cell.x);
+    m_maxCell.z = std::max(m_maxCell.z, cell.z);
+}
+
+void CObjectSpatialIndex::RemoveFromCell(CObject* object, Cell cell)
+{
+    auto it = m_cells.find(GetCellKey(cell));
+    assert(it != m_cells.end());
+
+    std::vector<CObject*>& objects = it->second;
+    auto objIt = std::find(objects.begin(), objects.end(), object);
+    assert(objIt != objects.end());
+    *objIt = objects.back();
+    objects.pop_back();
+
+    if (objects.empty())
+        m_cells.erase(it);
+}
+
+bool CObjectSpatialIndex::CellMayMatch(Cell cell, const Math::Vector& center,
+                                       float minDist, float maxDist,
+                                       float angle, float focus) const
+{
+    float x0 = cell.x * m_cellSize - CELL_MARGIN;
+    float z0 = cell.z * m_cellSize - CELL_MARGIN;
+    float x1 = (cell.x + 1) * m_cellSize + CELL_MARGIN;
+    float z1 = (cell.z + 1) * m_cellSize + CELL_MARGIN;
+
+    // Distance ring
+    float nearX = std::max(std::max(x0 - center.x, center.x - x1), 0.0f);
+    float nearZ = std::max(std::max(z0 - center.z, center.z - z1), 0.0f);
+    if (nearX*nearX + nearZ*nearZ > maxDist*maxDist)
+        return false;
+
+    float farX = std::max(std::fabs(center.x - x0), std::fabs(center.x - x1));
+    float farZ = std::max(std::fabs(center.z - z0), std::fabs(center.z - z1));
+    if (minDist > 0.0f && farX*farX + farZ*farZ < minDist*minDist)
+        return false;
+
+    // Direction cone, only for narrow cones and cells not containing the origin
+    if (focus < 0.0f || focus >= Math::PI)
+        return true;
+    if (nearX == 0.0f && nearZ == 0.0f)
+        return true;
+
+    // Angles are measured the same way as in CObjectManager::RadarAll() (clockwise)
+    float reference = Math::RotateAngle((x0 + x1) / 2.0f - center.x, center.z - (z0 + z1) / 2.0f);
+    float spanMin = 0.0f;
+    float spanMax = 0.0f;
+    const float cornersX[4] = { x0, x1, x0, x1 };
+    const float cornersZ[4] = { z0, z0, z1, z1 };
+    for (int i = 0; i < 4; ++i)
+    {
+        float a = Math::RotateAngle(cornersX[i] - center.x, center.z - cornersZ[i]);
+        float delta = SignedAngle(a - reference);
+        spanMin = std::min(spanMin, delta);
+        spanMax = std::max(spanMax, delta);
+    }
+
+    float offset = SignedAngle(angle - reference);
+    for (float shift : { -Math::PI*2.0f, 0.0f, Math::PI*2.0f })
+    {
+        float coneMin = offset + shift - focus/2.0f - ANGLE_MARGIN;
+        float coneMax = offset + shift + focus/2.0f + ANGLE_MARGIN;
+        if (coneMin <= spanMax && coneMax >= spanMin)
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,105 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file object/object_spatial_index.h
+ * \brief Uniform grid of objects used to speed up radar-like queries
+ */
+
+#pragma once
+
+#include "math/const.h"
+#include "math/vector.h"
+
+#include <unordered_map>
+#include <vector>
+
+class CObject;
+
+/**
+ * \class CObjectSpatialIndex
+ * \brief Uniform grid over the XZ plane holding all objects of the world
+ *
+ * Objects are bucketed by the projected position of their main part. The index
+ * only has to be told when an object appears, moves or disappears; queries then
+ * visit just the cells overlapping the requested distance ring and direction cone.
+ *
+ * Queries are conservative: they return every object that may satisfy the criteria
+ * (and possibly some that don't), so callers still have to do their exact tests.
+ */
+class CObjectSpatialIndex
+{
+public:
+    explicit CObjectSpatialIndex(float cellSize = 40.0f);
+    ~CObjectSpatialIndex();
+
+    //! Adds object to the index at its current position
+    void Add(CObject* object);
+    //! Removes object from the index
+    void Remove(CObject* object);
+    //! Moves object to the cell matching its current position; ignores unknown objects
+    void Update(CObject* object);
+    //! Removes all objects
+    void Clear();
+
+    //! Returns objects which may be in the given distance ring and direction cone, sorted by id
+    /**
+     * \param center   origin of the query, only x and z are used
+     * \param minDist  inner radius of the ring
+     * \param maxDist  outer radius of the ring
+     * \param angle    direction of the cone, clockwise like in CObjectManager::RadarAll()
+     * \param focus    opening angle of the cone, values >= 2*PI mean no cone
+     */
+    std::vector<CObject*> Query(const Math::Vector& center,
+                                float minDist,
+                                float maxDist,
+                                float angle = 0.0f,
+                                float focus = Math::PI*2.0f) const;
+
+    //! Returns objects which may be within given projected distance of the segment from a to b, sorted by id
+    /** Only the cells along the segment are visited, so long segments are cheap as long as radius is small */
+    std::vector<CObject*> QuerySegment(const Math::Vector& a,
+                                       const Math::Vector& b,
+                                       float radius) const;
+
+private:
+    struct Cell
+    {
+        int x;
+        int z;
+    };
+
+    Cell      GetCell(const Math::Vector& pos) const;
+    long long GetCellKey(Cell cell) const;
+    void      AddToCell(CObject* object, Cell cell);
+    void      RemoveFromCell(CObject* object, Cell cell);
+    bool      CellMayMatch(Cell cell, const Math::Vector& center,
+                           float minDist, float maxDist,
+                           float angle, float focus) const;
+
+private:
+    float m_cellSize;
+    //! Objects in each non-empty cell
+    std::unordered_map<long long, std::vector<CObject*>> m_cells;
+    //! Cell each indexed object is currently in
+    std::unordered_map<CObject*, Cell> m_objectCells;
+    //! Bounds of all cells ever used since last Clear()
+    Cell m_minCell;
+    Cell m_maxCell;
+};
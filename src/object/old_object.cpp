@@ -66,6 +66,8 @@
 #include "ui/controls/edit.h"
 
 #include <boost/lexical_cast.hpp>
+
+#include <algorithm>
 #include <iomanip>
 
 
@@ -1204,6 +1206,23 @@ void COldObject::TransformCrashSphere(Math::Sphere& crashSphere)
     crashSphere.pos = Math::Transform(m_objectPart[0].matWorld, crashSphere.pos);
 }
 
+void COldObject::PrepareCrashSphereTransform()
+{
+    // Same condition as in TransformCrashSphere()
+    if (m_crashSpheres.size() == 1 &&
+        m_crashSpheres[0].sphere.pos.x == 0.0f &&
+        m_crashSpheres[0].sphere.pos.z == 0.0f )
+    {
+        return;  // the world matrix isn't used
+    }
+
+    if (m_objectPart[0].bTranslate ||
+        m_objectPart[0].bRotate)
+    {
+        UpdateTransformObject();
+    }
+}
+
 void COldObject::TransformCameraCollisionSphere(Math::Sphere& collisionSphere)
 {
     collisionSphere.pos = Math::Transform(m_objectPart[0].matWorld, collisionSphere.pos);
@@ -1217,6 +1236,7 @@ void COldObject::SetJostlingSphere(const Math::Sphere& jostlingSphere)
 {
     m_jostlingSphere = jostlingSphere;
     m_implementedInterfaces[static_cast<int>(ObjectInterfaceType::Jostleable)] = true;
+    UpdateCollisionReach();
 }
 
 // Specifies the sphere of jostling, in the world.
@@ -1228,6 +1248,28 @@ Math::Sphere COldObject::GetJostlingSphere() const
     return transformedJostlingSphere;
 }
 
+// Bounds the distance of crash spheres and jostling sphere from the position,
+// following what TransformCrashSphere() and the world matrix do with them.
+
+float COldObject::GetCollisionReach()
+{
+    if ( !m_objectPart[0].bUsed )  return 0.0f;  // not created yet
+
+    const Math::Vector& zoom = m_objectPart[0].zoom;
+    float maxZoom = Math::Max(fabs(zoom.x), fabs(zoom.y), fabs(zoom.z));
+
+    float reach = 0.0f;
+    for (const auto& crashSphere : m_crashSpheres)
+    {
+        reach = Math::Max(reach, crashSphere.sphere.pos.Length()*maxZoom + crashSphere.sphere.radius*fabs(GetScaleX()));
+    }
+    if (Implements(ObjectInterfaceType::Jostleable))
+    {
+        reach = Math::Max(reach, m_jostlingSphere.pos.Length()*maxZoom + m_jostlingSphere.radius);
+    }
+    return reach + m_linVibration.Length();
+}
+
 
 // Positioning an object on a certain height, above the ground.
 
@@ -1246,6 +1288,7 @@ void COldObject::SetFloorHeight(float height)
 
     m_objectPart[0].position.y = pos.y+height+m_character.height;
     m_objectPart[0].bTranslate = true;  // it will recalculate the matrices
+    InvalidateCrashSpheres();
 }
 
 // Adjust the inclination of an object laying on the ground.
@@ -1277,6 +1320,7 @@ void COldObject::SetLinVibration(Math::Vector dir)
     {
         m_linVibration = dir;
         m_objectPart[0].bTranslate = true;
+        UpdateCollisionReach();
     }
 }
 
@@ -1329,6 +1373,15 @@ void COldObject::SetPartPosition(int part, const Math::Vector &pos)
     m_objectPart[part].position = pos;
     m_objectPart[part].bTranslate = true;  // it will recalculate the matrices
 
+    if ( part == 0 )
+    {
+        InvalidateCrashSpheres();
+
+        CObjectManager* objectManager = CObjectManager::GetInstancePointer();
+        if ( objectManager != nullptr )
+            objectManager->UpdateObjectPosition(this);
+    }
+
     if ( part == 0 && !m_bFlat )  // main part?
     {
         int rank = m_objectPart[0].object;
@@ -1435,6 +1488,12 @@ void COldObject::SetPartScale(int part, float zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )
+    {
+        InvalidateCrashSpheres();
+        UpdateCollisionReach();
+    }
 }
 
 void COldObject::SetPartScale(int part, Math::Vector zoom)
@@ -1445,6 +1504,12 @@ void COldObject::SetPartScale(int part, Math::Vector zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )
+    {
+        InvalidateCrashSpheres();
+        UpdateCollisionReach();
+    }
 }
 
 Math::Vector COldObject::GetPartScale(int part) const
@@ -1460,6 +1525,12 @@ void COldObject::SetPartScaleX(int part, float zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )
+    {
+        InvalidateCrashSpheres();
+        UpdateCollisionReach();
+    }
 }
 
 void COldObject::SetPartScaleY(int part, float zoom)
@@ -1470,6 +1541,12 @@ void COldObject::SetPartScaleY(int part, float zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )
+    {
+        InvalidateCrashSpheres();
+        UpdateCollisionReach();
+    }
 }
 
 void COldObject::SetPartScaleZ(int part, float zoom)
@@ -1480,6 +1557,12 @@ void COldObject::SetPartScaleZ(int part, float zoom)
     m_objectPart[part].bZoom = ( m_objectPart[part].zoom.x != 1.0f ||
                                  m_objectPart[part].zoom.y != 1.0f ||
                                  m_objectPart[part].zoom.z != 1.0f );
+
+    if ( part == 0 )
+    {
+        InvalidateCrashSpheres();
+        UpdateCollisionReach();
+    }
 }
 
 float COldObject::GetPartScaleX(int part)
@@ -1761,6 +1844,7 @@ bool COldObject::UpdateTransformObject(int part, bool bForceUpdate)
          m_objectPart[part].bRotate    )
     {
         parent = m_objectPart[part].parentPart;
+        Math::Matrix oldWorld = m_objectPart[part].matWorld;
 
         if ( part == 0 && m_transporter != nullptr )  // transported by a transporter?
         {
@@ -1782,6 +1866,12 @@ bool COldObject::UpdateTransformObject(int part, bool bForceUpdate)
             }
         }
         bModif = true;
+
+        if ( part == 0 &&
+             !std::equal(oldWorld.m, oldWorld.m+16, m_objectPart[part].matWorld.m) )
+        {
+            InvalidateCrashSpheres();  // crash spheres moved
+        }
     }
 
     if ( bModif )
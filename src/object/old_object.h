@@ -211,6 +211,8 @@ public:
     void        SetTransparency(float value) override;
 
     Math::Sphere GetJostlingSphere() const override;
+
+    float       GetCollisionReach() override;
     bool        JostleObject(float force) override;
 
     void        SetVirusMode(bool bEnable) override;
@@ -303,6 +305,7 @@ protected:
     bool        UpdateTransformObject();
     void        UpdateSelectParticle();
     void        TransformCrashSphere(Math::Sphere &crashSphere) override;
+    void        PrepareCrashSphereTransform() override;
     void TransformCameraCollisionSphere(Math::Sphere& collisionSphere) override;
 
     /**
@@ -0,0 +1,36 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#pragma once
+
+#include <string>
+
+//! Algorithm used by goto() to find a path around obstacles (see CTaskGoto)
+enum class PathPlannerType : unsigned int
+{
+    //! Recursive beam search, the original algorithm
+    Beam = 0,
+    //! A* search over the cells of the navigation grid
+    Grid,
+};
+
+//! Returns planner with given name ("beam" or "astar"), or the default if the name is unknown
+PathPlannerType ParsePathPlannerType(const std::string& name, PathPlannerType defaultType);
+//! Returns the name of the planner, as used by ParsePathPlannerType()
+std::string GetPathPlannerName(PathPlannerType type);
@@ -0,0 +1,339 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "object/path_search.h"
+
+#include "math/func.h"
+#include "math/geometry.h"
+
+#include "object/navigation_grid.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+
+namespace
+{
+
+//! Number of iterations between two reports of the progress to the main thread
+const int PROGRESS_STEP = 256;
+
+int GetCell(float coord)
+{
+    return static_cast<int>((coord+1600.0f)/NAVIGATION_CELL_SIZE);
+}
+
+float GetCellCenter(int cell)
+{
+    return (cell+0.5f)*NAVIGATION_CELL_SIZE-1600.0f;
+}
+
+} // anonymous namespace
+
+
+CNavigationSnapshot::CNavigationSnapshot(int minX, int minY, int maxX, int maxY)
+    : m_minX(minX),
+      m_minY(minY),
+      m_width(maxX-minX+1),
+      m_height(maxY-minY+1),
+      m_blocked(m_width*m_height, false)
+{
+}
+
+CNavigationSnapshot::~CNavigationSnapshot()
+{
+}
+
+void CNavigationSnapshot::SetBlocked(int x, int y)
+{
+    m_blocked[(x-m_minX)+(y-m_minY)*m_width] = true;
+}
+
+bool CNavigationSnapshot::TestLine(const Math::Vector& start, const Math::Vector& goal) const
+{
+    float dist = Math::DistanceProjected(start, goal);
+    if (dist == 0.0f) return true;
+    float step = NAVIGATION_CELL_SIZE*0.5f;
+
+    Math::Vector inc;
+    inc.x = (goal.x-start.x)*step/dist;
+    inc.z = (goal.z-start.z)*step/dist;
+
+    Math::Vector pos = start;
+    int max = static_cast<int>(dist/step);
+    if (max == 0) max = 1;
+    for (int i = 0; i < max; i++)
+    {
+        if (i == max-1)
+        {
+            pos = goal;  // tests the point of arrival
+        }
+        else
+        {
+            pos.x += inc.x;
+            pos.z += inc.z;
+        }
+
+        if (IsBlocked(GetCell(pos.x), GetCell(pos.z))) return false;
+    }
+    return true;
+}
+
+
+CPathSearch::CPathSearch(std::shared_ptr<const CNavigationSnapshot> snapshot,
+                         const Math::Vector& start, const Math::Vector& goal,
+                         float goalRadius, int maxIterations)
+    : m_snapshot(std::move(snapshot)),
+      m_start(start),
+      m_goal(goal),
+      m_goalRadius(goalRadius),
+      m_maxIterations(maxIterations),
+      m_goalX(GetCell(goal.x)),
+      m_goalY(GetCell(goal.z)),
+      m_cancel(false)
+{
+}
+
+CPathSearch::~CPathSearch()
+{
+}
+
+void CPathSearch::Run()
+{
+    int iterations = 0;
+    Error result = Search(iterations);
+
+    // Frees the memory now, the search may be kept around for a while
+    std::vector<OpenCell>().swap(m_open);
+    std::vector<float>().swap(m_length);
+    std::vector<int>().swap(m_parent);
+    std::vector<bool>().swap(m_closed);
+
+    m_mutex.Lock();
+    m_result = result;
+    m_iterations = iterations;
+    m_done = true;
+    m_cond.Signal();
+    m_mutex.Unlock();
+}
+
+void CPathSearch::Cancel()
+{
+    m_cancel = true;
+}
+
+bool CPathSearch::WaitForProgress(int iterations)
+{
+    m_mutex.Lock();
+    while (!m_done && m_iterations < iterations)
+    {
+        m_cond.Wait(*m_mutex);
+    }
+    bool done = m_done && m_iterations <= iterations;
+    m_mutex.Unlock();
+    return done;
+}
+
+Error CPathSearch::GetResult() const
+{
+    return m_result;
+}
+
+bool CPathSearch::HasReachedBorder() const
+{
+    return m_reachedBorder;
+}
+
+const std::vector<Math::Vector>& CPathSearch::GetPoints() const
+{
+    return m_points;
+}
+
+void CPathSearch::SetProgress(int iterations)
+{
+    m_mutex.Lock();
+    m_iterations = iterations;
+    m_cond.Signal();
+    m_mutex.Unlock();
+}
+
+Error CPathSearch::Search(int& iterations)
+{
+    static const int   dx[8]   = { 1, -1,  0,  0,  1,  1, -1, -1 };
+    static const int   dy[8]   = { 0,  0,  1, -1,  1, -1,  1, -1 };
+    static const float cost[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f };
+
+    // The heap keeps the cell with the lowest f on top, the farthest from the start on equality
+    auto compare = [](const OpenCell& a, const OpenCell& b)
+    {
+        if (a.f != b.f) return a.f > b.f;
+        if (a.g != b.g) return a.g < b.g;
+        return a.cell > b.cell;
+    };
+
+    const CNavigationSnapshot& snapshot = *m_snapshot;
+    int minX = snapshot.GetMinX();
+    int minY = snapshot.GetMinY();
+    int width = snapshot.GetWidth();
+    int height = snapshot.GetHeight();
+
+    m_length.assign(width*height, -1.0f);
+    m_parent.assign(width*height, -1);
+    m_closed.assign(width*height, false);
+
+    int startX = GetCell(m_start.x);
+    int startY = GetCell(m_start.z);
+    if (startX < minX || startX >= minX+width ||
+        startY < minY || startY >= minY+height) return ERR_GOTO_IMPOSSIBLE;
+
+    int startCell = (startX-minX)+(startY-minY)*width;
+    m_length[startCell] = 0.0f;
+    m_open.push_back(OpenCell{Estimate(startX, startY), 0.0f, startCell});
+
+    while (!m_open.empty())
+    {
+        std::pop_heap(m_open.begin(), m_open.end(), compare);
+        OpenCell current = m_open.back();
+        m_open.pop_back();
+
+        if (m_closed[current.cell]) continue;  // already explored?
+
+        // Only explored cells count as iterations. Only iterations already
+        // done are reported, so a search reported with n iterations will
+        // always end with more than n
+        if (iterations % PROGRESS_STEP == 0 && iterations > 0)
+        {
+            if (m_cancel) return ERR_GOTO_IMPOSSIBLE;
+            SetProgress(iterations);
+        }
+        iterations++;
+        if (iterations > m_maxIterations) return ERR_GOTO_ITER;
+
+        m_closed[current.cell] = true;
+
+        int x = current.cell%width + minX;
+        int y = current.cell/width + minY;
+
+        Math::Vector pos;
+        if (current.cell == startCell)
+        {
+            pos = m_start;
+        }
+        else
+        {
+            pos.x = GetCellCenter(x);
+            pos.z = GetCellCenter(y);
+        }
+
+        float dist = Math::DistanceProjected(pos, m_goal)-m_goalRadius;
+        if (dist <= NAVIGATION_CELL_SIZE*1.5f)  // close to the goal?
+        {
+            Math::Vector last = pos;
+            if (m_goalRadius == 0.0f)
+            {
+                last = m_goal;
+            }
+            else if (dist > 0.0f)
+            {
+                float total = Math::DistanceProjected(pos, m_goal);
+                last.x = pos.x + (m_goal.x-pos.x)*dist/total;
+                last.z = pos.z + (m_goal.z-pos.z)*dist/total;
+            }
+            if (snapshot.TestLine(pos, last))
+            {
+                MakePath(current.cell, last);
+                return ERR_OK;
+            }
+        }
+
+        for (int i = 0; i < 8; i++)
+        {
+            int nx = x+dx[i];
+            int ny = y+dy[i];
+            if (!IsFree(nx, ny))
+            {
+                if (nx >= 0 && nx < NAVIGATION_GRID_SIZE && ny >= 0 && ny < NAVIGATION_GRID_SIZE &&
+                    (nx < minX || nx >= minX+width || ny < minY || ny >= minY+height))
+                    m_reachedBorder = true;  // blocked only by the end of the snapshot?
+                continue;
+            }
+            if (i >= 4 && (!IsFree(nx, y) || !IsFree(x, ny))) continue;  // don't cut corners
+
+            int next = (nx-minX)+(ny-minY)*width;
+            if (m_closed[next]) continue;
+
+            float g = current.g + cost[i]*NAVIGATION_CELL_SIZE;
+            if (m_length[next] >= 0.0f && m_length[next] <= g) continue;
+
+            m_length[next] = g;
+            m_parent[next] = current.cell;
+            m_open.push_back(OpenCell{g+Estimate(nx, ny), g, next});
+            std::push_heap(m_open.begin(), m_open.end(), compare);
+        }
+    }
+
+    return ERR_GOTO_IMPOSSIBLE;
+}
+
+// Octile distance to the goal, never more than the real length
+float CPathSearch::Estimate(int x, int y) const
+{
+    float ax = static_cast<float>(abs(x-m_goalX));
+    float ay = static_cast<float>(abs(y-m_goalY));
+    float h = (Math::Max(ax, ay) + (1.41421356f-1.0f)*Math::Min(ax, ay))*NAVIGATION_CELL_SIZE
+            - m_goalRadius - NAVIGATION_CELL_SIZE*2.0f;
+    return Math::Max(h, 0.0f);
+}
+
+bool CPathSearch::IsFree(int x, int y) const
+{
+    return !m_snapshot->IsBlocked(x, y);
+}
+
+// Makes the list of points from the cells found by the search,
+// skipping all the points which can be reached in straight line
+void CPathSearch::MakePath(int cell, const Math::Vector& last)
+{
+    const CNavigationSnapshot& snapshot = *m_snapshot;
+    int width = snapshot.GetWidth();
+
+    std::vector<Math::Vector> path;
+    path.push_back(last);
+    for (; m_parent[cell] != -1; cell = m_parent[cell])
+    {
+        Math::Vector pos;
+        pos.x = GetCellCenter(cell%width + snapshot.GetMinX());
+        pos.z = GetCellCenter(cell/width + snapshot.GetMinY());
+        path.push_back(pos);
+    }
+    path.push_back(m_start);
+    std::reverse(path.begin(), path.end());
+
+    m_points.clear();
+    m_points.push_back(path[0]);
+    int anchor = 0;
+    for (int i = 1; i < static_cast<int>(path.size()); i++)
+    {
+        if (i < static_cast<int>(path.size())-1 &&
+            snapshot.TestLine(path[anchor], path[i+1])) continue;
+
+        m_points.push_back(path[i]);
+        anchor = i;
+    }
+}
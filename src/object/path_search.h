@@ -0,0 +1,157 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file object/path_search.h
+ * \brief Path search run on a frozen copy of the navigation grid
+ */
+
+#pragma once
+
+#include "common/error.h"
+
+#include "common/thread/sdl_cond_wrapper.h"
+#include "common/thread/sdl_mutex_wrapper.h"
+
+#include "math/vector.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+
+/**
+ * \class CNavigationSnapshot
+ * \brief Cells blocked for one robot in a rectangle of the navigation grid
+ *
+ * Filled on the main thread before the search starts (see CTaskGoto::GridSnapshotFill())
+ * and never changed afterwards, so it can be read by a worker thread while
+ * the world goes on. Cells outside the rectangle are blocked.
+ */
+class CNavigationSnapshot
+{
+public:
+    CNavigationSnapshot(int minX, int minY, int maxX, int maxY);
+    ~CNavigationSnapshot();
+
+    int GetMinX() const { return m_minX; }
+    int GetMinY() const { return m_minY; }
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+    //! Marks a cell as blocked, only used while making the snapshot
+    void SetBlocked(int x, int y);
+    //! Returns true if the robot can't go through the cell
+    bool IsBlocked(int x, int y) const
+    {
+        x -= m_minX;
+        y -= m_minY;
+        if (x < 0 || x >= m_width ||
+            y < 0 || y >= m_height) return true;
+        return m_blocked[x+y*m_width];
+    }
+
+    //! Tests if a path along a straight line is possible, same as CTaskGoto::BitmapTestLine()
+    bool TestLine(const Math::Vector& start, const Math::Vector& goal) const;
+
+private:
+    int m_minX;
+    int m_minY;
+    int m_width;
+    int m_height;
+    std::vector<bool> m_blocked;
+};
+
+/**
+ * \class CPathSearch
+ * \brief A* search from start to goal over the cells of a snapshot
+ *
+ * The search is run with Run(), usually on a worker thread, while the main
+ * thread checks its progress with WaitForProgress() once per frame.
+ *
+ * The result only depends on the snapshot and the given points. The search
+ * is considered done at the frame where a synchronous search with the same
+ * budget of iterations per frame would have finished, so the game goes on
+ * exactly the same way whatever the speed of the worker.
+ */
+class CPathSearch
+{
+public:
+    CPathSearch(std::shared_ptr<const CNavigationSnapshot> snapshot,
+                const Math::Vector& start, const Math::Vector& goal,
+                float goalRadius, int maxIterations);
+    ~CPathSearch();
+
+    //! Runs the whole search
+    void Run();
+    //! Asks a running search to stop as soon as possible
+    void Cancel();
+
+    //! Waits until the search is done or has run given number of iterations
+    /** \return true if the search was done within given number of iterations */
+    bool WaitForProgress(int iterations);
+
+    //! Returns ERR_OK if a path was found, ERR_GOTO_IMPOSSIBLE or ERR_GOTO_ITER otherwise
+    Error GetResult() const;
+    //! Returns true if the search was stopped by the border of the snapshot, not only by obstacles
+    /** A search without path could then find one with a bigger snapshot */
+    bool HasReachedBorder() const;
+    //! Returns the points of the path, starting with the start point
+    const std::vector<Math::Vector>& GetPoints() const;
+
+private:
+    struct OpenCell
+    {
+        float   f;      // estimated length of the whole path
+        float   g;      // length from the start
+        int     cell;
+    };
+
+    Error Search(int& iterations);
+    float Estimate(int x, int y) const;
+    bool IsFree(int x, int y) const;
+    void MakePath(int cell, const Math::Vector& last);
+    void SetProgress(int iterations);
+
+private:
+    std::shared_ptr<const CNavigationSnapshot> m_snapshot;
+    Math::Vector m_start;
+    Math::Vector m_goal;
+    float m_goalRadius;
+    int m_maxIterations;
+    int m_goalX;
+    int m_goalY;
+
+    // Search state, only used by the thread running the search
+    std::vector<OpenCell> m_open;       // heap of cells to explore
+    std::vector<float> m_length;        // shortest known length from the start, negative if not reached
+    std::vector<int> m_parent;          // previous cell on the path, -1 for the start
+    std::vector<bool> m_closed;         // cells already explored
+
+    // Read by the main thread once the search is done
+    Error m_result = ERR_CONTINUE;
+    bool m_reachedBorder = false;
+    std::vector<Math::Vector> m_points;
+
+    CSDLMutexWrapper m_mutex;
+    CSDLCondWrapper m_cond;
+    int m_iterations = 0;
+    bool m_done = false;
+    std::atomic<bool> m_cancel;
+};
@@ -25,13 +25,19 @@
 #include "common/image.h"
 #include "common/make_unique.h"
 
+#include "common/thread/worker_pool.h"
+
 #include "graphics/engine/terrain.h"
 #include "graphics/engine/water.h"
 
+#include "level/robotmain.h"
+
 #include "math/geometry.h"
 
+#include "object/navigation_grid.h"
 #include "object/object_manager.h"
 #include "object/old_object.h"
+#include "object/path_search.h"
 
 #include "object/interface/transportable_object.h"
 
@@ -39,6 +45,7 @@
 
 #include "physics/physics.h"
 
+#include <algorithm>
 #include <string.h>
 
 
@@ -46,11 +53,17 @@ const float FLY_DIST_GROUND = 80.0f;    // minimum distance to remain on the gro
 const float FLY_DEF_HEIGHT  = 50.0f;    // default flying height
 
 // Settings that define goto() accuracy:
-const float BM_DIM_STEP     = 5.0f;     // Size of one pixel on the bitmap. Setting 5 means that 5x5 square (in game units) will be represented by 1 px on the bitmap. Decreasing this value will make a bigger bitmap, and may increase accuracy. TODO: Check how it actually impacts goto() accuracy
+const float BM_DIM_STEP     = NAVIGATION_CELL_SIZE;     // Size of one pixel on the bitmap. TODO: Check how it actually impacts goto() accuracy
 const float BEAM_ACCURACY   = 5.0f;    // higher value = more accurate, but slower
 const float SAFETY_MARGIN   = 0.5f;     // Smallest distance between two objects. Smaller = less "no route to destination", but higher probability of collisions between objects.
 // Changing SAFETY_MARGIN (old value was 4.0f) seems to have fixed many issues with goto(). TODO: maybe we could make it even smaller? Did changing it introduce any new bugs?
 
+// Settings of the A* planner (PathPlannerType::Grid):
+const int   GRID_ITER       = 2000;     // cells explored per frame, the search is ready when a search on the main thread would be
+const int   GRID_MAX_CELLS  = 100000;   // gives up (ERR_GOTO_ITER) after exploring that many cells
+const int   GRID_MARGIN     = 64;       // cells around start and goal included in the first snapshot of the grid, doubled while the search is stopped by its border
+const int   GRID_SNAPSHOT_CELLS = 32768;    // cells of the grid copied into the snapshot per frame
+
 
 
 
@@ -65,6 +78,7 @@ CTaskGoto::CTaskGoto(COldObject* object) : CForegroundTask(object)
 
 CTaskGoto::~CTaskGoto()
 {
+    if ( m_pathSearch != nullptr )  m_pathSearch->Cancel();
     BitmapClose();
 
     if (m_engine->GetDebugGoto() && m_object->GetSelect())
@@ -220,7 +234,7 @@ bool CTaskGoto::EventProcess(const Event &event)
             if ( m_bmCargoObject->GetType() == OBJECT_BASE )  dist = 12.0f;
         }
 
-        ret = BeamSearch(pos, goal, dist);
+        ret = PathSearch(pos, goal, dist);
         if ( ret == ERR_OK )
         {
             if ( m_physics->GetLand() )  m_phase = TGP_BEAMWCOLD;
@@ -656,6 +670,7 @@ Error CTaskGoto::Start(Math::Vector goal, float altitude,
     int         x, y;
 
     type = m_object->GetType();
+    m_planner = m_main->GetMissionPathPlanner();
 
     if ( goalMode == TGG_DEFAULT )
     {
@@ -1095,7 +1110,7 @@ CObject* CTaskGoto::SearchTarget(Math::Vector pos, float margin)
 
     CObject* pBest = nullptr;
     float min = 1000000.0f;
-    for ( CObject* pObj : CObjectManager::GetInstancePointer()->GetAllObjects() )
+    for ( CObject* pObj : CObjectManager::GetInstancePointer()->GetObjectsInRange(pos, margin) )
     {
         if ( !pObj->GetActive() )  continue;
         if ( IsObjectBeingTransported(pObj) )  continue;  // object transtorted?
@@ -1355,6 +1370,50 @@ bool CTaskGoto::GetHotPoint(CObject *pObj, Math::Vector &pos,
 }
 
 
+// Finds a path to the goal without moving the robot.
+// Runs the search for as many frames as it would take in the game.
+
+Error CTaskGoto::ComputePath(Math::Vector goal, PathPlannerType planner, int &frames, float &length)
+{
+    const int   maxFrames = 1000;
+    int         x, y, i;
+    Error       ret;
+
+    frames = 0;
+    length = 0.0f;
+
+    m_goal = goal;
+    m_goalObject = goal;
+    m_altitude = 0.0f;
+    m_bmCargoObject = nullptr;
+    m_planner = planner;
+
+    BitmapOpen();
+    BeamInit();
+
+    x = static_cast<int>((m_goal.x+1600.0f)/BM_DIM_STEP);
+    y = static_cast<int>((m_goal.z+1600.0f)/BM_DIM_STEP);
+    if ( BitmapTestDot(0, x, y) )  return ERR_GOTO_BUSY;  // arrival occupied?
+
+    BitmapClearCircle(m_object->GetPosition(), BM_DIM_STEP*1.8f);
+
+    do
+    {
+        ret = PathSearch(m_object->GetPosition(), m_goal, 0.0f);
+        frames ++;
+    }
+    while ( ret == ERR_CONTINUE && frames < maxFrames );
+
+    if ( ret == ERR_CONTINUE )  return ERR_GOTO_ITER;
+    if ( ret != ERR_OK )  return ret;
+
+    for ( i=1 ; i<=m_bmTotal ; i++ )
+    {
+        length += Math::DistanceProjected(m_bmPoints[i-1], m_bmPoints[i]);
+    }
+    return ERR_OK;
+}
+
 // Seeks an object too close that he must flee.
 
 bool CTaskGoto::LeakSearch(Math::Vector &pos, float &delay)
@@ -1624,20 +1683,7 @@ int CTaskGoto::BeamShortcut()
 
 void CTaskGoto::BeamStart()
 {
-    Math::Vector    min, max;
-
     BitmapOpen();
-    BitmapObject();
-
-    min = m_object->GetPosition();
-    max = m_goal;
-    if ( min.x > max.x )  Math::Swap(min.x, max.x);
-    if ( min.z > max.z )  Math::Swap(min.z, max.z);
-    min.x -= 10.0f*BM_DIM_STEP;
-    min.z -= 10.0f*BM_DIM_STEP;
-    max.x += 10.0f*BM_DIM_STEP;
-    max.z += 10.0f*BM_DIM_STEP;
-    BitmapTerrain(min, max);
 
     if ( LeakSearch(m_leakPos, m_leakDelay) )
     {
@@ -1664,6 +1710,26 @@ void CTaskGoto::BeamInit()
         m_bmIter[i] = -1;
     }
     m_bmStep = 0;
+
+    if ( m_pathSearch != nullptr )
+    {
+        m_pathSearch->Cancel();
+        m_pathSearch.reset();
+    }
+    m_gridSnapshot.reset();
+}
+
+// Calculates points and passes to go from start to goal,
+// with the planner chosen by the mission.
+
+Error CTaskGoto::PathSearch(const Math::Vector &start, const Math::Vector &goal,
+                            float goalRadius)
+{
+    if ( m_planner == PathPlannerType::Grid )
+    {
+        return GridSearch(start, goal, goalRadius);
+    }
+    return BeamSearch(start, goal, goalRadius);
 }
 
 // Calculates points and passes to go from start to goal.
@@ -1809,6 +1875,115 @@ Math::Vector CTaskGoto::BeamPoint(const Math::Vector &startPoint,
     return resPoint;
 }
 
+// Calculates points and passes to go from start to goal with an A* search
+// over the cells of the bitmap. Gives a shortest path moving between
+// neighbouring cells, simplified by skipping the points which can be
+// reached in straight line.
+// The search runs on a worker thread, with a snapshot of the bitmap around
+// start and goal. The snapshot is copied over as many frames as needed and
+// made bigger step by step while the search is stopped by its border.
+
+Error CTaskGoto::GridSearch(const Math::Vector &start, const Math::Vector &goal,
+                            float goalRadius)
+{
+    m_bmStep ++;
+
+    if ( m_pathSearch == nullptr )  // search not started yet?
+    {
+        if ( m_gridSnapshot == nullptr )  // first call?
+        {
+            GridSnapshotStart(start, goal, goalRadius, 0);
+        }
+        if ( !GridSnapshotFill() )  return ERR_CONTINUE;
+
+        std::shared_ptr<CPathSearch> search = std::make_shared<CPathSearch>(m_gridSnapshot, start, goal, goalRadius, GRID_MAX_CELLS);
+        m_pathSearch = search;
+        m_pathSearchStep = m_bmStep-1;
+        m_main->GetPathWorkers()->Run([search]() { search->Run(); });
+    }
+
+    // Waits for the worker only if it's late, the game must go on
+    // the same way whatever the speed of the worker.
+    if ( !m_pathSearch->WaitForProgress((m_bmStep-m_pathSearchStep)*GRID_ITER) )  return ERR_CONTINUE;
+
+    Error ret = m_pathSearch->GetResult();
+    if ( ret == ERR_GOTO_IMPOSSIBLE && m_pathSearch->HasReachedBorder() &&
+         ( m_gridSnapshot->GetWidth() < m_bmSize || m_gridSnapshot->GetHeight() < m_bmSize ) )
+    {
+        // The way may go around the snapshot, tries again with a bigger one.
+        GridSnapshotStart(start, goal, goalRadius, m_gridMargin*2);
+        m_pathSearch.reset();
+        return ERR_CONTINUE;
+    }
+    if ( ret == ERR_OK )
+    {
+        const std::vector<Math::Vector>& points = m_pathSearch->GetPoints();
+        if ( static_cast<int>(points.size()) > MAXPOINTS+1 )
+        {
+            ret = ERR_GOTO_ITER;
+        }
+        else
+        {
+            std::copy(points.begin(), points.end(), m_bmPoints);
+            m_bmTotal = points.size()-1;
+        }
+    }
+    m_pathSearch.reset();
+    m_gridSnapshot.reset();
+    return ret;
+}
+
+// Makes an empty snapshot of the bitmap around start and goal,
+// filled by GridSnapshotFill(). The margin is computed from the
+// distance between start and goal if 0.
+
+void CTaskGoto::GridSnapshotStart(const Math::Vector &start, const Math::Vector &goal,
+                                  float goalRadius, int margin)
+{
+    int sx = static_cast<int>((start.x+1600.0f)/BM_DIM_STEP);
+    int sy = static_cast<int>((start.z+1600.0f)/BM_DIM_STEP);
+    int gx = static_cast<int>((goal.x+1600.0f)/BM_DIM_STEP);
+    int gy = static_cast<int>((goal.z+1600.0f)/BM_DIM_STEP);
+
+    if ( margin == 0 )
+    {
+        // Long paths may need long detours.
+        margin = GRID_MARGIN + Math::Max(abs(gx-sx), abs(gy-sy))/2 + static_cast<int>(goalRadius/BM_DIM_STEP);
+    }
+    m_gridMargin = margin;
+
+    int minX = Math::Max(Math::Min(sx, gx)-margin, 0);
+    int minY = Math::Max(Math::Min(sy, gy)-margin, 0);
+    int maxX = Math::Min(Math::Max(sx, gx)+margin, m_bmSize-1);
+    int maxY = Math::Min(Math::Max(sy, gy)+margin, m_bmSize-1);
+
+    m_gridSnapshot = std::make_shared<CNavigationSnapshot>(minX, minY, maxX, maxY);
+    m_gridSnapshotRow = minY;
+}
+
+// Copies the next rows of dots of the bitmap into the snapshot, about
+// GRID_SNAPSHOT_CELLS per frame. Returns true once the snapshot is complete.
+
+bool CTaskGoto::GridSnapshotFill()
+{
+    CNavigationSnapshot& snapshot = *m_gridSnapshot;
+    int minX = snapshot.GetMinX();
+    int maxX = minX+snapshot.GetWidth()-1;
+    int maxY = snapshot.GetMinY()+snapshot.GetHeight()-1;
+
+    int cells = 0;
+    while ( m_gridSnapshotRow <= maxY && cells < GRID_SNAPSHOT_CELLS )
+    {
+        int y = m_gridSnapshotRow++;
+        for ( int x=minX ; x<=maxX ; x++ )
+        {
+            if ( BitmapTestDot(0, x, y) )  snapshot.SetBlocked(x, y);
+        }
+        cells += snapshot.GetWidth();
+    }
+    return m_gridSnapshotRow > maxY;
+}
+
 // Tests if a path along a straight line is possible.
 
 bool CTaskGoto::BitmapTestLine(const Math::Vector &start, const Math::Vector &goal,
@@ -1870,93 +2045,14 @@ bool CTaskGoto::BitmapTestLine(const Math::Vector &start, const Math::Vector &go
     return true;
 }
 
-// Adds the objects in the bitmap.
-
-void CTaskGoto::BitmapObject()
-{
-    auto firstCrashSphere = m_object->GetFirstCrashSphere();
-    float iRadius = firstCrashSphere.sphere.radius;
-
-    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetAllObjects())
-    {
-        ObjectType type = pObj->GetType();
-
-        if ( pObj == m_object )  continue;
-        if ( pObj == m_bmCargoObject )  continue;
-        if (IsObjectBeingTransported(pObj))  continue;
-
-        float h = m_terrain->GetFloorLevel(pObj->GetPosition(), false);
-        if ( m_object->Implements(ObjectInterfaceType::Flying) && m_altitude > 0.0f )
-        {
-            h += m_altitude;
-        }
-
-        for (const auto& crashSphere : pObj->GetAllCrashSpheres())
-        {
-            Math::Vector oPos = crashSphere.sphere.pos;
-            float oRadius = crashSphere.sphere.radius;
-
-            if ( m_object->Implements(ObjectInterfaceType::Flying) && m_altitude > 0.0f )  // flying?
-            {
-                if ( oPos.y-oRadius > h+8.0f ||
-                     oPos.y+oRadius < h-8.0f )  continue;
-            }
-            else    // crawling?
-            {
-                if ( oPos.y-oRadius > h+8.0f )  continue;
-            }
-
-            if ( type == OBJECT_PARA )  oRadius -= 2.0f;
-            BitmapSetCircle(oPos, oRadius+iRadius+SAFETY_MARGIN);
-        }
-    }
-}
-
-// Adds a section of land in the bitmap.
-
-void CTaskGoto::BitmapTerrain(const Math::Vector &min, const Math::Vector &max)
-{
-    int     minx, miny, maxx, maxy;
-
-    minx = static_cast<int>((min.x+1600.0f)/BM_DIM_STEP);
-    miny = static_cast<int>((min.z+1600.0f)/BM_DIM_STEP);
-    maxx = static_cast<int>((max.x+1600.0f)/BM_DIM_STEP);
-    maxy = static_cast<int>((max.z+1600.0f)/BM_DIM_STEP);
-
-    BitmapTerrain(minx, miny, maxx, maxy);
-}
-
-// Adds a section of land in the bitmap.
+// Returns the terrain the robot can move on.
 
-void CTaskGoto::BitmapTerrain(int minx, int miny, int maxx, int maxy)
+NavigationDriveClass CTaskGoto::GetDriveClass()
 {
-    ObjectType  type;
-    Math::Vector    p;
-    float       aLimit, angle, h;
-    int         x, y;
-    bool        bAcceptWater, bFly;
-
-    if ( minx > maxx )  Math::Swap(minx, maxx);
-    if ( miny > maxy )  Math::Swap(miny, maxy);
-
-    if ( minx < 0          )  minx = 0;
-    if ( miny < 0          )  miny = 0;
-    if ( maxx > m_bmSize-1 )  maxx = m_bmSize-1;
-    if ( maxy > m_bmSize-1 )  maxy = m_bmSize-1;
-
-    if ( minx > m_bmMinX )  minx = m_bmMinX;
-    if ( miny > m_bmMinY )  miny = m_bmMinY;
-    if ( maxx < m_bmMaxX )  maxx = m_bmMaxX;
-    if ( maxy < m_bmMaxY )  maxy = m_bmMaxY;
+    NavigationDriveClass driveClass;
+    driveClass.slopeLimit = 20.0f*Math::PI/180.0f;
 
-    if ( minx >= m_bmMinX && maxx <= m_bmMaxX &&
-         miny >= m_bmMinY && maxy <= m_bmMaxY )  return;
-
-    aLimit = 20.0f*Math::PI/180.0f;
-    bAcceptWater = false;
-    bFly = false;
-
-    type = m_object->GetType();
+    ObjectType type = m_object->GetType();
 
     if ( type == OBJECT_MOBILEwa ||
          type == OBJECT_MOBILEwc ||
@@ -1965,7 +2061,7 @@ void CTaskGoto::BitmapTerrain(int minx, int miny, int maxx, int maxy)
          type == OBJECT_MOBILEwt ||
          type == OBJECT_MOBILEtg )  // wheels?
     {
-        aLimit = 20.0f*Math::PI/180.0f;
+        driveClass.slopeLimit = 20.0f*Math::PI/180.0f;
     }
 
     if ( type == OBJECT_MOBILEta ||
@@ -1973,7 +2069,7 @@ void CTaskGoto::BitmapTerrain(int minx, int miny, int maxx, int maxy)
          type == OBJECT_MOBILEti ||
          type == OBJECT_MOBILEts )  // caterpillars?
     {
-        aLimit = 35.0f*Math::PI/180.0f;
+        driveClass.slopeLimit = 35.0f*Math::PI/180.0f;
     }
 
     if ( type == OBJECT_MOBILErt ||
@@ -1981,18 +2077,18 @@ void CTaskGoto::BitmapTerrain(int minx, int miny, int maxx, int maxy)
          type == OBJECT_MOBILErr ||
          type == OBJECT_MOBILErs )  // large caterpillars?
     {
-        aLimit = 35.0f*Math::PI/180.0f;
+        driveClass.slopeLimit = 35.0f*Math::PI/180.0f;
     }
 
     if ( type == OBJECT_MOBILEsa )  // submarine caterpillars?
     {
-        aLimit = 35.0f*Math::PI/180.0f;
-        bAcceptWater = true;
+        driveClass.slopeLimit = 35.0f*Math::PI/180.0f;
+        driveClass.acceptWater = true;
     }
 
     if ( type == OBJECT_MOBILEdr )  // designer caterpillars?
     {
-        aLimit = 35.0f*Math::PI/180.0f;
+        driveClass.slopeLimit = 35.0f*Math::PI/180.0f;
     }
 
     if ( type == OBJECT_MOBILEfa ||
@@ -2001,8 +2097,8 @@ void CTaskGoto::BitmapTerrain(int minx, int miny, int maxx, int maxy)
          type == OBJECT_MOBILEfi ||
          type == OBJECT_MOBILEft )  // flying?
     {
-        aLimit = 15.0f*Math::PI/180.0f;
-        bFly = true;
+        driveClass.slopeLimit = 15.0f*Math::PI/180.0f;
+        driveClass.fly = true;
     }
 
     if ( type == OBJECT_MOBILEia ||
@@ -2010,73 +2106,44 @@ void CTaskGoto::BitmapTerrain(int minx, int miny, int maxx, int maxy)
          type == OBJECT_MOBILEis ||
          type == OBJECT_MOBILEii )  // insect legs?
     {
-        aLimit = 60.0f*Math::PI/180.0f;
+        driveClass.slopeLimit = 60.0f*Math::PI/180.0f;
     }
 
-    for ( y=miny ; y<=maxy ; y++ )
-    {
-        for ( x=minx ; x<=maxx ; x++ )
-        {
-            if ( x >= m_bmMinX && x <= m_bmMaxX &&
-                 y >= m_bmMinY && y <= m_bmMaxY )  continue;
-
-            p.x = x*BM_DIM_STEP-1600.0f;
-            p.z = y*BM_DIM_STEP-1600.0f;
-
-            if ( bFly )  // flying robot?
-            {
-                h = m_terrain->GetFloorLevel(p, true);
-                if ( h >= m_terrain->GetFlyingMaxHeight()-5.0f )
-                {
-                    BitmapSetDot(0, x, y);
-                }
-                continue;
-            }
-
-            if ( !bAcceptWater )  // not going underwater?
-            {
-                h = m_terrain->GetFloorLevel(p, true);
-                if ( h < m_water->GetLevel()-2.0f )  // under water (*)?
-                {
-//?                 BitmapSetDot(0, x, y);
-                    BitmapSetCircle(p, BM_DIM_STEP*1.0f);
-                    continue;
-                }
-            }
-
-            angle = m_terrain->GetFineSlope(p);
-            if ( angle > aLimit )
-            {
-                BitmapSetDot(0, x, y);
-            }
-        }
-    }
-
-    m_bmMinX = minx;
-    m_bmMinY = miny;
-    m_bmMaxX = maxx;
-    m_bmMaxY = maxy;  // expanded rectangular area
+    return driveClass;
 }
 
-// (*)  Accepts that a robot is 50cm under water, for example Tropica 3!
-
 // Opens an empty bitmap.
+// Obstacles come from the navigation grid shared by all robots,
+// the bitmap only holds what is specific to this robot.
 
 bool CTaskGoto::BitmapOpen()
 {
-    BitmapClose();
+    CNavigationGrid* grid = CObjectManager::GetInstancePointer()->GetNavigationGrid();
+    grid->Update();
 
-    m_bmSize = static_cast<int>(3200.0f/BM_DIM_STEP);
-    m_bmArray = MakeUniqueArray<unsigned char>(m_bmSize*m_bmSize/8*2);
-    m_bmChanged = true;
+    float altitude = 0.0f;
+    if ( m_object->Implements(ObjectInterfaceType::Flying) && m_altitude > 0.0f )
+    {
+        altitude = m_altitude;
+    }
+
+    float iRadius = m_object->GetFirstCrashSphere().sphere.radius;
+    m_bmTerrain = grid->GetTerrainLayer(GetDriveClass());
+    m_bmObjects = grid->GetObjectLayer(iRadius+SAFETY_MARGIN, altitude);
 
+    m_bmSize = NAVIGATION_GRID_SIZE;
     m_bmOffset = m_bmSize/2;
     m_bmLine = m_bmSize/8;
 
-    m_bmMinX = m_bmSize;  // non-existent rectangular area
-    m_bmMinY = m_bmSize;
-    m_bmMaxX = 0;
-    m_bmMaxY = 0;
+    if ( m_bmArray == nullptr )
+    {
+        m_bmArray = MakeUniqueArray<unsigned char>(m_bmSize*m_bmSize/8*2);
+    }
+    else
+    {
+        memset(m_bmArray.get(), 0, m_bmSize*m_bmSize/8*2);
+    }
+    m_bmChanged = true;
 
     return true;
 }
@@ -2086,34 +2153,14 @@ bool CTaskGoto::BitmapOpen()
 bool CTaskGoto::BitmapClose()
 {
     m_bmArray.reset();
+    m_bmTerrain.reset();
+    m_bmObjects.reset();
     m_bmChanged = true;
     return true;
 }
 
-// Puts a circle in the bitmap.
-
-void CTaskGoto::BitmapSetCircle(const Math::Vector &pos, float radius)
-{
-    float   d, r;
-    int     cx, cy, ix, iy;
-
-    cx = static_cast<int>((pos.x+1600.0f)/BM_DIM_STEP);
-    cy = static_cast<int>((pos.z+1600.0f)/BM_DIM_STEP);
-    r = radius/BM_DIM_STEP;
-
-    for ( iy=cy-static_cast<int>(r) ; iy<=cy+static_cast<int>(r) ; iy++ )
-    {
-        for ( ix=cx-static_cast<int>(r) ; ix<=cx+static_cast<int>(r) ; ix++ )
-        {
-            d = Math::Point(static_cast<float>(ix-cx), static_cast<float>(iy-cy)).Length();
-            if ( d > r )  continue;
-            BitmapSetDot(0, ix, iy);
-        }
-    }
-}
-
 // Removes a circle in the bitmap.
-//TODO this method is almost same as above one
+
 void CTaskGoto::BitmapClearCircle(const Math::Vector &pos, float radius)
 {
     float   d, r;
@@ -2136,13 +2183,21 @@ void CTaskGoto::BitmapClearCircle(const Math::Vector &pos, float radius)
 
 // Makes a point in the bitmap.
 // x:y: 0..m_bmSize-1
+// Rank 0 of the array holds the dots freed from obstacles.
 
 void CTaskGoto::BitmapSetDot(int rank, int x, int y)
 {
     if ( x < 0 || x >= m_bmSize ||
          y < 0 || y >= m_bmSize )  return;
 
-    m_bmArray[rank*m_bmLine*m_bmSize + m_bmLine*y + x/8] |= (1<<x%8);
+    if ( rank == 0 )
+    {
+        m_bmArray[m_bmLine*y + x/8] &= ~(1<<x%8);
+    }
+    else
+    {
+        m_bmArray[rank*m_bmLine*m_bmSize + m_bmLine*y + x/8] |= (1<<x%8);
+    }
     m_bmChanged = true;
 }
 
@@ -2154,7 +2209,14 @@ void CTaskGoto::BitmapClearDot(int rank, int x, int y)
     if ( x < 0 || x >= m_bmSize ||
          y < 0 || y >= m_bmSize )  return;
 
-    m_bmArray[rank*m_bmLine*m_bmSize + m_bmLine*y + x/8] &= ~(1<<x%8);
+    if ( rank == 0 )
+    {
+        m_bmArray[m_bmLine*y + x/8] |= (1<<x%8);
+    }
+    else
+    {
+        m_bmArray[rank*m_bmLine*m_bmSize + m_bmLine*y + x/8] &= ~(1<<x%8);
+    }
     m_bmChanged = true;
 }
 
@@ -2166,10 +2228,23 @@ bool CTaskGoto::BitmapTestDot(int rank, int x, int y)
     if ( x < 0 || x >= m_bmSize ||
          y < 0 || y >= m_bmSize )  return false;
 
-    if ( x < m_bmMinX || x > m_bmMaxX ||
-         y < m_bmMinY || y > m_bmMaxY )
+    if ( rank == 0 )
     {
-        BitmapTerrain(x-10,y-10, x+10,y+10);  // remade a layer
+        if ( m_bmArray[m_bmLine*y + x/8] & (1<<x%8) )  return false;  // freed?
+
+        if ( m_bmTerrain->IsBlocked(x, y) )  return true;
+
+        int count = m_bmObjects->GetCount(x, y);
+        if ( count == 0 )  return false;
+
+        // Ignores the robot itself and the object it goes to.
+        CNavigationGrid* grid = CObjectManager::GetInstancePointer()->GetNavigationGrid();
+        count -= grid->CountObjectCoverage(*m_bmObjects, m_object, x, y);
+        if ( m_bmCargoObject != nullptr )
+        {
+            count -= grid->CountObjectCoverage(*m_bmObjects, m_bmCargoObject, x, y);
+        }
+        return count > 0;
     }
 
     return m_bmArray[rank*m_bmLine*m_bmSize + m_bmLine*y + x/8] & (1<<x%8);
@@ -23,6 +23,8 @@
 
 #include "math/vector.h"
 
+#include "object/path_planner_type.h"
+
 #include <memory>
 
 namespace Math
@@ -32,6 +34,11 @@ struct Point;
 
 
 class CObject;
+class CNavigationObjectLayer;
+class CNavigationSnapshot;
+class CNavigationTerrainLayer;
+class CPathSearch;
+struct NavigationDriveClass;
 
 const int MAXPOINTS = 500;
 
@@ -88,6 +95,13 @@ public:
     Error       Start(Math::Vector goal, float altitude, TaskGotoGoal goalMode, TaskGotoCrash crashMode);
     Error       IsEnded() override;
 
+    //! Finds a path to the goal without moving the robot, used to compare path planners
+    /**
+     * \param frames number of frames the search would take in the game
+     * \param length length of the path found
+     */
+    Error       ComputePath(Math::Vector goal, PathPlannerType planner, int &frames, float &length);
+
 protected:
     CObject*    WormSearch(Math::Vector &impact);
     void        WormFrame(float rTime);
@@ -102,17 +116,19 @@ protected:
     int         BeamShortcut();
     void        BeamStart();
     void        BeamInit();
+    Error       PathSearch(const Math::Vector &start, const Math::Vector &goal, float goalRadius);
     Error       BeamSearch(const Math::Vector &start, const Math::Vector &goal, float goalRadius);
     Error       BeamExplore(const Math::Vector &prevPos, const Math::Vector &curPos, const Math::Vector &goalPos, float goalRadius, float angle, int nbDiv, float step, int i, int nbIter);
     Math::Vector    BeamPoint(const Math::Vector &startPoint, const Math::Vector &goalPoint, float angle, float step);
 
+    Error       GridSearch(const Math::Vector &start, const Math::Vector &goal, float goalRadius);
+    void        GridSnapshotStart(const Math::Vector &start, const Math::Vector &goal, float goalRadius, int margin);
+    bool        GridSnapshotFill();
+
     bool        BitmapTestLine(const Math::Vector &start, const Math::Vector &goal, float stepAngle, bool bSecond);
-    void        BitmapObject();
-    void        BitmapTerrain(const Math::Vector &min, const Math::Vector &max);
-    void        BitmapTerrain(int minx, int miny, int maxx, int maxy);
+    NavigationDriveClass GetDriveClass();
     bool        BitmapOpen();
     bool        BitmapClose();
-    void        BitmapSetCircle(const Math::Vector &pos, float radius);
     void        BitmapClearCircle(const Math::Vector &pos, float radius);
     void        BitmapSetDot(int rank, int x, int y);
     void        BitmapClearDot(int rank, int x, int y);
@@ -141,9 +157,9 @@ protected:
     int             m_bmSize = 0;       // width or height of the table
     int             m_bmOffset = 0;     // m_bmSize/2
     int             m_bmLine = 0;       // increment line m_bmSize/8
-    std::unique_ptr<unsigned char[]> m_bmArray;      // bit table
-    int             m_bmMinX = 0, m_bmMinY = 0;
-    int             m_bmMaxX = 0, m_bmMaxY = 0;
+    std::unique_ptr<unsigned char[]> m_bmArray;      // bit table: dots freed from obstacles, flags
+    std::shared_ptr<CNavigationTerrainLayer> m_bmTerrain;  // obstacles of the terrain, shared with other robots
+    std::shared_ptr<CNavigationObjectLayer> m_bmObjects;   // obstacles of the objects, shared with other robots
     int             m_bmTotal = 0;      // number of points in m_bmPoints
     int             m_bmIndex = 0;      // index in m_bmPoints
     Math::Vector        m_bmPoints[MAXPOINTS+2];
@@ -157,6 +173,12 @@ protected:
     int             m_bmStep = 0;
     Math::Vector        m_bmWatchDogPos;
     float           m_bmWatchDogTime = 0.0f;
+    PathPlannerType m_planner = PathPlannerType::Beam;
+    std::shared_ptr<CNavigationSnapshot> m_gridSnapshot;  // part of the bitmap copied for the A* search
+    int             m_gridSnapshotRow = 0;      // next row of m_gridSnapshot to copy
+    int             m_gridMargin = 0;           // cells around start and goal in m_gridSnapshot
+    std::shared_ptr<CPathSearch> m_pathSearch;   // A* search running on a worker thread
+    int             m_pathSearchStep = 0;       // m_bmStep before the current search started
     Math::Vector        m_leakPos;      // initial position leak
     float           m_leakDelay = 0.0f;
     float           m_leakTime = 0.0f;
@@ -64,6 +64,11 @@ const float LANDING_SPEED   = 3.0f;
 const float LANDING_ACCEL   = 5.0f;
 const float LANDING_ACCELh  = 1.5f;
 
+// Largest distance at which waypoints and targets are checked in ObjectAdapt()
+const float WAYPOINT_RANGE  = 10.0f*1.5f;
+// Added to the broad phase range to be safe against rounding errors
+const float COLLISION_RANGE_MARGIN = 1.0f;
+
 
 
 
@@ -2497,7 +2502,12 @@ int CPhysics::ObjectAdapt(const Math::Vector &pos, const Math::Vector &angle)
     iPos = iiPos + (pos - m_object->GetPosition());
     iType = m_object->GetType();
 
-    for (CObject* pObj : CObjectManager::GetInstancePointer()->GetAllObjects())
+    // Broad phase: other objects can only be touched if their crash spheres,
+    // jostling sphere or waypoint area reach our sphere
+    CObjectManager* objectManager = CObjectManager::GetInstancePointer();
+    float range = Math::Max(iRad + objectManager->GetMaxCollisionReach(), WAYPOINT_RANGE) + COLLISION_RANGE_MARGIN;
+
+    for (CObject* pObj : objectManager->GetObjectsInRange(iPos, range))
     {
         if ( pObj == m_object )  continue;  // yourself?
         if (IsObjectBeingTransported(pObj))  continue;
@@ -2518,7 +2528,7 @@ int CPhysics::ObjectAdapt(const Math::Vector &pos, const Math::Vector &angle)
         {
             Math::Vector oPos = pObj->GetPosition();
             distance = Math::DistanceProjected(oPos, iPos);
-            if ( distance < 4.0f )
+            if ( distance < 4.0f )  // see WAYPOINT_RANGE
             {
                 m_sound->Play(SOUND_WAYPOINT, m_object->GetPosition());
                 m_engine->GetPyroManager()->Create(Gfx::PT_WPCHECK, pObj);
@@ -2529,13 +2539,17 @@ int CPhysics::ObjectAdapt(const Math::Vector &pos, const Math::Vector &angle)
         {
             Math::Vector oPos = pObj->GetPosition();
             distance = Math::Distance(oPos, iPos);
-            if ( distance < 10.0f*1.5f )
+            if ( distance < 10.0f*1.5f )  // see WAYPOINT_RANGE
             {
                 m_sound->Play(SOUND_WAYPOINT, m_object->GetPosition());
                 m_engine->GetPyroManager()->Create(Gfx::PT_WPCHECK, pObj);
             }
         }
 
+        // None of the crash spheres can touch us?
+        Math::Sphere bounds = pObj->GetCrashSpheresBounds();
+        if ( Math::Distance(bounds.pos, iPos) > iRad+bounds.radius+COLLISION_RANGE_MARGIN )  continue;
+
         for (const auto& crashSphere : pObj->GetAllCrashSpheres())
         {
             Math::Vector oPos = crashSphere.sphere.pos;
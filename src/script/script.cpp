@@ -22,6 +22,7 @@
 
 #include "CBot/CBot.h"
 
+#include "common/profiler.h"
 #include "common/restext.h"
 #include "common/stringutils.h"
 
@@ -132,6 +133,39 @@ bool CScript::GetScript(Ui::CEdit* edit)
     return true;
 }
 
+// Compiles the text of the editor on the side, to find the errors while the program is edited.
+// Neither the compiled program nor the text of the script are modified.
+
+bool CScript::CheckScript(Ui::CEdit* edit, std::string& error)
+{
+    error.clear();
+
+    std::string text = edit->GetText(edit->GetTextLength());
+
+    // Classes and public functions are shared by all programs, compiling them again would
+    // replace the ones of the running programs and invalidate the compiled programs shared
+    // between robots (see CBotProgram::CompileShared()). They are only checked when the
+    // program is really compiled.
+    auto tokens = CBot::CBotToken::CompileTokens(text);
+    for (CBot::CBotToken* p = tokens.get(); p != nullptr; p = p->GetNext())
+    {
+        if (p->GetType() == CBot::ID_CLASS ||
+            p->GetType() == CBot::ID_PUBLIC)  return true;
+    }
+
+    CBot::CBotProgram program(m_object->GetBotVar());
+    std::vector<std::string> functionList;
+    if (program.Compile(text, functionList, this))  return true;
+
+    CBot::CBotError err;
+    int cursor1, cursor2;
+    program.GetError(err, cursor1, cursor2);
+    if (err == CBot::CBotNoErr)  return true;
+
+    GetResource(RES_CBOT, err, error);
+    return false;
+}
+
 // Indicates whether a program is compiled correctly.
 
 bool CScript::GetCompile()
@@ -160,6 +194,7 @@ bool CScript::CheckToken()
 
     m_error = CBot::CBotNoErr;
     m_title.clear();
+    m_zoneName = nullptr;
     m_mainFunction.clear();
     m_token.clear();
     m_bCompile = false;
@@ -226,6 +261,7 @@ bool CScript::Compile()
     m_cursor1 = 0;
     m_cursor2 = 0;
     m_title.clear();
+    m_zoneName = nullptr;
     m_mainFunction.clear();
     m_bCompile = false;
 
@@ -239,8 +275,12 @@ bool CScript::Compile()
     {
         m_botProg = MakeUnique<CBot::CBotProgram>(m_object->GetBotVar());
     }
+    m_botProg->EnableBytecode(m_main->GetScriptBytecode());
 
-    if ( m_botProg->Compile(m_script.get(), functionList, this) )
+    // Robots of the same type running the same code share the compiled program,
+    // the compile functions of external calls only check the type of the object (see CScriptFunctions::cFire())
+    std::string context = StrUtils::ToString<int>(m_object->GetType());
+    if ( m_botProg->CompileShared(m_script.get(), functionList, this, context) )
     {
         if (functionList.empty())
         {
@@ -286,6 +326,21 @@ const std::string& CScript::GetTitle()
     return m_title;
 }
 
+// Returns the name of the profiler zone of the script.
+
+const char* CScript::GetZoneName()
+{
+    if (m_zoneName == nullptr)
+        m_zoneName = CProfiler::GetZoneName(m_title);
+    return m_zoneName;
+}
+
+long long CScript::GetInstructionCount()
+{
+    if (m_botProg == nullptr) return 0;
+    return m_botProg->GetInstructionCount();
+}
+
 
 // Choice of mode of execution.
 
@@ -312,6 +367,7 @@ bool CScript::Run()
 
     m_bRun = true;
     m_bContinue = false;
+    m_parallelResult = ParallelResult::None;
     m_ipf = CBOT_IPF;
     m_errMode = ERM_STOP;
 
@@ -363,7 +419,11 @@ bool CScript::Continue()
         return false;
     }
 
-    if ( m_botProg->Run(this, m_ipf) )
+    ParallelResult parallelResult = m_parallelResult;
+    m_parallelResult = ParallelResult::None;
+    if ( parallelResult == ParallelResult::Suspended )  return false;
+
+    if ( parallelResult == ParallelResult::Finished || m_botProg->Run(this, m_ipf) )
     {
         m_botProg->GetError(m_error, m_cursor1, m_cursor2);
         if ( m_cursor1 < 0 || m_cursor1 > m_len ||
@@ -390,6 +450,32 @@ bool CScript::Continue()
     return false;
 }
 
+// Indicates whether ContinueParallel() can be used before the next Continue().
+
+bool CScript::CanContinueParallel()
+{
+    return m_botProg != nullptr && m_bRun && !m_bStepMode && m_parallelResult == ParallelResult::None;
+}
+
+// Runs the beginning of the next Continue() as far as it doesn't touch anything
+// outside of the program. Can be called from any thread, as long as the world
+// isn't changed at the same time; the next Continue() carries on from there.
+
+void CScript::ContinueParallel()
+{
+    CBot::CBotExecutionContext* context = m_botProg->GetExecutionContext();
+    context->SetDeferExternalAccess(true);
+    bool finished = m_botProg->Run(this, m_ipf);
+    context->SetDeferExternalAccess(false);
+
+    if ( finished )
+        m_parallelResult = ParallelResult::Finished;
+    else if ( context->IsExternalAccessDeferred() )
+        m_parallelResult = ParallelResult::Deferred;
+    else
+        m_parallelResult = ParallelResult::Suspended;
+}
+
 // Continues the execution of current program.
 // Returns true when execution is finished.
 
@@ -439,6 +525,7 @@ void CScript::Stop()
     }
 
     m_bRun = false;
+    m_parallelResult = ParallelResult::None;
 }
 
 // Indicates whether the program runs.
@@ -600,8 +687,7 @@ void CScript::ColorizeScript(Ui::CEdit* edit, int rangeStart, int rangeEnd)
     edit->SetFormat(rangeStart, rangeEnd, Gfx::FONT_HIGHLIGHT_COMMENT); // anything not processed is a comment
 
     // NOTE: Images are registered as index in some array, and that can be 0 which normally ends the string!
-    std::string text = edit->GetText();
-    text = text.substr(rangeStart, rangeEnd-rangeStart);
+    std::string text = edit->GetText().substr(rangeStart, rangeEnd-rangeStart);
 
     auto tokens = CBot::CBotToken::CompileTokens(text.c_str());
     CBot::CBotToken* bt = tokens.get();
@@ -989,6 +1075,7 @@ bool CScript::ReadStack(FILE *file)
 
     m_bRun = true;
     m_bContinue = false;
+    m_parallelResult = ParallelResult::None;
     return true;
 }
 
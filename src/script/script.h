@@ -64,14 +64,21 @@ public:
 
     void        PutScript(Ui::CEdit* edit, const char* name);
     bool        GetScript(Ui::CEdit* edit);
+    bool        CheckScript(Ui::CEdit* edit, std::string& error);
     bool        GetCompile();
 
     const std::string& GetTitle();
+    //! Returns the profiler zone name of the script, made from its title at first use
+    const char* GetZoneName();
+    //! Returns the number of CBot instructions executed by this script so far
+    long long   GetInstructionCount();
 
     void        SetStepMode(bool bStep);
     bool        GetStepMode();
     bool        Run();
     bool        Continue();
+    bool        CanContinueParallel();
+    void        ContinueParallel();
     bool        Step();
     void        Stop();
     bool        IsRunning();
@@ -95,6 +102,16 @@ public:
     void        SetFilename(const std::string &filename);
     const std::string& GetFilename();
 
+protected:
+    //! Result of ContinueParallel() waiting for the next Continue()
+    enum class ParallelResult
+    {
+        None,       //!< nothing was run
+        Finished,   //!< program has ended
+        Suspended,  //!< all instructions for this frame were used
+        Deferred,   //!< stopped before touching anything outside of the program
+    };
+
 protected:
     bool        IsEmpty();
     bool        CheckToken();
@@ -119,7 +136,9 @@ protected:
     bool    m_bStepMode = false;        // step by step
     bool    m_bContinue = false;        // external function to continue
     bool    m_bCompile = false;     // compilation ok?
+    ParallelResult m_parallelResult = ParallelResult::None;
     std::string m_title = "";        // script title
+    const char* m_zoneName = nullptr;   // profiler zone name of m_title, nullptr if not made yet
     std::string m_mainFunction = "";
     std::string m_filename = "";     // file name
     std::string m_token = "";        // missing instruction
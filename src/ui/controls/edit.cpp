@@ -42,6 +42,7 @@
 #include <SDL.h>
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <cstring>
 
 namespace Ui
@@ -94,7 +95,23 @@ bool IsBreaker(char c)
 bool IsDelimiter(char c)
 {
     return IsSpace( c ) || IsBreaker( c );
-}
+}
+
+//! Adds the replacement of [pos, pos+removed[ by inserted characters to the modified part
+//! [start, end[ of the text, the text after end is the same as before the modifications.
+
+void MergeModif(int &start, int &end, int pos, int removed, int inserted)
+{
+    if ( start == -1 )
+    {
+        start = pos;
+        end = pos+inserted;
+        return;
+    }
+
+    start = std::min(start, pos);
+    end = std::max(end+inserted-removed, pos+inserted);
+}
 
 //! Object's constructor.
 CEdit::CEdit()
@@ -102,7 +119,8 @@ CEdit::CEdit()
       m_maxChar( std::numeric_limits<int>::max() ),
       m_text(),
       m_lineOffset(),
-      m_lineIndent()
+      m_lineIndent(),
+      m_lineNesting()
 {
     m_len = 0;
 
@@ -133,6 +151,11 @@ CEdit::CEdit()
     m_lineHeight = 0.0f;
     m_lineVisible = 0;
     m_lineFirst = 0;
+    m_justifStart = -1;
+    m_justifEnd = 0;
+    m_justifDelta = 0;
+    m_modifStart = -1;
+    m_modifEnd = 0;
 
     HyperFlush();
 
@@ -626,7 +649,7 @@ void CEdit::MouseDoubleClick(Math::Point mouse)
 
     m_bUndoForce = true;
 
-    Justif();
+    JustifModif();
     ColumnFix();
 }
 
@@ -1358,6 +1381,7 @@ void CEdit::SetText(const std::string& text, bool bNew)
 
     m_cursor1 = 0;
     m_cursor2 = 0;  // cursor to the beginning
+    TextModifiedAll();
     Justif();
     ColumnFix();
 }
@@ -1837,6 +1861,7 @@ bool CEdit::ReadText(std::string filename)
     }
     m_len = j;
 
+    TextModifiedAll();
     Justif();
     ColumnFix();
     return true;
@@ -1922,6 +1947,7 @@ void CEdit::SetMaxChar(int max)
     m_len = 0;
     m_cursor1 = 0;
     m_cursor2 = 0;
+    TextModifiedAll();
     Justif();
     UndoFlush();
 }
@@ -2175,7 +2201,7 @@ void CEdit::Scroll(int pos, bool bAdjustCursor)
         }
     }
 
-    Justif();
+    JustifModif();
 }
 
 // Moves the cursor to the beginning of the line.
@@ -2214,7 +2240,7 @@ void CEdit::MoveHome(bool bWord, bool bSelect)
     if ( !bSelect )  m_cursor2 = m_cursor1;
 
     m_bUndoForce = true;
-    Justif();
+    JustifModif();
     ColumnFix();
 }
 
@@ -2236,7 +2262,7 @@ void CEdit::MoveEnd(bool bWord, bool bSelect)
     if ( !bSelect )  m_cursor2 = m_cursor1;
 
     m_bUndoForce = true;
-    Justif();
+    JustifModif();
     ColumnFix();
 }
 
@@ -2349,7 +2375,7 @@ void CEdit::MoveChar(int move, bool bWord, bool bSelect)
     if ( !bSelect )  m_cursor2 = m_cursor1;
 
     m_bUndoForce = true;
-    Justif();
+    JustifModif();
     ColumnFix();
 }
 
@@ -2422,7 +2448,7 @@ void CEdit::MoveLine(int move, bool bWord, bool bSelect)
     if ( !bSelect )  m_cursor2 = m_cursor1;
 
     m_bUndoForce = true;
-    Justif();
+    JustifModif();
 }
 
 // Sets the horizontal position.
@@ -2437,13 +2463,13 @@ void CEdit::ColumnFix()
     if ( m_format.empty() )
     {
         m_column = m_engine->GetText()->GetStringWidth(
-                                std::string(m_text.data()+m_lineOffset[line]),
+                                std::string(m_text, m_lineOffset[line], m_cursor1-m_lineOffset[line]),
                                 m_fontType, m_fontSize);
     }
     else
     {
         m_column = m_engine->GetText()->GetStringWidth(
-                                std::string(m_text.data()+m_lineOffset[line]),
+                                std::string(m_text, m_lineOffset[line], m_cursor1-m_lineOffset[line]),
                                 m_format.begin() + m_lineOffset[line],
                                 m_format.end(),
                                 m_fontSize
@@ -2467,7 +2493,7 @@ bool CEdit::Cut()
     Copy(true);
 
     DeleteOne(0);  // deletes the selected characters
-    Justif();
+    JustifModif();
     ColumnFix();
     SendModifEvent();
     return true;
@@ -2559,7 +2585,7 @@ bool CEdit::Paste()
     }
 
     SDL_free(text);
-    Justif();
+    JustifModif();
     ColumnFix();
     SendModifEvent();
     return true;
@@ -2672,7 +2698,7 @@ void CEdit::Insert(char character)
         InsertOne(character);
     }
 
-    Justif();
+    JustifModif();
     ColumnFix();
 }
 
@@ -2713,6 +2739,7 @@ void CEdit::InsertOne(char character)
     {
         m_format[m_cursor1] = m_fontType;
     }
+    TextModified(m_cursor1, 0, 1);
 
     m_cursor1++;
     m_cursor2 = m_cursor1;
@@ -2727,7 +2754,7 @@ void CEdit::Delete(int dir)
     UndoMemorize(OPERUNDO_DELETE);
     DeleteOne(dir);
 
-    Justif();
+    JustifModif();
     ColumnFix();
 }
 
@@ -2767,7 +2794,8 @@ void CEdit::DeleteOne(int dir)
     }
     m_len -= hole;
     m_cursor2 = m_cursor1;
-}
+    TextModified(m_cursor1, hole, 0);
+}
 
 // Delete word
 
@@ -2939,7 +2967,7 @@ bool CEdit::Shift(bool bLeft)
     m_cursor1 = c1;
     m_cursor2 = c2;
 
-    Justif();
+    JustifModif();
     ColumnFix();
     SendModifEvent();
     return true;
@@ -2966,8 +2994,9 @@ bool CEdit::MinMaj(bool bMaj)
         else         character = tolower(character);
         m_text[i] = character;
     }
+    TextModified(c1, c2-c1, c2-c1);
 
-    Justif();
+    JustifModif();
     ColumnFix();
     SendModifEvent();
     return true;
@@ -2978,18 +3007,77 @@ bool CEdit::MinMaj(bool bMaj)
 
 void CEdit::Justif()
 {
-    float   width, size, indentLength = 0.0f;
-    int     i, j, k, line, indent;
-    bool    bDual, bString, bRem;
-
     m_lineOffset.clear();
     m_lineIndent.clear();
+    m_lineNesting.clear();
 
-    indent = 0;
-    m_lineTotal = 0;
     m_lineOffset.push_back( 0 );
-    m_lineIndent.push_back( indent );
-    m_lineTotal ++;
+    m_lineIndent.push_back( 0 );
+    m_lineNesting.push_back( 0 );
+    m_lineTotal = 1;
+
+    m_justifStart = -1;  // the previous lines are not reused
+    JustifLines(0);
+    JustifScroll();
+}
+
+// Cut again the lines of the modified part of the text.
+
+void CEdit::JustifModif()
+{
+    int     line, len;
+
+    if ( m_justifStart != -1 )
+    {
+        if ( m_lineTotal == 0 )
+        {
+            Justif();
+            return;
+        }
+
+        // Starts at the beginning of the paragraph, because a modification
+        // may move the cut of the previous lines of the same paragraph.
+        len = m_len-m_justifDelta;  // length before the modifications
+        line = GetCursorLine(m_justifStart);
+        while ( line > 0 &&
+                (m_lineOffset[line] >= std::min(len, m_len) || m_text[m_lineOffset[line]-1] != '\n' ||
+                 m_lineOffset[line-1] == m_lineOffset[line] ||  // double line of a title?
+                 m_lineOffset[line+1] == m_lineOffset[line]) )
+        {
+            line --;
+        }
+        JustifLines(line);
+    }
+
+    JustifScroll();
+}
+
+// Cut the text lines from the given line, which must begin a paragraph.
+// If the text was modified, the lines after the modified part are taken
+// from the previous cut as soon as a paragraph begins at the same place
+// and with the same level of {} as before.
+
+void CEdit::JustifLines(int line)
+{
+    float   width, size, indentLength = 0.0f;
+    int     i, j, k, first, old, reused, indent;
+    bool    bDual, bString, bRem;
+
+    std::vector<int>  oldOffset;
+    std::vector<char> oldIndent;
+    std::vector<char> oldNesting;
+    if ( m_justifStart != -1 )
+    {
+        oldOffset.assign(m_lineOffset.begin()+line+1, m_lineOffset.end());
+        oldIndent.assign(m_lineIndent.begin()+line+1, m_lineIndent.end());
+        oldNesting.assign(m_lineNesting.begin()+line+1, m_lineNesting.end());
+    }
+
+    m_lineOffset.resize(line+1);
+    m_lineIndent.resize(line+1);
+    m_lineNesting.resize(line+1);
+    m_lineTotal = line+1;
+    reused = -1;
 
     if ( m_bAutoIndent )
     {
@@ -2997,8 +3085,9 @@ void CEdit::Justif()
                         * m_engine->GetEditIndentValue();
     }
 
+    indent = m_lineNesting[line];
     bString = bRem = false;
-    i = k = 0;
+    i = k = m_lineOffset[line];
     while ( true )
     {
         bDual = false;
@@ -3006,14 +3095,19 @@ void CEdit::Justif()
         width = m_dim.x-(10.0f/640.0f)*2.0f-(m_bMulti?MARGX*2.0f+SCROLL_WIDTH:0.0f);
         if ( m_bAutoIndent )
         {
-            width -= indentLength*m_lineIndent[m_lineTotal-1];
+            width -= indentLength*m_lineNesting[m_lineTotal-1];
         }
 
+        // Justify() stops at the end of the paragraph, no need to give it the rest of the text
+        j = i;
+        while ( j < m_len && m_text[j] != '\n' && m_text[j] != 0 )  j ++;
+        if ( j < m_len && m_text[j] == '\n' )  j ++;
+
         if ( m_format.empty() )
         {
             // TODO check if good
 
-            i += m_engine->GetText()->Justify(m_text.data()+i, m_fontType,
+            i += m_engine->GetText()->Justify(std::string(m_text, i, j-i), m_fontType,
                                               m_fontSize, width);
         }
         else
@@ -3033,7 +3127,7 @@ void CEdit::Justif()
             else
             {
                 // TODO check if good
-                i += m_engine->GetText()->Justify(std::string(m_text.data()+i),
+                i += m_engine->GetText()->Justify(std::string(m_text, i, j-i),
                                                   m_format.begin() + i,
                                                   m_format.end(),
                                                   size,
@@ -3060,30 +3154,63 @@ void CEdit::Justif()
 
         m_lineOffset.push_back( i );
         m_lineIndent.push_back( indent );
+        m_lineNesting.push_back( indent );
         m_lineTotal ++;
         if ( bDual )
         {
             m_lineOffset.push_back( i );
             m_lineIndent.push_back( indent );
+            m_lineNesting.push_back( indent );
             m_lineTotal ++;
         }
+
+        // Paragraph after the modified part, cut as before?
+        // (not after a title, because its double line is given by the modified part)
+        if ( m_justifStart != -1 && i > m_justifEnd && m_text[i-1] == '\n' && !bDual )
+        {
+            first = std::lower_bound(oldOffset.begin(), oldOffset.end(), i-m_justifDelta) - oldOffset.begin();
+            old = std::upper_bound(oldOffset.begin(), oldOffset.end(), i-m_justifDelta) - oldOffset.begin();
+            if ( old-first == 1 && oldNesting[first] == indent )
+            {
+                reused = m_lineOffset.size();
+                for ( ; old < static_cast<int>(oldOffset.size()) ; old++ )
+                {
+                    m_lineOffset.push_back( oldOffset[old]+m_justifDelta );
+                    m_lineIndent.push_back( oldIndent[old] );
+                    m_lineNesting.push_back( oldNesting[old] );
+                }
+                m_lineTotal = m_lineOffset.size()-1;  // without the final offset
+                break;
+            }
+        }
+
         if ( k == i ) break;
         k = i;
     }
 
-    if ( m_len > 0 && m_text[m_len-1] == '\n' )
+    if ( reused == -1 )
     {
+        if ( m_len > 0 && m_text[m_len-1] == '\n' )
+        {
+            m_lineOffset.push_back( m_len );
+            m_lineIndent.push_back( 0 );
+            m_lineNesting.push_back( 0 );
+            m_lineTotal ++;
+        }
         m_lineOffset.push_back( m_len );
         m_lineIndent.push_back( 0 );
-        m_lineTotal ++;
+        m_lineNesting.push_back( 0 );
+        reused = m_lineOffset.size();
     }
-    m_lineOffset.push_back( m_len );
-    m_lineIndent.push_back( 0 );
 
     if ( m_bAutoIndent )
     {
-        for ( i=0 ; i<=m_lineTotal ; i++ )
+        first = line;
+        while ( first > 0 && m_lineOffset[first-1] == m_lineOffset[line] )  first --;
+
+        for ( i=first ; i<reused ; i++ )
         {
+            m_lineIndent[i] = m_lineNesting[i];
             if ( m_text[m_lineOffset[i]] == '}' )
             {
                 if ( m_lineIndent[i] > 0 )  m_lineIndent[i] --;
@@ -3091,6 +3218,15 @@ void CEdit::Justif()
         }
     }
 
+    m_justifStart = -1;
+}
+
+// Shows the line of the cursor after cutting the text lines.
+
+void CEdit::JustifScroll()
+{
+    int     line;
+
     if ( m_bMulti )
     {
         if ( m_bEdit )
@@ -3120,19 +3256,33 @@ void CEdit::Justif()
 
 int CEdit::GetCursorLine(int cursor)
 {
-    int     line, i;
+    int     line;
 
-    line = 0;
-    for ( i=0 ; i<m_lineTotal ; i++ )
-    {
-        if ( cursor >= m_lineOffset[i] )
-        {
-            line = i;
-        }
-    }
+    // the offsets are sorted, looks for the last line beginning before the cursor
+    line = std::upper_bound(m_lineOffset.begin(), m_lineOffset.begin()+m_lineTotal, cursor) - m_lineOffset.begin() - 1;
+    if ( line < 0 )  line = 0;
     return line;
 }
 
+// Remembers that the characters [pos, pos+removed[ were replaced by inserted characters.
+
+void CEdit::TextModified(int pos, int removed, int inserted)
+{
+    if ( m_justifStart == -1 )  m_justifDelta = 0;
+    m_justifDelta += inserted-removed;
+
+    MergeModif(m_justifStart, m_justifEnd, pos, removed, inserted);
+    MergeModif(m_modifStart, m_modifEnd, pos, removed, inserted);
+}
+
+// Remembers that the whole text was replaced.
+
+void CEdit::TextModifiedAll()
+{
+    m_modifStart = 0;
+    m_modifEnd = m_len;
+}
+
 
 // Flush the buffer undo.
 
@@ -3202,6 +3352,7 @@ bool CEdit::UndoRecall()
     m_undo[EDITUNDOMAX-1].text.clear();
 
     m_bUndoForce = true;
+    TextModifiedAll();
     Justif();
     ColumnFix();
     SendModifEvent();
@@ -3239,6 +3390,23 @@ bool CEdit::SetFormat(int cursor1, int cursor2, int format)
     return true;
 }
 
+// Returns the part of the text modified since the last ResetModifRange().
+
+bool CEdit::GetModifRange(int &start, int &end)
+{
+    if ( m_modifStart == -1 )  return false;
+
+    start = m_modifStart;
+    end = std::min(m_modifEnd, m_len);
+    return true;
+}
+
+void CEdit::ResetModifRange()
+{
+    m_modifStart = -1;
+    m_modifEnd = 0;
+}
+
 void CEdit::UpdateScroll()
 {
     if (m_scroll != nullptr)
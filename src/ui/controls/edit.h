@@ -176,6 +176,10 @@ public:
     bool        ClearFormat();
     bool        SetFormat(int cursor1, int cursor2, int format);
 
+    //! Gives the part of the text modified since ResetModifRange(), returns false if nothing was modified
+    bool        GetModifRange(int &start, int &end);
+    void        ResetModifRange();
+
 protected:
     void        SendModifEvent();
     bool        IsLinkPos(Math::Point pos);
@@ -213,7 +217,12 @@ protected:
     void        IndentTabAdjust(int number);
     bool        Shift(bool bLeft);
     bool        MinMaj(bool bMaj);
+    void        TextModified(int pos, int removed, int inserted);
+    void        TextModifiedAll();
     void        Justif();
+    void        JustifModif();
+    void        JustifLines(int line);
+    void        JustifScroll();
     int         GetCursorLine(int cursor);
 
     void        UndoFlush();
@@ -254,6 +263,12 @@ protected:
     int     m_lineTotal;            // number lines used (in m_lineOffset)
     std::vector<int> m_lineOffset;
     std::vector<char> m_lineIndent;
+    std::vector<char> m_lineNesting;    // level of {} at the beginning of each line, before the '}' correction
+    int     m_justifStart;          // first modified character not cut in lines yet (-1 if none)
+    int     m_justifEnd;            // end of these modified characters
+    int     m_justifDelta;          // length difference since the last cut in lines
+    int     m_modifStart;           // first modified character since ResetModifRange() (-1 if none)
+    int     m_modifEnd;             // end of these modified characters
     std::vector<ImageLine> m_image;
     std::vector<HyperLink> m_link;
     std::vector<HyperMarker> m_marker;
@@ -22,6 +22,7 @@
 #include "app/app.h"
 
 #include "common/event.h"
+#include "common/profiler.h"
 #include "common/stringutils.h"
 
 #include "graphics/engine/lightning.h"
@@ -42,6 +43,8 @@
 
 #include <SDL_clipboard.h>
 
+#include <algorithm>
+
 namespace Ui
 {
 
@@ -74,6 +77,9 @@ void CDebugMenu::ToggleInterface()
     }
 }
 
+//! Number of last frames exported by the "Export profiler trace" button
+const long long PROFILER_TRACE_FRAMES = 300;
+
 const Math::Point dim = Math::Point(33.0f/640.0f, 33.0f/480.0f);
 const float ox = 3.0f/640.0f, oy = 3.0f/480.0f;
 const float /*sx = 33.0f/640.0f,*/ sy = 33.0f/480.0f;
@@ -86,9 +92,9 @@ void CDebugMenu::CreateInterface()
     CButton* pb;
 
     ddim.x = 4*dim.x+4*ox;
-    ddim.y = 222.0f/480.0f;
+    ddim.y = 222.0f/480.0f+0.048f;
     pos.x = 1.0f-ddim.x;
-    pos.y = oy+sy*3.0f;
+    pos.y = oy+sy*3.0f-0.048f;
     pw->CreateGroup(pos, ddim, 6, EVENT_WINDOW7);
 
     ddim.x = ddim.x - 4*ox;
@@ -122,6 +128,9 @@ void CDebugMenu::CreateInterface()
     pos.y -= 0.048f;
     pb = pw->CreateButton(pos, ddim, -1, EVENT_DBG_LIGHTS_DUMP);
     pb->SetName("Dump lights to log");
+    pos.y -= 0.048f;
+    pb = pw->CreateButton(pos, ddim, -1, EVENT_DBG_PROFILER_TRACE);
+    pb->SetName("Export profiler trace");
 
     UpdateInterface();
 }
@@ -322,6 +331,14 @@ bool CDebugMenu::EventProcess(const Event &event)
             m_engine->DebugDumpLights();
             break;
 
+        case EVENT_DBG_PROFILER_TRACE:
+        {
+            // The current frame is not finished yet
+            long long lastFrame = CProfiler::GetFrame()-1;
+            CProfiler::ExportTrace("profiler_trace.json", std::max(lastFrame-PROFILER_TRACE_FRAMES+1, 1LL), lastFrame);
+            break;
+        }
+
 
         case EVENT_SPAWN_CANCEL:
             DestroyInterface();
@@ -62,7 +62,9 @@
 #include "ui/controls/window.h"
 
 #include <stdio.h>
+#include <algorithm>
 #include <ctime>
+#include <iterator>
 
 
 namespace Ui
@@ -93,6 +95,8 @@ CStudio::CStudio()
     m_bRealTime = true;
     m_bRunning  = false;
     m_fixInfoTextTime = 0.0f;
+    m_checkTime = 0.0f;
+    m_colorLength = 0;
     m_dialog = SD_NULL;
     m_editCamera = Gfx::CAM_TYPE_NULL;
 }
@@ -135,7 +139,8 @@ bool CStudio::EventProcess(const Event &event)
 
     if ( event.type == EVENT_STUDIO_EDIT )  // text modifief?
     {
-        ColorizeScript(edit);
+        ColorizeModifScript(edit);
+        m_checkTime = 1.0f;  // checks the program when the user stops typing
     }
 
     if ( event.type == EVENT_STUDIO_LIST )  // list clicked?
@@ -388,6 +393,15 @@ bool CStudio::EventFrame(const Event &event)
     }
     UpdateButtons();
 
+    if ( m_checkTime > 0.0f )
+    {
+        m_checkTime -= event.rTime;
+        if ( m_checkTime <= 0.0f && !m_bRunning )
+        {
+            CheckScript(edit);
+        }
+    }
+
     if ( m_bRunning )
     {
         m_script->GetCursor(cursor1, cursor2);
@@ -548,6 +562,129 @@ void CStudio::SearchToken(CEdit* edit)
 void CStudio::ColorizeScript(CEdit* edit)
 {
     m_script->ColorizeScript(edit);
+
+    edit->ResetModifRange();
+    m_colorLength = edit->GetTextLength();
+    m_colorBlocks = CBot::CBotToken::FindMultiLineBlocks(edit->GetText(m_colorLength));
+}
+
+// Colors again the lines modified since the last colorization.
+
+void CStudio::ColorizeModifScript(CEdit* edit)
+{
+    std::vector<std::pair<int, int>> blocks, oldBlocks, modified;
+    int     start, end, len, delta, scan, stop;
+    bool    changed;
+
+    if ( !edit->GetModifRange(start, end) )  return;
+    edit->ResetModifRange();
+
+    const std::string& text = edit->GetText();
+    len = edit->GetTextLength();
+    delta = len-m_colorLength;
+    m_colorLength = len;
+
+    // The colors of a line depend on its beginning, the line after
+    // the modification is colorized again even if it was not modified.
+    while ( start > 0 && text[start-1] != '\n' )  start --;
+    while ( end < len && text[end] != '\n' )  end ++;
+    if ( end < len )  end ++;
+
+    // The text before start and after end is the same as before, so are its block comments
+    // and multi-line strings. A block which appeared or disappeared is colorized again entirely.
+    scan = start;
+    for ( auto block : m_colorBlocks )
+    {
+        if ( block.first < start && block.second >= start )  scan = block.first;  // an unterminated block may go on
+        if ( block.first  > start )  block.first  = std::max(start, block.first +delta);
+        if ( block.second > start )  block.second = std::max(start, block.second+delta);
+        oldBlocks.push_back(block);
+    }
+
+    // The blocks are searched again from the beginning of a line outside of them
+    // before the modification, up to the beginning of a line after it which is
+    // outside of them both before and after the modification. The blocks after
+    // it are the same as before, only moved.
+    for ( const auto& block : oldBlocks )
+    {
+        if ( block.first < scan )  blocks.push_back(block);
+    }
+    stop = end;
+    while ( true )
+    {
+        std::vector<std::pair<int, int>> found = CBot::CBotToken::FindMultiLineBlocks(text, len, scan, stop);
+        blocks.insert(blocks.end(), found.begin(), found.end());
+        if ( stop >= len )  break;
+
+        auto old = std::find_if(oldBlocks.begin(), oldBlocks.end(), [stop](const std::pair<int, int>& block)
+        {
+            return block.first < stop && block.second > stop;
+        });
+        if ( old == oldBlocks.end() )
+        {
+            for ( const auto& block : oldBlocks )
+            {
+                if ( block.first >= stop )  blocks.push_back(block);
+            }
+            break;
+        }
+        scan = stop;
+        stop = old->second;
+    }
+    std::set_symmetric_difference(blocks.begin(), blocks.end(),
+                                  oldBlocks.begin(), oldBlocks.end(),
+                                  std::back_inserter(modified));
+    for ( const auto& block : modified )
+    {
+        start = std::min(start, block.first);
+        end   = std::max(end, block.second);
+    }
+
+    // The colorization must begin and end outside of these blocks, at the beginning of a line.
+    do
+    {
+        changed = false;
+        while ( start > 0 && text[start-1] != '\n' )  start --;
+        while ( end < len && text[end-1] != '\n' )  end ++;
+        for ( const auto& block : blocks )
+        {
+            if ( block.first < end && block.second > start &&
+                 (block.first < start || block.second > end) )
+            {
+                start = std::min(start, block.first);
+                end   = std::max(end, block.second);
+                changed = true;
+            }
+        }
+    }
+    while ( changed );
+
+    m_script->ColorizeScript(edit, start, end);
+    m_colorBlocks = blocks;
+}
+
+// Compiles the program when the user stops typing, to show
+// the errors without waiting for the compile button.
+// Only the execution of programs can run on worker threads, the compiler
+// keeps its state in static members of CBotCStack and CBotInstr. So this
+// runs on the main thread, once per pause in typing.
+
+void CStudio::CheckScript(CEdit* edit)
+{
+    std::string error;
+
+    m_script->CheckScript(edit, error);
+    if ( error == m_checkError )  return;  // nothing new
+    m_checkError = error;
+
+    if ( error.empty() )
+    {
+        m_fixInfoTextTime = 0.0f;  // the help about the instructions can be shown again
+    }
+    else
+    {
+        SetInfoText(error, false);
+    }
 }
 
 
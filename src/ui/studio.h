@@ -22,6 +22,7 @@
 #include "graphics/engine/camera.h"
 
 #include <string>
+#include <vector>
 
 class CEventQueue;
 class CScript;
@@ -66,6 +67,8 @@ protected:
     bool        EventFrame(const Event &event);
     void        SearchToken(CEdit* edit);
     void        ColorizeScript(CEdit* edit);
+    void        ColorizeModifScript(CEdit* edit);
+    void        CheckScript(CEdit* edit);
     void        AdjustEditScript();
     void        ViewEditScript();
     void        UpdateFlux();
@@ -117,6 +120,11 @@ protected:
     ActivePause* m_runningPause = nullptr;
     std::string  m_helpFilename;
 
+    float        m_checkTime;       // time before checking the modified program
+    std::string  m_checkError;      // error found by the last check
+    int          m_colorLength;     // length of the text when it was colorized
+    std::vector<std::pair<int, int>> m_colorBlocks;  // multi-line blocks when the text was colorized
+
     StudioDialog m_dialog;
 };
 
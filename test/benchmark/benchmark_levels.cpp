@@ -0,0 +1,96 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "benchmark_levels.h"
+
+#include "app/app.h"
+
+#include "common/event.h"
+#include "common/logger.h"
+#include "common/restext.h"
+#include "common/stringutils.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include "common/system/system.h"
+
+#include "level/level_category.h"
+#include "level/robotmain.h"
+
+#include "level/parser/parser.h"
+
+#include <vector>
+
+int RunInAllLevels(int argc, char* argv[], const std::function<void(const std::string& scene)>& function)
+{
+    CLogger logger;
+    logger.AddOutput(stderr);
+    logger.SetLogLevel(LOG_WARN);
+
+    auto systemUtils = CSystemUtils::Create();
+    systemUtils->Init();
+
+    CResourceManager manager(argv[0]);
+
+    InitializeRestext();
+    InitializeEventTypeTexts();
+
+    // Run without graphics, sound and user interaction
+    std::string headless = "-headless";
+    std::vector<char*> args(argv, argv + argc);
+    args.insert(args.begin() + 1, &headless[0]);
+
+    CApplication app(systemUtils.get());
+    if (app.ParseArguments(static_cast<int>(args.size()), args.data()) != PARSE_ARGS_OK)
+        return app.GetExitCode();
+    if (!app.Create())
+    {
+        logger.Error("Failed to start the game: %s\n", app.GetErrorMessage().c_str());
+        return 1;
+    }
+
+    CRobotMain* main = CRobotMain::GetInstancePointer();
+    int failed = 0;
+    for (int cat = 0; cat < static_cast<int>(LevelCategory::CustomLevels); cat++)
+    {
+        LevelCategory category = static_cast<LevelCategory>(cat);
+        for (int chap = 1; chap <= MAXSCENE; chap++)
+        {
+            if (!CLevelParser(category, chap, 0).Exists()) break;
+
+            for (int rank = 1; rank <= MAXSCENE; rank++)
+            {
+                if (!CLevelParser(category, chap, rank).Exists()) break;
+
+                std::string scene = GetLevelCategoryDir(category) + StrUtils::Format("%d%02d", chap, rank);
+                main->SetLevel(category, chap, rank);
+                main->ChangePhase(PHASE_SIMUL);
+                if (main->GetPhase() != PHASE_SIMUL)
+                {
+                    logger.Error("Failed to load %s\n", scene.c_str());
+                    failed++;
+                    continue;
+                }
+                function(scene);
+            }
+        }
+    }
+
+    return failed == 0 ? 0 : 1;
+}
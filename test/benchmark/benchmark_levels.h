@@ -0,0 +1,37 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+/**
+ * \file test/benchmark/benchmark_levels.h
+ * \brief Loading of the shipped levels for the benchmark tools
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+//! Starts the game headless and calls \a function in each shipped level, once its scene is loaded
+/**
+ * Custom levels are skipped, levels which fail to load are reported and skipped.
+ * Additional command line arguments (e.g. -datadir) are passed to CApplication.
+ * \param function called with the scene name, e.g. "missions103"
+ * \return exit code for the tool
+ */
+int RunInAllLevels(int argc, char* argv[], const std::function<void(const std::string& scene)>& function);
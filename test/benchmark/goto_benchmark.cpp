@@ -0,0 +1,152 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "benchmark_levels.h"
+
+#include "graphics/engine/terrain.h"
+
+#include "level/robotmain.h"
+
+#include "math/const.h"
+
+#include "object/drive_type.h"
+#include "object/object.h"
+#include "object/object_manager.h"
+#include "object/old_object.h"
+#include "object/path_planner_type.h"
+
+#include "object/task/taskgoto.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+/**
+ * \file test/benchmark/goto_benchmark.cpp
+ * \brief A tool for comparing the path planners of goto()
+ *
+ * Each shipped level is loaded headless and every ground robot looks for a path
+ * to random goals around it with both planners (see CTaskGoto::ComputePath()).
+ * The goals are always the same, so that runs can be compared:
+ *
+ * \code{.sh}
+ * ./colobot_goto_benchmark -datadir ../data
+ * \endcode
+ */
+
+namespace
+{
+
+const int GOAL_COUNT = 20;
+const PathPlannerType PLANNERS[2] = { PathPlannerType::Beam, PathPlannerType::Grid };
+
+struct Result
+{
+    int found = 0;
+    int failed = 0;
+    long long frames = 0;
+    double length = 0.0;
+};
+
+void PrintResults(const std::string& name, const Result (&results)[2])
+{
+    std::cout << std::fixed << std::setprecision(1);
+    for (int j = 0; j < 2; j++)
+    {
+        const Result& result = results[j];
+        int found = std::max(result.found, 1);
+        std::cout << name << ", " << GetPathPlannerName(PLANNERS[j]) << " planner: "
+                  << result.found << " paths found, " << result.failed << " failed, average "
+                  << static_cast<double>(result.frames) / found << " frames, length "
+                  << result.length / found << std::endl;
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    Result total[2];
+
+    // Always the same goals, so that runs can be compared
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> angleDistribution(0.0f, Math::PI*2.0f);
+    std::uniform_real_distribution<float> distanceDistribution(50.0f, 400.0f);
+
+    int code = RunInAllLevels(argc, argv, [&](const std::string& scene)
+    {
+        Gfx::CTerrain* terrain = CRobotMain::GetInstancePointer()->GetTerrain();
+        Result results[2];
+
+        for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+        {
+            if (GetDriveFromObject(obj->GetType()) == DriveType::Other) continue;
+            if (!obj->Implements(ObjectInterfaceType::Movable)) continue;
+            COldObject* robot = dynamic_cast<COldObject*>(obj);
+            if (robot == nullptr) continue;
+
+            for (int i = 0; i < GOAL_COUNT; i++)
+            {
+                float angle = angleDistribution(random);
+                float distance = distanceDistribution(random);
+                Math::Vector goal = robot->GetPosition();
+                goal.x += cosf(angle)*distance;
+                goal.z += sinf(angle)*distance;
+                terrain->AdjustToStandardBounds(goal);
+
+                Error errors[2];
+                int frames[2];
+                float lengths[2];
+                for (int j = 0; j < 2; j++)
+                {
+                    CTaskGoto task(robot);
+                    errors[j] = task.ComputePath(goal, PLANNERS[j], frames[j], lengths[j]);
+                }
+                // The goal is on an obstacle, neither planner searches for a path
+                if (errors[0] == ERR_GOTO_BUSY || errors[1] == ERR_GOTO_BUSY) continue;
+
+                for (int j = 0; j < 2; j++)
+                {
+                    if (errors[j] != ERR_OK)
+                    {
+                        results[j].failed++;
+                        continue;
+                    }
+                    results[j].found++;
+                    results[j].frames += frames[j];
+                    results[j].length += lengths[j];
+                }
+            }
+        }
+
+        PrintResults(scene, results);
+        for (int j = 0; j < 2; j++)
+        {
+            total[j].found += results[j].found;
+            total[j].failed += results[j].failed;
+            total[j].frames += results[j].frames;
+            total[j].length += results[j].length;
+        }
+    });
+
+    PrintResults("All levels", total);
+    return code;
+}
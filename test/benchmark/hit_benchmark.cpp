@@ -0,0 +1,168 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "benchmark_levels.h"
+
+#include "graphics/engine/engine.h"
+#include "graphics/engine/particle.h"
+
+#include "math/const.h"
+
+#include "object/object.h"
+#include "object/object_manager.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+/**
+ * \file test/benchmark/hit_benchmark.cpp
+ * \brief A tool for comparing bullet and ray hit tests with and without the object spatial index
+ *
+ * Each shipped level is loaded headless and each object able to be hit shoots
+ * a few bullets and rays in random directions. The shots are tested against all
+ * objects and against the objects found with the spatial index, which must give
+ * the same results:
+ *
+ * \code{.sh}
+ * ./colobot_hit_benchmark -datadir ../data
+ * \endcode
+ */
+
+namespace
+{
+
+const int SHOT_COUNT = 20;
+const Gfx::ParticleType SHOT_TYPES[] = { Gfx::PARTIGUN1, Gfx::PARTIGUN2, Gfx::PARTIGUN3, Gfx::PARTIGUN4, Gfx::PARTITRACK11, Gfx::PARTIRAY1 };
+
+struct Shot
+{
+    Math::Vector start;
+    Math::Vector end;
+    Gfx::ParticleType type;
+    CObject* father;
+};
+
+struct Result
+{
+    int shots = 0;
+    int hits = 0;
+    int mismatches = 0;
+    double linearTime = 0.0;
+    double indexedTime = 0.0;
+};
+
+void PrintResult(const std::string& name, const Result& result)
+{
+    std::cout << std::fixed << std::setprecision(2)
+              << name << ": " << result.shots << " shots, " << result.hits << " hits, all objects "
+              << result.linearTime << " ms, spatial index " << result.indexedTime << " ms, "
+              << result.mismatches << " different results" << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    using Clock = std::chrono::steady_clock;
+    Result total;
+
+    // Always the same shots, so that runs can be compared
+    std::mt19937 random(1234);
+    std::uniform_real_distribution<float> angleDistribution(0.0f, Math::PI*2.0f);
+    std::uniform_real_distribution<float> distanceDistribution(0.0f, 100.0f);
+    std::uniform_real_distribution<float> lengthDistribution(1.0f, 20.0f);
+
+    int code = RunInAllLevels(argc, argv, [&](const std::string& scene)
+    {
+        Gfx::CParticle* particle = Gfx::CEngine::GetInstancePointer()->GetParticle();
+
+        std::vector<CObject*> allObjects;
+        std::vector<CObject*> shooters;
+        for (CObject* obj : CObjectManager::GetInstancePointer()->GetAllObjects())
+        {
+            allObjects.push_back(obj);
+            if (obj->Implements(ObjectInterfaceType::Damageable))
+                shooters.push_back(obj);
+        }
+
+        std::vector<Shot> shots;
+        for (CObject* shooter : shooters)
+        {
+            for (int i = 0; i < SHOT_COUNT; i++)
+            {
+                Shot shot;
+                shot.type = SHOT_TYPES[i % (sizeof(SHOT_TYPES)/sizeof(SHOT_TYPES[0]))];
+                shot.father = shooter;
+
+                float angle = angleDistribution(random);
+                float distance = distanceDistribution(random);
+                shot.start = shooter->GetPosition();
+                shot.start.y += 2.0f;
+                shot.end = shot.start;
+                shot.end.x += cosf(angle)*distance;
+                shot.end.z += sinf(angle)*distance;
+                // Bullets move by small steps, rays hit everything on their way at once
+                if (shot.type != Gfx::PARTIRAY1)
+                {
+                    float length = lengthDistribution(random);
+                    shot.start = shot.end;
+                    shot.start.x -= cosf(angle)*length;
+                    shot.start.z -= sinf(angle)*length;
+                }
+                shots.push_back(shot);
+            }
+        }
+
+        std::vector<CObject*> linearResults;
+        auto linearStart = Clock::now();
+        for (const Shot& shot : shots)
+            linearResults.push_back(particle->SearchObjectHit(shot.start, shot.end, shot.type, shot.father, allObjects));
+        auto linearEnd = Clock::now();
+
+        std::vector<CObject*> indexedResults;
+        for (const Shot& shot : shots)
+            indexedResults.push_back(particle->SearchObjectHit(shot.start, shot.end, shot.type, shot.father));
+        auto indexedEnd = Clock::now();
+
+        Result result;
+        result.shots = static_cast<int>(shots.size());
+        for (unsigned int i = 0; i < shots.size(); i++)
+        {
+            if (linearResults[i] != nullptr) result.hits++;
+            if (linearResults[i] != indexedResults[i]) result.mismatches++;
+        }
+        result.linearTime = std::chrono::duration<double, std::milli>(linearEnd - linearStart).count();
+        result.indexedTime = std::chrono::duration<double, std::milli>(indexedEnd - linearEnd).count();
+        PrintResult(scene, result);
+
+        total.shots += result.shots;
+        total.hits += result.hits;
+        total.mismatches += result.mismatches;
+        total.linearTime += result.linearTime;
+        total.indexedTime += result.indexedTime;
+    });
+
+    PrintResult("All levels", total);
+    if (total.mismatches > 0) return 1;
+    return code;
+}
@@ -0,0 +1,173 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/config.h"
+
+#include "common/logger.h"
+#include "common/make_unique.h"
+
+#include "common/resources/resourcemanager.h"
+
+#include "level/parser/parser.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \file test/benchmark/parser_benchmark.cpp
+ * \brief A tool for measuring the level parser on all shipped scene files
+ *
+ * All scene.txt files under levels/ in the given data directory are loaded,
+ * then every command is looked up (indexed, and with a linear scan for comparison)
+ * and the parameters of all CreateObject lines are converted twice, the second
+ * time from the already parsed values:
+ *
+ * \code{.sh}
+ * ./colobot_parser_benchmark ../data
+ * \endcode
+ */
+
+int main(int argc, char* argv[])
+{
+    using Clock = std::chrono::steady_clock;
+    auto milliseconds = [](Clock::duration duration)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / 1000.0;
+    };
+
+    CLogger logger;
+    logger.AddOutput(stderr);
+
+    CResourceManager manager(argv[0]);
+    std::string dataDir = argc > 1 ? argv[1] : COLOBOT_DEFAULT_DATADIR;
+    if (!CResourceManager::AddLocation(dataDir, false))
+    {
+        std::cerr << "USAGE: " << argv[0] << " [data_directory]" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> files;
+    std::vector<std::string> directories = { "levels" };
+    while (!directories.empty())
+    {
+        std::string directory = directories.back();
+        directories.pop_back();
+        for (const std::string& file : CResourceManager::ListFiles(directory))
+        {
+            if (file == "scene.txt")
+                files.push_back(directory + "/" + file);
+        }
+        for (const std::string& subdirectory : CResourceManager::ListDirectories(directory))
+            directories.push_back(directory + "/" + subdirectory);
+    }
+
+    std::vector<std::unique_ptr<CLevelParser>> parsers;
+    int failed = 0;
+    std::size_t lineCount = 0;
+    auto loadStart = Clock::now();
+    for (const std::string& file : files)
+    {
+        auto parser = MakeUnique<CLevelParser>(file);
+        try
+        {
+            parser->Load();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            failed++;
+            continue;
+        }
+        lineCount += parser->GetLines().size();
+        parsers.push_back(std::move(parser));
+    }
+    auto loadEnd = Clock::now();
+
+    // Look up every command of every file, like scene loading does
+    int found = 0;
+    auto indexedStart = Clock::now();
+    for (auto& parser : parsers)
+    {
+        for (auto& line : parser->GetLines())
+        {
+            if (parser->GetIfDefined(line->GetCommand()) != nullptr)
+                found += parser->CountLines(line->GetCommand());
+        }
+    }
+    auto indexedEnd = Clock::now();
+
+    int linearFound = 0;
+    auto linearStart = Clock::now();
+    for (auto& parser : parsers)
+    {
+        const auto& lines = parser->GetLines();
+        for (auto& line : lines)
+        {
+            for (auto& other : lines)
+            {
+                if (other->GetCommand() == line->GetCommand())
+                    linearFound++;
+            }
+        }
+    }
+    auto linearEnd = Clock::now();
+
+    // Convert parameters of all objects twice, the second time the values are already parsed
+    Clock::duration conversionTimes[2];
+    int conversionErrors = 0;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        auto start = Clock::now();
+        for (auto& parser : parsers)
+        {
+            for (auto& line : parser->GetLines())
+            {
+                if (line->GetCommand() != "CreateObject") continue;
+                try
+                {
+                    line->GetParam("type")->AsObjectType();
+                    line->GetParam("pos")->AsPoint();
+                    line->GetParam("dir")->AsFloat(0.0f);
+                    line->GetParam("power")->AsFloat(1.0f);
+                    line->GetParam("team")->AsInt(0);
+                }
+                catch (const std::exception&)
+                {
+                    if (pass == 0) conversionErrors++;
+                }
+            }
+        }
+        conversionTimes[pass] = Clock::now() - start;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Scene files: " << files.size() << " (" << failed << " failed to load), "
+              << lineCount << " lines loaded in " << milliseconds(loadEnd - loadStart) << " ms" << std::endl;
+    std::cout << "Command lookups: " << milliseconds(indexedEnd - indexedStart) << " ms indexed, "
+              << milliseconds(linearEnd - linearStart) << " ms with linear scan ("
+              << found << "/" << linearFound << " lines found)" << std::endl;
+    std::cout << "CreateObject parameters: " << milliseconds(conversionTimes[0]) << " ms first conversion, "
+              << milliseconds(conversionTimes[1]) << " ms cached (" << conversionErrors << " errors)" << std::endl;
+
+    return failed == 0 ? 0 : 1;
+}
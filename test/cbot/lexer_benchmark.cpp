@@ -0,0 +1,93 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "CBot/CBot.h"
+
+/**
+ * \file test/cbot/lexer_benchmark.cpp
+ * \brief A tool for measuring the throughput of the CBot lexer
+ *
+ * The program is read from stdin and split into tokens the given number of times
+ * (1000 by default), with as many constants defined as in the game:
+ *
+ * \code{.sh}
+ * ./CBot_lexer_benchmark 1000 < input_file.txt
+ * \endcode
+ */
+
+using namespace CBot;
+
+int main(int argc, char* argv[])
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 1000;
+    if (iterations <= 0)
+    {
+        std::cerr << "USAGE: " << argv[0] << " [iterations] < input_file.txt" << std::endl;
+        return 1;
+    }
+
+    // Read program code from stdin
+    std::string code = "";
+    std::string line;
+    while (std::getline(std::cin, line))
+    {
+        code += line;
+        code += "\n";
+    }
+
+    // Initialize the CBot engine, the game defines a few hundred constants (see CScriptFunctions::Init())
+    CBotProgram::Init();
+    for (int i = 0; i < 500; i++)
+    {
+        CBotProgram::DefineNum("BenchmarkConstant" + std::to_string(i), i);
+    }
+
+    long long tokenCount = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        std::unique_ptr<CBotToken> tokens = CBotToken::CompileTokens(code);
+        for (CBotToken* token = tokens.get(); token != nullptr; token = token->GetNext())
+        {
+            tokenCount++;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Iterations: " << iterations << std::endl;
+    std::cout << "Tokens per iteration: " << tokenCount / iterations << std::endl;
+    std::cout << "Total time: " << seconds << " s" << std::endl;
+    if (seconds > 0.0)
+    {
+        std::cout << "Throughput: " << code.size() * iterations / seconds / 1e6 << " MB/s, "
+                  << tokenCount / seconds / 1e6 << " Mtokens/s" << std::endl;
+    }
+
+    // Free the engine
+    CBotProgram::Free();
+
+    return 0;
+}
@@ -122,3 +122,75 @@ TEST_F(CBotTokenUT, BasicProgram)
         {"}",           ID_CLBLK},
     });
 }
+
+TEST_F(CBotTokenUT, Operators)
+{
+    // operators are extended as long as they are still a known operator
+    ExecuteTest("a<<=b>>c>=d!=!e**f%=g&&h||~i--", {
+        {"a",   TokenTypVar},
+        {"<<=", ID_ASSSL},
+        {"b",   TokenTypVar},
+        {">>",  ID_SR},
+        {"c",   TokenTypVar},
+        {">=",  ID_HS},
+        {"d",   TokenTypVar},
+        {"!=",  ID_NE},
+        {"!",   ID_LOG_NOT},
+        {"e",   TokenTypVar},
+        {"**",  ID_POWER},
+        {"f",   TokenTypVar},
+        {"%=",  ID_ASSMODULO},
+        {"g",   TokenTypVar},
+        {"&&",  ID_LOG_AND},
+        {"h",   TokenTypVar},
+        {"||",  ID_LOG_OR},
+        {"~",   ID_NOT},
+        {"i",   TokenTypVar},
+        {"--",  ID_DEC},
+    });
+}
+
+TEST_F(CBotTokenUT, KeywordsAndConstants)
+{
+    CBotProgram::DefineNum("TestConstant", 42);
+    ExecuteTest("if in int integer CBotErrZeroDiv TestConstant TestConstants nan undefined", {
+        {"if",             ID_IF},
+        {"in",             TokenTypVar},
+        {"int",            ID_INT},
+        {"integer",        TokenTypVar},
+        {"CBotErrZeroDiv", TokenTypDef},
+        {"TestConstant",   TokenTypDef},
+        {"TestConstants",  TokenTypVar},
+        {"nan",            ID_NAN},
+        {"undefined",      TX_UNDEF},
+    });
+}
+
+TEST_F(CBotTokenUT, MultiLineBlocks)
+{
+    // the block comments and the strings continued by an escaped line break,
+    // "c\"" is a variable name and "/*/" a whole comment like for the tokens
+    std::string code = "a /* x\n*/ b // /* y\n\"d\\\ne\" c\"/*/ f";
+    std::vector<std::pair<int, int>> blocks = {
+        {2, 9},
+        {20, 26},
+        {29, 32},
+    };
+    ASSERT_EQ(CBotToken::FindMultiLineBlocks(code), blocks);
+
+    // a part only goes up to the first beginning of a line outside of the blocks
+    int stop = 3;
+    blocks = {
+        {2, 9},
+    };
+    ASSERT_EQ(CBotToken::FindMultiLineBlocks(code, code.length(), 0, stop), blocks);
+    ASSERT_EQ(stop, 20);
+
+    stop = 20;
+    blocks = {
+        {20, 26},
+        {29, 32},
+    };
+    ASSERT_EQ(CBotToken::FindMultiLineBlocks(code, code.length(), 20, stop), blocks);
+    ASSERT_EQ(stop, static_cast<int>(code.length()));
+}
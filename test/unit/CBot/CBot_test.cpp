@@ -21,6 +21,7 @@
 
 #include <gtest/gtest.h>
 #include <stdexcept>
+#include <thread>
 
 using namespace CBot;
 
@@ -198,12 +199,20 @@ private:
     }
 
 protected:
+    //! Runs the tests with the tree interpreter and then on the bytecode VM, which must give the same results
     std::unique_ptr<CBotProgram> ExecuteTest(const std::string& code, CBotError expectedError = CBotNoErr)
+    {
+        ExecuteTest(code, expectedError, false);
+        return ExecuteTest(code, expectedError, true);
+    }
+
+    std::unique_ptr<CBotProgram> ExecuteTest(const std::string& code, CBotError expectedError, bool bytecode)
     {
         CBotError expectedCompileError = expectedError < 6000 ? expectedError : CBotNoErr;
         CBotError expectedRuntimeError = expectedError >= 6000 ? expectedError : CBotNoErr;
 
         auto program = std::unique_ptr<CBotProgram>(new CBotProgram());
+        program->EnableBytecode(bytecode);
         std::vector<std::string> tests;
         program->Compile(code, tests);
 
@@ -251,7 +260,7 @@ protected:
             catch (const CBotTestFail& e)
             {
                 std::stringstream ss;
-                ss << "*** Failed test " << test << ": " << e.what() << std::endl;
+                ss << "*** Failed test " << test << (bytecode ? " (bytecode)" : "") << ": " << e.what() << std::endl;
 
                 std::string funcName;
                 program->GetRunPos(funcName, cursor1, cursor2);
@@ -640,6 +649,18 @@ TEST_F(CBotUT, Arrays)
         CBotErrOutArray
     );
 
+    ExecuteTest(
+        "extern void LargeArrayTest()\n"
+        "{\n"
+        "    int a[];\n"
+        "    for (int i = 9998; i >= 0; i--) a[i] = i;\n"
+        "    ASSERT(sizeof(a) == 9999);\n"
+        "    for (int i = 0; i < 9999; i++) ASSERT(a[i] == i);\n"
+        "    a[10000] = 1;\n"
+        "}\n",
+        CBotErrOutArray
+    );
+
     ExecuteTest(
         "extern void BadArrayDeclarationTest()\n"
         "{\n"
@@ -728,6 +749,34 @@ TEST_F(CBotUT, FunctionRecursion)
     );
 }
 
+TEST_F(CBotUT, FunctionRecursionLocalVariables)
+{
+    // the same variables are looked up from different block levels and call depths
+    ExecuteTest(
+        "int sum(int n)\n"
+        "{\n"
+        "    int total = n;\n"
+        "    if (n > 0)\n"
+        "    {\n"
+        "        for (int i = 0; i < 2; i++)\n"
+        "        {\n"
+        "            int half = sum(n - 1);\n"
+        "            if (i == 1) total += half;\n"
+        "        }\n"
+        "    }\n"
+        "    return total;\n"
+        "}\n"
+        "\n"
+        "extern void FunctionRecursionLocalVariables()\n"
+        "{\n"
+        "    ASSERT(sum(5) == 15);\n"
+        "    int n = 0;\n"
+        "    for (int i = 0; i < 3; i++) { n += i; { n += i; } }\n"
+        "    ASSERT(n == 6);\n"
+        "}\n"
+    );
+}
+
 TEST_F(CBotUT, FunctionRecursionStackOverflow)
 {
     ExecuteTest(
@@ -2402,3 +2451,562 @@ TEST_F(CBotUT, ParametersWithDefaultValues)
         "}\n"
     );
 }
+
+TEST_F(CBotUT, ConcurrentExecution)
+{
+    const std::string codeA =
+        "extern void TestConcurrentA() {\n"
+        "    int total = 0;\n"
+        "    outer: for (int i = 0; i < 50; i++) {\n"
+        "        for (int j = 0; j < 50; j++) {\n"
+        "            if (j == i) continue outer;\n"
+        "            if (i > 40) break outer;\n"
+        "            total += Add(i, j);\n"
+        "        }\n"
+        "    }\n"
+        "    ASSERT(total == 32800);\n"
+        "}\n"
+        "int Add(int a, int b) {\n"
+        "    CounterA c = new CounterA();\n"
+        "    c.value = a;\n"
+        "    return c.Plus(b);\n"
+        "}\n"
+        "public class CounterA {\n"
+        "    int value = 0;\n"
+        "    int Plus(int n) { return value + n; }\n"
+        "}\n";
+
+    const std::string codeB =
+        "extern void TestConcurrentB() {\n"
+        "    int total = 0;\n"
+        "    for (int k = 0; k < 200; k++) {\n"
+        "        try {\n"
+        "            if (k % 7 == 0) throw 1234;\n"
+        "            total += Square(k);\n"
+        "        } catch (1234) {\n"
+        "            total += k * k;\n"
+        "        }\n"
+        "    }\n"
+        "    ASSERT(total == 2646700);\n"
+        "    int zero = 0;\n"
+        "    int x = total / zero;\n"
+        "}\n"
+        "int Square(int n) {\n"
+        "    CounterB c = new CounterB();\n"
+        "    return c.Mul(n, n);\n"
+        "}\n"
+        "public class CounterB {\n"
+        "    int Mul(int a, int b) { return a * b; }\n"
+        "}\n";
+
+    std::vector<std::string> externFunctions;
+    CBotProgram programA;
+    ASSERT_TRUE(programA.Compile(codeA, externFunctions));
+    CBotProgram programB;
+    ASSERT_TRUE(programB.Compile(codeB, externFunctions));
+    ASSERT_NE(programA.GetExecutionContext(), programB.GetExecutionContext());
+
+    auto runProgram = [](CBotProgram* program, const std::string& name, bool* failed)
+    {
+        for (int repeat = 0; repeat < 20; repeat++)
+        {
+            program->Start(name);
+            try
+            {
+                while (!program->Run(nullptr, 5));
+            }
+            catch (...)
+            {
+                *failed = true;
+                return;
+            }
+        }
+    };
+
+    bool failedA = false;
+    bool failedB = false;
+    std::thread threadA(runProgram, &programA, "TestConcurrentA", &failedA);
+    std::thread threadB(runProgram, &programB, "TestConcurrentB", &failedB);
+    threadA.join();
+    threadB.join();
+
+    EXPECT_FALSE(failedA);
+    EXPECT_FALSE(failedB);
+    EXPECT_EQ(CBotNoErr, programA.GetError());
+    EXPECT_EQ(CBotErrZeroDiv, programB.GetError());
+}
+
+namespace
+{
+int g_deferredCalls = 0;
+
+CBotTypResult cDeferredCall(CBotVar* &var, void* user)
+{
+    if (var != nullptr) return CBotTypResult(CBotErrOverParam);
+    return CBotTypResult(CBotTypInt);
+}
+
+bool rDeferredCall(CBotVar* var, CBotVar* result, int& exception, void* user)
+{
+    result->SetValInt(++g_deferredCalls);
+    return true;
+}
+}
+
+TEST_F(CBotUT, DeferredExternalAccess)
+{
+    CBotProgram::AddFunction("DeferredCall", rDeferredCall, cDeferredCall);
+    g_deferredCalls = 0;
+
+    const std::string code =
+        "extern void TestDeferredExternalAccess() {\n"
+        "    float total = 0;\n"
+        "    for (int i = 0; i < 3; i++) total += sqrt(4);\n"
+        "    ASSERT(total == 6);\n"
+        "    ASSERT(DeferredCall() == 1);\n"
+        "    ASSERT(DeferredCall() == 2);\n"
+        "}\n";
+
+    std::vector<std::string> externFunctions;
+    CBotProgram program;
+    ASSERT_TRUE(program.Compile(code, externFunctions));
+    program.Start("TestDeferredExternalAccess");
+
+    // Thread-safe functions (sqrt) are run, the first other one (ASSERT) is deferred
+    program.GetExecutionContext()->SetDeferExternalAccess(true);
+    EXPECT_FALSE(program.Run(nullptr, 1000));
+    EXPECT_TRUE(program.GetExecutionContext()->IsExternalAccessDeferred());
+    EXPECT_FALSE(program.Run(nullptr, 1000));
+    EXPECT_TRUE(program.GetExecutionContext()->IsExternalAccessDeferred());
+
+    // Resuming without deferring continues from there
+    program.GetExecutionContext()->SetDeferExternalAccess(false);
+    EXPECT_TRUE(program.Run(nullptr, 1000));
+    EXPECT_FALSE(program.GetExecutionContext()->IsExternalAccessDeferred());
+    EXPECT_EQ(CBotNoErr, program.GetError());
+    EXPECT_EQ(2, g_deferredCalls);
+}
+
+TEST_F(CBotUT, DeferredExternalAccessInDestructor)
+{
+    CBotProgram::AddFunction("DeferredCall", rDeferredCall, cDeferredCall);
+    g_deferredCalls = 0;
+
+    const std::string code =
+        "public class TestDeferredClass {\n"
+        "    int a = -1;\n"
+        "    void ~TestDeferredClass() { DeferredCall(); }\n"
+        "}\n"
+        "extern void TestDeferredExternalAccessInDestructor() {\n"
+        "    TestDeferredClass c();\n"
+        "    c = null;\n"
+        "}\n";
+
+    std::vector<std::string> externFunctions;
+    CBotProgram program;
+    ASSERT_TRUE(program.Compile(code, externFunctions));
+    program.Start("TestDeferredExternalAccessInDestructor");
+
+    // The destructor can't be interrupted, the program isn't run at all
+    program.GetExecutionContext()->SetDeferExternalAccess(true);
+    EXPECT_FALSE(program.Run(nullptr, 1000));
+    EXPECT_TRUE(program.GetExecutionContext()->IsExternalAccessDeferred());
+    EXPECT_EQ(0, g_deferredCalls);
+
+    program.GetExecutionContext()->SetDeferExternalAccess(false);
+    EXPECT_TRUE(program.Run(nullptr, 1000));
+    EXPECT_EQ(CBotNoErr, program.GetError());
+    EXPECT_EQ(1, g_deferredCalls);
+}
+
+TEST_F(CBotUT, DeferredExternalAccessConstantFields)
+{
+    const std::string code =
+        "public class TestConstantFields {\n"
+        "    int a = -1;\n"
+        "    string b = \"b\";\n"
+        "    float[] c[2];\n"
+        "}\n"
+        "extern int TestDeferredExternalAccessConstantFields() {\n"
+        "    TestConstantFields t();\n"
+        "    return t.a;\n"
+        "}\n";
+
+    std::vector<std::string> externFunctions;
+    CBotProgram program;
+    ASSERT_TRUE(program.Compile(code, externFunctions));
+    program.Start("TestDeferredExternalAccessConstantFields");
+
+    // Constant field initializers don't prevent running the program
+    program.GetExecutionContext()->SetDeferExternalAccess(true);
+    EXPECT_TRUE(program.Run(nullptr, 1000));
+    EXPECT_FALSE(program.GetExecutionContext()->IsExternalAccessDeferred());
+    EXPECT_EQ(CBotNoErr, program.GetError());
+    program.GetExecutionContext()->SetDeferExternalAccess(false);
+}
+
+TEST_F(CBotUT, DeferredExternalAccessFollowsClassChanges)
+{
+    const std::string code =
+        "extern void TestDeferredExternalAccessFollowsClassChanges() {\n"
+        "    int a = 1;\n"
+        "}\n";
+    const std::string classCode =
+        "public class TestDestructorAdded {\n"
+        "    void ~TestDestructorAdded() {}\n"
+        "}\n";
+
+    std::vector<std::string> externFunctions;
+    CBotProgram program;
+    ASSERT_TRUE(program.Compile(code, externFunctions));
+    program.GetExecutionContext()->SetDeferExternalAccess(true);
+
+    program.Start("TestDeferredExternalAccessFollowsClassChanges");
+    EXPECT_TRUE(program.Run(nullptr, 1000));
+    EXPECT_FALSE(program.GetExecutionContext()->IsExternalAccessDeferred());
+
+    // A destructor defined by another program defers this one too
+    {
+        CBotProgram classProgram;
+        classProgram.Compile(classCode, externFunctions);
+        program.Start("TestDeferredExternalAccessFollowsClassChanges");
+        EXPECT_FALSE(program.Run(nullptr, 1000));
+        EXPECT_TRUE(program.GetExecutionContext()->IsExternalAccessDeferred());
+    }
+
+    // Once it's gone, the program runs again
+    program.Start("TestDeferredExternalAccessFollowsClassChanges");
+    EXPECT_TRUE(program.Run(nullptr, 1000));
+    EXPECT_FALSE(program.GetExecutionContext()->IsExternalAccessDeferred());
+    program.GetExecutionContext()->SetDeferExternalAccess(false);
+}
+
+TEST_F(CBotUT, MemoryPoolReusesAllocations)
+{
+    const std::string code =
+        "int Square(int x) { return x * x; }\n"
+        "extern void TestMemoryPool() {\n"
+        "    int sum = 0;\n"
+        "    float f = 0;\n"
+        "    for (int i = 0; i < 100; i++) {\n"
+        "        sum += Square(i % 10);\n"
+        "        f = f + 0.5;\n"
+        "        bool b = (i < 50) && (f > 0);\n"
+        "        string s = \"a\";\n"
+        "    }\n"
+        "    ASSERT(sum == 2850);\n"
+        "}\n";
+
+    std::vector<std::string> externFunctions;
+    CBotProgram program;
+    ASSERT_TRUE(program.Compile(code, externFunctions));
+
+    // The first run fills the free lists
+    program.Start("TestMemoryPool");
+    while (!program.Run(nullptr, 1000));
+    ASSERT_EQ(CBotNoErr, program.GetError());
+
+    CBotMemoryPool::ResetStats();
+    program.Start("TestMemoryPool");
+    while (!program.Run(nullptr, 1000));
+    ASSERT_EQ(CBotNoErr, program.GetError());
+
+    CBotAllocationStats stats = CBotMemoryPool::GetStats();
+    EXPECT_GT(stats.allocations, 100);
+    EXPECT_EQ(0, stats.heapAllocations);
+    EXPECT_EQ(1, stats.stackAllocations);
+    EXPECT_EQ(0, stats.stackHeapAllocations);
+}
+
+TEST_F(CBotUT, InstructionCount)
+{
+    const std::string code =
+        "extern void TestInstructionCount() {\n"
+        "    int a = 0;\n"
+        "    for (int i = 0; i < 100; i++) a++;\n"
+        "}\n";
+
+    std::vector<std::string> externFunctions;
+    CBotProgram program;
+    ASSERT_TRUE(program.Compile(code, externFunctions));
+    EXPECT_EQ(0, program.GetInstructionCount());
+
+    program.Start("TestInstructionCount");
+    EXPECT_FALSE(program.Run(nullptr, 10));
+    long long count = program.GetInstructionCount();
+    EXPECT_GE(count, 10);
+
+    while (!program.Run(nullptr, 10));
+    EXPECT_GT(program.GetInstructionCount(), count + 100);
+    EXPECT_EQ(program.GetExecutionContext()->GetInstructionCount(), program.GetInstructionCount());
+}
+
+TEST_F(CBotUT, SharedCompiledFunctions)
+{
+    const std::string code =
+        "extern void TestShared() {\n"
+        "    int total = 0;\n"
+        "    for (int i = 0; i < 10; i++) total += Square(i);\n"
+        "    ASSERT(total == 285);\n"
+        "}\n"
+        "int Square(int x) { return x * x; }\n";
+
+    std::vector<std::string> externFunctions;
+    auto programA = std::unique_ptr<CBotProgram>(new CBotProgram());
+    ASSERT_TRUE(programA->CompileShared(code, externFunctions, nullptr, "robot"));
+    CBotProgram programB;
+    ASSERT_TRUE(programB.CompileShared(code, externFunctions, nullptr, "robot"));
+    ASSERT_EQ(1u, externFunctions.size());
+    EXPECT_EQ("TestShared", externFunctions[0]);
+    EXPECT_EQ(programA->GetFunctions(), programB.GetFunctions());
+
+    // Another context is compiled again
+    CBotProgram programC;
+    ASSERT_TRUE(programC.CompileShared(code, externFunctions, nullptr, "other robot"));
+    EXPECT_NE(programA->GetFunctions().front(), programC.GetFunctions().front());
+
+    // Public functions can change how any code compiles, so the code is compiled again after them
+    CBotProgram programD;
+    ASSERT_TRUE(programD.CompileShared("public void PublicFunction() {}\n", externFunctions, nullptr, "robot"));
+    CBotProgram programE;
+    ASSERT_TRUE(programE.CompileShared(code, externFunctions, nullptr, "robot"));
+    EXPECT_NE(programA->GetFunctions().front(), programE.GetFunctions().front());
+
+    // Both programs run the same functions at the same time, each with its own state
+    programA->Start("TestShared");
+    programB.Start("TestShared");
+    bool doneA = false;
+    bool doneB = false;
+    while (!doneA || !doneB)
+    {
+        if (!doneA) doneA = programA->Run(nullptr, 3);
+        if (!doneB) doneB = programB.Run(nullptr, 5);
+    }
+    EXPECT_EQ(CBotNoErr, programA->GetError());
+    EXPECT_EQ(CBotNoErr, programB.GetError());
+
+    // The functions stay as long as any program uses them
+    programA.reset();
+    programB.Start("TestShared");
+    while (!programB.Run(nullptr, 1000));
+    EXPECT_EQ(CBotNoErr, programB.GetError());
+}
+
+TEST_F(CBotUT, BytecodeSemantics)
+{
+    ExecuteTest(
+        "int Fib(int n) { if (n < 2) return n; return Fib(n - 1) + Fib(n - 2); }\n"
+        "float Half(float x) { return x / 2; }\n"
+        "void Nothing() {}\n"
+        "extern void BytecodeOperands() {\n"
+        "    int a = 1;\n"
+        "    ASSERT(a + (a = 5) == 6);\n"
+        "    int b = 2;\n"
+        "    b += b++;\n"
+        "    ASSERT(b == 4);\n"
+        "    int c = 3;\n"
+        "    ASSERT(c++ + c == 7);\n"
+        "    ASSERT(++c == 5);\n"
+        "    ASSERT(7 / 2 == 3.5);\n"
+        "    ASSERT(7 % 3 == 1);\n"
+        "    ASSERT(~5 == -6);\n"
+        "    int d;\n"
+        "    d = 10;\n"
+        "    d -= 4;\n"
+        "    d *= d;\n"
+        "    ASSERT(d == 36);\n"
+        "    bool t = true;\n"
+        "    ASSERT(!(t && false));\n"
+        "    ASSERT(t || 1 / 0 == 0);\n"
+        "    ASSERT((t ? 1 : 2) == 1);\n"
+        "    ASSERT(Fib(10) == 55);\n"
+        "    ASSERT(Half(3) == 1.5);\n"
+        "    Nothing();\n"
+        "    ASSERT(nan != 1);\n"
+        "    int n = nan;\n"
+        "    ASSERT(n == nan);\n"
+        "}\n"
+        "extern void BytecodeLoops() {\n"
+        "    int sum = 0;\n"
+        "    outer: for (int i = 0; i < 10; i++) {\n"
+        "        int j = 0;\n"
+        "        while (true) {\n"
+        "            j++;\n"
+        "            if (j > i) continue outer;\n"
+        "            if (i == 8) break outer;\n"
+        "            sum += j;\n"
+        "        }\n"
+        "    }\n"
+        "    ASSERT(sum == 84);\n"
+        "    int k = 0;\n"
+        "    do { k += 2; } while (k < 7);\n"
+        "    ASSERT(k == 8);\n"
+        "    int m = 0;\n"
+        "    for (;;) { if (++m == 5) break; }\n"
+        "    ASSERT(m == 5);\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "extern void BytecodeNotInit() {\n"
+        "    int a;\n"
+        "    int b = a + 1;\n"
+        "}\n",
+        CBotErrNotInit
+    );
+
+    ExecuteTest(
+        "extern void BytecodeNan() {\n"
+        "    int a = nan;\n"
+        "    a++;\n"
+        "}\n",
+        CBotErrNan
+    );
+
+    ExecuteTest(
+        "extern void BytecodeZeroDiv() {\n"
+        "    int a = 0;\n"
+        "    a %= a;\n"
+        "}\n",
+        CBotErrZeroDiv
+    );
+}
+
+TEST_F(CBotUT, BytecodeSaveRestore)
+{
+    const std::string code =
+        "int Sum(int n) { int s = 0; for (int i = 1; i <= n; i++) s += i; return s; }\n"
+        "extern void TestSaveRestore() {\n"
+        "    int total = 0;\n"
+        "    for (int k = 0; k < 20; k++) total += Sum(k);\n"
+        "    ASSERT(total == 1330);\n"
+        "}\n";
+
+    std::vector<std::string> externFunctions;
+    std::unique_ptr<CBotProgram> program(new CBotProgram());
+    ASSERT_TRUE(program->Compile(code, externFunctions));
+    program->EnableBytecode(true);
+    program->Start("TestSaveRestore");
+
+    // Each time the program is interrupted, it continues in a new program, switching between the VM and the tree interpreter
+    int restores = 0;
+    while (!program->Run(nullptr, 7))
+    {
+        FILE* file = tmpfile();
+        ASSERT_NE(nullptr, file);
+        ASSERT_TRUE(program->SaveState(file));
+        rewind(file);
+
+        program.reset(new CBotProgram());
+        ASSERT_TRUE(program->Compile(code, externFunctions));
+        program->EnableBytecode(restores % 2 == 0);
+        ASSERT_TRUE(program->RestoreState(file));
+        fclose(file);
+        restores++;
+    }
+    EXPECT_EQ(CBotNoErr, program->GetError());
+    EXPECT_GT(restores, 10);
+}
+
+TEST_F(CBotUT, BytecodeInstructionCount)
+{
+    const std::string code =
+        "extern void TestBytecodeCount() {\n"
+        "    int a = 0;\n"
+        "    for (int i = 0; i < 100; i++) a += i * 2;\n"
+        "}\n";
+
+    long long counts[2];
+    for (int bytecode = 0; bytecode < 2; bytecode++)
+    {
+        std::vector<std::string> externFunctions;
+        CBotProgram program;
+        ASSERT_TRUE(program.Compile(code, externFunctions));
+        program.EnableBytecode(bytecode != 0);
+        program.Start("TestBytecodeCount");
+        while (!program.Run(nullptr, 10));
+        ASSERT_EQ(CBotNoErr, program.GetError());
+        counts[bytecode] = program.GetInstructionCount();
+    }
+
+    // The VM takes one tick per instruction, fewer than the tree interpreter
+    EXPECT_GT(counts[1], 100);
+    EXPECT_LT(counts[1], counts[0]);
+}
+
+TEST_F(CBotUT, ConstantFolding)
+{
+    ExecuteTest(
+        "extern void ConstantFolding()\n"
+        "{\n"
+        "    int a = 2 * 3 + 4;\n"
+        "    ASSERT(a == 10);\n"
+        "    ASSERT(10 - 2 - 3 == 5);\n"
+        "    ASSERT(2 + 3 * 4 == 14);\n"
+        "    ASSERT(-3 * -2 == 6);\n"
+        "    ASSERT(2 ** 10 == 1024);\n"
+        "    ASSERT(7 % 3 == 1);\n"
+        "    ASSERT(1 << 4 == 16);\n"
+        "    ASSERT(1.5 * 2 == 3);\n"
+        "    float b = 5 / 2;\n"
+        "    ASSERT(b == 2.5);\n"
+        "    int c = 5 / 2;\n"
+        "    ASSERT(c == 2);\n"
+        "    int x = 3;\n"
+        "    ASSERT(x * 2 + 1 * 4 == 10);\n"
+        "    ASSERT(x > 2 && 1 + 1 == 2);\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "extern void ConstantDivideByZero()\n"
+        "{\n"
+        "    int a = 1 % (3 - 3);\n"
+        "}\n",
+        CBotErrZeroDiv
+    );
+}
+
+TEST_F(CBotUT, NumericOperations)
+{
+    ExecuteTest(
+        "extern void NumericOperations()\n"
+        "{\n"
+        "    int s = 0;\n"
+        "    float f = 0;\n"
+        "    for (int i = 0; i < 10; i++)\n"
+        "    {\n"
+        "        s = s + i * 2;\n"
+        "        f = f + i / 2.0;\n"
+        "    }\n"
+        "    ASSERT(s == 90);\n"
+        "    ASSERT(f == 22.5);\n"
+        "    ASSERT(s - 1 >= 89 && s - 1 <= 89 && s != 91);\n"
+        "    ASSERT(f * 2 > 44.9 && f / 2 < 11.3);\n"
+        "    int d = s / 4;\n"
+        "    ASSERT(d == 22);\n"
+        "    float n = nan;\n"
+        "    ASSERT(n == nan);\n"
+        "    ASSERT(n != 1.0);\n"
+        "}\n"
+    );
+
+    ExecuteTest(
+        "extern void NumericNan()\n"
+        "{\n"
+        "    float n = nan;\n"
+        "    float m = 1.0;\n"
+        "    bool b = n < m;\n"
+        "}\n",
+        CBotErrNan
+    );
+
+    ExecuteTest(
+        "extern void NumericDivideByZero()\n"
+        "{\n"
+        "    float z = 0;\n"
+        "    float a = 1.0 / z;\n"
+        "}\n",
+        CBotErrZeroDiv
+    );
+}
@@ -59,6 +59,11 @@ public:
     {
         return CApplication::CreateUpdateEvent();
     }
+
+    int GetPendingSimulationTicks()
+    {
+        return CApplication::GetPendingSimulationTicks();
+    }
 };
 
 class CApplicationUT : public testing::Test
@@ -325,3 +330,70 @@ TEST_F(CApplicationUT, UpdateEventTimeCalculation_SuspendingAndResumingSimulatio
 
     TestCreateUpdateEvent(relTimeExact, absTimeExact, relTime, absTime, relTimeReal, absTimeReal);
 }
+
+TEST_F(CApplicationUT, UpdateEventTimeCalculation_FixedStep)
+{
+    m_app->SetFixedStepRate(50);
+
+    long long relTimeExact = 20000000;
+    long long absTimeExact = relTimeExact;
+    float relTime = relTimeExact / 1e9f;
+    float absTime = absTimeExact / 1e9f;
+    long long relTimeReal = relTimeExact;
+    long long absTimeReal = absTimeExact;
+
+    // The real time doesn't matter
+    NextInstant(1234);
+
+    TestCreateUpdateEvent(relTimeExact, absTimeExact, relTime, absTime, relTimeReal, absTimeReal);
+
+    absTimeExact += relTimeExact;
+    absTime = absTimeExact / 1e9f;
+    absTimeReal += relTimeReal;
+
+    NextInstant(99999999);
+
+    TestCreateUpdateEvent(relTimeExact, absTimeExact, relTime, absTime, relTimeReal, absTimeReal);
+
+    // Simulation speed doesn't change the length of a tick
+    m_app->SetSimulationSpeed(2.0f);
+
+    absTimeExact += relTimeExact;
+    absTime = absTimeExact / 1e9f;
+    relTimeReal = relTimeExact / 2;
+    absTimeReal += relTimeReal;
+
+    TestCreateUpdateEvent(relTimeExact, absTimeExact, relTime, absTime, relTimeReal, absTimeReal);
+}
+
+TEST_F(CApplicationUT, FixedStepTicksPerFrame)
+{
+    EXPECT_EQ(1, m_app->GetPendingSimulationTicks());
+
+    m_app->SetFixedStepRate(100);
+
+    NextInstant(25000000);
+    EXPECT_EQ(2, m_app->GetPendingSimulationTicks());
+
+    // The remaining 5 ms are carried over
+    NextInstant(5000000);
+    EXPECT_EQ(1, m_app->GetPendingSimulationTicks());
+
+    NextInstant(5000000);
+    EXPECT_EQ(0, m_app->GetPendingSimulationTicks());
+
+    m_app->SetSimulationSpeed(4.0f);
+
+    NextInstant(5000000);
+    EXPECT_EQ(2, m_app->GetPendingSimulationTicks());
+
+    // Long frames don't cause an avalanche of ticks
+    NextInstant(1000000000);
+    EXPECT_EQ(10, m_app->GetPendingSimulationTicks());
+    NextInstant(0);
+    EXPECT_EQ(0, m_app->GetPendingSimulationTicks());
+
+    m_app->SuspendSimulation();
+    NextInstant(1000000000);
+    EXPECT_EQ(0, m_app->GetPendingSimulationTicks());
+}
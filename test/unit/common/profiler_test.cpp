@@ -0,0 +1,147 @@
+/*
+ * This file is part of the Colobot: Gold Edition source code
+ * Copyright (C) 2001-2016, Daniel Roux, EPSITEC SA & TerranovaTeam
+ * http://epsitec.ch; http://colobot.info; http://github.com/colobot
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see http://gnu.org/licenses
+ */
+
+#include "common/profiler.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::string ReadFile(const std::string& filename)
+{
+    std::ifstream file(filename);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+} // anonymous namespace
+
+TEST(CProfilerTest, ZoneNamesAreShared)
+{
+    const char* name = CProfiler::GetZoneName("Test zone");
+    EXPECT_EQ(name, CProfiler::GetZoneName(std::string("Test zone")));
+    EXPECT_STREQ("Test zone", name);
+}
+
+TEST(CProfilerTest, ExportTraceOfFrame)
+{
+    CProfiler::StartPerformanceCounter(PCNT_ALL);
+    {
+        CProfilerZone outer("Outer \"zone\"");
+        CProfilerZone inner("Inner zone");
+    }
+    CProfiler::StopPerformanceCounter(PCNT_ALL);
+    long long frame = CProfiler::GetFrame();
+
+    CProfiler::StartPerformanceCounter(PCNT_ALL);
+    {
+        CProfilerZone zone("Next frame zone");
+    }
+    CProfiler::StopPerformanceCounter(PCNT_ALL);
+
+    const std::string filename = "profiler_test_trace.json";
+    ASSERT_TRUE(CProfiler::ExportTrace(filename, frame, frame));
+    std::string trace = ReadFile(filename);
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(0u, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"Frame\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"Outer \\\"zone\\\"\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, trace.find("\"name\":\"Inner zone\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, trace.find("\"args\":{\"frame\":" + std::to_string(frame) + "}"));
+    EXPECT_EQ(std::string::npos, trace.find("Next frame zone"));
+}
+
+TEST(CProfilerTest, PerformanceCountersOfPreviousFrame)
+{
+    CProfiler::StartPerformanceCounter(PCNT_ALL);
+    CProfiler::StartPerformanceCounter(PCNT_UPDATE_ALL);
+    CProfiler::StopPerformanceCounter(PCNT_UPDATE_ALL);
+    CProfiler::StopPerformanceCounter(PCNT_ALL);
+
+    EXPECT_GE(CProfiler::GetPerformanceCounterTime(PCNT_ALL), CProfiler::GetPerformanceCounterTime(PCNT_UPDATE_ALL));
+    EXPECT_EQ(0, CProfiler::GetPerformanceCounterTime(PCNT_RENDER_ALL));
+}
+
+TEST(CProfilerTest, HistogramPercentiles)
+{
+    CTimeHistogram histogram;
+    EXPECT_EQ(0, histogram.GetPercentile(0.5f));
+
+    // 1 ms to 100 ms
+    for (int i = 1; i <= 100; i++)
+        histogram.Add(i * 1000000LL);
+
+    EXPECT_EQ(100, histogram.GetCount());
+    EXPECT_EQ(100000000LL, histogram.GetMax());
+    EXPECT_NEAR(50e6, histogram.GetPercentile(0.5f), 50e6 * 0.05);
+    EXPECT_NEAR(95e6, histogram.GetPercentile(0.95f), 95e6 * 0.05);
+    EXPECT_NEAR(99e6, histogram.GetPercentile(0.99f), 99e6 * 0.05);
+    EXPECT_EQ(100000000LL, histogram.GetPercentile(1.0f));
+
+    CTimeHistogram other;
+    other.Add(500000000LL);
+    histogram.Add(other);
+    EXPECT_EQ(101, histogram.GetCount());
+    EXPECT_EQ(500000000LL, histogram.GetPercentile(1.0f));
+}
+
+TEST(CProfilerTest, HitchesAreRecorded)
+{
+    long long threshold = CProfiler::GetHitchThreshold();
+    CProfiler::ResetFrameStatistics();
+    CProfiler::SetHitchThreshold(1);
+
+    CProfiler::StartPerformanceCounter(PCNT_ALL);
+    CProfiler::StartPerformanceCounter(PCNT_UPDATE_ALL);
+    CProfiler::StartPerformanceCounter(PCNT_UPDATE_GAME);
+    CProfiler::StopPerformanceCounter(PCNT_UPDATE_GAME);
+    CProfiler::StopPerformanceCounter(PCNT_UPDATE_ALL);
+    CProfiler::StopPerformanceCounter(PCNT_ALL);
+
+    CProfiler::SetHitchThreshold(threshold);
+
+    const FrameStatistics& statistics = CProfiler::GetFrameStatistics();
+    EXPECT_EQ(1, statistics.frameTimes.GetCount());
+    EXPECT_EQ(1, statistics.updateTimes.GetCount());
+    EXPECT_EQ(1, statistics.hitchCount);
+    ASSERT_EQ(1u, statistics.hitches.size());
+    EXPECT_EQ(CProfiler::GetFrame(), statistics.hitches[0].frame);
+    EXPECT_EQ(1, CProfiler::GetRecentFrameStatistics().hitchCount);
+}
+
+TEST(CProfilerTest, HitchCauseExcludesNestedCounters)
+{
+    ProfilerHitch hitch;
+    hitch.counters[PCNT_ALL] = 200;
+    hitch.counters[PCNT_UPDATE_ALL] = 190;
+    hitch.counters[PCNT_UPDATE_GAME] = 185;
+    hitch.counters[PCNT_UPDATE_CBOT] = 180;
+    hitch.counters[PCNT_RENDER_ALL] = 8;
+
+    long long time = 0;
+    EXPECT_EQ(PCNT_UPDATE_CBOT, CProfiler::GetHitchCause(hitch, &time));
+    EXPECT_EQ(180, time);
+}